@@ -0,0 +1,1431 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include <verus.h>
+#include <array>
+#include <numeric>
+
+using namespace verus;
+
+// About the size of a block node:
+struct StoreBenchmarkNode
+{
+	BYTE  _data[600] = {};
+	int   _id = 0;
+	float _value = 0;
+};
+
+// Containers are protected, iterate them like WorldManager does:
+struct ListStore : Store<StoreBenchmarkNode>
+{
+	template<typename TFn> void ForEach(const TFn& fn) { for (auto& x : _list) fn(x); }
+};
+struct SlotMapStore : StoreSlotMap<StoreBenchmarkNode>
+{
+	template<typename TFn> void ForEach(const TFn& fn) { for (auto& x : _slotMap) fn(x); }
+};
+
+// Singletons, which WorldManager and base nodes need, no renderer is required:
+struct HeadlessWorld
+{
+	HeadlessWorld()
+	{
+		App::Settings::Make();
+		Physics::Bullet::Make();
+		World::WorldUtils::Make();
+		World::WorldManager::Make();
+		World::WorldManager::I().Init();
+	}
+	~HeadlessWorld()
+	{
+		World::WorldManager::Free();
+		World::WorldUtils::Free();
+		Physics::Bullet::Free();
+		App::Settings::Free();
+	}
+};
+
+// Levels of detail and clusters are protected, add them like BaseMesh::Load() does:
+struct BenchmarkMesh : World::BaseMesh
+{
+	void SetIndexCount(int indexCount) { _indexCount = indexCount; }
+	void AddLOD(int faceCount, float error)
+	{
+		LOD lod;
+		lod._firstIndex = _vLODs.empty() ? _indexCount : _vLODs.back()._firstIndex + _vLODs.back()._indexCount;
+		lod._indexCount = faceCount * 3;
+		lod._error = error;
+		_vLODs.push_back(lod);
+	}
+	void AddCluster(Math::MeshOptimizer::RcCluster cluster)
+	{
+		Cluster meshCluster;
+		meshCluster._sphere = glm::vec4(cluster._center, cluster._radius);
+		meshCluster._cone = glm::vec4(cluster._coneAxis, cluster._coneCutoff);
+		meshCluster._firstIndex = cluster._firstIndex;
+		meshCluster._indexCount = cluster._indexCount;
+		_vClusters.push_back(meshCluster);
+	}
+};
+
+// Texture with parts, which are loaded immediately. Each part is four times larger than the next one:
+struct StreamerBenchmarkTexture : World::StreamedTexture
+{
+	UINT64 _tinySize = 64 * 1024;
+	float  _importance = 0;
+	int    _maxPart = 4;
+	int    _residentPart = 4;
+	int    _loadCount = 0;
+	int    _evictionCount = 0;
+
+	virtual int GetMaxPart() const override { return _maxPart; }
+	virtual int GetResidentPart() const override { return _residentPart; }
+	virtual float GetImportance() const override { return _importance; }
+	virtual bool HasHugeTex() const override { return _residentPart < _maxPart; }
+	virtual bool IsLoadingPart() const override { return false; }
+	virtual bool IsStreamingBusy() const override { return false; }
+	virtual bool IsLoadRequired(int part) const override { return part < _maxPart; }
+	virtual void LoadPart(int part) override
+	{
+		if (part >= _maxPart && HasHugeTex())
+			_evictionCount++;
+		else if (part < _maxPart)
+			_loadCount++;
+		_residentPart = Math::Min(part, _maxPart);
+	}
+	virtual UINT64 ComputeMemoryUsage(int part) const override { return _tinySize << (2 * Math::Max(_maxPart - part, 0)); }
+	virtual UINT64 ComputeMemoryUsageForPart(int part) const override { return part < _maxPart ? ComputeMemoryUsage(part) : 0; }
+	virtual UINT64 GetMemoryUsage() const override { return HasHugeTex() ? ComputeMemoryUsage(_residentPart) : 0; }
+};
+
+// Measures engine's containers and algorithms on synthetic data and compares them with the code they replaced.
+// Each benchmark also checks that both versions give the same result.
+class BenchmarkTool
+{
+	typedef std::chrono::duration<float, std::milli> TMilliseconds;
+
+	int  _repeatCount = 10;
+	bool _textureStreamer = false;
+	bool _radixSort = false;
+	bool _lightClusters = false;
+	bool _store = false;
+	bool _nodeEvents = false;
+	bool _weld = false;
+	bool _meshOptimizer = false;
+	bool _lods = false;
+	bool _clusters = false;
+	bool _physics = false;
+	bool _labels = false;
+
+public:
+	BenchmarkTool();
+	~BenchmarkTool();
+
+	int Main(VERUS_MAIN_DEFAULT_ARGS);
+	bool ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS);
+	void PrintUsage();
+
+	void BenchmarkTextureStreamer();
+	void BenchmarkRadixSort();
+	void BenchmarkLightClusters();
+	void BenchmarkStore();
+	void BenchmarkNodeEvents();
+	void BenchmarkWeld();
+	void BenchmarkMeshOptimizer();
+	void BenchmarkLODs();
+	void BenchmarkClusters();
+	void BenchmarkPhysics();
+	void BenchmarkLabels();
+
+	static void GenerateImportedMesh(Vector<Extra::BaseConvert::Mesh::UberVertex>& vVerts);
+	static String GenerateFontXml();
+
+	template<typename T>
+	float Measure(const T& fn)
+	{
+		float best = FLT_MAX;
+		VERUS_FOR(i, _repeatCount)
+		{
+			const auto t0 = std::chrono::steady_clock::now();
+			fn();
+			const auto t1 = std::chrono::steady_clock::now();
+			best = Math::Min(best, TMilliseconds(t1 - t0).count());
+		}
+		return best;
+	}
+
+	static void Check(bool ok, CSZ what);
+};
+
+BenchmarkTool::BenchmarkTool()
+{
+}
+
+BenchmarkTool::~BenchmarkTool()
+{
+}
+
+int BenchmarkTool::Main(VERUS_MAIN_DEFAULT_ARGS)
+{
+	if (argc <= 1)
+	{
+		PrintUsage();
+		return EXIT_SUCCESS;
+	}
+
+	if (!ParseCommandLine(argc, argv))
+		return EXIT_FAILURE;
+
+	std::wcout << _T("Best of ") << _repeatCount << _T(" runs is shown.") << std::endl;
+	if (_textureStreamer)
+		BenchmarkTextureStreamer();
+	if (_radixSort)
+		BenchmarkRadixSort();
+	if (_lightClusters)
+		BenchmarkLightClusters();
+	if (_store)
+		BenchmarkStore();
+	if (_nodeEvents)
+		BenchmarkNodeEvents();
+	if (_weld)
+		BenchmarkWeld();
+	if (_meshOptimizer)
+		BenchmarkMeshOptimizer();
+	if (_lods)
+		BenchmarkLODs();
+	if (_clusters)
+		BenchmarkClusters();
+	if (_physics)
+		BenchmarkPhysics();
+	if (_labels)
+		BenchmarkLabels();
+	return EXIT_SUCCESS;
+}
+
+bool BenchmarkTool::ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS)
+{
+	bool any = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--repeat") && i + 1 < argc)
+			_repeatCount = Math::Max(1, atoi(argv[++i]));
+		else if (!strcmp(argv[i], "--texture-streamer"))
+			any = _textureStreamer = true;
+		else if (!strcmp(argv[i], "--radix-sort"))
+			any = _radixSort = true;
+		else if (!strcmp(argv[i], "--light-clusters"))
+			any = _lightClusters = true;
+		else if (!strcmp(argv[i], "--store"))
+			any = _store = true;
+		else if (!strcmp(argv[i], "--node-events"))
+			any = _nodeEvents = true;
+		else if (!strcmp(argv[i], "--weld"))
+			any = _weld = true;
+		else if (!strcmp(argv[i], "--mesh-optimizer"))
+			any = _meshOptimizer = true;
+		else if (!strcmp(argv[i], "--lods"))
+			any = _lods = true;
+		else if (!strcmp(argv[i], "--clusters"))
+			any = _clusters = true;
+		else if (!strcmp(argv[i], "--physics"))
+			any = _physics = true;
+		else if (!strcmp(argv[i], "--labels"))
+			any = _labels = true;
+		else if (!strcmp(argv[i], "--all"))
+		{
+			any = true;
+			_textureStreamer = true;
+			_radixSort = true;
+			_lightClusters = true;
+			_store = true;
+			_nodeEvents = true;
+			_weld = true;
+			_meshOptimizer = true;
+			_lods = true;
+			_clusters = true;
+			_physics = true;
+			_labels = true;
+		}
+		else
+			std::wcout << _T("WARNING: Unknown argument ") << Str::Utf8ToWide(argv[i]) << std::endl;
+	}
+	if (!any)
+	{
+		std::wcerr << _T("ERROR: No benchmark selected") << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void BenchmarkTool::PrintUsage()
+{
+	std::wcout << _T("Usage: BenchmarkTool [options] <benchmark> ...") << std::endl;
+	std::wcout << std::endl;
+	std::wcout << _T("Benchmarks:") << std::endl;
+	std::wcout << _T("  --texture-streamer Stream 2k textures within a 256 MB budget, check budget and eviction order (one run).") << std::endl;
+	std::wcout << _T("  --radix-sort     Sort keys of 50k visible blocks, compare with std::sort and material comparator.") << std::endl;
+	std::wcout << _T("  --light-clusters Assign 1k lights to clusters from 100 views, check that lit points find their lights.") << std::endl;
+	std::wcout << _T("  --store          Insert, delete, find and iterate 100k nodes in Store and StoreSlotMap.") << std::endl;
+	std::wcout << _T("  --node-events    Move 1k hierarchies in a world of 10k nodes, compare with broadcasting to all nodes.") << std::endl;
+	std::wcout << _T("  --weld           Weld vertices of an imported 32k-face mesh, compare with a linear search.") << std::endl;
+	std::wcout << _T("  --mesh-optimizer Optimize vertex cache, overdraw and vertex fetch of a 32k-face mesh.") << std::endl;
+	std::wcout << _T("  --lods           Generate levels of detail of a 32k-face mesh and select them for 10k blocks.") << std::endl;
+	std::wcout << _T("  --clusters       Build clusters of a 32k-face sphere and cull them by normal cones from 100 views.") << std::endl;
+	std::wcout << _T("  --physics        Drop 5k boxes, report ms per step of single-threaded and multithreaded Bullet world (one run).") << std::endl;
+	std::wcout << _T("  --labels         Lay out 2k labels with Font's layout cache, compare cold and warm frame.") << std::endl;
+	std::wcout << _T("  --all            Run all benchmarks.") << std::endl;
+	std::wcout << std::endl;
+	std::wcout << _T("Options:") << std::endl;
+	std::wcout << _T("  --repeat <count> Number of runs, the best one is shown (default is 10).") << std::endl;
+}
+
+void BenchmarkTool::BenchmarkTextureStreamer()
+{
+	const int count = 2000;
+	const UINT64 budget = 256 << 20;
+	const int maxFrameCount = 1000;
+	std::wcout << std::endl << _T("Texture streamer, ") << count << _T(" textures, ") << (budget >> 20) << _T(" MB budget:") << std::endl;
+
+	// Same size for all textures, so that the most important ones must get the most detailed parts:
+	Vector<StreamerBenchmarkTexture> vTextures(count);
+	Random random(1);
+	for (auto& texture : vTextures)
+		texture._importance = random.NextFloat(0, 1);
+
+	World::TextureStreamer::Make();
+	World::RTextureStreamer ts = World::TextureStreamer::I();
+	ts.SetBudget(budget);
+	ts.SetMaxLoadsPerFrame(32);
+	for (auto& texture : vTextures)
+		ts.Register(&texture);
+
+	// Each texture wants part 0, runs frames until nothing changes, returns milliseconds per frame:
+	bool budgetRespected = true;
+	bool evictionOrder = true;
+	auto Run = [&vTextures, &ts, &budgetRespected, &evictionOrder, budget, maxFrameCount](int& frameCount)
+	{
+		float time = 0;
+		for (frameCount = 0; frameCount < maxFrameCount; ++frameCount)
+		{
+			Vector<int> vPrevParts;
+			vPrevParts.reserve(vTextures.size());
+			for (auto& texture : vTextures)
+			{
+				vPrevParts.push_back(texture._residentPart);
+				texture._loadCount = 0;
+				texture._evictionCount = 0;
+				if (texture._residentPart)
+					ts.Request(&texture, 0);
+			}
+
+			const auto t0 = std::chrono::steady_clock::now();
+			ts.ProcessRequests();
+			const auto t1 = std::chrono::steady_clock::now();
+			time += TMilliseconds(t1 - t0).count();
+
+			UINT64 usedMemory = 0;
+			float maxEvictedImportance = -1;
+			float minLoadedImportance = FLT_MAX;
+			bool changed = false;
+			VERUS_FOR(i, vTextures.size())
+			{
+				const auto& texture = vTextures[i];
+				usedMemory += texture.GetMemoryUsage();
+				if (texture._evictionCount)
+					maxEvictedImportance = Math::Max(maxEvictedImportance, texture._importance);
+				if (texture._loadCount && texture._residentPart < vPrevParts[i])
+					minLoadedImportance = Math::Min(minLoadedImportance, texture._importance);
+				if (texture._residentPart != vPrevParts[i])
+					changed = true;
+			}
+			if (usedMemory > budget || ts.GetStats()._usedMemory != usedMemory)
+				budgetRespected = false;
+			if (maxEvictedImportance >= minLoadedImportance) // Only less important textures can be evicted.
+				evictionOrder = false;
+			if (!changed)
+				break;
+		}
+		return frameCount ? time / frameCount : 0;
+	};
+
+	// More important textures must not have less detailed parts:
+	auto IsRanked = [&vTextures]()
+	{
+		Vector<const StreamerBenchmarkTexture*> vSorted;
+		for (const auto& texture : vTextures)
+			vSorted.push_back(&texture);
+		std::sort(vSorted.begin(), vSorted.end(), [](const StreamerBenchmarkTexture* pA, const StreamerBenchmarkTexture* pB)
+			{
+				return pA->_importance > pB->_importance;
+			});
+		VERUS_FOR(i, vSorted.size() - 1)
+		{
+			if (vSorted[i]->_residentPart > vSorted[i + 1]->_residentPart)
+				return false;
+		}
+		return true;
+	};
+
+	int frameCount = 0;
+	const float fillTime = Run(frameCount);
+	const int fillFrameCount = frameCount;
+	const bool filledRanked = IsRanked();
+	for (auto& texture : vTextures)
+		texture._importance = 1 - texture._importance; // Camera turned around.
+	const float swapTime = Run(frameCount);
+	const int swapFrameCount = frameCount;
+	const bool swappedRanked = IsRanked();
+	const World::TextureStreamer::Stats stats = ts.GetStats();
+
+	int residentCount = 0;
+	for (const auto& texture : vTextures)
+	{
+		if (texture.HasHugeTex())
+			residentCount++;
+		ts.Unregister(&texture);
+	}
+	World::TextureStreamer::Free();
+
+	std::wcout << _T("Fill:              ") << fillTime << _T(" ms per frame, ") << fillFrameCount << _T(" frames") << std::endl;
+	std::wcout << _T("Invert importance: ") << swapTime << _T(" ms per frame, ") << swapFrameCount << _T(" frames") << std::endl;
+	std::wcout << _T("Resident textures: ") << residentCount << _T(", used ") << (stats._usedMemory >> 20) << _T(" MB") << std::endl;
+	Check(fillFrameCount < maxFrameCount && swapFrameCount < maxFrameCount, "Streaming converged");
+	Check(budgetRespected, "Memory budget");
+	Check(evictionOrder && filledRanked && swappedRanked, "Importance ranking");
+}
+
+void BenchmarkTool::BenchmarkRadixSort()
+{
+	const int count = 50000;
+	const int materialCount = 300;
+	const int modelCount = 200;
+	std::wcout << std::endl << _T("Radix sort, ") << count << _T(" visible blocks:") << std::endl;
+
+	// Materials are real, they can be used without a renderer:
+	World::MaterialManager::Make();
+	Random random(1);
+	Vector<int> vNameOrder(materialCount);
+	std::iota(vNameOrder.begin(), vNameOrder.end(), 0);
+	std::shuffle(vNameOrder.begin(), vNameOrder.end(), std::mt19937(1)); // Names are not in the order of sort IDs.
+	Vector<World::MaterialPwn> vMaterials(materialCount);
+	VERUS_FOR(i, materialCount)
+	{
+		const String name = "Material" + std::to_string(vNameOrder[i]) + ".vml";
+		World::Material::Desc matDesc;
+		matDesc._name = _C(name);
+		vMaterials[i].Init(matDesc);
+		vMaterials[i]->_blending = static_cast<World::Material::Blending>(random.Next(0, 2));
+	}
+
+	// What the comparator used to read from block nodes. Model nodes need meshes, so models are only sort IDs:
+	struct Block
+	{
+		World::MaterialPtr _material;
+		int                _modelID = 0;
+		int                _lod = 0;
+		float              _distToHeadSq = 0;
+	};
+
+	// Blocks are scattered in memory:
+	Vector<std::unique_ptr<Block>> vBlocks(count);
+	for (auto& p : vBlocks)
+	{
+		p = std::make_unique<Block>();
+		if (random.Next(0, 99)) // Some blocks have no material.
+			p->_material = vMaterials[random.Next(0, materialCount - 1)];
+		p->_modelID = random.Next(0, modelCount - 1);
+		p->_lod = random.Next(0, 3);
+		p->_distToHeadSq = random.NextFloat(0, 1e6f);
+	}
+	Vector<Block*> vVisible(count);
+	VERUS_FOR(i, count)
+		vVisible[i] = vBlocks[i].get();
+
+	Vector<Block*> vSortedByComparator;
+	const float comparatorTime = Measure([&vVisible, &vSortedByComparator]()
+		{
+			vSortedByComparator = vVisible;
+			// Same as the block part of the comparator, which WorldManager::SortVisible() used to have:
+			std::sort(vSortedByComparator.begin(), vSortedByComparator.end(), [](const Block* pA, const Block* pB)
+				{
+					World::MaterialPtr materialA = pA->_material;
+					World::MaterialPtr materialB = pB->_material;
+
+					if (materialA && materialB) // A and B have materials, compare them.
+					{
+						const bool ab = *materialA < *materialB;
+						const bool ba = *materialB < *materialA;
+						if (ab || ba)
+							return ab;
+					}
+					else if (materialA) // A is with material, B is without, so A goes first.
+					{
+						return true;
+					}
+					else if (materialB) // A is without material, B is with, so B goes first.
+					{
+						return false;
+					}
+
+					// Equal materials or none have any material, compare models used:
+					if (pA->_modelID != pB->_modelID)
+						return pA->_modelID < pB->_modelID;
+
+					// Draw same node types front-to-back:
+					return pA->_distToHeadSq < pB->_distToHeadSq;
+				});
+		});
+
+	Vector<SortKey> vSortKeys(count);
+	Vector<SortKey> vSortKeysTemp;
+	Vector<Block*> vSortedByKey(count);
+	const float radixTime = Measure([&vVisible, &vSortKeys, &vSortKeysTemp, &vSortedByKey, count]()
+		{
+			VERUS_FOR(i, count)
+			{
+				const Block* pBlock = vVisible[i];
+				const UINT64 group = World::WorldManager::MakeBlockSortGroup(pBlock->_material, pBlock->_modelID, pBlock->_lod);
+				vSortKeys[i]._key = World::WorldManager::MakeSortKey(World::NodeType::block, group, pBlock->_distToHeadSq);
+				vSortKeys[i]._index = i;
+			}
+			RadixSort::Sort(vSortKeys, vSortKeysTemp, count);
+			VERUS_FOR(i, count)
+				vSortedByKey[i] = vVisible[vSortKeys[i]._index];
+		});
+
+	std::wcout << _T("std::sort with comparator: ") << comparatorTime << _T(" ms") << std::endl;
+	std::wcout << _T("Keys and radix sort:       ") << radixTime << _T(" ms") << std::endl;
+
+	// Groups are in a different order (names vs sort IDs), but both must keep blending order
+	// and put blocks with the same material and model next to each other:
+	typedef std::pair<World::PMaterial, int> TGroup;
+	Set<TGroup> setGroups;
+	for (const auto& p : vBlocks)
+		setGroups.insert(TGroup(p->_material.Get(), p->_modelID));
+	auto IsGrouped = [&setGroups](const Vector<Block*>& v)
+	{
+		auto GetBlending = [](const Block* pBlock) { return pBlock->_material ? +pBlock->_material->_blending : 0x7; };
+		int runCount = 1;
+		VERUS_FOR(i, v.size() - 1)
+		{
+			if (GetBlending(v[i]) > GetBlending(v[i + 1]))
+				return false;
+			if (v[i]->_material != v[i + 1]->_material || v[i]->_modelID != v[i + 1]->_modelID)
+				runCount++;
+		}
+		return runCount == Utils::Cast32(setGroups.size());
+	};
+	const bool grouped = IsGrouped(vSortedByComparator) && IsGrouped(vSortedByKey);
+
+	vBlocks.clear();
+	for (auto& material : vMaterials)
+		material.Done();
+	World::MaterialManager::Free();
+
+	Check(grouped, "Sorted groups");
+}
+
+void BenchmarkTool::BenchmarkLightClusters()
+{
+	const int lightCount = 1000;
+	const int viewCount = 100;
+	std::wcout << std::endl << _T("Light clusters, ") << lightCount << _T(" lights:") << std::endl;
+
+	// Omni lights around the camera, like street lights in a city:
+	Random random(1);
+	Vector<Math::Sphere> vLights(lightCount);
+	for (auto& light : vLights)
+	{
+		const Point3 center(random.NextFloat(-300, 300), random.NextFloat(0, 10), random.NextFloat(-300, 300));
+		light = Math::Sphere(center, random.NextFloat(2, 20));
+	}
+
+	// 1080p, 70 degrees, camera turns around:
+	Vector<World::Camera> vCameras(viewCount);
+	VERUS_FOR(view, viewCount)
+	{
+		const float yaw = VERUS_2PI * view / viewCount;
+		World::RCamera camera = vCameras[view];
+		camera.SetYFov(glm::radians(70.f));
+		camera.SetAspectRatio(16 / 9.f);
+		camera.SetZNear(0.1f);
+		camera.SetZFar(1000);
+		camera.MoveEyeTo(Point3(0, 2, 0));
+		camera.MoveAtTo(Point3(sin(yaw), 2, -cos(yaw)));
+		camera.Update();
+	}
+
+	World::LightClusters lightClusters;
+	lightClusters.Init();
+	const float buildTime = Measure([&vCameras, &vLights, &lightClusters]()
+		{
+			for (const auto& camera : vCameras)
+				lightClusters.Build(camera, vLights.data(), Utils::Cast32(vLights.size()));
+		});
+
+	// Each point, which is inside of a light and inside of the frustum, must find this light in its cluster:
+	World::LightClusters::RcDesc desc = lightClusters.GetDesc();
+	INT64 lightIndexCount = 0;
+	INT64 occupiedClusterCount = 0;
+	int assignedLightCount = 0;
+	bool valid = true;
+	for (const auto& camera : vCameras)
+	{
+		lightClusters.Build(camera, vLights.data(), Utils::Cast32(vLights.size()));
+		lightIndexCount += lightClusters.GetLightIndices().size();
+		for (const auto& cluster : lightClusters.GetClusters())
+		{
+			if (cluster._count)
+				occupiedClusterCount++;
+		}
+
+		const float tanY = tan(camera.GetYFov() * 0.5f);
+		const float tanX = tanY * camera.GetAspectRatio();
+		VERUS_FOR(i, lightCount)
+		{
+			if (lightClusters.IsLightAssigned(i))
+				assignedLightCount++;
+			const Point3 center = vLights[i].GetCenter();
+			const float r = vLights[i].GetRadius() * 0.99f;
+			const Point3 points[] =
+			{
+				center,
+				center + Vector3(r, 0, 0), center + Vector3(-r, 0, 0),
+				center + Vector3(0, r, 0), center + Vector3(0, -r, 0),
+				center + Vector3(0, 0, r), center + Vector3(0, 0, -r)
+			};
+			for (const auto& point : points)
+			{
+				const Point3 posV = camera.GetMatrixV() * point;
+				const float depth = -posV.getZ();
+				if (depth < camera.GetZNear() || depth > camera.GetZFar())
+					continue;
+				const float ndcX = posV.getX() / (depth * tanX);
+				const float ndcY = posV.getY() / (depth * tanY);
+				if (abs(ndcX) >= 1 || abs(ndcY) >= 1)
+					continue;
+				const int x = static_cast<int>((ndcX * 0.5f + 0.5f) * desc._width);
+				const int y = static_cast<int>((0.5f - ndcY * 0.5f) * desc._height);
+				World::LightClusters::RcCluster cluster = lightClusters.GetCluster(lightClusters.GetClusterIndex(x, y, lightClusters.GetSliceAt(depth)));
+				const auto itBegin = lightClusters.GetLightIndices().begin() + cluster._offset;
+				if (std::find(itBegin, itBegin + cluster._count, static_cast<UINT32>(i)) == itBegin + cluster._count)
+					valid = false;
+			}
+		}
+	}
+
+	const int clusterCount = desc._width * desc._height * desc._depth;
+	std::wcout << _T("Build ") << desc._width << _T("x") << desc._height << _T("x") << desc._depth << _T(" clusters for ") << viewCount << _T(" views: ");
+	std::wcout << buildTime / viewCount << _T(" ms per view") << std::endl;
+	std::wcout << _T("Lights in frustum: ") << assignedLightCount / viewCount << _T(" of ") << lightCount << std::endl;
+	std::wcout << _T("Lights per cluster: ") << static_cast<float>(lightIndexCount) / Math::Max<INT64>(1, occupiedClusterCount);
+	std::wcout << _T(" (") << 100.0 * occupiedClusterCount / (static_cast<INT64>(clusterCount) * viewCount) << _T("% of clusters have lights), without clusters ") << lightCount << std::endl;
+	Check(valid, "Lit points");
+}
+
+void BenchmarkTool::BenchmarkStore()
+{
+	const int count = 100000;
+	const int deleteCount = count / 100; // Store::Delete is a linear search.
+	std::wcout << std::endl << _T("Store, ") << count << _T(" nodes:") << std::endl;
+
+	typedef StoreBenchmarkNode Node;
+
+	Vector<int> vDeleteOrder(count);
+	std::iota(vDeleteOrder.begin(), vDeleteOrder.end(), 0);
+	std::shuffle(vDeleteOrder.begin(), vDeleteOrder.end(), std::mt19937(1));
+	vDeleteOrder.resize(deleteCount);
+
+	// Same operations for both stores, returns a checksum:
+	auto Run = [this, count, &vDeleteOrder](auto& store, Vector<Node*>& vNodes, float times[4])
+	{
+		double checksum = 0;
+		VERUS_FOR(rep, _repeatCount)
+		{
+			store.DeleteAll();
+
+			const auto t0 = std::chrono::steady_clock::now();
+			vNodes.resize(count);
+			VERUS_FOR(i, count)
+			{
+				vNodes[i] = store.Insert();
+				vNodes[i]->_id = i;
+				vNodes[i]->_value = static_cast<float>(i & 0xFF);
+			}
+			const auto t1 = std::chrono::steady_clock::now();
+			for (int i : vDeleteOrder)
+				store.Delete(vNodes[i]);
+			const auto t2 = std::chrono::steady_clock::now();
+			int found = 0;
+			VERUS_FOR(i, 1000)
+				found += (store.FindStoredIndex(vNodes[(i * 7919) % count]) >= 0) ? 1 : 0;
+			const auto t3 = std::chrono::steady_clock::now();
+			double sum = 0;
+			VERUS_FOR(i, 10)
+				store.ForEach([&sum](const Node& node) { sum += node._value; });
+			const auto t4 = std::chrono::steady_clock::now();
+
+			const float t[4] = { TMilliseconds(t1 - t0).count(), TMilliseconds(t2 - t1).count(), TMilliseconds(t3 - t2).count(), TMilliseconds(t4 - t3).count() };
+			VERUS_FOR(i, 4)
+				times[i] = rep ? Math::Min(times[i], t[i]) : t[i];
+			checksum = sum + found;
+		}
+		return checksum;
+	};
+
+	float listTimes[4];
+	float slotMapTimes[4];
+	Vector<Node*> vNodes;
+	std::unique_ptr<ListStore> pListStore = std::make_unique<ListStore>();
+	const double listChecksum = Run(*pListStore, vNodes, listTimes);
+	pListStore.reset();
+	std::unique_ptr<SlotMapStore> pSlotMapStore = std::make_unique<SlotMapStore>();
+	const double slotMapChecksum = Run(*pSlotMapStore, vNodes, slotMapTimes);
+	pSlotMapStore.reset();
+
+	CSZ names[] = { "Insert 100k:", "Delete 1k:", "FindStoredIndex 1k:", "Iterate 99k x10:" };
+	VERUS_FOR(i, 4)
+	{
+		std::wcout << Str::Utf8ToWide(names[i]) << _T(" Store ") << listTimes[i] << _T(" ms, StoreSlotMap ") << slotMapTimes[i] << _T(" ms") << std::endl;
+	}
+	Check(listChecksum == slotMapChecksum, "Store checksum");
+}
+
+void BenchmarkTool::BenchmarkNodeEvents()
+{
+	const int count = 10000;
+	const int hierarchyCount = 1000;
+	const int childCount = 4;
+	const int subscriberCount = 100;
+	std::wcout << std::endl << _T("Node events, ") << count << _T(" nodes, ") << hierarchyCount << _T(" hierarchies:") << std::endl;
+
+	HeadlessWorld headlessWorld;
+	World::RWorldManager wm = World::WorldManager::I();
+	wm.SetDeferredTransformMode(false);
+
+	// Unique names, so that EnsureUniqueName() doesn't have to search for a free one:
+	Vector<World::PBaseNode> vNodes(count);
+	wm.DisableNodeSorting();
+	VERUS_FOR(i, count)
+	{
+		World::BaseNodePtr node;
+		node.Init(_C("Node" + std::to_string(i)));
+		vNodes[i] = node.Get();
+	}
+
+	// Roots are followed by their children, the rest are unrelated nodes:
+	Vector<World::PBaseNode> vRoots;
+	vRoots.reserve(hierarchyCount);
+	int index = 0;
+	VERUS_FOR(i, hierarchyCount)
+	{
+		World::PBaseNode pRoot = vNodes[index++];
+		VERUS_FOR(j, childCount)
+		{
+			World::PBaseNode pChild = vNodes[index++];
+			pChild->MoveTo(Point3(static_cast<float>(j + 1), 0, 0));
+			pChild->SetParent(pRoot, true);
+		}
+		vRoots.push_back(pRoot);
+	}
+	wm.EnableNodeSorting();
+	const Vector<World::PBaseNode> vSubscribers(vNodes.begin() + index, vNodes.begin() + index + subscriberCount);
+
+	// Subscribing every node gives the same result as broadcasting to all nodes:
+	auto Run = [this, &wm, &vRoots, &vNodes](const Vector<World::PBaseNode>& vEventSubscribers, float& time)
+	{
+		for (auto pNode : vNodes)
+			wm.UnsubscribeFromNodeEvent(World::NodeEvent::transformed, pNode);
+		for (auto pNode : vEventSubscribers)
+			wm.SubscribeToNodeEvent(World::NodeEvent::transformed, pNode);
+		int step = 0;
+		time = Measure([&vRoots, &step]()
+			{
+				step++;
+				for (auto pRoot : vRoots)
+					pRoot->MoveTo(Point3(0, static_cast<float>(step), 0));
+			});
+		Vector<glm::vec3> vPositions;
+		vPositions.reserve(vNodes.size());
+		for (auto pNode : vNodes)
+			vPositions.push_back(pNode->GetPosition().GLM());
+		return vPositions;
+	};
+
+	float allTime = 0;
+	float subtreeTime = 0;
+	const Vector<glm::vec3> vAllPositions = Run(vNodes, allTime);
+	const Vector<glm::vec3> vSubtreePositions = Run(vSubscribers, subtreeTime);
+
+	std::wcout << _T("Every node subscribed (broadcast to all): ") << allTime << _T(" ms") << std::endl;
+	std::wcout << _T("Target, children and subscribers only:    ") << subtreeTime << _T(" ms") << std::endl;
+	bool childrenFollow = true;
+	VERUS_FOR(i, hierarchyCount)
+	{
+		const int rootIndex = i * (childCount + 1);
+		VERUS_FOR(j, childCount)
+		{
+			if (vSubtreePositions[rootIndex + j + 1] != vSubtreePositions[rootIndex] + glm::vec3(static_cast<float>(j + 1), 0, 0))
+				childrenFollow = false;
+		}
+	}
+	Check(vAllPositions == vSubtreePositions, "Node positions");
+	Check(childrenFollow, "Children follow their roots");
+}
+
+void BenchmarkTool::BenchmarkWeld()
+{
+	typedef Extra::BaseConvert::Mesh::UberVertex UberVertex;
+	typedef Extra::BaseConvert::Mesh::WeldGrid WeldGrid;
+
+	Vector<UberVertex> vVerts;
+	GenerateImportedMesh(vVerts);
+	const int vertCount = Utils::Cast32(vVerts.size());
+	std::wcout << std::endl << _T("Weld, ") << vertCount << _T(" vertices:") << std::endl;
+
+	// Same as BaseConvert::Mesh::Optimize() used to do:
+	Vector<UberVertex> vLinearVerts;
+	Vector<int> vLinearIndices;
+	const float linearTime = Measure([&vVerts, &vLinearVerts, &vLinearIndices]()
+		{
+			vLinearVerts.clear();
+			vLinearIndices.clear();
+			for (const auto& test : vVerts)
+			{
+				const auto similar = std::find(vLinearVerts.begin(), vLinearVerts.end(), test);
+				if (similar == vLinearVerts.end())
+				{
+					vLinearIndices.push_back(Utils::Cast32(vLinearVerts.size()));
+					vLinearVerts.push_back(test);
+				}
+				else
+				{
+					vLinearIndices.push_back(Utils::Cast32(std::distance(vLinearVerts.begin(), similar)));
+				}
+			}
+		});
+
+	Vector<UberVertex> vGridVerts;
+	Vector<int> vGridIndices;
+	const float gridTime = Measure([&vVerts, &vGridVerts, &vGridIndices, vertCount]()
+		{
+			WeldGrid weldGrid;
+			weldGrid.Reserve(vertCount);
+			vGridVerts.clear();
+			vGridIndices.clear();
+			for (const auto& test : vVerts)
+			{
+				const int index = weldGrid.Find(vGridVerts, test);
+				if (index < 0)
+				{
+					vGridIndices.push_back(Utils::Cast32(vGridVerts.size()));
+					weldGrid.PushBack(test);
+					vGridVerts.push_back(test);
+				}
+				else
+				{
+					vGridIndices.push_back(index);
+				}
+			}
+		});
+
+	std::wcout << _T("Linear search: ") << linearTime << _T(" ms, ") << vLinearVerts.size() << _T(" vertices left") << std::endl;
+	std::wcout << _T("WeldGrid:      ") << gridTime << _T(" ms, ") << vGridVerts.size() << _T(" vertices left") << std::endl;
+	Check(vLinearIndices == vGridIndices, "Welded indices");
+}
+
+void BenchmarkTool::BenchmarkMeshOptimizer()
+{
+	typedef Extra::BaseConvert::Mesh::UberVertex UberVertex;
+	typedef Extra::BaseConvert::Mesh::WeldGrid WeldGrid;
+
+	Vector<UberVertex> vVerts;
+	GenerateImportedMesh(vVerts);
+
+	// Welded mesh with faces in random order:
+	WeldGrid weldGrid;
+	Vector<glm::vec3> vPositions;
+	Vector<UberVertex> vWeldedVerts;
+	Vector<UINT32> vIndices;
+	for (const auto& test : vVerts)
+	{
+		const int index = weldGrid.Find(vWeldedVerts, test);
+		if (index < 0)
+		{
+			vIndices.push_back(Utils::Cast32(vWeldedVerts.size()));
+			weldGrid.PushBack(test);
+			vWeldedVerts.push_back(test);
+			vPositions.push_back(test._pos);
+		}
+		else
+		{
+			vIndices.push_back(index);
+		}
+	}
+	const int vertCount = Utils::Cast32(vPositions.size());
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	std::wcout << std::endl << _T("Mesh optimizer, ") << faceCount << _T(" faces:") << std::endl;
+
+	Vector<UINT32> vCacheIndices, vOverdrawIndices, vFetchIndices;
+	Vector<int> vRemap;
+	const float cacheTime = Measure([&vIndices, &vCacheIndices, vertCount]()
+		{
+			vCacheIndices = vIndices;
+			Math::MeshOptimizer::OptimizeVertexCache(vCacheIndices, vertCount);
+		});
+	const float overdrawTime = Measure([&vCacheIndices, &vOverdrawIndices, &vPositions]()
+		{
+			vOverdrawIndices = vCacheIndices;
+			Math::MeshOptimizer::OptimizeOverdraw(vOverdrawIndices, vPositions);
+		});
+	const float fetchTime = Measure([&vOverdrawIndices, &vFetchIndices, &vRemap, vertCount]()
+		{
+			vFetchIndices = vOverdrawIndices;
+			Math::MeshOptimizer::OptimizeVertexFetch(vFetchIndices, vertCount, vRemap);
+		});
+
+	std::wcout << _T("OptimizeVertexCache: ") << cacheTime << _T(" ms") << std::endl;
+	std::wcout << _T("OptimizeOverdraw:    ") << overdrawTime << _T(" ms") << std::endl;
+	std::wcout << _T("OptimizeVertexFetch: ") << fetchTime << _T(" ms") << std::endl;
+	std::wcout << _T("ACMR: ") << Math::MeshOptimizer::ComputeACMR(vIndices, vertCount) << _T(" -> ") << Math::MeshOptimizer::ComputeACMR(vFetchIndices, vertCount) << std::endl;
+
+	// Same triangles with the same winding, in any order:
+	auto GetSortedFaces = [](const Vector<UINT32>& vFaceIndices, const Vector<int>& vVertRemap)
+	{
+		Vector<int> vOriginal(vVertRemap.size());
+		VERUS_FOR(i, vVertRemap.size())
+			vOriginal[vVertRemap[i]] = i;
+		Vector<std::array<int, 3>> vFaces(vFaceIndices.size() / 3);
+		VERUS_FOR(i, vFaces.size())
+		{
+			const int a = vOriginal[vFaceIndices[i * 3 + 0]];
+			const int b = vOriginal[vFaceIndices[i * 3 + 1]];
+			const int c = vOriginal[vFaceIndices[i * 3 + 2]];
+			if (a < b && a < c)
+				vFaces[i] = { a, b, c };
+			else if (b < c)
+				vFaces[i] = { b, c, a };
+			else
+				vFaces[i] = { c, a, b };
+		}
+		std::sort(vFaces.begin(), vFaces.end());
+		return vFaces;
+	};
+	Vector<int> vIdentity(vertCount);
+	std::iota(vIdentity.begin(), vIdentity.end(), 0);
+	Check(GetSortedFaces(vIndices, vIdentity) == GetSortedFaces(vFetchIndices, vRemap), "Optimized faces");
+}
+
+void BenchmarkTool::BenchmarkLODs()
+{
+	const int side = 128;
+	const float spacing = 0.1f;
+	const int maxLODCount = 3;
+
+	// Hills:
+	Vector<glm::vec3> vPositions;
+	Vector<UINT32> vIndices;
+	VERUS_FOR(z, side)
+	{
+		VERUS_FOR(x, side)
+			vPositions.push_back(glm::vec3(x * spacing, sin(x * 0.1f) * cos(z * 0.07f) * 1.5f, z * spacing));
+	}
+	VERUS_FOR(z, side - 1)
+	{
+		VERUS_FOR(x, side - 1)
+		{
+			const UINT32 i = z * side + x;
+			vIndices.insert(vIndices.end(), { i, i + side, i + 1, i + 1, i + side, i + side + 1 });
+		}
+	}
+	const int vertCount = Utils::Cast32(vPositions.size());
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	std::wcout << std::endl << _T("Levels of detail, ") << faceCount << _T(" faces:") << std::endl;
+
+	// Same steps as BaseConvert::Mesh::GenerateLODs():
+	struct LOD
+	{
+		int   _faceCount = 0;
+		float _error = 0;
+	};
+	Vector<LOD> vLODs;
+	const float simplifyTime = Measure([&vIndices, &vPositions, &vLODs, vertCount, faceCount, maxLODCount]()
+		{
+			vLODs.clear();
+			Vector<UINT32> vLODIndices = vIndices;
+			float error = 0;
+			VERUS_FOR(lod, maxLODCount)
+			{
+				const int prevFaceCount = Utils::Cast32(vLODIndices.size() / 3);
+				const int targetFaceCount = faceCount >> (lod + 1);
+				error = Math::Max(error, Math::MeshOptimizer::Simplify(vLODIndices, vPositions, targetFaceCount * 3));
+				const int lodFaceCount = Utils::Cast32(vLODIndices.size() / 3);
+				if (lodFaceCount > prevFaceCount * 3 / 4)
+					break;
+				Math::MeshOptimizer::OptimizeVertexCache(vLODIndices, vertCount);
+				LOD lodData;
+				lodData._faceCount = lodFaceCount;
+				lodData._error = error;
+				vLODs.push_back(lodData);
+			}
+		});
+
+	std::wcout << _T("Generate ") << vLODs.size() << _T(" levels: ") << simplifyTime << _T(" ms") << std::endl;
+	std::wcout << _T("Faces (error): ") << faceCount;
+	for (const auto& lod : vLODs)
+		std::wcout << _T(" -> ") << lod._faceCount << _T(" (") << lod._error << _T(")");
+	std::wcout << std::endl;
+
+	BenchmarkMesh mesh;
+	mesh.SetIndexCount(faceCount * 3);
+	for (const auto& lod : vLODs)
+		mesh.AddLOD(lod._faceCount, lod._error);
+
+	// Size in pixels is computed like WorldManager::SelectLODs() does, 1080p, 70 degrees, 1 pixel error:
+	const int blockCount = 10000;
+	const float screenScale = 1080 / (2 * tan(glm::radians(70.f) * 0.5f));
+	const float maxSide = (side - 1) * spacing;
+	const float maxPixelError = 1;
+	Random random(1);
+	Vector<float> vDistances(blockCount);
+	for (auto& dist : vDistances)
+		dist = random.NextFloat(5, 500);
+	INT64 drawnFaceCount = 0;
+	const float selectTime = Measure([&vDistances, &mesh, &drawnFaceCount, screenScale, maxSide, maxPixelError]()
+		{
+			drawnFaceCount = 0;
+			for (float dist : vDistances)
+			{
+				const int lod = mesh.SelectLOD(maxSide * screenScale / dist, maxPixelError);
+				drawnFaceCount += mesh.GetLODIndexCount(lod) / 3;
+			}
+		});
+	const INT64 fullFaceCount = static_cast<INT64>(faceCount) * blockCount;
+	std::wcout << _T("Select for ") << blockCount << _T(" blocks at 5 to 500 m: ") << selectTime << _T(" ms, faces drawn ");
+	std::wcout << drawnFaceCount << _T(" of ") << fullFaceCount << _T(" (") << 100.0 * drawnFaceCount / fullFaceCount << _T("%)") << std::endl;
+
+	bool valid = !vLODs.empty();
+	VERUS_FOR(i, vLODs.size())
+	{
+		const int prevFaceCount = i ? vLODs[i - 1]._faceCount : faceCount;
+		const float prevError = i ? vLODs[i - 1]._error : 0;
+		if (vLODs[i]._faceCount >= prevFaceCount || vLODs[i]._error < prevError)
+			valid = false;
+	}
+	Check(valid, "Level of detail chain");
+}
+
+void BenchmarkTool::BenchmarkClusters()
+{
+	const int ringCount = 128;
+	const int segmentCount = 128;
+	const int viewCount = 100;
+
+	// Sphere with the radius of 1, poles are the first and the last vertex:
+	Vector<glm::vec3> vPositions;
+	Vector<UINT32> vIndices;
+	vPositions.push_back(glm::vec3(0, 1, 0));
+	for (int ring = 1; ring < ringCount; ++ring)
+	{
+		const float theta = VERUS_PI * ring / ringCount;
+		VERUS_FOR(segment, segmentCount)
+		{
+			const float phi = VERUS_2PI * segment / segmentCount;
+			vPositions.push_back(glm::vec3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi)));
+		}
+	}
+	vPositions.push_back(glm::vec3(0, -1, 0));
+	const UINT32 lastVert = Utils::Cast32(vPositions.size()) - 1;
+	auto GetVert = [segmentCount](int ring, int segment)
+	{
+		return static_cast<UINT32>(1 + (ring - 1) * segmentCount + segment % segmentCount);
+	};
+	VERUS_FOR(segment, segmentCount)
+	{
+		vIndices.insert(vIndices.end(), { 0, GetVert(1, segment + 1), GetVert(1, segment) });
+		for (int ring = 1; ring < ringCount - 1; ++ring)
+		{
+			const UINT32 a = GetVert(ring, segment);
+			const UINT32 b = GetVert(ring, segment + 1);
+			const UINT32 c = GetVert(ring + 1, segment);
+			const UINT32 d = GetVert(ring + 1, segment + 1);
+			vIndices.insert(vIndices.end(), { a, b, c, b, d, c });
+		}
+		vIndices.insert(vIndices.end(), { GetVert(ringCount - 1, segment), GetVert(ringCount - 1, segment + 1), lastVert });
+	}
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	std::wcout << std::endl << _T("Clusters, ") << faceCount << _T(" faces:") << std::endl;
+
+	Vector<UINT32> vClusterIndices;
+	Vector<Math::MeshOptimizer::Cluster> vClusters;
+	const float buildTime = Measure([&vIndices, &vPositions, &vClusterIndices, &vClusters]()
+		{
+			vClusterIndices = vIndices;
+			Math::MeshOptimizer::BuildClusters(vClusterIndices, vPositions, vClusters);
+		});
+	const int coneCount = Utils::Cast32(std::count_if(vClusters.begin(), vClusters.end(), [](const Math::MeshOptimizer::Cluster& x)
+		{
+			return x._coneCutoff < 1;
+		}));
+
+	BenchmarkMesh mesh;
+	mesh.SetIndexCount(Utils::Cast32(vClusterIndices.size()));
+	for (const auto& cluster : vClusters)
+		mesh.AddCluster(cluster);
+
+	// Only backface culling, eyes are around the sphere:
+	Random random(1);
+	Vector<Point3> vEyes(viewCount);
+	for (auto& eye : vEyes)
+	{
+		const glm::vec3 dir(random.NextFloat(-1, 1), random.NextFloat(-1, 1), random.NextFloat(-1, 1));
+		eye = glm::normalize(dir + glm::vec3(0, 0, 0.001f)) * 3.f;
+	}
+	const Math::Frustum frustum;
+	Vector<Vector<World::BaseMesh::IndexRange>> vViewRanges(viewCount);
+	const float cullTime = Measure([&mesh, &vEyes, &vViewRanges, &frustum]()
+		{
+			VERUS_FOR(view, vEyes.size())
+				mesh.CullClusters(Transform3::identity(), frustum, &vEyes[view], vViewRanges[view], false);
+		});
+
+	// Ranges are made of adjacent visible clusters, the rest are culled:
+	INT64 culledFaceCount = 0;
+	Vector<BYTE> vCulled(vClusters.size() * viewCount);
+	VERUS_FOR(view, vEyes.size())
+	{
+		auto itRange = vViewRanges[view].begin();
+		VERUS_FOR(i, vClusters.size())
+		{
+			const auto& cluster = vClusters[i];
+			while (itRange != vViewRanges[view].end() && itRange->_firstIndex + itRange->_indexCount <= cluster._firstIndex)
+				itRange++;
+			const bool culled = itRange == vViewRanges[view].end() || itRange->_firstIndex > cluster._firstIndex;
+			vCulled[view * vClusters.size() + i] = culled;
+			if (culled)
+				culledFaceCount += cluster._indexCount / 3;
+		}
+	}
+
+	std::wcout << _T("BuildClusters: ") << buildTime << _T(" ms, ") << vClusters.size() << _T(" clusters, ") << coneCount << _T(" with normal cone") << std::endl;
+	std::wcout << _T("Cone test from ") << viewCount << _T(" views: ") << cullTime << _T(" ms, faces culled ");
+	std::wcout << 100.0 * culledFaceCount / (static_cast<INT64>(faceCount) * viewCount) << _T("%") << std::endl;
+
+	// Clusters must cover all faces, culled faces must face away from the eye:
+	bool valid = true;
+	int nextIndex = 0;
+	for (const auto& cluster : vClusters)
+	{
+		if (cluster._firstIndex != nextIndex)
+			valid = false;
+		nextIndex = cluster._firstIndex + cluster._indexCount;
+	}
+	if (nextIndex != Utils::Cast32(vClusterIndices.size()))
+		valid = false;
+	VERUS_FOR(view, vEyes.size())
+	{
+		VERUS_FOR(i, vClusters.size())
+		{
+			if (!vCulled[view * vClusters.size() + i])
+				continue;
+			const auto& cluster = vClusters[i];
+			for (int j = cluster._firstIndex; j < cluster._firstIndex + cluster._indexCount; j += 3)
+			{
+				const glm::vec3& a = vPositions[vClusterIndices[j + 0]];
+				const glm::vec3& b = vPositions[vClusterIndices[j + 1]];
+				const glm::vec3& c = vPositions[vClusterIndices[j + 2]];
+				if (glm::dot(glm::cross(b - a, c - a), a - vEyes[view].GLM()) < 0)
+					valid = false;
+			}
+		}
+	}
+	Check(valid, "Culled clusters");
+}
+
+void BenchmarkTool::BenchmarkPhysics()
+{
+	const int side = 25;
+	const int layerCount = 8;
+	const int bodyCount = side * side * layerCount;
+	const int stepCount = 300;
+	std::wcout << std::endl << _T("Physics, ") << bodyCount << _T(" bodies, ") << stepCount << _T(" steps:") << std::endl;
+#ifndef BT_THREADSAFE
+	std::wcout << _T("WARNING: Bullet is built without BT_THREADSAFE, multithreaded world runs on one thread") << std::endl;
+#endif
+
+	TaskScheduler::Make();
+	TaskScheduler::I().Init();
+	Physics::BulletTaskScheduler taskScheduler;
+	taskScheduler.setNumThreads(taskScheduler.getMaxNumThreads());
+
+	// Same setup as Physics::Bullet::Init(), returns milliseconds per step:
+	auto Run = [side, layerCount, stepCount, &taskScheduler](bool multithreaded, int& restingCount)
+	{
+		std::unique_ptr<btDefaultCollisionConfiguration> pCollisionConfiguration;
+		std::unique_ptr<btCollisionDispatcher> pDispatcher;
+		std::unique_ptr<btBroadphaseInterface> pBroadphase;
+		std::unique_ptr<btConstraintSolverPoolMt> pConstraintSolverPool;
+		std::unique_ptr<btConstraintSolver> pConstraintSolver;
+		std::unique_ptr<btDiscreteDynamicsWorld> pWorld;
+		if (multithreaded)
+		{
+			btSetTaskScheduler(&taskScheduler);
+			btDefaultCollisionConstructionInfo cci;
+			cci.m_defaultMaxPersistentManifoldPoolSize = Physics::Bullet::s_mtPoolSize;
+			cci.m_defaultMaxCollisionAlgorithmPoolSize = Physics::Bullet::s_mtPoolSize;
+			pCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>(cci);
+			pDispatcher = std::make_unique<btCollisionDispatcherMt>(pCollisionConfiguration.get());
+			pBroadphase = std::make_unique<btDbvtBroadphase>();
+			pConstraintSolverPool = std::make_unique<btConstraintSolverPoolMt>(taskScheduler.getNumThreads());
+			pConstraintSolver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+			pWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+				pDispatcher.get(),
+				pBroadphase.get(),
+				pConstraintSolverPool.get(),
+				pConstraintSolver.get(),
+				pCollisionConfiguration.get());
+		}
+		else
+		{
+			pCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
+			pDispatcher = std::make_unique<btCollisionDispatcher>(pCollisionConfiguration.get());
+			pBroadphase = std::make_unique<btAxisSweep3>(btVector3(-2048, -1024, -2048), btVector3(+2048, +1024, +2048));
+			pConstraintSolver = std::make_unique<btSequentialImpulseConstraintSolver>();
+			pWorld = std::make_unique<btDiscreteDynamicsWorld>(
+				pDispatcher.get(),
+				pBroadphase.get(),
+				pConstraintSolver.get(),
+				pCollisionConfiguration.get());
+		}
+
+		btStaticPlaneShape groundShape(btVector3(0, 1, 0), 0);
+		btRigidBody ground(0, nullptr, &groundShape);
+		pWorld->addRigidBody(&ground);
+
+		// Layers of boxes, slightly shifted, so that they fall over:
+		btBoxShape boxShape(btVector3(0.5f, 0.5f, 0.5f));
+		btVector3 localInertia;
+		boxShape.calculateLocalInertia(1, localInertia);
+		Random random(1);
+		Vector<std::unique_ptr<btDefaultMotionState>> vMotionStates;
+		Vector<std::unique_ptr<btRigidBody>> vBodies;
+		VERUS_FOR(layer, layerCount)
+		{
+			VERUS_FOR(z, side)
+			{
+				VERUS_FOR(x, side)
+				{
+					const btVector3 pos(
+						(x - side / 2) * 1.1f + random.NextFloat(-0.2f, 0.2f),
+						0.6f + layer * 1.1f,
+						(z - side / 2) * 1.1f + random.NextFloat(-0.2f, 0.2f));
+					vMotionStates.push_back(std::make_unique<btDefaultMotionState>(btTransform(btQuaternion::getIdentity(), pos)));
+					btRigidBody::btRigidBodyConstructionInfo rbci(1, vMotionStates.back().get(), &boxShape, localInertia);
+					vBodies.push_back(std::make_unique<btRigidBody>(rbci));
+					pWorld->addRigidBody(vBodies.back().get());
+				}
+			}
+		}
+
+		const auto t0 = std::chrono::steady_clock::now();
+		VERUS_FOR(i, stepCount)
+			pWorld->stepSimulation(1 / 60.f, 1, 1 / 60.f);
+		const auto t1 = std::chrono::steady_clock::now();
+
+		restingCount = 0;
+		for (auto& pBody : vBodies)
+		{
+			if (pBody->getWorldTransform().getOrigin().getY() > 0)
+				restingCount++;
+			pWorld->removeRigidBody(pBody.get());
+		}
+		pWorld->removeRigidBody(&ground);
+		pWorld.reset();
+		if (multithreaded)
+			btSetTaskScheduler(nullptr);
+		return TMilliseconds(t1 - t0).count() / stepCount;
+	};
+
+	int singleRestingCount = 0;
+	int multiRestingCount = 0;
+	const float singleTime = Run(false, singleRestingCount);
+	const float multiTime = Run(true, multiRestingCount);
+
+	std::wcout << _T("Single-threaded world:            ") << singleTime << _T(" ms per step") << std::endl;
+	std::wcout << _T("Multithreaded world, ") << taskScheduler.getNumThreads() << _T(" threads: ") << multiTime << _T(" ms per step") << std::endl;
+	std::wcout << _T("Speedup:                          ") << singleTime / multiTime << _T("x") << std::endl;
+
+	TaskScheduler::Free();
+
+	Check(singleRestingCount == bodyCount && multiRestingCount == bodyCount, "Bodies above ground");
+}
+
+void BenchmarkTool::BenchmarkLabels()
+{
+	const int labelCount = 2000;
+	std::wcout << std::endl << _T("Labels, ") << labelCount << _T(" labels:") << std::endl;
+
+	const String xml = GenerateFontXml();
+
+	// Menu items, text is wrapped within the label's box:
+	CSZ words[] = { "New", "Game", "Load", "Save", "Options", "Video", "Audio", "Controls", "Quality", "Volume", "Back", "Apply" };
+	Random random(1);
+	Vector<WideString> vTexts(labelCount);
+	Vector<GUI::Font::DrawDesc> vDrawDescs(labelCount);
+	VERUS_FOR(i, labelCount)
+	{
+		String text = std::to_string(i) + ".";
+		const int wordCount = random.Next(2, 8);
+		VERUS_FOR(j, wordCount)
+		{
+			text += " ";
+			text += words[random.Next() % VERUS_COUNT_OF(words)];
+		}
+		vTexts[i] = Str::Utf8ToWide(text);
+
+		// Same fields as Label::Draw() sets:
+		GUI::Font::RDrawDesc dd = vDrawDescs[i];
+		dd._text = _C(vTexts[i]);
+		dd._x = (i % 8) * 0.125f;
+		dd._y = (i / 8 % 40) * 0.025f;
+		dd._w = 0.12f;
+		dd._h = 0.1f;
+		dd._scale = (i & 0x1) ? 0.5f : 0.75f;
+		dd._center = !(i % 3);
+	}
+
+	// Quads are collected like Font::Draw() adds them to the dynamic buffer:
+	Vector<GUI::Font::Vertex> vVerts;
+	auto DrawLabels = [&vDrawDescs, &vVerts](GUI::RFont font)
+	{
+		font.ResetDynamicBuffer(); // Next frame.
+		vVerts.clear();
+		for (const auto& dd : vDrawDescs)
+		{
+			font.ForEachQuad(dd, dd._scale, [&vVerts](const GUI::Font::Vertex& a0, const GUI::Font::Vertex& a1, const GUI::Font::Vertex& b0, const GUI::Font::Vertex& b1)
+				{
+					vVerts.insert(vVerts.end(), { a0, a1, b0, b1 });
+				});
+		}
+	};
+
+	// Cold frame lays out every label, each run needs a new font:
+	float coldTime = FLT_MAX;
+	GUI::Font::Stats coldStats;
+	VERUS_FOR(i, _repeatCount)
+	{
+		GUI::Font font;
+		font.InitMetrics(_C(xml));
+		const auto t0 = std::chrono::steady_clock::now();
+		DrawLabels(font);
+		const auto t1 = std::chrono::steady_clock::now();
+		coldTime = Math::Min(coldTime, TMilliseconds(t1 - t0).count());
+		coldStats = font.GetStats();
+	}
+	const Vector<GUI::Font::Vertex> vColdVerts = vVerts;
+
+	GUI::Font font;
+	font.InitMetrics(_C(xml));
+	DrawLabels(font); // Fill the cache.
+	const float warmTime = Measure([&DrawLabels, &font]()
+		{
+			DrawLabels(font);
+		});
+	const GUI::Font::Stats warmStats = font.GetStats();
+
+	std::wcout << _T("Cold frame: ") << coldTime << _T(" ms, ") << coldStats._layoutMissCount << _T(" layouts") << std::endl;
+	std::wcout << _T("Warm frame: ") << warmTime << _T(" ms, ") << warmStats._layoutHitCount << _T(" cached layouts, ") << vVerts.size() / 4 << _T(" glyphs") << std::endl;
+	Check(coldStats._layoutMissCount == labelCount && warmStats._layoutHitCount == labelCount && !warmStats._layoutMissCount, "Layout cache");
+	Check(vVerts.size() == vColdVerts.size() && !memcmp(vVerts.data(), vColdVerts.data(), vVerts.size() * sizeof(GUI::Font::Vertex)), "Cached glyphs");
+}
+
+String BenchmarkTool::GenerateFontXml()
+{
+	// Printable ASCII chars in a 512x512 texture and a few kerning pairs, like AngelCode's Bitmap Font Generator writes them:
+	StringStream ss;
+	ss << "<font><common lineHeight=\"32\" scaleW=\"512\" scaleH=\"512\"/><chars>";
+	for (int c = 32; c < 127; ++c)
+	{
+		const int index = c - 32;
+		ss << "<char id=\"" << c << "\" x=\"" << (index % 16) * 32 << "\" y=\"" << (index / 16) * 32;
+		ss << "\" width=\"" << 14 + c % 7 << "\" height=\"26\" xoffset=\"1\" yoffset=\"3\" xadvance=\"" << 15 + c % 7 << "\"/>";
+	}
+	ss << "</chars><kernings>";
+	const char pairs[][3] = { "AV", "Av", "LT", "To", "Ta", "Vo", "Wa", "Ye" };
+	for (const auto& pair : pairs)
+		ss << "<kerning first=\"" << static_cast<int>(pair[0]) << "\" second=\"" << static_cast<int>(pair[1]) << "\" amount=\"-2\"/>";
+	ss << "</kernings></font>";
+	return ss.str();
+}
+
+void BenchmarkTool::GenerateImportedMesh(Vector<Extra::BaseConvert::Mesh::UberVertex>& vVerts)
+{
+	typedef Extra::BaseConvert::Mesh::UberVertex UberVertex;
+
+	const int side = 128; // Faces have 16-bit indices.
+
+	// Each face has its own vertices, like after import. Faces are not in any particular order.
+	// Positions are jittered, so that similar vertices are often in different grid cells:
+	Vector<int> vQuads((side - 1) * (side - 1));
+	std::iota(vQuads.begin(), vQuads.end(), 0);
+	std::shuffle(vQuads.begin(), vQuads.end(), std::mt19937(1));
+	Random random(1);
+	auto AddVertex = [&vVerts, &random, side](int x, int z)
+	{
+		const float jitter = UberVertex::s_weldEpsilon * 0.4f;
+		UberVertex vertex;
+		vertex._pos = glm::vec3(
+			x * 0.1f + random.NextFloat(-jitter, jitter),
+			0,
+			z * 0.1f + random.NextFloat(-jitter, jitter));
+		vertex._nrm = glm::vec3(0, 1, 0);
+		vertex._tc0 = glm::vec2(static_cast<float>(x) / side, static_cast<float>(z) / side);
+		vertex._tc1 = vertex._tc0;
+		vVerts.push_back(vertex);
+	};
+	vVerts.clear();
+	vVerts.reserve(vQuads.size() * 6);
+	for (int quad : vQuads)
+	{
+		const int x = quad % (side - 1);
+		const int z = quad / (side - 1);
+		AddVertex(x, z);
+		AddVertex(x, z + 1);
+		AddVertex(x + 1, z);
+		AddVertex(x + 1, z);
+		AddVertex(x, z + 1);
+		AddVertex(x + 1, z + 1);
+	}
+}
+
+void BenchmarkTool::Check(bool ok, CSZ what)
+{
+	if (ok)
+	{
+		std::wcout << Str::Utf8ToWide(what) << _T(": OK") << std::endl;
+	}
+	else
+	{
+		std::wcerr << _T("ERROR: ") << Str::Utf8ToWide(what) << _T(": results are different") << std::endl;
+		throw std::exception();
+	}
+}
+
+int main(VERUS_MAIN_DEFAULT_ARGS)
+{
+	AlignedAllocator alloc;
+	Utils::MakeEx(&alloc); // For paths.
+	Make_D(); // For log.
+	int ret = EXIT_SUCCESS;
+	try
+	{
+		BenchmarkTool benchmarkTool;
+		ret = benchmarkTool.Main(argc, argv);
+	}
+	catch (const std::exception& e)
+	{
+		std::wcerr << _T("EXCEPTION: ") << e.what() << std::endl;
+		ret = EXIT_FAILURE;
+	}
+	Free_D();
+	Utils::FreeEx(&alloc);
+	return ret;
+}
@@ -0,0 +1,249 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include <verus.h>
+
+using namespace verus;
+
+class ModelTool : public Extra::BaseConvertDelegate
+{
+	Vector<String> _vPathnames;
+	float          _scaleFactor = 1;
+	float          _angle = 0;
+	float          _areaBasedNormals = 0;
+	int            _lodCount = 3;
+	bool           _useRigidBones = false;
+	bool           _convertAsScene = false;
+	bool           _overwrite = false;
+	bool           _recursive = false;
+	int            _convertedCount = 0;
+	int            _failedCount = 0;
+
+public:
+	ModelTool();
+	~ModelTool();
+
+	virtual void BaseConvert_OnProgress(float percent) override;
+	virtual void BaseConvert_OnProgressText(CSZ txt) override;
+	virtual void BaseConvert_Optimize(
+		Vector<Extra::BaseConvert::Mesh::UberVertex>& vVB,
+		Vector<Extra::BaseConvert::Mesh::Face>& vIB) override;
+	virtual bool BaseConvert_CanOverwriteFile(CSZ filename) override;
+
+	int Main(VERUS_MAIN_DEFAULT_ARGS);
+	void ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS);
+	void PrintUsage();
+	void AddInput(CSZ path);
+	void ConvertFile(CSZ pathname);
+
+	static bool IsSupportedFile(CSZ pathname);
+};
+
+ModelTool::ModelTool()
+{
+}
+
+ModelTool::~ModelTool()
+{
+}
+
+void ModelTool::BaseConvert_OnProgress(float percent)
+{
+	wprintf(_T("\rProgress: %3d%%"), static_cast<int>(percent + 0.5f));
+	if (percent >= 100)
+		wprintf(_T("\n"));
+	fflush(stdout);
+}
+
+void ModelTool::BaseConvert_OnProgressText(CSZ txt)
+{
+	std::wcout << _T("\r") << Str::Utf8ToWide(txt) << std::endl;
+}
+
+void ModelTool::BaseConvert_Optimize(
+	Vector<Extra::BaseConvert::Mesh::UberVertex>& vVB,
+	Vector<Extra::BaseConvert::Mesh::Face>& vIB)
+{
+	// Built-in optimizer is used.
+}
+
+bool ModelTool::BaseConvert_CanOverwriteFile(CSZ filename)
+{
+	return _overwrite || !IO::FileSystem::FileExist(filename);
+}
+
+int ModelTool::Main(VERUS_MAIN_DEFAULT_ARGS)
+{
+	if (argc <= 1)
+	{
+		PrintUsage();
+		return EXIT_SUCCESS;
+	}
+	ParseCommandLine(argc, argv);
+
+	std::wcout << _T("Files to convert: ") << _vPathnames.size() << std::endl;
+	const auto t0 = std::chrono::steady_clock::now();
+	for (const auto& pathname : _vPathnames)
+		ConvertFile(_C(pathname));
+	const auto t1 = std::chrono::steady_clock::now();
+	const auto d = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+
+	std::wcout << std::endl;
+	std::wcout << _T("Converted: ") << _convertedCount << _T(", failed: ") << _failedCount;
+	std::wcout << _T(", time: ") << d.count() << _T(" ms") << std::endl;
+	return _failedCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+void ModelTool::ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--scale") && i + 1 < argc)
+			_scaleFactor = static_cast<float>(atof(argv[++i]));
+		else if (!strcmp(argv[i], "--angle") && i + 1 < argc)
+			_angle = glm::radians(static_cast<float>(atof(argv[++i])));
+		else if (!strcmp(argv[i], "--lods") && i + 1 < argc)
+			_lodCount = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--area-based-normals"))
+			_areaBasedNormals = 1;
+		else if (!strcmp(argv[i], "--rigid-bones"))
+			_useRigidBones = true;
+		else if (!strcmp(argv[i], "--scene"))
+			_convertAsScene = true;
+		else if (!strcmp(argv[i], "--overwrite") || !strcmp(argv[i], "-y"))
+			_overwrite = true;
+		else if (!strcmp(argv[i], "--recursive") || !strcmp(argv[i], "-r"))
+			_recursive = true;
+		else if (!strncmp(argv[i], "--", 2))
+			std::wcout << _T("WARNING: Unknown argument ") << Str::Utf8ToWide(argv[i]) << std::endl;
+		else
+			AddInput(argv[i]);
+	}
+}
+
+void ModelTool::PrintUsage()
+{
+	std::wcout << _T("Usage: ModelTool [options] <file or folder> ...") << std::endl;
+	std::wcout << std::endl;
+	std::wcout << _T("Converts glTF (.gltf, .glb) and DirectX (.x) files to X3D meshes and XAN motions.") << std::endl;
+	std::wcout << _T("Meshes and motions of each file are converted in parallel.") << std::endl;
+	std::wcout << std::endl;
+	std::wcout << _T("Options:") << std::endl;
+	std::wcout << _T("  --scale <factor>     Scale factor (default is 1).") << std::endl;
+	std::wcout << _T("  --angle <degrees>    Rotation around Y axis.") << std::endl;
+	std::wcout << _T("  --lods <count>       Extra levels of detail, 0 to disable (default is 3).") << std::endl;
+	std::wcout << _T("  --area-based-normals Weight normals by face area.") << std::endl;
+	std::wcout << _T("  --rigid-bones        Use one bone per vertex.") << std::endl;
+	std::wcout << _T("  --scene              Convert as scene.") << std::endl;
+	std::wcout << _T("  --overwrite, -y      Overwrite existing files.") << std::endl;
+	std::wcout << _T("  --recursive, -r      Include subfolders.") << std::endl;
+}
+
+void ModelTool::AddInput(CSZ path)
+{
+	const std::filesystem::path fsPath(Str::Utf8ToWide(path));
+	if (std::filesystem::is_directory(fsPath))
+	{
+		auto AddEntry = [this](const std::filesystem::directory_entry& entry)
+		{
+			if (!entry.is_regular_file())
+				return;
+			const String pathname = Str::WideToUtf8(entry.path().wstring());
+			if (IsSupportedFile(_C(pathname)))
+				_vPathnames.push_back(pathname);
+		};
+		if (_recursive)
+		{
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(fsPath))
+				AddEntry(entry);
+		}
+		else
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(fsPath))
+				AddEntry(entry);
+		}
+	}
+	else if (std::filesystem::exists(fsPath) && IsSupportedFile(path))
+	{
+		_vPathnames.push_back(Str::WideToUtf8(std::filesystem::absolute(fsPath).wstring()));
+	}
+	else
+	{
+		std::wcerr << _T("ERROR: Unsupported file: ") << Str::Utf8ToWide(path) << std::endl;
+		_failedCount++;
+	}
+}
+
+void ModelTool::ConvertFile(CSZ pathname)
+{
+	std::wcout << std::endl;
+	std::wcout << _T("Converting: ") << Str::Utf8ToWide(pathname) << std::endl;
+	try
+	{
+		if (Str::EndsWith(pathname, ".x", false))
+		{
+			Extra::ConvertX::Desc desc;
+			desc._scaleFactor = _scaleFactor;
+			desc._angle = _angle;
+			desc._areaBasedNormals = _areaBasedNormals;
+			desc._lodCount = _lodCount;
+			desc._useRigidBones = _useRigidBones;
+			desc._convertAsScene = _convertAsScene;
+			Extra::RConvertX convert = Extra::ConvertX::I();
+			convert.Init(this, desc);
+			convert.ParseData(pathname);
+			convert.SerializeAll(pathname);
+		}
+		else
+		{
+			Extra::ConvertGLTF::Desc desc;
+			desc._scaleFactor = _scaleFactor;
+			desc._angle = _angle;
+			desc._areaBasedNormals = _areaBasedNormals;
+			desc._lodCount = _lodCount;
+			desc._useRigidBones = _useRigidBones;
+			desc._convertAsScene = _convertAsScene;
+			Extra::RConvertGLTF convert = Extra::ConvertGLTF::I();
+			convert.Init(this, desc);
+			convert.ParseData(pathname);
+			convert.SerializeAll(pathname);
+		}
+		_convertedCount++;
+	}
+	catch (D::RcRecoverable e)
+	{
+		std::wcerr << std::endl << _T("ERROR: ") << Str::Utf8ToWide(e.what()) << std::endl;
+		_failedCount++;
+	}
+	Extra::ConvertX::I().Done();
+	Extra::ConvertGLTF::I().Done();
+}
+
+bool ModelTool::IsSupportedFile(CSZ pathname)
+{
+	return
+		Str::EndsWith(pathname, ".gltf", false) ||
+		Str::EndsWith(pathname, ".glb", false) ||
+		Str::EndsWith(pathname, ".x", false);
+}
+
+int main(VERUS_MAIN_DEFAULT_ARGS)
+{
+	AlignedAllocator alloc;
+	Utils::MakeEx(&alloc); // For random and paths.
+	Make_D(); // For log.
+	Make_Extra();
+	int ret = EXIT_SUCCESS;
+	try
+	{
+		ModelTool modelTool;
+		ret = modelTool.Main(argc, argv);
+	}
+	catch (const std::exception& e)
+	{
+		std::wcerr << _T("EXCEPTION: ") << e.what() << std::endl;
+		ret = EXIT_FAILURE;
+	}
+	Free_Extra();
+	Free_D();
+	Utils::FreeEx(&alloc);
+	return ret;
+}
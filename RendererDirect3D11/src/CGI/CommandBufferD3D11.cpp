@@ -40,6 +40,11 @@ void CommandBufferD3D11::DoneOneTimeSubmit()
 	Done();
 }
 
+void CommandBufferD3D11::InitSecondary()
+{
+	throw VERUS_RUNTIME_ERROR << "InitSecondary(); Parallel recording is not supported";
+}
+
 void CommandBufferD3D11::Begin()
 {
 }
@@ -48,11 +53,21 @@ void CommandBufferD3D11::End()
 {
 }
 
+void CommandBufferD3D11::BeginSecondary(RPHandle renderPassHandle, int subpass, FBHandle framebufferHandle, ViewportScissorFlags vsf)
+{
+	throw VERUS_RUNTIME_ERROR << "BeginSecondary(); Parallel recording is not supported";
+}
+
+void CommandBufferD3D11::ExecuteSecondary(const CommandBufferPtr* pCommandBuffers, int count)
+{
+	throw VERUS_RUNTIME_ERROR << "ExecuteSecondary(); Parallel recording is not supported";
+}
+
 void CommandBufferD3D11::PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout oldLayout, ImageLayout newLayout, Range mipLevels, Range arrayLayers)
 {
 }
 
-void CommandBufferD3D11::BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle, std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf)
+void CommandBufferD3D11::BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle, std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf, SubpassContents contents)
 {
 	VERUS_QREF_RENDERER_D3D11;
 
@@ -71,14 +86,22 @@ void CommandBufferD3D11::BeginRenderPass(RPHandle renderPassHandle, FBHandle fra
 		_vClearValues.push_back(pColor[3]);
 	}
 
+	_renderPassHandle = renderPassHandle;
+	_framebufferHandle = framebufferHandle;
+	_subpass = 0;
+	_subpassContents = contents;
+
 	_subpassIndex = 0;
 	PrepareSubpass();
 
 	SetViewportAndScissor(vsf, _pFramebuffer->_width, _pFramebuffer->_height);
 }
 
-void CommandBufferD3D11::NextSubpass()
+void CommandBufferD3D11::NextSubpass(SubpassContents contents)
 {
+	_subpass++;
+	_subpassContents = contents;
+
 	_subpassIndex++;
 	PrepareSubpass();
 }
@@ -91,6 +114,11 @@ void CommandBufferD3D11::EndRenderPass()
 	_pRenderPass = nullptr;
 	_pFramebuffer = nullptr;
 	_subpassIndex = 0;
+
+	_renderPassHandle = RPHandle();
+	_framebufferHandle = FBHandle();
+	_subpass = 0;
+	_subpassContents = SubpassContents::inlined;
 }
 
 void CommandBufferD3D11::BindPipeline(PipelinePtr pipe)
@@ -188,12 +216,12 @@ void CommandBufferD3D11::BindIndexBuffer(GeometryPtr geo)
 	_pDeviceContext->IASetIndexBuffer(geoD3D11.GetD3DIndexBuffer(), geoD3D11.Has32BitIndices() ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT, 0);
 }
 
-bool CommandBufferD3D11::BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle)
+bool CommandBufferD3D11::BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle, const void* pSrc)
 {
 	auto& shaderD3D11 = static_cast<RShaderD3D11>(*shader);
 
 	const ShaderStageFlags stageFlags = shaderD3D11.GetShaderStageFlags(setNumber);
-	ID3D11Buffer* pBuffer = shaderD3D11.UpdateConstantBuffer(setNumber);
+	ID3D11Buffer* pBuffer = shaderD3D11.UpdateConstantBuffer(setNumber, pSrc);
 
 	ShaderResources shaderResources;
 	if (complexSetHandle.IsSet())
@@ -22,14 +22,19 @@ namespace verus::CGI
 		virtual void InitOneTimeSubmit() override;
 		virtual void DoneOneTimeSubmit() override;
 
+		virtual void InitSecondary() override;
+
 		virtual void Begin() override;
 		virtual void End() override;
 
+		virtual void BeginSecondary(RPHandle renderPassHandle, int subpass, FBHandle framebufferHandle, ViewportScissorFlags vsf) override;
+		virtual void ExecuteSecondary(const CommandBufferPtr* pCommandBuffers, int count) override;
+
 		virtual void PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout oldLayout, ImageLayout newLayout, Range mipLevels, Range arrayLayers) override;
 
 		virtual void BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle,
-			std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf) override;
-		virtual void NextSubpass() override;
+			std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf, SubpassContents contents) override;
+		virtual void NextSubpass(SubpassContents contents) override;
 		virtual void EndRenderPass() override;
 
 		virtual void BindPipeline(PipelinePtr pipe) override;
@@ -40,7 +45,7 @@ namespace verus::CGI
 		virtual void BindVertexBuffers(GeometryPtr geo, UINT32 bindingsFilter) override;
 		virtual void BindIndexBuffer(GeometryPtr geo) override;
 
-		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle) override;
+		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle, const void* pSrc) override;
 		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, GeometryPtr geo, int sbIndex) override;
 		virtual void PushConstants(ShaderPtr shader, int offset, int size, const void* p, ShaderStageFlags stageFlags) override;
 
@@ -350,6 +350,7 @@ void RendererD3D11::ImGuiRenderDrawData()
 {
 	VERUS_QREF_RENDERER;
 	renderer.UpdateUtilization();
+	D::Profiler::I().DrawOverlay();
 	ImGui::Render();
 	if (ImGui::GetDrawData())
 		ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
@@ -403,6 +404,7 @@ void RendererD3D11::EndFrame()
 	ImGui::EndFrame();
 
 	_ringBufferIndex = (_ringBufferIndex + 1) % s_ringBufferSize;
+	_ringBufferFrameCount++;
 
 	// <Present>
 	if (_swapChainBufferIndex >= 0)
@@ -324,7 +324,7 @@ void ShaderD3D11::EndBindDescriptors()
 {
 }
 
-ID3D11Buffer* ShaderD3D11::UpdateConstantBuffer(int setNumber) const
+ID3D11Buffer* ShaderD3D11::UpdateConstantBuffer(int setNumber, const void* pSrc) const
 {
 	VERUS_QREF_RENDERER_D3D11;
 	HRESULT hr = 0;
@@ -334,7 +334,7 @@ ID3D11Buffer* ShaderD3D11::UpdateConstantBuffer(int setNumber) const
 	D3D11_MAPPED_SUBRESOURCE ms;
 	if (FAILED(hr = pRendererD3D11->GetD3DDeviceContext()->Map(dsd._pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &ms)))
 		throw VERUS_RUNTIME_ERROR << "Map(); hr=" << VERUS_HR(hr);
-	memcpy(ms.pData, dsd._pSrc, dsd._size);
+	memcpy(ms.pData, pSrc ? pSrc : dsd._pSrc, dsd._size);
 	pRendererD3D11->GetD3DDeviceContext()->Unmap(dsd._pConstantBuffer.Get(), 0);
 
 	return dsd._pConstantBuffer.Get();
@@ -92,7 +92,7 @@ namespace verus::CGI
 
 		RcCompiled GetCompiled(CSZ branch) const { return _mapCompiled.at(branch); }
 
-		ID3D11Buffer* UpdateConstantBuffer(int setNumber) const;
+		ID3D11Buffer* UpdateConstantBuffer(int setNumber, const void* pSrc = nullptr) const;
 		ShaderStageFlags GetShaderStageFlags(int setNumber) const;
 		void GetShaderResources(int setNumber, int complexSetHandle, RShaderResources shaderResources)  const;
 		void GetSamplers(int setNumber, int complexSetHandle, RShaderResources shaderResources)  const;
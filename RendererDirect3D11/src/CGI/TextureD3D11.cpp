@@ -260,6 +260,7 @@ void TextureD3D11::Done()
 	_vUAVs.clear();
 
 	_pSRV.Reset();
+	_vOldSRVs.clear();
 
 	_vCshGenerateMips.clear();
 
@@ -476,9 +477,38 @@ void TextureD3D11::GenerateCubeMapMips(PBaseCommandBuffer pCB)
 	ClearCshGenerateMips();
 }
 
+void TextureD3D11::SetMostDetailedMip(int mipLevel)
+{
+	VERUS_QREF_RENDERER_D3D11;
+	HRESULT hr = 0;
+	VERUS_RT_ASSERT(!(_desc._flags & TextureDesc::Flags::cubeMap) && _desc._arrayLayers == 1);
+
+	if (GetMostDetailedMip() == mipLevel)
+		return;
+	BaseTexture::SetMostDetailedMip(mipLevel);
+
+	// Descriptor sets store raw pointers to views, keep the old view alive for a few frames:
+	_vOldSRVs.push_back(_pSRV);
+	_pSRV.Reset();
+	Schedule(0);
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Format = ToNativeFormat(_desc._format, false);
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MostDetailedMip = mipLevel;
+	srvDesc.Texture2D.MipLevels = _desc._mipLevels - mipLevel;
+	if (FAILED(hr = pRendererD3D11->GetD3DDevice()->CreateShaderResourceView(GetD3DResource(), &srvDesc, &_pSRV)))
+		throw VERUS_RUNTIME_ERROR << "CreateShaderResourceView(MostDetailedMip); hr=" << VERUS_HR(hr);
+}
+
 Continue TextureD3D11::Scheduled_Update()
 {
-	return Continue::yes;
+	if (!IsScheduledAllowed())
+		return Continue::yes;
+
+	_vOldSRVs.clear();
+
+	return Continue::no;
 }
 
 void TextureD3D11::ClearCshGenerateMips()
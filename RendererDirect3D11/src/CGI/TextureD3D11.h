@@ -11,6 +11,7 @@ namespace verus::CGI
 		Vector<ComPtr<ID3D11Texture2D>>           _vReadbackTextures;
 		Vector<CSHandle>                          _vCshGenerateMips;
 		ComPtr<ID3D11ShaderResourceView>          _pSRV;
+		Vector<ComPtr<ID3D11ShaderResourceView>>  _vOldSRVs;
 		Vector<ComPtr<ID3D11UnorderedAccessView>> _vUAVs;
 		Vector<ComPtr<ID3D11RenderTargetView>>    _vRTVs;
 		ComPtr<ID3D11DepthStencilView>            _pDSV[2];
@@ -29,6 +30,8 @@ namespace verus::CGI
 		virtual void GenerateMips(PBaseCommandBuffer pCB) override;
 		void GenerateCubeMapMips(PBaseCommandBuffer pCB);
 
+		virtual void SetMostDetailedMip(int mipLevel) override;
+
 		virtual Continue Scheduled_Update() override;
 
 		//
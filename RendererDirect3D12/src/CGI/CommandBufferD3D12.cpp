@@ -29,8 +29,16 @@ void CommandBufferD3D12::Done()
 {
 	VERUS_FOR(i, BaseRenderer::s_ringBufferSize)
 	{
+		_vBundles[i].clear();
 		VERUS_COM_RELEASE_CHECK(_pCommandLists[i].Get());
 		_pCommandLists[i].Reset();
+		VERUS_COM_RELEASE_CHECK(_pBundleCommandAllocators[i].Get());
+		_pBundleCommandAllocators[i].Reset();
+	}
+	if (IsInitialized() && _secondary)
+	{
+		VERUS_QREF_RENDERER_D3D12;
+		pRendererD3D12->ReleaseUniformAllocator(_uniformAllocator);
 	}
 	VERUS_RT_ASSERT(_vAttachmentStates.capacity() < 100);
 	VERUS_RT_ASSERT(_vBarriers.capacity() < 1000);
@@ -66,14 +74,34 @@ void CommandBufferD3D12::DoneOneTimeSubmit()
 		_pCommandLists[i].Reset();
 }
 
+void CommandBufferD3D12::InitSecondary()
+{
+	VERUS_INIT();
+	VERUS_QREF_RENDERER_D3D12;
+
+	_secondary = true;
+	_uniformAllocator = pRendererD3D12->AcquireUniformAllocator();
+	VERUS_FOR(i, BaseRenderer::s_ringBufferSize)
+	{
+		_pBundleCommandAllocators[i] = pRendererD3D12->CreateD3DCommandAllocator(D3D12_COMMAND_LIST_TYPE_BUNDLE);
+		_secondaryFrames[i] = UINT64_MAX;
+	}
+}
+
 void CommandBufferD3D12::Begin()
 {
 	VERUS_QREF_RENDERER_D3D12;
 
+	ID3D12CommandAllocator* pCommandAllocator = nullptr;
+	if (_pOneTimeCommandAllocator)
+		pCommandAllocator = _pOneTimeCommandAllocator.Get();
+	else if (_secondary)
+		pCommandAllocator = _pBundleCommandAllocators[pRendererD3D12->GetRingBufferIndex()].Get();
+	else
+		pCommandAllocator = pRendererD3D12->GetD3DCommandAllocator(pRendererD3D12->GetRingBufferIndex());
+
 	HRESULT hr = 0;
-	if (FAILED(hr = GetD3DGraphicsCommandList()->Reset(
-		_pOneTimeCommandAllocator ? _pOneTimeCommandAllocator.Get() : pRendererD3D12->GetD3DCommandAllocator(pRendererD3D12->GetRingBufferIndex()),
-		nullptr)))
+	if (FAILED(hr = GetD3DGraphicsCommandList()->Reset(pCommandAllocator, nullptr)))
 		throw VERUS_RUNTIME_ERROR << "Reset(); hr=" << VERUS_HR(hr);
 }
 
@@ -84,6 +112,43 @@ void CommandBufferD3D12::End()
 		throw VERUS_RUNTIME_ERROR << "Close(); hr=" << VERUS_HR(hr);
 }
 
+void CommandBufferD3D12::BeginSecondary(RPHandle renderPassHandle, int subpass, FBHandle framebufferHandle, ViewportScissorFlags vsf)
+{
+	VERUS_QREF_RENDERER_D3D12;
+	VERUS_RT_ASSERT(_secondary);
+
+	// Executed bundles cannot be recorded again during the same frame, so each begin takes the next one.
+	// Allocator is used only by this object, so it can be reset on any thread:
+	const int ringBufferIndex = pRendererD3D12->GetRingBufferIndex();
+	if (_secondaryFrames[ringBufferIndex] != pRendererD3D12->GetRingBufferFrameCount())
+	{
+		HRESULT hr = 0;
+		if (FAILED(hr = _pBundleCommandAllocators[ringBufferIndex]->Reset()))
+			throw VERUS_RUNTIME_ERROR << "Reset(); hr=" << VERUS_HR(hr);
+		_secondaryFrames[ringBufferIndex] = pRendererD3D12->GetRingBufferFrameCount();
+		_usedSecondaryCount = 0;
+	}
+	auto& vBundles = _vBundles[ringBufferIndex];
+	if (Utils::Cast32(vBundles.size()) == _usedSecondaryCount)
+		vBundles.push_back(pRendererD3D12->CreateD3DCommandList(D3D12_COMMAND_LIST_TYPE_BUNDLE, _pBundleCommandAllocators[ringBufferIndex]));
+	_pCommandLists[ringBufferIndex] = vBundles[_usedSecondaryCount++];
+	Begin();
+
+	// Bundle must use the same descriptor heaps as the command list, which executes it:
+	pRendererD3D12->SetDescriptorHeaps(this);
+
+	// Viewport and scissor are inherited, but viewport size must be known:
+	RP::RcD3DFramebuffer framebuffer = pRendererD3D12->GetFramebuffer(framebufferHandle);
+	SetViewportAndScissor(vsf, framebuffer._width, framebuffer._height);
+}
+
+void CommandBufferD3D12::ExecuteSecondary(const CommandBufferPtr* pCommandBuffers, int count)
+{
+	auto pCmdList = GetD3DGraphicsCommandList();
+	VERUS_FOR(i, count)
+		pCmdList->ExecuteBundle(static_cast<RCommandBufferD3D12>(*pCommandBuffers[i]).GetD3DGraphicsCommandList());
+}
+
 void CommandBufferD3D12::PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout oldLayout, ImageLayout newLayout, Range mipLevels, Range arrayLayers)
 {
 	auto& texD3D12 = static_cast<RTextureD3D12>(*tex);
@@ -102,7 +167,7 @@ void CommandBufferD3D12::PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout
 		GetD3DGraphicsCommandList()->ResourceBarrier(static_cast<UINT>(_vBarriers.size()), _vBarriers.data());
 }
 
-void CommandBufferD3D12::BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle, std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf)
+void CommandBufferD3D12::BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle, std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf, SubpassContents contents)
 {
 	VERUS_QREF_RENDERER_D3D12;
 
@@ -124,14 +189,22 @@ void CommandBufferD3D12::BeginRenderPass(RPHandle renderPassHandle, FBHandle fra
 	for (const auto& attachment : _pRenderPass->_vAttachments)
 		_vAttachmentStates.push_back(attachment._initialState);
 
+	_renderPassHandle = renderPassHandle;
+	_framebufferHandle = framebufferHandle;
+	_subpass = 0;
+	_subpassContents = contents;
+
 	_subpassIndex = 0;
 	PrepareSubpass();
 
 	SetViewportAndScissor(vsf, _pFramebuffer->_width, _pFramebuffer->_height);
 }
 
-void CommandBufferD3D12::NextSubpass()
+void CommandBufferD3D12::NextSubpass(SubpassContents contents)
 {
+	_subpass++;
+	_subpassContents = contents;
+
 	_subpassIndex++;
 	PrepareSubpass();
 }
@@ -169,6 +242,11 @@ void CommandBufferD3D12::EndRenderPass()
 	_pRenderPass = nullptr;
 	_pFramebuffer = nullptr;
 	_subpassIndex = 0;
+
+	_renderPassHandle = RPHandle();
+	_framebufferHandle = FBHandle();
+	_subpass = 0;
+	_subpassContents = SubpassContents::inlined;
 }
 
 void CommandBufferD3D12::BindPipeline(PipelinePtr pipe)
@@ -196,6 +274,9 @@ void CommandBufferD3D12::SetViewport(std::initializer_list<Vector4> il, float mi
 		_viewportSize = Vector4(w, h, 1 / w, 1 / h);
 	}
 
+	if (_secondary)
+		return; // Bundles inherit viewports.
+
 	VERUS_RT_ASSERT(il.size() <= VERUS_MAX_CA);
 	CD3DX12_VIEWPORT vpD3D12[VERUS_MAX_CA];
 	UINT count = 0;
@@ -206,6 +287,9 @@ void CommandBufferD3D12::SetViewport(std::initializer_list<Vector4> il, float mi
 
 void CommandBufferD3D12::SetScissor(std::initializer_list<Vector4> il)
 {
+	if (_secondary)
+		return; // Bundles inherit scissor rectangles.
+
 	VERUS_RT_ASSERT(il.size() <= VERUS_MAX_CA);
 	CD3DX12_RECT rcD3D12[VERUS_MAX_CA];
 	UINT count = 0;
@@ -248,14 +332,14 @@ void CommandBufferD3D12::BindIndexBuffer(GeometryPtr geo)
 	GetD3DGraphicsCommandList()->IASetIndexBuffer(geoD3D12.GetD3DIndexBufferView());
 }
 
-bool CommandBufferD3D12::BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle)
+bool CommandBufferD3D12::BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle, const void* pSrc)
 {
 	auto& shaderD3D12 = static_cast<RShaderD3D12>(*shader);
 
-	if (shaderD3D12.TryRootConstants(setNumber, *this))
+	if (shaderD3D12.TryRootConstants(setNumber, *this, pSrc))
 		return true;
 
-	const D3D12_GPU_DESCRIPTOR_HANDLE hGPU = shaderD3D12.UpdateConstantBuffer(setNumber, complexSetHandle.Get());
+	const D3D12_GPU_DESCRIPTOR_HANDLE hGPU = shaderD3D12.UpdateConstantBuffer(setNumber, complexSetHandle.Get(), _uniformAllocator, pSrc);
 	if (!hGPU.ptr)
 		return false;
 
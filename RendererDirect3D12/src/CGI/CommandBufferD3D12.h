@@ -5,14 +5,18 @@ namespace verus::CGI
 {
 	class CommandBufferD3D12 : public BaseCommandBuffer
 	{
-		ComPtr<ID3D12CommandAllocator>     _pOneTimeCommandAllocator;
-		ComPtr<ID3D12GraphicsCommandList3> _pCommandLists[BaseRenderer::s_ringBufferSize];
-		RP::PcD3DRenderPass                _pRenderPass = nullptr;
-		RP::PcD3DFramebuffer               _pFramebuffer = nullptr;
-		Vector<FLOAT>                      _vClearValues;
-		Vector<D3D12_RESOURCE_STATES>      _vAttachmentStates;
-		Vector<D3D12_RESOURCE_BARRIER>     _vBarriers;
-		int                                _subpassIndex = 0;
+		ComPtr<ID3D12CommandAllocator>             _pOneTimeCommandAllocator;
+		ComPtr<ID3D12CommandAllocator>             _pBundleCommandAllocators[BaseRenderer::s_ringBufferSize];
+		ComPtr<ID3D12GraphicsCommandList3>         _pCommandLists[BaseRenderer::s_ringBufferSize];
+		Vector<ComPtr<ID3D12GraphicsCommandList3>> _vBundles[BaseRenderer::s_ringBufferSize]; // Secondary can begin many times per frame.
+		UINT64                                     _secondaryFrames[BaseRenderer::s_ringBufferSize] = {};
+		RP::PcD3DRenderPass                        _pRenderPass = nullptr;
+		RP::PcD3DFramebuffer                       _pFramebuffer = nullptr;
+		Vector<FLOAT>                              _vClearValues;
+		Vector<D3D12_RESOURCE_STATES>              _vAttachmentStates;
+		Vector<D3D12_RESOURCE_BARRIER>             _vBarriers;
+		int                                        _subpassIndex = 0;
+		int                                        _usedSecondaryCount = 0; // During this frame.
 
 	public:
 		CommandBufferD3D12();
@@ -24,14 +28,19 @@ namespace verus::CGI
 		virtual void InitOneTimeSubmit() override;
 		virtual void DoneOneTimeSubmit() override;
 
+		virtual void InitSecondary() override;
+
 		virtual void Begin() override;
 		virtual void End() override;
 
+		virtual void BeginSecondary(RPHandle renderPassHandle, int subpass, FBHandle framebufferHandle, ViewportScissorFlags vsf) override;
+		virtual void ExecuteSecondary(const CommandBufferPtr* pCommandBuffers, int count) override;
+
 		virtual void PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout oldLayout, ImageLayout newLayout, Range mipLevels, Range arrayLayers) override;
 
 		virtual void BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle,
-			std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf) override;
-		virtual void NextSubpass() override;
+			std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf, SubpassContents contents) override;
+		virtual void NextSubpass(SubpassContents contents) override;
 		virtual void EndRenderPass() override;
 
 		virtual void BindPipeline(PipelinePtr pipe) override;
@@ -42,7 +51,7 @@ namespace verus::CGI
 		virtual void BindVertexBuffers(GeometryPtr geo, UINT32 bindingsFilter) override;
 		virtual void BindIndexBuffer(GeometryPtr geo) override;
 
-		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle) override;
+		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle, const void* pSrc) override;
 		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, GeometryPtr geo, int sbIndex) override;
 		virtual void PushConstants(ShaderPtr shader, int offset, int size, const void* p, ShaderStageFlags stageFlags) override;
 
@@ -38,7 +38,8 @@ CD3DX12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::AtGPU(int index) const
 
 void DynamicDescriptorHeap::Create(ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, int count, int staticCount, bool shaderVisible)
 {
-	VERUS_CT_ASSERT(sizeof(*this) == 56);
+	VERUS_CT_ASSERT(sizeof(*this) == 64);
+	_pMutex = std::make_unique<std::mutex>();
 	_capacity = count;
 	_offset = 0;
 	DescriptorHeap::Create(pDevice, type, _capacity * BaseRenderer::s_ringBufferSize + staticCount, shaderVisible);
@@ -47,6 +48,7 @@ void DynamicDescriptorHeap::Create(ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_
 HandlePair DynamicDescriptorHeap::GetNextHandlePair(int count)
 {
 	VERUS_QREF_RENDERER;
+	std::lock_guard<std::mutex> lock(*_pMutex);
 
 	if (_currentFrame != renderer.GetFrameCount())
 	{
@@ -38,12 +38,14 @@ namespace verus::CGI
 	VERUS_TYPEDEFS(HandlePair);
 
 	// This descriptor heap should be refilled every frame:
+	// GetNextHandlePair() can be called from multiple threads.
 	class DynamicDescriptorHeap : public DescriptorHeap
 	{
-		int    _capacity = 0;
-		int    _offset = 0;
-		UINT64 _currentFrame = UINT64_MAX;
-		UINT64 _peakLoad = 0;
+		std::unique_ptr<std::mutex> _pMutex;
+		int                         _capacity = 0;
+		int                         _offset = 0;
+		UINT64                      _currentFrame = UINT64_MAX;
+		UINT64                      _peakLoad = 0;
 
 	public:
 		void Create(ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, int count, int staticCount = 0, bool shaderVisible = false);
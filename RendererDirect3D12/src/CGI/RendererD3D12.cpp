@@ -502,6 +502,7 @@ void RendererD3D12::ImGuiRenderDrawData()
 {
 	VERUS_QREF_RENDERER;
 	renderer.UpdateUtilization();
+	D::Profiler::I().DrawOverlay();
 	ImGui::Render();
 	auto pCmdList = static_cast<CommandBufferD3D12*>(renderer.GetCommandBuffer().Get())->GetD3DGraphicsCommandList();
 	if (ImGui::GetDrawData())
@@ -582,6 +583,7 @@ void RendererD3D12::EndFrame()
 	_pCommandQueue->ExecuteCommandLists(VERUS_COUNT_OF(ppCommandLists), ppCommandLists);
 	_fenceValues[_ringBufferIndex] = QueueSignal();
 	_ringBufferIndex = (_ringBufferIndex + 1) % s_ringBufferSize;
+	_ringBufferFrameCount++;
 	// </QueueSubmit>
 
 	// <Present>
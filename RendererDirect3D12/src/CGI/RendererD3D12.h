@@ -90,6 +90,8 @@ namespace verus::CGI
 		virtual void OnMinimized() override;
 		// </FrameCycle>
 
+		virtual bool IsParallelRecordingSupported() const override { return true; }
+
 		// <Resources>
 		virtual PBaseCommandBuffer InsertCommandBuffer() override;
 		virtual PBaseGeometry      InsertGeometry() override;
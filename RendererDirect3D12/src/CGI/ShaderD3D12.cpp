@@ -13,9 +13,8 @@ HRESULT STDMETHODCALLTYPE ShaderInclude::Open(
 	LPCVOID* ppData,
 	UINT* pBytes)
 {
-	const String url = String("[Shaders]:") + pFileName;
 	Vector<BYTE> vData;
-	IO::FileSystem::LoadResource(_C(url), vData);
+	_pCache->LoadInclude(pFileName, vData, _vIncludes);
 	char* p = new char[vData.size()];
 	memcpy(p, vData.data(), vData.size());
 	*pBytes = Utils::Cast32(vData.size());
@@ -44,27 +43,38 @@ void ShaderD3D12::Init(CSZ source, CSZ sourceName, CSZ* branches)
 {
 	VERUS_INIT();
 	VERUS_QREF_CONST_SETTINGS;
-	HRESULT hr = 0;
 
 	_sourceName = sourceName;
 	const size_t len = strlen(source);
-	ShaderInclude inc;
 	const String version = "5_1";
 #ifdef _DEBUG
 	const UINT flags = D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_WARNINGS_ARE_ERRORS | D3DCOMPILE_ALL_RESOURCES_BOUND | D3DCOMPILE_OPTIMIZATION_LEVEL1 | D3DCOMPILE_DEBUG;
 #else
 	const UINT flags = D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_WARNINGS_ARE_ERRORS | D3DCOMPILE_ALL_RESOURCES_BOUND | D3DCOMPILE_OPTIMIZATION_LEVEL3;
 #endif
-	ComPtr<ID3DBlob> pErrorMsgs;
+	CSZ stageTargets[] = { "vs_", "hs_", "ds_", "gs_", "ps_", "cs_" };
+	VERUS_CT_ASSERT(VERUS_COUNT_OF(stageTargets) == +Stage::count);
 
-	auto CheckErrorMsgs = [this](ComPtr<ID3DBlob>& pErrorMsgs)
-		{
-			if (pErrorMsgs)
-			{
-				OnError(static_cast<CSZ>(pErrorMsgs->GetBufferPointer()));
-				pErrorMsgs.Reset();
-			}
-		};
+	// One job compiles one stage of one branch:
+	struct Job
+	{
+		String           _branch;
+		String           _entry;
+		Vector<String>   _vDefines; // Name-value pairs.
+		ComPtr<ID3DBlob> _pBlob;
+		String           _errorMsgs;
+		Stage            _stage = Stage::vs;
+	};
+	Vector<Job> vJobs;
+
+	// <System defines>
+	Vector<String> vSystemDefines;
+	GetSystemDefines(settings, vSystemDefines);
+	vSystemDefines.push_back("_DIRECT3D");
+	vSystemDefines.push_back("1");
+	vSystemDefines.push_back("_DIRECT3D12");
+	vSystemDefines.push_back("1");
+	// </System defines>
 
 	while (*branches)
 	{
@@ -79,107 +89,102 @@ void ShaderD3D12::Init(CSZ source, CSZ sourceName, CSZ* branches)
 			continue;
 		}
 
-		// <User defines>
-		Vector<D3D_SHADER_MACRO> vDefines;
-		vDefines.reserve(20);
-		const int count = Utils::Cast32(vMacroName.size());
-		VERUS_FOR(i, count)
-		{
-			D3D_SHADER_MACRO sm;
-			sm.Name = _C(vMacroName[i]);
-			sm.Definition = _C(vMacroValue[i]);
-			vDefines.push_back(sm);
-		}
-		// </User defines>
-
-		// <System defines>
-		char defAnisotropyLevel[64] = {};
-		{
-			sprintf_s(defAnisotropyLevel, "%d", settings._gpuAnisotropyLevel);
-			vDefines.push_back({ "_ANISOTROPY_LEVEL", defAnisotropyLevel });
-		}
-		char defShaderQuality[64] = {};
-		{
-			sprintf_s(defShaderQuality, "%d", settings._gpuShaderQuality);
-			vDefines.push_back({ "_SHADER_QUALITY", defShaderQuality });
-		}
-		char defShadowQuality[64] = {};
-		{
-			sprintf_s(defShadowQuality, "%d", settings._sceneShadowQuality);
-			vDefines.push_back({ "_SHADOW_QUALITY", defShadowQuality });
-		}
-		char defWaterQuality[64] = {};
-		{
-			sprintf_s(defWaterQuality, "%d", settings._sceneWaterQuality);
-			vDefines.push_back({ "_WATER_QUALITY", defWaterQuality });
-		}
-		char defMaxNumBones[64] = {};
-		{
-			sprintf_s(defMaxNumBones, "%d", VERUS_MAX_BONES);
-			vDefines.push_back({ "VERUS_MAX_BONES", defMaxNumBones });
-		}
-		vDefines.push_back({ "_DIRECT3D", "1" });
-		vDefines.push_back({ "_DIRECT3D12", "1" });
-		const int typeIndex = Utils::Cast32(vDefines.size());
-		vDefines.push_back({ "_XS", "1" });
-		vDefines.push_back({});
-		// </System defines>
-
 		Compiled compiled;
 		compiled._entry = entry;
 
-		if (strchr(_C(stages), 'V'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex].Name = "_VS";
-			hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::vs]), _C("vs_" + version), flags, 0, &compiled._pBlobs[+Stage::vs], &pErrorMsgs);
-			CheckErrorMsgs(pErrorMsgs);
-		}
-
-		if (strchr(_C(stages), 'H'))
+		VERUS_FOR(i, +Stage::count)
 		{
+			if (!strchr(_C(stages), GetStageLetter(static_cast<Stage>(i))))
+				continue;
 			compiled._stageCount++;
-			vDefines[typeIndex].Name = "_HS";
-			hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::hs]), _C("hs_" + version), flags, 0, &compiled._pBlobs[+Stage::hs], &pErrorMsgs);
-			CheckErrorMsgs(pErrorMsgs);
+			if (Stage::cs == static_cast<Stage>(i))
+				_compute = true;
+
+			Job job;
+			job._branch = branch;
+			job._entry = stageEntries[i];
+			job._stage = static_cast<Stage>(i);
+			job._vDefines.reserve(vMacroName.size() * 2 + vSystemDefines.size() + 2);
+			const int count = Utils::Cast32(vMacroName.size());
+			VERUS_FOR(j, count)
+			{
+				job._vDefines.push_back(vMacroName[j]);
+				job._vDefines.push_back(vMacroValue[j]);
+			}
+			job._vDefines.insert(job._vDefines.end(), vSystemDefines.begin(), vSystemDefines.end());
+			job._vDefines.push_back(GetStageDefine(static_cast<Stage>(i)));
+			job._vDefines.push_back("1");
+			vJobs.push_back(std::move(job));
 		}
 
-		if (strchr(_C(stages), 'D'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex].Name = "_DS";
-			hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::ds]), _C("ds_" + version), flags, 0, &compiled._pBlobs[+Stage::ds], &pErrorMsgs);
-			CheckErrorMsgs(pErrorMsgs);
-		}
+		_mapCompiled[branch] = compiled;
 
-		if (strchr(_C(stages), 'G'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex].Name = "_GS";
-			hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::gs]), _C("gs_" + version), flags, 0, &compiled._pBlobs[+Stage::gs], &pErrorMsgs);
-			CheckErrorMsgs(pErrorMsgs);
-		}
+		branches++;
+	}
 
-		if (strchr(_C(stages), 'F'))
+	// Cached stages are loaded, the rest are compiled in parallel:
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	ShaderCache cache(_C("DXBC; D3DCompiler " + std::to_string(D3D_COMPILER_VERSION)), "dxbc");
+	const int jobCount = Utils::Cast32(vJobs.size());
+	std::exception_ptr pException;
+	std::mutex mutex;
+	if (jobCount > 0)
+	{
+		VERUS_P_FOR(i, jobCount)
 		{
-			compiled._stageCount++;
-			vDefines[typeIndex].Name = "_FS";
-			hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::fs]), _C("ps_" + version), flags, 0, &compiled._pBlobs[+Stage::fs], &pErrorMsgs);
-			CheckErrorMsgs(pErrorMsgs);
-		}
+			try
+			{
+				Job& job = vJobs[i];
+				HRESULT hr = 0;
+
+				const String target = stageTargets[+job._stage] + version;
+				const String params = ShaderCache::GetParams(_C(job._entry), _C(target), flags, job._vDefines);
+				const String key = cache.GetKey(source, sourceName, params);
+				Vector<BYTE> vCode;
+				if (cache.Load(key, vCode))
+				{
+					if (FAILED(hr = D3DCreateBlob(vCode.size(), &job._pBlob)))
+						throw VERUS_RUNTIME_ERROR << "D3DCreateBlob(); hr=" << VERUS_HR(hr);
+					memcpy(job._pBlob->GetBufferPointer(), vCode.data(), vCode.size());
+					return;
+				}
 
-		if (strchr(_C(stages), 'C'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex].Name = "_CS";
-			hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::cs]), _C("cs_" + version), flags, 0, &compiled._pBlobs[+Stage::cs], &pErrorMsgs);
-			CheckErrorMsgs(pErrorMsgs);
-			_compute = true;
-		}
+				Vector<D3D_SHADER_MACRO> vDefines;
+				vDefines.reserve(job._vDefines.size() / 2 + 1);
+				for (size_t j = 0; j < job._vDefines.size(); j += 2)
+					vDefines.push_back({ _C(job._vDefines[j]), _C(job._vDefines[j + 1]) });
+				vDefines.push_back({});
+
+				ShaderInclude inc;
+				inc._pCache = &cache;
+				ComPtr<ID3DBlob> pErrorMsgs;
+				hr = D3DCompile(source, len, sourceName, vDefines.data(), &inc, _C(job._entry), _C(target), flags, 0, &job._pBlob, &pErrorMsgs);
+				if (pErrorMsgs)
+					job._errorMsgs = static_cast<CSZ>(pErrorMsgs->GetBufferPointer());
+				if (SUCCEEDED(hr) && job._pBlob)
+					cache.Save(key, inc._vIncludes, job._pBlob->GetBufferPointer(), job._pBlob->GetBufferSize());
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!pException)
+					pException = std::current_exception();
+			}
+		});
+	}
+	if (pException)
+		std::rethrow_exception(pException);
+	const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
 
-		_mapCompiled[branch] = compiled;
+	const ShaderCache::Stats stats = cache.GetStats();
+	VERUS_LOG_INFO("Init(); source=" << sourceName << ", stages=" << jobCount << ", cached=" << stats._hitCount
+		<< ", time=" << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << " ms");
 
-		branches++;
+	for (auto& job : vJobs)
+	{
+		if (!job._errorMsgs.empty())
+			OnError(_C(job._errorMsgs));
+		_mapCompiled[job._branch]._pBlobs[+job._stage] = job._pBlob;
 	}
 
 	_vDescriptorSetDesc.reserve(8);
@@ -187,6 +192,9 @@ void ShaderD3D12::Init(CSZ source, CSZ sourceName, CSZ* branches)
 
 void ShaderD3D12::Done()
 {
+	VERUS_QREF_RENDERER_D3D12;
+
+	pRendererD3D12->UnscheduleUniformBufferGrowth(this);
 	for (auto& dsd : _vDescriptorSetDesc)
 	{
 		VERUS_SMART_RELEASE(dsd._pMaAllocation);
@@ -211,10 +219,8 @@ void ShaderD3D12::Done()
 
 void ShaderD3D12::CreateDescriptorSet(int setNumber, const void* pSrc, int size, int capacity, std::initializer_list<Sampler> il, ShaderStageFlags stageFlags)
 {
-	VERUS_QREF_RENDERER_D3D12;
 	VERUS_RT_ASSERT(_vDescriptorSetDesc.size() == setNumber);
 	VERUS_RT_ASSERT(!(reinterpret_cast<intptr_t>(pSrc) & 0xF));
-	HRESULT hr = 0;
 
 	DescriptorSetDesc dsd;
 	dsd._vSamplers.assign(il);
@@ -224,39 +230,47 @@ void ShaderD3D12::CreateDescriptorSet(int setNumber, const void* pSrc, int size,
 	dsd._capacity = capacity;
 	dsd._capacityInBytes = dsd._alignedSize * dsd._capacity;
 	dsd._stageFlags = stageFlags;
+	dsd._vUniformBlocks.resize(BaseRenderer::s_uniformAllocatorCount);
+
+	_vDescriptorSetDesc.push_back(dsd);
 
 	if (capacity > 0)
+		CreateConstantBuffer(setNumber);
+}
+
+void ShaderD3D12::CreateConstantBuffer(int setNumber)
+{
+	VERUS_QREF_RENDERER_D3D12;
+	HRESULT hr = 0;
+
+	auto& dsd = _vDescriptorSetDesc[setNumber];
+	const UINT64 bufferSize = dsd._capacityInBytes * BaseRenderer::s_ringBufferSize;
+	D3D12MA::ALLOCATION_DESC allocDesc = {};
+	allocDesc.HeapType = D3D12_HEAP_TYPE_UPLOAD;
+	const auto resDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+	if (FAILED(hr = pRendererD3D12->GetMaAllocator()->CreateResource(
+		&allocDesc,
+		&resDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		&dsd._pMaAllocation,
+		IID_PPV_ARGS(&dsd._pConstantBuffer))))
+		throw VERUS_RUNTIME_ERROR << "CreateResource(D3D12_HEAP_TYPE_UPLOAD); hr=" << VERUS_HR(hr);
+	dsd._pConstantBuffer->SetName(_C(Str::Utf8ToWide("Shader.ConstantBuffer (" + _sourceName + ", set=" + std::to_string(setNumber) + ")")));
+
+	// Device requires alignment be a multiple of 256.
+	// Device requires SizeInBytes be a multiple of 256.
+	const int count = dsd._capacity * BaseRenderer::s_ringBufferSize;
+	dsd._dhDynamicOffsets.Create(pRendererD3D12->GetD3DDevice(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, count);
+	VERUS_FOR(i, count)
 	{
-		const UINT64 bufferSize = dsd._capacityInBytes * BaseRenderer::s_ringBufferSize;
-		D3D12MA::ALLOCATION_DESC allocDesc = {};
-		allocDesc.HeapType = D3D12_HEAP_TYPE_UPLOAD;
-		const auto resDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
-		if (FAILED(hr = pRendererD3D12->GetMaAllocator()->CreateResource(
-			&allocDesc,
-			&resDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			&dsd._pMaAllocation,
-			IID_PPV_ARGS(&dsd._pConstantBuffer))))
-			throw VERUS_RUNTIME_ERROR << "CreateResource(D3D12_HEAP_TYPE_UPLOAD); hr=" << VERUS_HR(hr);
-		dsd._pConstantBuffer->SetName(_C(Str::Utf8ToWide("Shader.ConstantBuffer (" + _sourceName + ", set=" + std::to_string(setNumber) + ")")));
-
-		// Device requires alignment be a multiple of 256.
-		// Device requires SizeInBytes be a multiple of 256.
-		const int count = dsd._capacity * BaseRenderer::s_ringBufferSize;
-		dsd._dhDynamicOffsets.Create(pRendererD3D12->GetD3DDevice(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, count);
-		VERUS_FOR(i, count)
-		{
-			const int offset = i * dsd._alignedSize;
-			auto handle = dsd._dhDynamicOffsets.AtCPU(i);
-			D3D12_CONSTANT_BUFFER_VIEW_DESC desc = {};
-			desc.BufferLocation = dsd._pConstantBuffer->GetGPUVirtualAddress() + offset;
-			desc.SizeInBytes = dsd._alignedSize;
-			pRendererD3D12->GetD3DDevice()->CreateConstantBufferView(&desc, handle);
-		}
+		const int offset = i * dsd._alignedSize;
+		auto handle = dsd._dhDynamicOffsets.AtCPU(i);
+		D3D12_CONSTANT_BUFFER_VIEW_DESC desc = {};
+		desc.BufferLocation = dsd._pConstantBuffer->GetGPUVirtualAddress() + offset;
+		desc.SizeInBytes = dsd._alignedSize;
+		pRendererD3D12->GetD3DDevice()->CreateConstantBufferView(&desc, handle);
 	}
-
-	_vDescriptorSetDesc.push_back(dsd);
 }
 
 void ShaderD3D12::CreatePipelineLayout()
@@ -528,12 +542,11 @@ void ShaderD3D12::FreeDescriptorSet(CSHandle& complexSetHandle)
 
 void ShaderD3D12::BeginBindDescriptors()
 {
-	VERUS_QREF_RENDERER;
 	VERUS_QREF_RENDERER_D3D12;
 	HRESULT hr = 0;
 
-	const bool resetOffset = _currentFrame != renderer.GetFrameCount();
-	_currentFrame = renderer.GetFrameCount();
+	const bool resetOffset = _currentFrame != pRendererD3D12->GetRingBufferFrameCount();
+	_currentFrame = pRendererD3D12->GetRingBufferFrameCount();
 
 	for (auto& dsd : _vDescriptorSetDesc)
 	{
@@ -549,7 +562,13 @@ void ShaderD3D12::BeginBindDescriptors()
 		if (resetOffset)
 		{
 			dsd._offset = 0;
-			dsd._index = 0;
+			dsd._skippedCount = 0;
+			for (auto& block : dsd._vUniformBlocks)
+			{
+				const int used = block._used;
+				block = UniformBlock();
+				block._prevUsed = used;
+			}
 		}
 	}
 }
@@ -566,6 +585,15 @@ void ShaderD3D12::EndBindDescriptors()
 	}
 }
 
+void ShaderD3D12::GrowUniformBuffers()
+{
+	VERUS_FOR(i, _vDescriptorSetDesc.size())
+	{
+		if (_vDescriptorSetDesc[i]._full)
+			GrowConstantBuffer(i);
+	}
+}
+
 UINT ShaderD3D12::ToRootParameterIndex(int setNumber) const
 {
 	// Arrange parameters in a large root signature so that the parameters most likely to change often,
@@ -573,7 +601,7 @@ UINT ShaderD3D12::ToRootParameterIndex(int setNumber) const
 	return static_cast<UINT>(_vDescriptorSetDesc.size()) - setNumber - 1;
 }
 
-bool ShaderD3D12::TryRootConstants(int setNumber, RBaseCommandBuffer cb) const
+bool ShaderD3D12::TryRootConstants(int setNumber, RBaseCommandBuffer cb, const void* pSrc) const
 {
 	const auto& dsd = _vDescriptorSetDesc[setNumber];
 	if (!dsd._capacity)
@@ -581,31 +609,28 @@ bool ShaderD3D12::TryRootConstants(int setNumber, RBaseCommandBuffer cb) const
 		auto& cbD3D12 = static_cast<RCommandBufferD3D12>(cb);
 		const UINT rootParameterIndex = ToRootParameterIndex(setNumber);
 		if (_compute)
-			cbD3D12.GetD3DGraphicsCommandList()->SetComputeRoot32BitConstants(rootParameterIndex, dsd._size >> 2, dsd._pSrc, 0);
+			cbD3D12.GetD3DGraphicsCommandList()->SetComputeRoot32BitConstants(rootParameterIndex, dsd._size >> 2, pSrc ? pSrc : dsd._pSrc, 0);
 		else
-			cbD3D12.GetD3DGraphicsCommandList()->SetGraphicsRoot32BitConstants(rootParameterIndex, dsd._size >> 2, dsd._pSrc, 0);
+			cbD3D12.GetD3DGraphicsCommandList()->SetGraphicsRoot32BitConstants(rootParameterIndex, dsd._size >> 2, pSrc ? pSrc : dsd._pSrc, 0);
 		return true;
 	}
 	return false;
 }
 
-CD3DX12_GPU_DESCRIPTOR_HANDLE ShaderD3D12::UpdateConstantBuffer(int setNumber, int complexSetHandle)
+CD3DX12_GPU_DESCRIPTOR_HANDLE ShaderD3D12::UpdateConstantBuffer(int setNumber, int complexSetHandle, int allocator, const void* pSrc)
 {
 	VERUS_QREF_RENDERER_D3D12;
 
 	auto& dsd = _vDescriptorSetDesc[setNumber];
-	if (dsd._offset + dsd._alignedSize > dsd._capacityInBytes)
-	{
-		VERUS_RT_FAIL("ConstantBuffer is full.");
+	auto& block = dsd._vUniformBlocks[allocator];
+	if (block._offset + dsd._alignedSize > block._end && !ClaimUniformBlock(dsd, block))
 		return CD3DX12_GPU_DESCRIPTOR_HANDLE(D3D12_DEFAULT);
-	}
 
 	VERUS_RT_ASSERT(dsd._pMappedData);
-	const int at = dsd._capacity * pRendererD3D12->GetRingBufferIndex() + dsd._index;
-	memcpy(dsd._pMappedData + dsd._offset, dsd._pSrc, dsd._size);
-	dsd._offset += dsd._alignedSize;
-	dsd._peakLoad = Math::Max(dsd._peakLoad, dsd._offset);
-	dsd._index++;
+	const int at = dsd._capacity * pRendererD3D12->GetRingBufferIndex() + block._offset / dsd._alignedSize;
+	memcpy(dsd._pMappedData + block._offset, pSrc ? pSrc : dsd._pSrc, dsd._size);
+	block._offset += dsd._alignedSize;
+	block._used += dsd._alignedSize;
 
 	bool hpBaseUsed = false;
 	HandlePair hpBase;
@@ -618,21 +643,23 @@ CD3DX12_GPU_DESCRIPTOR_HANDLE ShaderD3D12::UpdateConstantBuffer(int setNumber, i
 			hpBaseUsed = true;
 		}
 	}
-	if (!hpBaseUsed)
-		hpBase = pRendererD3D12->GetViewHeap().GetNextHandlePair();
+	const int textureCount = (complexSetHandle >= 0 && !hpBaseUsed) ? Utils::Cast32(_vComplexSets[complexSetHandle]._vTextures.size()) : 0;
+	if (!hpBaseUsed) // Allocate all at once, other threads can use this heap.
+		hpBase = pRendererD3D12->GetViewHeap().GetNextHandlePair(1 + textureCount);
+	if (!hpBase._hCPU.ptr)
+		return CD3DX12_GPU_DESCRIPTOR_HANDLE(D3D12_DEFAULT);
 
 	// Copy CBV:
 	pRendererD3D12->GetD3DDevice()->CopyDescriptorsSimple(1,
 		hpBase._hCPU,
 		dsd._dhDynamicOffsets.AtCPU(at),
 		D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	if (complexSetHandle >= 0 && !hpBaseUsed)
+	if (textureCount)
 	{
 		// Copy SRVs:
 		const auto& complexSet = _vComplexSets[complexSetHandle];
-		const int count = Utils::Cast32(complexSet._vTextures.size());
-		pRendererD3D12->GetD3DDevice()->CopyDescriptorsSimple(count,
-			pRendererD3D12->GetViewHeap().GetNextHandlePair(count)._hCPU,
+		pRendererD3D12->GetD3DDevice()->CopyDescriptorsSimple(textureCount,
+			CD3DX12_CPU_DESCRIPTOR_HANDLE(hpBase._hCPU, 1, pRendererD3D12->GetViewHeap().GetHandleIncrementSize()),
 			complexSet._dhViews.AtCPU(0),
 			D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 	}
@@ -640,6 +667,53 @@ CD3DX12_GPU_DESCRIPTOR_HANDLE ShaderD3D12::UpdateConstantBuffer(int setNumber, i
 	return hpBase._hGPU;
 }
 
+bool ShaderD3D12::ClaimUniformBlock(DescriptorSetDesc& dsd, UniformBlock& block)
+{
+	VERUS_QREF_RENDERER_D3D12;
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (dsd._offset + dsd._alignedSize > dsd._capacityInBytes)
+	{
+		if (!dsd._full)
+		{
+			dsd._full = true;
+			pRendererD3D12->ScheduleUniformBufferGrowth(this);
+			VERUS_LOG_WARN("ConstantBuffer is full, bindings are skipped until it grows at the beginning of the next frame (capacity=" << dsd._capacity << ", " << _sourceName << ").");
+		}
+		dsd._skippedCount++;
+		return false;
+	}
+
+	// Block gets what this allocator used during the previous frame, so that other allocators don't run out of space:
+	const int blockSize = Math::Max(block._prevUsed - block._used, dsd._alignedSize);
+	block._offset = dsd._offset;
+	block._end = Math::Min(dsd._offset + blockSize, dsd._capacityInBytes);
+	dsd._offset = block._end;
+	dsd._peakLoad = Math::Max(dsd._peakLoad, dsd._offset);
+	return true;
+}
+
+void ShaderD3D12::GrowConstantBuffer(int setNumber)
+{
+	VERUS_QREF_RENDERER_D3D12;
+
+	auto& dsd = _vDescriptorSetDesc[setNumber];
+	VERUS_RT_ASSERT(!dsd._pMappedData);
+
+	// GPU is idle, see BaseRenderer::GrowUniformBuffers():
+	VERUS_SMART_RELEASE(dsd._pMaAllocation);
+	VERUS_COM_RELEASE_CHECK(dsd._pConstantBuffer.Get());
+	dsd._dhDynamicOffsets.Reset();
+	dsd._pConstantBuffer.Reset();
+
+	dsd._capacity = Math::Max(dsd._capacity * 2, dsd._capacity + dsd._skippedCount);
+	dsd._capacityInBytes = dsd._alignedSize * dsd._capacity;
+	dsd._full = false;
+	CreateConstantBuffer(setNumber);
+
+	VERUS_LOG_INFO("ConstantBuffer grew (capacity=" << dsd._capacity << ", skipped=" << dsd._skippedCount << ", set=" << setNumber << ", " << _sourceName << ").");
+}
+
 CD3DX12_GPU_DESCRIPTOR_HANDLE ShaderD3D12::UpdateSamplers(int setNumber, int complexSetHandle) const
 {
 	VERUS_QREF_RENDERER_D3D12;
@@ -809,7 +883,7 @@ void ShaderD3D12::UpdateUtilization() const
 	{
 		StringStream ss;
 		ss << "set=" << setNumber << ", " << _sourceName;
-		renderer.AddUtilization(_C(ss.str()), dsd._index, dsd._capacity);
+		renderer.AddUtilization(_C(ss.str()), dsd._offset / Math::Max(1, dsd._alignedSize), dsd._capacity);
 		setNumber++;
 	}
 }
@@ -6,6 +6,9 @@ namespace verus::CGI
 	struct ShaderInclude : public ID3DInclude
 	{
 	public:
+		PShaderCache                 _pCache = nullptr;
+		Vector<ShaderCache::Include> _vIncludes;
+
 		virtual HRESULT STDMETHODCALLTYPE Open(
 			D3D_INCLUDE_TYPE IncludeType,
 			LPCSTR pFileName,
@@ -35,9 +38,19 @@ namespace verus::CGI
 	private:
 		typedef Map<String, Compiled> TMapCompiled;
 
+		// Part of the constant buffer, which is filled by one uniform allocator without locking.
+		struct UniformBlock
+		{
+			int _offset = 0;
+			int _end = 0;
+			int _used = 0; // During this frame.
+			int _prevUsed = 0; // During the previous frame, next blocks are sized by it.
+		};
+
 		struct DescriptorSetDesc
 		{
 			Vector<Sampler>        _vSamplers;
+			Vector<UniformBlock>   _vUniformBlocks; // For each uniform allocator.
 			ComPtr<ID3D12Resource> _pConstantBuffer;
 			D3D12MA::Allocation* _pMaAllocation = nullptr;
 			DescriptorHeap         _dhDynamicOffsets;
@@ -49,9 +62,10 @@ namespace verus::CGI
 			int                    _capacityInBytes = 0;
 			int                    _offset = 0;
 			int                    _peakLoad = 0;
-			int                    _index = 0;
+			int                    _skippedCount = 0; // Bindings, which didn't fit.
 			ShaderStageFlags       _stageFlags = ShaderStageFlags::vs_fs;
 			bool                   _staticSamplersOnly = true;
+			bool                   _full = false; // Grow at the beginning of the next frame.
 		};
 
 		struct ComplexSet
@@ -68,6 +82,7 @@ namespace verus::CGI
 		Vector<ComplexSet>          _vComplexSets;
 		ComPtr<ID3D12RootSignature> _pRootSignature;
 		String                      _debugInfo;
+		std::mutex                  _mutex;
 		UINT64                      _currentFrame = UINT64_MAX;
 		bool                        _compute = false;
 
@@ -86,6 +101,8 @@ namespace verus::CGI
 		virtual void BeginBindDescriptors() override;
 		virtual void EndBindDescriptors() override;
 
+		virtual void GrowUniformBuffers() override;
+
 		//
 		// D3D12
 		//
@@ -95,8 +112,9 @@ namespace verus::CGI
 		ID3D12RootSignature* GetD3DRootSignature() const { return _pRootSignature.Get(); }
 
 		UINT ToRootParameterIndex(int setNumber) const;
-		bool TryRootConstants(int setNumber, RBaseCommandBuffer cb) const;
-		CD3DX12_GPU_DESCRIPTOR_HANDLE UpdateConstantBuffer(int setNumber, int complexSetHandle);
+		bool TryRootConstants(int setNumber, RBaseCommandBuffer cb, const void* pSrc = nullptr) const;
+		// Thread-safe, if each thread uses its own uniform allocator.
+		CD3DX12_GPU_DESCRIPTOR_HANDLE UpdateConstantBuffer(int setNumber, int complexSetHandle, int allocator = 0, const void* pSrc = nullptr);
 		CD3DX12_GPU_DESCRIPTOR_HANDLE UpdateSamplers(int setNumber, int complexSetHandle) const;
 		int GetDescriptorSetCount() const { return static_cast<int>(_vDescriptorSetDesc.size()); }
 		bool IsCompute() const { return _compute; }
@@ -109,6 +127,10 @@ namespace verus::CGI
 			D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags);
 
 		void UpdateUtilization() const;
+
+		VERUS_P(void CreateConstantBuffer(int setNumber));
+		VERUS_P(bool ClaimUniformBlock(DescriptorSetDesc& dsd, UniformBlock& block));
+		VERUS_P(void GrowConstantBuffer(int setNumber));
 	};
 	VERUS_TYPEDEFS(ShaderD3D12);
 }
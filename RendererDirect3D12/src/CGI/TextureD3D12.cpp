@@ -597,6 +597,25 @@ void TextureD3D12::GenerateCubeMapMips(PBaseCommandBuffer pCB)
 	Schedule(0);
 }
 
+void TextureD3D12::SetMostDetailedMip(int mipLevel)
+{
+	VERUS_QREF_RENDERER_D3D12;
+	VERUS_RT_ASSERT(!(_desc._flags & TextureDesc::Flags::cubeMap) && _desc._arrayLayers == 1);
+
+	if (GetMostDetailedMip() == mipLevel)
+		return;
+	BaseTexture::SetMostDetailedMip(mipLevel);
+
+	// Descriptor is copied to shader-visible heap when descriptor set is bound, so it can be recreated in place:
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Format = ToNativeFormat(_desc._format, false);
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Texture2D.MostDetailedMip = mipLevel;
+	srvDesc.Texture2D.MipLevels = _desc._mipLevels - mipLevel;
+	pRendererD3D12->GetD3DDevice()->CreateShaderResourceView(_resource._pResource.Get(), &srvDesc, _dhSRV.AtCPU(0));
+}
+
 Continue TextureD3D12::Scheduled_Update()
 {
 	if (!IsScheduledAllowed())
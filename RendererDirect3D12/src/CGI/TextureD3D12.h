@@ -35,6 +35,8 @@ namespace verus::CGI
 		virtual void GenerateMips(PBaseCommandBuffer pCB) override;
 		void GenerateCubeMapMips(PBaseCommandBuffer pCB);
 
+		virtual void SetMostDetailedMip(int mipLevel) override;
+
 		virtual Continue Scheduled_Update() override;
 
 		//
@@ -24,6 +24,14 @@ void CommandBufferVulkan::Init()
 
 void CommandBufferVulkan::Done()
 {
+	if (IsInitialized() && _secondary)
+	{
+		VERUS_QREF_RENDERER_VULKAN;
+		VERUS_FOR(i, BaseRenderer::s_ringBufferSize)
+			VERUS_VULKAN_DESTROY(_commandPools[i], vkDestroyCommandPool(pRendererVulkan->GetVkDevice(), _commandPools[i], pRendererVulkan->GetAllocator()));
+		pRendererVulkan->ReleaseUniformAllocator(_uniformAllocator);
+	}
+
 	VERUS_DONE(CommandBufferVulkan);
 }
 
@@ -54,6 +62,20 @@ void CommandBufferVulkan::DoneOneTimeSubmit()
 	_oneTimeSubmit = false;
 }
 
+void CommandBufferVulkan::InitSecondary()
+{
+	VERUS_INIT();
+	VERUS_QREF_RENDERER_VULKAN;
+
+	_secondary = true;
+	_uniformAllocator = pRendererVulkan->AcquireUniformAllocator();
+	VERUS_FOR(i, BaseRenderer::s_ringBufferSize)
+	{
+		_commandPools[i] = pRendererVulkan->CreateVkCommandPool();
+		_secondaryFrames[i] = UINT64_MAX;
+	}
+}
+
 void CommandBufferVulkan::Begin()
 {
 	VkResult res = VK_SUCCESS;
@@ -71,6 +93,52 @@ void CommandBufferVulkan::End()
 		throw VERUS_RUNTIME_ERROR << "vkEndCommandBuffer(); res=" << res;
 }
 
+void CommandBufferVulkan::BeginSecondary(RPHandle renderPassHandle, int subpass, FBHandle framebufferHandle, ViewportScissorFlags vsf)
+{
+	VERUS_QREF_RENDERER_VULKAN;
+	VERUS_RT_ASSERT(_secondary);
+	VkResult res = VK_SUCCESS;
+
+	// Executed command buffers cannot be recorded again during the same frame, so each begin takes the next one.
+	// Pool is used only by this object, so it can be reset on any thread:
+	const int ringBufferIndex = pRendererVulkan->GetRingBufferIndex();
+	if (_secondaryFrames[ringBufferIndex] != pRendererVulkan->GetRingBufferFrameCount())
+	{
+		if (VK_SUCCESS != (res = vkResetCommandPool(pRendererVulkan->GetVkDevice(), _commandPools[ringBufferIndex], 0)))
+			throw VERUS_RUNTIME_ERROR << "vkResetCommandPool(); res=" << res;
+		_secondaryFrames[ringBufferIndex] = pRendererVulkan->GetRingBufferFrameCount();
+		_usedSecondaryCount = 0;
+	}
+	auto& vCommandBuffers = _vSecondaryCommandBuffers[ringBufferIndex];
+	if (Utils::Cast32(vCommandBuffers.size()) == _usedSecondaryCount)
+		vCommandBuffers.push_back(pRendererVulkan->CreateVkCommandBuffer(_commandPools[ringBufferIndex], true));
+	_commandBuffers[ringBufferIndex] = vCommandBuffers[_usedSecondaryCount++];
+
+	RendererVulkan::RcFramebuffer framebuffer = pRendererVulkan->GetFramebuffer(framebufferHandle);
+	VkCommandBufferInheritanceInfo vkcbii = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+	vkcbii.renderPass = pRendererVulkan->GetRenderPass(renderPassHandle);
+	vkcbii.subpass = subpass;
+	vkcbii.framebuffer = framebuffer._framebuffer;
+	VkCommandBufferBeginInfo vkcbbi = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	vkcbbi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+	vkcbbi.pInheritanceInfo = &vkcbii;
+	if (VK_SUCCESS != (res = vkBeginCommandBuffer(GetVkCommandBuffer(), &vkcbbi)))
+		throw VERUS_RUNTIME_ERROR << "vkBeginCommandBuffer(); res=" << res;
+
+	// Dynamic state is not inherited:
+	SetViewportAndScissor(vsf, framebuffer._width, framebuffer._height);
+}
+
+void CommandBufferVulkan::ExecuteSecondary(const CommandBufferPtr* pCommandBuffers, int count)
+{
+	VERUS_RT_ASSERT(count <= BaseRenderer::s_uniformAllocatorCount);
+	VkCommandBuffer commandBuffers[BaseRenderer::s_uniformAllocatorCount];
+	VERUS_FOR(i, count)
+		commandBuffers[i] = static_cast<RCommandBufferVulkan>(*pCommandBuffers[i]).GetVkCommandBuffer();
+	if (count)
+		vkCmdExecuteCommands(GetVkCommandBuffer(), count, commandBuffers);
+}
+
 void CommandBufferVulkan::PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout oldLayout, ImageLayout newLayout, Range mipLevels, Range arrayLayers)
 {
 	auto& texVulkan = static_cast<RTextureVulkan>(*tex);
@@ -180,7 +248,7 @@ void CommandBufferVulkan::PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout
 		1, &vkimb);
 }
 
-void CommandBufferVulkan::BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle, std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf)
+void CommandBufferVulkan::BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle, std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf, SubpassContents contents)
 {
 	VERUS_QREF_RENDERER_VULKAN;
 
@@ -202,19 +270,31 @@ void CommandBufferVulkan::BeginRenderPass(RPHandle renderPassHandle, FBHandle fr
 	vkrpbi.clearValueCount = count;
 	vkrpbi.pClearValues = clearValues;
 	// There may be a performance cost for using a render area smaller than the framebuffer, unless it matches the render area granularity for the render pass.
-	vkCmdBeginRenderPass(GetVkCommandBuffer(), &vkrpbi, VK_SUBPASS_CONTENTS_INLINE);
+	vkCmdBeginRenderPass(GetVkCommandBuffer(), &vkrpbi, ToNativeSubpassContents(contents));
+
+	_renderPassHandle = renderPassHandle;
+	_framebufferHandle = framebufferHandle;
+	_subpass = 0;
+	_subpassContents = contents;
 
 	SetViewportAndScissor(vsf, framebuffer._width, framebuffer._height);
 }
 
-void CommandBufferVulkan::NextSubpass()
+void CommandBufferVulkan::NextSubpass(SubpassContents contents)
 {
-	vkCmdNextSubpass(GetVkCommandBuffer(), VK_SUBPASS_CONTENTS_INLINE);
+	vkCmdNextSubpass(GetVkCommandBuffer(), ToNativeSubpassContents(contents));
+	_subpass++;
+	_subpassContents = contents;
 }
 
 void CommandBufferVulkan::EndRenderPass()
 {
 	vkCmdEndRenderPass(GetVkCommandBuffer());
+
+	_renderPassHandle = RPHandle();
+	_framebufferHandle = FBHandle();
+	_subpass = 0;
+	_subpassContents = SubpassContents::inlined;
 }
 
 void CommandBufferVulkan::BindPipeline(PipelinePtr pipe)
@@ -300,14 +380,14 @@ void CommandBufferVulkan::BindIndexBuffer(GeometryPtr geo)
 	vkCmdBindIndexBuffer(GetVkCommandBuffer(), buffer, offset, geoVulkan.Has32BitIndices() ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16);
 }
 
-bool CommandBufferVulkan::BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle)
+bool CommandBufferVulkan::BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle, const void* pSrc)
 {
 	auto& shaderVulkan = static_cast<RShaderVulkan>(*shader);
 
-	if (shaderVulkan.TryPushConstants(setNumber, *this))
+	if (shaderVulkan.TryPushConstants(setNumber, *this, pSrc))
 		return true;
 
-	const int offset = shaderVulkan.UpdateUniformBuffer(setNumber);
+	const int offset = shaderVulkan.UpdateUniformBuffer(setNumber, _uniformAllocator, pSrc);
 	if (offset < 0)
 		return false;
 
@@ -87,6 +87,16 @@ VkImageLayout CGI::ToNativeImageLayout(ImageLayout layout)
 	}
 }
 
+VkSubpassContents CGI::ToNativeSubpassContents(SubpassContents contents)
+{
+	switch (contents)
+	{
+	case SubpassContents::inlined:                 return VK_SUBPASS_CONTENTS_INLINE;
+	case SubpassContents::secondaryCommandBuffers: return VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+	default: throw VERUS_RECOVERABLE << "ToNativeSubpassContents()";
+	}
+}
+
 VkShaderStageFlags CGI::ToNativeStageFlags(ShaderStageFlags stageFlags)
 {
 	VkShaderStageFlags ret = 0;
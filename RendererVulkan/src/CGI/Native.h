@@ -17,6 +17,8 @@ namespace verus::CGI
 
 	VkShaderStageFlags ToNativeStageFlags(ShaderStageFlags stageFlags);
 
+	VkSubpassContents ToNativeSubpassContents(SubpassContents contents);
+
 	VkSampleCountFlagBits ToNativeSampleCount(int sampleCount);
 
 	VkFormat ToNativeFormat(Format format);
@@ -142,7 +142,7 @@ void PipelineVulkan::Init(RcPipelineDesc desc)
 	vkgpci.renderPass = pRendererVulkan->GetRenderPass(desc._renderPassHandle);
 	vkgpci.subpass = desc._subpass;
 	vkgpci.basePipelineHandle = VK_NULL_HANDLE;
-	if (VK_SUCCESS != (res = vkCreateGraphicsPipelines(pRendererVulkan->GetVkDevice(), VK_NULL_HANDLE, 1, &vkgpci, pRendererVulkan->GetAllocator(), &_pipeline)))
+	if (VK_SUCCESS != (res = vkCreateGraphicsPipelines(pRendererVulkan->GetVkDevice(), pRendererVulkan->GetVkPipelineCache(), 1, &vkgpci, pRendererVulkan->GetAllocator(), &_pipeline)))
 		throw VERUS_RUNTIME_ERROR << "vkCreateGraphicsPipelines(); res=" << res;
 }
 
@@ -172,7 +172,7 @@ void PipelineVulkan::InitCompute(RcPipelineDesc desc)
 	vkcpci.stage.module = shaderModule;
 	vkcpci.stage.pName = _C(entryName);
 	vkcpci.layout = shader.GetVkPipelineLayout();
-	if (VK_SUCCESS != (res = vkCreateComputePipelines(pRendererVulkan->GetVkDevice(), VK_NULL_HANDLE, 1, &vkcpci, pRendererVulkan->GetAllocator(), &_pipeline)))
+	if (VK_SUCCESS != (res = vkCreateComputePipelines(pRendererVulkan->GetVkDevice(), pRendererVulkan->GetVkPipelineCache(), 1, &vkcpci, pRendererVulkan->GetAllocator(), &_pipeline)))
 		throw VERUS_RUNTIME_ERROR << "vkCreateComputePipelines(); res=" << res;
 }
 
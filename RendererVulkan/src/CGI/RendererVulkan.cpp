@@ -81,6 +81,7 @@ void RendererVulkan::Init()
 	CreateCommandPools();
 	CreateSyncObjects();
 	CreateSamplers();
+	CreatePipelineCache();
 
 	if (_extReality.IsInitialized())
 		_extReality.InitByRenderer(this);
@@ -119,6 +120,9 @@ void RendererVulkan::Done()
 	_vSwapChainImages.clear();
 	VERUS_VULKAN_DESTROY(_swapChain, vkDestroySwapchainKHR(_device, _swapChain, GetAllocator()));
 
+	SavePipelineCache();
+	VERUS_VULKAN_DESTROY(_pipelineCache, vkDestroyPipelineCache(_device, _pipelineCache, GetAllocator()));
+
 	VERUS_VULKAN_DESTROY(_vmaAllocator, vmaDestroyAllocator(_vmaAllocator));
 	VERUS_VULKAN_DESTROY(_device, vkDestroyDevice(_device, GetAllocator()));
 	VERUS_VULKAN_DESTROY(_surface, vkDestroySurfaceKHR(_instance, _surface, GetAllocator()));
@@ -158,6 +162,18 @@ void RendererVulkan::VulkanCompilerDone()
 #endif
 }
 
+CSZ RendererVulkan::VulkanCompilerVersion()
+{
+#ifdef _WIN32
+	PFNVULKANCOMPILERVERSION VulkanCompilerVersion = reinterpret_cast<PFNVULKANCOMPILERVERSION>(
+		GetProcAddress(LoadLibraryA("VulkanShaderCompiler.dll"), "VulkanCompilerVersion"));
+#else
+	PFNVULKANCOMPILERVERSION VulkanCompilerVersion = reinterpret_cast<PFNVULKANCOMPILERVERSION>(
+		dlsym(dlopen("./libVulkanShaderCompiler.so", RTLD_LAZY), "VulkanCompilerVersion"));
+#endif
+	return VulkanCompilerVersion ? VulkanCompilerVersion() : "";
+}
+
 bool RendererVulkan::VulkanCompile(CSZ source, CSZ sourceName, CSZ* defines, BaseShaderInclude* pInclude,
 	CSZ entryPoint, CSZ target, UINT32 flags, UINT32** ppCode, UINT32* pSize, CSZ* ppErrorMsgs)
 {
@@ -580,14 +596,8 @@ void RendererVulkan::CreateImageViews()
 
 void RendererVulkan::CreateCommandPools()
 {
-	VkResult res = VK_SUCCESS;
 	VERUS_FOR(i, s_ringBufferSize)
-	{
-		VkCommandPoolCreateInfo vkcpci = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
-		vkcpci.queueFamilyIndex = _queueFamilyIndices._graphicsFamilyIndex;
-		if (VK_SUCCESS != (res = vkCreateCommandPool(_device, &vkcpci, GetAllocator(), &_commandPools[i])))
-			throw VERUS_RUNTIME_ERROR << "vkCreateCommandPool(); res=" << res;
-	}
+		_commandPools[i] = CreateVkCommandPool();
 }
 
 void RendererVulkan::CreateSyncObjects()
@@ -721,12 +731,109 @@ void RendererVulkan::CreateSamplers()
 	// </Clamp>
 }
 
-VkCommandBuffer RendererVulkan::CreateVkCommandBuffer(VkCommandPool commandPool)
+void RendererVulkan::CreatePipelineCache()
+{
+	VkResult res = VK_SUCCESS;
+
+	// Reuse data from the previous run, but only if it was created by the same device and driver:
+	Vector<BYTE> vData;
+	IO::File file;
+	if (file.Open(_C(GetPipelineCachePathname())))
+	{
+		const INT64 size = file.GetSize();
+		if (size > 0)
+		{
+			vData.resize(size);
+			if (file.Read(vData.data(), size) != size)
+				vData.clear();
+		}
+		file.Close();
+	}
+	if (!vData.empty() && !IsPipelineCacheDataCompatible(vData))
+	{
+		VERUS_LOG_INFO("Pipeline cache is not compatible with this device, it will be rebuilt");
+		vData.clear();
+	}
+
+	VkPipelineCacheCreateInfo vkpcci = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+	vkpcci.initialDataSize = vData.size();
+	vkpcci.pInitialData = vData.empty() ? nullptr : vData.data();
+	if (VK_SUCCESS != (res = vkCreatePipelineCache(_device, &vkpcci, GetAllocator(), &_pipelineCache)))
+		throw VERUS_RUNTIME_ERROR << "vkCreatePipelineCache(); res=" << res;
+	VERUS_LOG_INFO("Pipeline cache loaded: " << vData.size() << " bytes");
+}
+
+bool RendererVulkan::IsPipelineCacheDataCompatible(const Vector<BYTE>& vData) const
+{
+	// See VkPipelineCacheHeaderVersionOne:
+	struct Header
+	{
+		UINT32 _headerSize;
+		UINT32 _headerVersion;
+		UINT32 _vendorID;
+		UINT32 _deviceID;
+		BYTE   _pipelineCacheUUID[VK_UUID_SIZE];
+	};
+	VERUS_CT_ASSERT(sizeof(Header) == 32);
+
+	if (vData.size() < sizeof(Header))
+		return false;
+	Header header;
+	memcpy(&header, vData.data(), sizeof(Header));
+
+	VkPhysicalDeviceProperties vkpdp = {};
+	vkGetPhysicalDeviceProperties(_physicalDevice, &vkpdp);
+	return
+		header._headerSize >= sizeof(Header) &&
+		header._headerSize <= vData.size() &&
+		header._headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+		header._vendorID == vkpdp.vendorID &&
+		header._deviceID == vkpdp.deviceID &&
+		!memcmp(header._pipelineCacheUUID, vkpdp.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+void RendererVulkan::SavePipelineCache()
+{
+	if (VK_NULL_HANDLE == _pipelineCache)
+		return;
+
+	size_t size = 0;
+	if (VK_SUCCESS != vkGetPipelineCacheData(_device, _pipelineCache, &size, nullptr) || !size)
+		return;
+	Vector<BYTE> vData(size);
+	if (VK_SUCCESS != vkGetPipelineCacheData(_device, _pipelineCache, &size, vData.data()))
+		return;
+
+	IO::File file;
+	if (file.Open(_C(GetPipelineCachePathname()), "wb"))
+	{
+		file.Write(vData.data(), size);
+		VERUS_LOG_INFO("Pipeline cache saved: " << size << " bytes");
+	}
+}
+
+String RendererVulkan::GetPipelineCachePathname()
+{
+	return String(_C(Utils::I().GetWritablePath())) + "PipelineCache.vk";
+}
+
+VkCommandPool RendererVulkan::CreateVkCommandPool()
+{
+	VkResult res = VK_SUCCESS;
+	VkCommandPoolCreateInfo vkcpci = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+	vkcpci.queueFamilyIndex = _queueFamilyIndices._graphicsFamilyIndex;
+	VkCommandPool commandPool = VK_NULL_HANDLE;
+	if (VK_SUCCESS != (res = vkCreateCommandPool(_device, &vkcpci, GetAllocator(), &commandPool)))
+		throw VERUS_RUNTIME_ERROR << "vkCreateCommandPool(); res=" << res;
+	return commandPool;
+}
+
+VkCommandBuffer RendererVulkan::CreateVkCommandBuffer(VkCommandPool commandPool, bool secondary)
 {
 	VkResult res = VK_SUCCESS;
 	VkCommandBufferAllocateInfo vkcbai = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
 	vkcbai.commandPool = commandPool;
-	vkcbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	vkcbai.level = secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 	vkcbai.commandBufferCount = 1;
 	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 	if (VK_SUCCESS != (res = vkAllocateCommandBuffers(_device, &vkcbai, &commandBuffer)))
@@ -784,7 +891,7 @@ void RendererVulkan::ImGuiInit(RPHandle renderPassHandle)
 	info.Device = _device;
 	info.QueueFamily = _queueFamilyIndices._graphicsFamilyIndex;
 	info.Queue = _graphicsQueue;
-	info.PipelineCache = nullptr;
+	info.PipelineCache = _pipelineCache;
 	info.DescriptorPool = _descriptorPoolImGui;
 	info.Allocator = GetAllocator();
 	info.MinImageCount = (settings._displayVSync && !settings._openXR) ? 3 : 2;
@@ -803,6 +910,7 @@ void RendererVulkan::ImGuiRenderDrawData()
 {
 	VERUS_QREF_RENDERER;
 	renderer.UpdateUtilization();
+	D::Profiler::I().DrawOverlay();
 	ImGui::Render();
 	VkCommandBuffer commandBuffer = static_cast<CommandBufferVulkan*>(renderer.GetCommandBuffer().Get())->GetVkCommandBuffer();
 	if (ImGui::GetDrawData())
@@ -897,6 +1005,7 @@ void RendererVulkan::EndFrame()
 	if (VK_SUCCESS != (res = vkQueueSubmit(_graphicsQueue, 1, &vksi, _queueSubmitFences[_ringBufferIndex])))
 		throw VERUS_RUNTIME_ERROR << "vkQueueSubmit(); res=" << res;
 	_ringBufferIndex = (_ringBufferIndex + 1) % s_ringBufferSize;
+	_ringBufferFrameCount++;
 	// </QueueSubmit>
 
 	// <Present>
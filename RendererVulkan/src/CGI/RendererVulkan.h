@@ -82,6 +82,7 @@ namespace verus::CGI
 		VkFence                  _queueSubmitFences[s_ringBufferSize] = {};
 		QueueFamilyIndices       _queueFamilyIndices;
 		VkDescriptorPool         _descriptorPoolImGui = VK_NULL_HANDLE;
+		VkPipelineCache          _pipelineCache = VK_NULL_HANDLE;
 		Vector<VkSampler>        _vSamplers;
 		Vector<VkRenderPass>     _vRenderPasses;
 		Vector<Framebuffer>      _vFramebuffers;
@@ -98,6 +99,7 @@ namespace verus::CGI
 
 		static void VulkanCompilerInit();
 		static void VulkanCompilerDone();
+		static CSZ VulkanCompilerVersion();
 		static bool VulkanCompile(CSZ source, CSZ sourceName, CSZ* defines, BaseShaderInclude* pInclude,
 			CSZ entryPoint, CSZ target, UINT32 flags, UINT32** ppCode, UINT32* pSize, CSZ* ppErrorMsgs);
 
@@ -124,10 +126,15 @@ namespace verus::CGI
 		void CreateCommandPools();
 		void CreateSyncObjects();
 		void CreateSamplers();
+		void CreatePipelineCache();
+		bool IsPipelineCacheDataCompatible(const Vector<BYTE>& vData) const;
+		void SavePipelineCache();
+		static String GetPipelineCachePathname();
 
 	public:
 		// <CreateAndGet>
-		VkCommandBuffer CreateVkCommandBuffer(VkCommandPool commandPool);
+		VkCommandPool CreateVkCommandPool();
+		VkCommandBuffer CreateVkCommandBuffer(VkCommandPool commandPool, bool secondary = false);
 
 		VkInstance GetVkInstance() const { return _instance; }
 		VkPhysicalDevice GetVkPhysicalDevice() const { return _physicalDevice; }
@@ -137,6 +144,8 @@ namespace verus::CGI
 		const VkAllocationCallbacks* GetAllocator() const { return nullptr; }
 		VmaAllocator GetVmaAllocator() const { return _vmaAllocator; }
 		VkCommandPool GetVkCommandPool(int ringBufferIndex) const { return _commandPools[ringBufferIndex]; }
+		// Pipeline cache is thread-safe, pipelines can be created on multiple threads.
+		VkPipelineCache GetVkPipelineCache() const { return _pipelineCache; }
 		const VkSampler* GetImmutableSampler(Sampler s) const;
 		// </CreateAndGet>
 
@@ -159,6 +168,8 @@ namespace verus::CGI
 		virtual void OnMinimized() override;
 		// </FrameCycle>
 
+		virtual bool IsParallelRecordingSupported() const override { return true; }
+
 		// <Resources>
 		virtual PBaseCommandBuffer InsertCommandBuffer() override;
 		virtual PBaseGeometry      InsertGeometry() override;
@@ -214,6 +225,7 @@ namespace verus::CGI
 	{
 		typedef void(*PFNVULKANCOMPILERINIT)();
 		typedef void(*PFNVULKANCOMPILERDONE)();
+		typedef CSZ(*PFNVULKANCOMPILERVERSION)();
 		typedef bool(*PFNVULKANCOMPILE)(CSZ source, CSZ sourceName, CSZ* defines, CGI::BaseShaderInclude* pInclude,
 			CSZ entryPoint, CSZ target, UINT32 flags, UINT32** ppCode, UINT32* pSize, CSZ* ppErrorMsgs);
 	}
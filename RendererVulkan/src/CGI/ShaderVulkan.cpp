@@ -6,11 +6,13 @@ using namespace verus::CGI;
 
 struct ShaderInclude : BaseShaderInclude
 {
+	PShaderCache                 _pCache = nullptr;
+	Vector<ShaderCache::Include> _vIncludes;
+
 	virtual void Open(CSZ filename, void** ppData, UINT32* pBytes) override
 	{
-		const String url = String("[Shaders]:") + filename;
 		Vector<BYTE> vData;
-		IO::FileSystem::LoadResource(_C(url), vData);
+		_pCache->LoadInclude(filename, vData, _vIncludes);
 		char* p = new char[vData.size()];
 		memcpy(p, vData.data(), vData.size());
 		*pBytes = Utils::Cast32(vData.size());
@@ -40,34 +42,32 @@ void ShaderVulkan::Init(CSZ source, CSZ sourceName, CSZ* branches)
 	VERUS_QREF_CONST_SETTINGS;
 
 	_sourceName = sourceName;
-	ShaderInclude inc;
 #ifdef _DEBUG
 	const UINT32 flags = 1;
 #else
 	const UINT32 flags = 0;
 #endif
-	UINT32* pCode = nullptr;
-	UINT32 size = 0;
-	CSZ pErrorMsgs = nullptr;
+	CSZ stageTargets[] = { "vs", "hs", "ds", "gs", "fs", "cs" };
+	VERUS_CT_ASSERT(VERUS_COUNT_OF(stageTargets) == +Stage::count);
 
-	auto CheckErrorMsgs = [this](CSZ pErrorMsgs)
+	// One job compiles one stage of one branch:
+	struct Job
 	{
-		if (pErrorMsgs)
-			OnError(pErrorMsgs);
+		String         _branch;
+		String         _entry;
+		Vector<String> _vDefines; // Name-value pairs.
+		Vector<BYTE>   _vCode;
+		String         _errorMsgs;
+		Stage          _stage = Stage::vs;
 	};
+	Vector<Job> vJobs;
 
-	auto CreateShaderModule = [](const UINT32* pCode, UINT32 size, VkShaderModule& shaderModule)
-	{
-		if (!pCode || !size)
-			return;
-		VERUS_QREF_RENDERER_VULKAN;
-		VkResult res = VK_SUCCESS;
-		VkShaderModuleCreateInfo vksmci = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
-		vksmci.codeSize = size;
-		vksmci.pCode = pCode;
-		if (VK_SUCCESS != (res = vkCreateShaderModule(pRendererVulkan->GetVkDevice(), &vksmci, pRendererVulkan->GetAllocator(), &shaderModule)))
-			throw VERUS_RUNTIME_ERROR << "vkCreateShaderModule(); res=" << res;
-	};
+	// <System defines>
+	Vector<String> vSystemDefines;
+	GetSystemDefines(settings, vSystemDefines);
+	vSystemDefines.push_back("_VULKAN");
+	vSystemDefines.push_back("1");
+	// </System defines>
 
 	while (*branches)
 	{
@@ -82,117 +82,103 @@ void ShaderVulkan::Init(CSZ source, CSZ sourceName, CSZ* branches)
 			continue;
 		}
 
-		// <User defines>
-		Vector<CSZ> vDefines;
-		vDefines.reserve(40);
-		const int count = Utils::Cast32(vMacroName.size());
-		VERUS_FOR(i, count)
-		{
-			vDefines.push_back(_C(vMacroName[i]));
-			vDefines.push_back(_C(vMacroValue[i]));
-		}
-		// </User defines>
-
-		// <System defines>
-		char defAnisotropyLevel[64] = {};
-		{
-			sprintf_s(defAnisotropyLevel, "%d", settings._gpuAnisotropyLevel);
-			vDefines.push_back("_ANISOTROPY_LEVEL");
-			vDefines.push_back(defAnisotropyLevel);
-		}
-		char defShaderQuality[64] = {};
-		{
-			sprintf_s(defShaderQuality, "%d", settings._gpuShaderQuality);
-			vDefines.push_back("_SHADER_QUALITY");
-			vDefines.push_back(defShaderQuality);
-		}
-		char defShadowQuality[64] = {};
-		{
-			sprintf_s(defShadowQuality, "%d", settings._sceneShadowQuality);
-			vDefines.push_back("_SHADOW_QUALITY");
-			vDefines.push_back(defShadowQuality);
-		}
-		char defWaterQuality[64] = {};
-		{
-			sprintf_s(defWaterQuality, "%d", settings._sceneWaterQuality);
-			vDefines.push_back("_WATER_QUALITY");
-			vDefines.push_back(defWaterQuality);
-		}
-		char defMaxNumBones[64] = {};
-		{
-			sprintf_s(defMaxNumBones, "%d", VERUS_MAX_BONES);
-			vDefines.push_back("VERUS_MAX_BONES");
-			vDefines.push_back(defMaxNumBones);
-		}
-		vDefines.push_back("_VULKAN");
-		vDefines.push_back("1");
-		const int typeIndex = Utils::Cast32(vDefines.size());
-		vDefines.push_back("_XS");
-		vDefines.push_back("1");
-		vDefines.push_back(nullptr);
-		// </System defines>
-
 		Compiled compiled;
 		compiled._entry = entry;
 
-		if (strchr(_C(stages), 'V'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex] = "_VS";
-			if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::vs]), "vs", flags, &pCode, &size, &pErrorMsgs))
-				CheckErrorMsgs(pErrorMsgs);
-			CreateShaderModule(pCode, size, compiled._shaderModules[+Stage::vs]);
-		}
-
-		if (strchr(_C(stages), 'H'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex] = "_HS";
-			if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::hs]), "hs", flags, &pCode, &size, &pErrorMsgs))
-				CheckErrorMsgs(pErrorMsgs);
-			CreateShaderModule(pCode, size, compiled._shaderModules[+Stage::hs]);
-		}
-
-		if (strchr(_C(stages), 'D'))
+		VERUS_FOR(i, +Stage::count)
 		{
+			if (!strchr(_C(stages), GetStageLetter(static_cast<Stage>(i))))
+				continue;
 			compiled._stageCount++;
-			vDefines[typeIndex] = "_DS";
-			if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::ds]), "ds", flags, &pCode, &size, &pErrorMsgs))
-				CheckErrorMsgs(pErrorMsgs);
-			CreateShaderModule(pCode, size, compiled._shaderModules[+Stage::ds]);
+			if (Stage::cs == static_cast<Stage>(i))
+				_compute = true;
+
+			Job job;
+			job._branch = branch;
+			job._entry = stageEntries[i];
+			job._stage = static_cast<Stage>(i);
+			job._vDefines.reserve(vMacroName.size() * 2 + vSystemDefines.size() + 2);
+			const int count = Utils::Cast32(vMacroName.size());
+			VERUS_FOR(j, count)
+			{
+				job._vDefines.push_back(vMacroName[j]);
+				job._vDefines.push_back(vMacroValue[j]);
+			}
+			job._vDefines.insert(job._vDefines.end(), vSystemDefines.begin(), vSystemDefines.end());
+			job._vDefines.push_back(GetStageDefine(static_cast<Stage>(i)));
+			job._vDefines.push_back("1");
+			vJobs.push_back(std::move(job));
 		}
 
-		if (strchr(_C(stages), 'G'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex] = "_GS";
-			if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::gs]), "gs", flags, &pCode, &size, &pErrorMsgs))
-				CheckErrorMsgs(pErrorMsgs);
-			CreateShaderModule(pCode, size, compiled._shaderModules[+Stage::gs]);
-		}
+		_mapCompiled[branch] = compiled;
 
-		if (strchr(_C(stages), 'F'))
-		{
-			compiled._stageCount++;
-			vDefines[typeIndex] = "_FS";
-			if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::fs]), "fs", flags, &pCode, &size, &pErrorMsgs))
-				CheckErrorMsgs(pErrorMsgs);
-			CreateShaderModule(pCode, size, compiled._shaderModules[+Stage::fs]);
-		}
+		branches++;
+	}
 
-		if (strchr(_C(stages), 'C'))
+	// Cached stages are loaded, the rest are compiled in parallel (compiler's state is thread-local):
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	ShaderCache cache(RendererVulkan::VulkanCompilerVersion(), "spv");
+	const int jobCount = Utils::Cast32(vJobs.size());
+	std::exception_ptr pException;
+	std::mutex mutex;
+	if (jobCount > 0)
+	{
+		VERUS_P_FOR(i, jobCount)
 		{
-			compiled._stageCount++;
-			vDefines[typeIndex] = "_CS";
-			if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(stageEntries[+Stage::cs]), "cs", flags, &pCode, &size, &pErrorMsgs))
-				CheckErrorMsgs(pErrorMsgs);
-			CreateShaderModule(pCode, size, compiled._shaderModules[+Stage::cs]);
-			_compute = true;
-		}
+			try
+			{
+				Job& job = vJobs[i];
+
+				const String params = ShaderCache::GetParams(_C(job._entry), stageTargets[+job._stage], flags, job._vDefines);
+				const String key = cache.GetKey(source, sourceName, params);
+				if (cache.Load(key, job._vCode))
+					return;
+
+				Vector<CSZ> vDefines;
+				vDefines.reserve(job._vDefines.size() + 1);
+				for (const auto& x : job._vDefines)
+					vDefines.push_back(_C(x));
+				vDefines.push_back(nullptr);
+
+				ShaderInclude inc;
+				inc._pCache = &cache;
+				UINT32* pCode = nullptr;
+				UINT32 size = 0;
+				CSZ pErrorMsgs = nullptr;
+				if (!RendererVulkan::VulkanCompile(source, sourceName, vDefines.data(), &inc, _C(job._entry), stageTargets[+job._stage], flags, &pCode, &size, &pErrorMsgs))
+				{
+					if (pErrorMsgs)
+						job._errorMsgs = pErrorMsgs;
+				}
+				if (pCode && size)
+				{
+					// Code is owned by compiler, copy it before the next call:
+					const BYTE* p = reinterpret_cast<const BYTE*>(pCode);
+					job._vCode.assign(p, p + size);
+					cache.Save(key, inc._vIncludes, pCode, size);
+				}
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!pException)
+					pException = std::current_exception();
+			}
+		});
+	}
+	if (pException)
+		std::rethrow_exception(pException);
+	const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
 
-		_mapCompiled[branch] = compiled;
+	const ShaderCache::Stats stats = cache.GetStats();
+	VERUS_LOG_INFO("Init(); source=" << sourceName << ", stages=" << jobCount << ", cached=" << stats._hitCount
+		<< ", time=" << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << " ms");
 
-		branches++;
+	for (auto& job : vJobs)
+	{
+		if (!job._errorMsgs.empty())
+			OnError(_C(job._errorMsgs));
+		CreateShaderModule(job._vCode, _mapCompiled[job._branch]._shaderModules[+job._stage]);
 	}
 
 	_vDescriptorSetDesc.reserve(8);
@@ -204,6 +190,7 @@ void ShaderVulkan::Done()
 {
 	VERUS_QREF_RENDERER_VULKAN;
 
+	pRendererVulkan->UnscheduleUniformBufferGrowth(this);
 	VERUS_VULKAN_DESTROY(_pipelineLayout, vkDestroyPipelineLayout(pRendererVulkan->GetVkDevice(), _pipelineLayout, pRendererVulkan->GetAllocator()));
 	_descriptors.Done();
 	for (auto& x : _vDescriptorSetDesc)
@@ -239,6 +226,7 @@ void ShaderVulkan::CreateDescriptorSet(int setNumber, const void* pSrc, int size
 	dsd._capacity = capacity;
 	dsd._capacityInBytes = dsd._alignedSize * dsd._capacity;
 	dsd._stageFlags = ToNativeStageFlags(stageFlags);
+	dsd._vUniformBlocks.resize(BaseRenderer::s_uniformAllocatorCount);
 
 	if (capacity > 0)
 	{
@@ -405,6 +393,7 @@ CSHandle ShaderVulkan::BindDescriptorSetTextures(int setNumber, std::initializer
 	{
 		complexSetHandle = Utils::Cast32(_vComplexDescriptorSets.size());
 		_vComplexDescriptorSets.resize(complexSetHandle + 1);
+		_vComplexSetNumbers.resize(complexSetHandle + 1);
 	}
 	// </NewComplexSetHandle>
 
@@ -447,6 +436,7 @@ CSHandle ShaderVulkan::BindDescriptorSetTextures(int setNumber, std::initializer
 		index++;
 	}
 	_vComplexDescriptorSets[complexSetHandle] = _descriptors.EndAllocateSet();
+	_vComplexSetNumbers[complexSetHandle] = setNumber;
 
 	return CSHandle::Make(complexSetHandle);
 }
@@ -467,12 +457,11 @@ void ShaderVulkan::FreeDescriptorSet(CSHandle& complexSetHandle)
 
 void ShaderVulkan::BeginBindDescriptors()
 {
-	VERUS_QREF_RENDERER;
 	VERUS_QREF_RENDERER_VULKAN;
 	VkResult res = VK_SUCCESS;
 
-	const bool resetOffset = _currentFrame != renderer.GetFrameCount();
-	_currentFrame = renderer.GetFrameCount();
+	const bool resetOffset = _currentFrame != pRendererVulkan->GetRingBufferFrameCount();
+	_currentFrame = pRendererVulkan->GetRingBufferFrameCount();
 
 	for (auto& dsd : _vDescriptorSetDesc)
 	{
@@ -485,7 +474,16 @@ void ShaderVulkan::BeginBindDescriptors()
 		dsd._pMappedData = static_cast<BYTE*>(pData);
 		dsd._pMappedData += dsd._capacityInBytes * pRendererVulkan->GetRingBufferIndex(); // Adjust address for this frame.
 		if (resetOffset)
+		{
 			dsd._offset = 0;
+			dsd._skippedCount = 0;
+			for (auto& block : dsd._vUniformBlocks)
+			{
+				const int used = block._used;
+				block = UniformBlock();
+				block._prevUsed = used;
+			}
+		}
 	}
 }
 
@@ -503,6 +501,15 @@ void ShaderVulkan::EndBindDescriptors()
 	}
 }
 
+void ShaderVulkan::GrowUniformBuffers()
+{
+	VERUS_FOR(i, _vDescriptorSetDesc.size())
+	{
+		if (_vDescriptorSetDesc[i]._full)
+			GrowUniformBuffer(i);
+	}
+}
+
 void ShaderVulkan::CreateDescriptorSets()
 {
 	VERUS_QREF_RENDERER_VULKAN;
@@ -531,35 +538,117 @@ VkDescriptorSet ShaderVulkan::GetComplexVkDescriptorSet(CSHandle descSetID) cons
 	return _vComplexDescriptorSets[descSetID.Get()];
 }
 
-bool ShaderVulkan::TryPushConstants(int setNumber, RBaseCommandBuffer cb) const
+bool ShaderVulkan::TryPushConstants(int setNumber, RBaseCommandBuffer cb, const void* pSrc) const
 {
 	auto& dsd = _vDescriptorSetDesc[setNumber];
 	if (!dsd._capacity)
 	{
 		auto& cbVulkan = static_cast<RCommandBufferVulkan>(cb);
-		vkCmdPushConstants(cbVulkan.GetVkCommandBuffer(), _pipelineLayout, dsd._stageFlags, 0, dsd._size, dsd._pSrc);
+		vkCmdPushConstants(cbVulkan.GetVkCommandBuffer(), _pipelineLayout, dsd._stageFlags, 0, dsd._size, pSrc ? pSrc : dsd._pSrc);
 		return true;
 	}
 	return false;
 }
 
-int ShaderVulkan::UpdateUniformBuffer(int setNumber)
+int ShaderVulkan::UpdateUniformBuffer(int setNumber, int allocator, const void* pSrc)
 {
 	VERUS_QREF_RENDERER_VULKAN;
 
 	auto& dsd = _vDescriptorSetDesc[setNumber];
+	auto& block = dsd._vUniformBlocks[allocator];
+	if (block._offset + dsd._alignedSize > block._end && !ClaimUniformBlock(dsd, block))
+		return -1;
+
+	VERUS_RT_ASSERT(dsd._pMappedData);
+	const int ret = dsd._capacityInBytes * pRendererVulkan->GetRingBufferIndex() + block._offset;
+	memcpy(dsd._pMappedData + block._offset, pSrc ? pSrc : dsd._pSrc, dsd._size);
+	block._offset += dsd._alignedSize;
+	block._used += dsd._alignedSize;
+	return ret;
+}
+
+void ShaderVulkan::CreateShaderModule(const Vector<BYTE>& vCode, VkShaderModule& shaderModule)
+{
+	if (vCode.empty())
+		return;
+	VERUS_QREF_RENDERER_VULKAN;
+	VkResult res = VK_SUCCESS;
+	VkShaderModuleCreateInfo vksmci = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+	vksmci.codeSize = vCode.size();
+	vksmci.pCode = reinterpret_cast<const UINT32*>(vCode.data());
+	if (VK_SUCCESS != (res = vkCreateShaderModule(pRendererVulkan->GetVkDevice(), &vksmci, pRendererVulkan->GetAllocator(), &shaderModule)))
+		throw VERUS_RUNTIME_ERROR << "vkCreateShaderModule(); res=" << res;
+}
+
+bool ShaderVulkan::ClaimUniformBlock(DescriptorSetDesc& dsd, UniformBlock& block)
+{
+	VERUS_QREF_RENDERER_VULKAN;
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	if (dsd._offset + dsd._alignedSize > dsd._capacityInBytes)
 	{
-		VERUS_RT_FAIL("UniformBuffer is full.");
-		return -1;
+		if (!dsd._full)
+		{
+			dsd._full = true;
+			pRendererVulkan->ScheduleUniformBufferGrowth(this);
+			VERUS_LOG_WARN("UniformBuffer is full, bindings are skipped until it grows at the beginning of the next frame (capacity=" << dsd._capacity << ", " << _sourceName << ").");
+		}
+		dsd._skippedCount++;
+		return false;
 	}
 
-	VERUS_RT_ASSERT(dsd._pMappedData);
-	const int ret = dsd._capacityInBytes * pRendererVulkan->GetRingBufferIndex() + dsd._offset;
-	memcpy(dsd._pMappedData + dsd._offset, dsd._pSrc, dsd._size);
-	dsd._offset += dsd._alignedSize;
+	// Block gets what this allocator used during the previous frame, so that other allocators don't run out of space:
+	const int blockSize = Math::Max(block._prevUsed - block._used, dsd._alignedSize);
+	block._offset = dsd._offset;
+	block._end = Math::Min(dsd._offset + blockSize, dsd._capacityInBytes);
+	dsd._offset = block._end;
 	dsd._peakLoad = Math::Max(dsd._peakLoad, dsd._offset);
-	return ret;
+	return true;
+}
+
+void ShaderVulkan::GrowUniformBuffer(int setNumber)
+{
+	VERUS_QREF_RENDERER_VULKAN;
+
+	auto& dsd = _vDescriptorSetDesc[setNumber];
+	VERUS_RT_ASSERT(!dsd._pMappedData);
+
+	// GPU is idle, see BaseRenderer::GrowUniformBuffers():
+	VERUS_VULKAN_DESTROY(dsd._buffer, vmaDestroyBuffer(pRendererVulkan->GetVmaAllocator(), dsd._buffer, dsd._vmaAllocation));
+
+	dsd._capacity = Math::Max(dsd._capacity * 2, dsd._capacity + dsd._skippedCount);
+	dsd._capacityInBytes = dsd._alignedSize * dsd._capacity;
+	dsd._full = false;
+	const VkDeviceSize bufferSize = dsd._capacityInBytes * BaseRenderer::s_ringBufferSize;
+	pRendererVulkan->CreateBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, HostAccess::sequentialWrite,
+		dsd._buffer, dsd._vmaAllocation);
+
+	// Point existing descriptor sets to the new buffer:
+	VkDescriptorBufferInfo vkdbi = {};
+	vkdbi.buffer = dsd._buffer;
+	vkdbi.range = dsd._size;
+	Vector<VkWriteDescriptorSet> vWriteSets;
+	auto AddWriteSet = [&vWriteSets, &vkdbi](VkDescriptorSet descriptorSet)
+	{
+		VkWriteDescriptorSet vkwds = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+		vkwds.dstSet = descriptorSet;
+		vkwds.dstBinding = 0;
+		vkwds.descriptorCount = 1;
+		vkwds.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		vkwds.pBufferInfo = &vkdbi;
+		vWriteSets.push_back(vkwds);
+	};
+	if (dsd._descriptorSet != VK_NULL_HANDLE)
+		AddWriteSet(dsd._descriptorSet);
+	VERUS_FOR(i, _vComplexDescriptorSets.size())
+	{
+		if (_vComplexSetNumbers[i] == setNumber && _vComplexDescriptorSets[i] != VK_NULL_HANDLE)
+			AddWriteSet(_vComplexDescriptorSets[i]);
+	}
+	if (!vWriteSets.empty())
+		vkUpdateDescriptorSets(pRendererVulkan->GetVkDevice(), Utils::Cast32(vWriteSets.size()), vWriteSets.data(), 0, nullptr);
+
+	VERUS_LOG_INFO("UniformBuffer grew (capacity=" << dsd._capacity << ", skipped=" << dsd._skippedCount << ", set=" << setNumber << ", " << _sourceName << ").");
 }
 
 void ShaderVulkan::OnError(CSZ s) const
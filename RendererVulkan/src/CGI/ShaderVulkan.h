@@ -17,9 +17,19 @@ namespace verus::CGI
 	private:
 		typedef Map<String, Compiled> TMapCompiled;
 
+		// Part of the uniform buffer, which is filled by one uniform allocator without locking.
+		struct UniformBlock
+		{
+			int _offset = 0;
+			int _end = 0;
+			int _used = 0; // During this frame.
+			int _prevUsed = 0; // During the previous frame, next blocks are sized by it.
+		};
+
 		struct DescriptorSetDesc
 		{
-			Vector<Sampler>    _vSamplers;
+			Vector<Sampler>      _vSamplers;
+			Vector<UniformBlock> _vUniformBlocks; // For each uniform allocator.
 			VkBuffer           _buffer = VK_NULL_HANDLE;
 			VmaAllocation      _vmaAllocation = VK_NULL_HANDLE;
 			VkDescriptorSet    _descriptorSet = VK_NULL_HANDLE;
@@ -31,15 +41,19 @@ namespace verus::CGI
 			int                _capacityInBytes = 0;
 			int                _offset = 0;
 			int                _peakLoad = 0;
+			int                _skippedCount = 0; // Bindings, which didn't fit.
 			VkShaderStageFlags _stageFlags = 0;
+			bool               _full = false; // Grow at the beginning of the next frame.
 		};
 
 		TMapCompiled              _mapCompiled;
 		Vector<DescriptorSetDesc> _vDescriptorSetDesc;
 		Vector<VkDescriptorSet>   _vComplexDescriptorSets;
+		Vector<int>               _vComplexSetNumbers;
 		Descriptors               _descriptors;
 		VkPipelineLayout          _pipelineLayout = VK_NULL_HANDLE;
 		String                    _debugInfo;
+		std::mutex                _mutex;
 		UINT64                    _currentFrame = UINT64_MAX;
 		bool                      _compute = false;
 
@@ -58,6 +72,8 @@ namespace verus::CGI
 		virtual void BeginBindDescriptors() override;
 		virtual void EndBindDescriptors() override;
 
+		virtual void GrowUniformBuffers() override;
+
 		//
 		// Vulkan
 		//
@@ -70,14 +86,19 @@ namespace verus::CGI
 
 		VkPipelineLayout GetVkPipelineLayout() const { return _pipelineLayout; }
 
-		bool TryPushConstants(int setNumber, RBaseCommandBuffer cb) const;
-		int UpdateUniformBuffer(int setNumber);
+		bool TryPushConstants(int setNumber, RBaseCommandBuffer cb, const void* pSrc = nullptr) const;
+		// Thread-safe, if each thread uses its own uniform allocator. Returns -1 if the buffer is full.
+		int UpdateUniformBuffer(int setNumber, int allocator = 0, const void* pSrc = nullptr);
 
 		bool IsCompute() const { return _compute; }
 
 		void OnError(CSZ s) const;
 
 		void UpdateUtilization() const;
+
+		VERUS_P(static void CreateShaderModule(const Vector<BYTE>& vCode, VkShaderModule& shaderModule));
+		VERUS_P(bool ClaimUniformBlock(DescriptorSetDesc& dsd, UniformBlock& block));
+		VERUS_P(void GrowUniformBuffer(int setNumber));
 	};
 	VERUS_TYPEDEFS(ShaderVulkan);
 }
@@ -211,6 +211,9 @@ void TextureVulkan::Done()
 		VERUS_VULKAN_DESTROY(_imageViewForFramebuffer[i], vkDestroyImageView(pRendererVulkan->GetVkDevice(), _imageViewForFramebuffer[i], pRendererVulkan->GetAllocator()));
 	VERUS_VULKAN_DESTROY(_imageView, vkDestroyImageView(pRendererVulkan->GetVkDevice(), _imageView, pRendererVulkan->GetAllocator()));
 
+	for (auto view : _vOldImageViews)
+		VERUS_VULKAN_DESTROY(view, vkDestroyImageView(pRendererVulkan->GetVkDevice(), view, pRendererVulkan->GetAllocator()));
+	_vOldImageViews.clear();
 	for (auto view : _vStorageImageViews)
 		VERUS_VULKAN_DESTROY(view, vkDestroyImageView(pRendererVulkan->GetVkDevice(), view, pRendererVulkan->GetAllocator()));
 	_vStorageImageViews.clear();
@@ -524,6 +527,34 @@ void TextureVulkan::GenerateCubeMapMips(PBaseCommandBuffer pCB)
 	Schedule(0);
 }
 
+void TextureVulkan::SetMostDetailedMip(int mipLevel)
+{
+	VERUS_QREF_RENDERER_VULKAN;
+	VkResult res = VK_SUCCESS;
+	VERUS_RT_ASSERT(!(_desc._flags & TextureDesc::Flags::cubeMap) && _desc._arrayLayers == 1);
+
+	if (GetMostDetailedMip() == mipLevel)
+		return;
+	BaseTexture::SetMostDetailedMip(mipLevel);
+
+	// Old view can still be used by command buffers in flight:
+	_vOldImageViews.push_back(_imageView);
+	_imageView = VK_NULL_HANDLE;
+	Schedule(0);
+
+	VkImageViewCreateInfo vkivci = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+	vkivci.image = _image;
+	vkivci.viewType = (_desc._flags & TextureDesc::Flags::forceArrayTexture) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+	vkivci.format = ToNativeFormat(_desc._format);
+	vkivci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	vkivci.subresourceRange.baseMipLevel = mipLevel;
+	vkivci.subresourceRange.levelCount = _desc._mipLevels - mipLevel;
+	vkivci.subresourceRange.baseArrayLayer = 0;
+	vkivci.subresourceRange.layerCount = 1;
+	if (VK_SUCCESS != (res = vkCreateImageView(pRendererVulkan->GetVkDevice(), &vkivci, pRendererVulkan->GetAllocator(), &_imageView)))
+		throw VERUS_RUNTIME_ERROR << "vkCreateImageView(); res=" << res;
+}
+
 Continue TextureVulkan::Scheduled_Update()
 {
 	if (!IsScheduledAllowed())
@@ -533,6 +564,10 @@ Continue TextureVulkan::Scheduled_Update()
 	for (auto& x : _vStagingBuffers)
 		VERUS_VULKAN_DESTROY(x._buffer, vmaDestroyBuffer(pRendererVulkan->GetVmaAllocator(), x._buffer, x._vmaAllocation));
 
+	for (auto view : _vOldImageViews)
+		VERUS_VULKAN_DESTROY(view, vkDestroyImageView(pRendererVulkan->GetVkDevice(), view, pRendererVulkan->GetAllocator()));
+	_vOldImageViews.clear();
+
 	if (!_vCshGenerateMips.empty())
 	{
 		VERUS_QREF_RENDERER;
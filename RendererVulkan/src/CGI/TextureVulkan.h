@@ -20,6 +20,7 @@ namespace verus::CGI
 		VkSampler           _sampler = VK_NULL_HANDLE;
 		Vector<UINT32>      _vDefinedSubresources;
 		Vector<VkImageView> _vStorageImageViews;
+		Vector<VkImageView> _vOldImageViews;
 		Vector<BufferEx>    _vStagingBuffers;
 		Vector<BufferEx>    _vReadbackBuffers;
 		Vector<CSHandle>    _vCshGenerateMips;
@@ -38,6 +39,8 @@ namespace verus::CGI
 		virtual void GenerateMips(PBaseCommandBuffer pCB) override;
 		void GenerateCubeMapMips(PBaseCommandBuffer pCB);
 
+		virtual void SetMostDetailedMip(int mipLevel) override;
+
 		virtual Continue Scheduled_Update() override;
 
 		//
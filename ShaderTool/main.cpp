@@ -0,0 +1,434 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include <verus.h>
+
+using namespace verus;
+
+// Must match the interface, which VulkanShaderCompiler expects:
+struct BaseShaderInclude
+{
+	virtual void Open(CSZ filename, void** ppData, UINT32* pBytes) = 0;
+	virtual void Close(void* pData) = 0;
+};
+
+extern "C"
+{
+	typedef void(*PFNVULKANCOMPILERINIT)();
+	typedef void(*PFNVULKANCOMPILERDONE)();
+	typedef CSZ(*PFNVULKANCOMPILERVERSION)();
+	typedef bool(*PFNVULKANCOMPILE)(CSZ source, CSZ sourceName, CSZ* defines, BaseShaderInclude* pInclude,
+		CSZ entryPoint, CSZ target, UINT32 flags, UINT32** ppCode, UINT32* pSize, CSZ* ppErrorMsgs);
+}
+
+// Compiles all branches of all shaders in a folder to SPIR-V, the way ShaderVulkan::Init() does it.
+// Output goes to Precompiled subfolder, which is packed into Shaders.pak by PAKBuilder.
+// At runtime ShaderCache finds these files by the same content-based key, so any changed shader is simply compiled again.
+class ShaderTool
+{
+	typedef CGI::BaseShader::Stage Stage;
+	typedef App::QualitySettings::OverallQuality OverallQuality;
+
+	struct Source
+	{
+		String         _name; // Relative to shader folder, like in "[Shaders]:" URLs.
+		Vector<char>   _vText;
+		Vector<String> _vBranches;
+	};
+
+	// One stage of one branch with one quality preset:
+	struct Job
+	{
+		String         _entry;
+		Vector<String> _vDefines; // Name-value pairs.
+		String         _key;
+		String         _errorMsgs;
+		int            _sourceIndex = 0;
+		Stage          _stage = Stage::vs;
+		bool           _compiled = false;
+		bool           _failed = false;
+	};
+
+	PFNVULKANCOMPILERINIT    _pfnInit = nullptr;
+	PFNVULKANCOMPILERDONE    _pfnDone = nullptr;
+	PFNVULKANCOMPILERVERSION _pfnVersion = nullptr;
+	PFNVULKANCOMPILE         _pfnCompile = nullptr;
+	String                   _inputPath;
+	String                   _outputPath;
+	Vector<OverallQuality>   _vQualities;
+	Vector<Source>           _vSources;
+	Vector<Job>              _vJobs;
+	bool                     _debug = false;
+	bool                     _keepStale = false;
+
+public:
+	ShaderTool();
+	~ShaderTool();
+
+	int Main(VERUS_MAIN_DEFAULT_ARGS);
+	bool ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS);
+	void PrintUsage();
+	bool LoadCompiler();
+	void LoadSources();
+	void CreateJobs();
+	void RunJobs();
+	int DeleteStaleFiles();
+};
+
+ShaderTool::ShaderTool()
+{
+}
+
+ShaderTool::~ShaderTool()
+{
+}
+
+int ShaderTool::Main(VERUS_MAIN_DEFAULT_ARGS)
+{
+	if (argc <= 1)
+	{
+		PrintUsage();
+		return EXIT_SUCCESS;
+	}
+
+	if (!ParseCommandLine(argc, argv))
+		return EXIT_FAILURE;
+	if (!LoadCompiler())
+		return EXIT_FAILURE;
+
+	std::wcout << _T("Compiler: ") << Str::Utf8ToWide(_pfnVersion()) << std::endl;
+	std::wcout << _T("Input: ") << Str::Utf8ToWide(_inputPath) << std::endl;
+	std::wcout << _T("Output: ") << Str::Utf8ToWide(_outputPath) << std::endl;
+
+	const auto t0 = std::chrono::steady_clock::now();
+	LoadSources();
+	CreateJobs();
+	std::wcout << _T("Shaders: ") << _vSources.size() << _T(", stages to check: ") << _vJobs.size() << std::endl;
+
+	_pfnInit();
+	RunJobs();
+	_pfnDone();
+	const auto t1 = std::chrono::steady_clock::now();
+	const auto d = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+
+	int compiledCount = 0;
+	int failedCount = 0;
+	for (const auto& job : _vJobs)
+	{
+		if (job._failed)
+		{
+			failedCount++;
+			std::wcerr << std::endl << _T("ERROR: ") << Str::Utf8ToWide(_vSources[job._sourceIndex]._name) << _T(", ") << Str::Utf8ToWide(job._entry) << std::endl;
+			std::wcerr << Str::Utf8ToWide(job._errorMsgs) << std::endl;
+		}
+		else if (job._compiled)
+		{
+			compiledCount++;
+		}
+	}
+	const int deletedCount = (_keepStale || failedCount) ? 0 : DeleteStaleFiles();
+
+	std::wcout << std::endl;
+	std::wcout << _T("Compiled: ") << compiledCount << _T(", up to date: ") << (_vJobs.size() - compiledCount - failedCount);
+	std::wcout << _T(", failed: ") << failedCount << _T(", deleted: ") << deletedCount;
+	std::wcout << _T(", time: ") << d.count() << _T(" ms") << std::endl;
+
+	return failedCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+bool ShaderTool::ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--output") && i + 1 < argc)
+		{
+			_outputPath = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--quality") && i + 1 < argc)
+		{
+			const String quality = argv[++i];
+			if (quality == "low")
+				_vQualities.push_back(OverallQuality::low);
+			else if (quality == "medium")
+				_vQualities.push_back(OverallQuality::medium);
+			else if (quality == "high")
+				_vQualities.push_back(OverallQuality::high);
+			else if (quality == "ultra")
+				_vQualities.push_back(OverallQuality::ultra);
+			else
+				std::wcout << _T("WARNING: Unknown quality ") << Str::Utf8ToWide(quality) << std::endl;
+		}
+		else if (!strcmp(argv[i], "--debug"))
+			_debug = true;
+		else if (!strcmp(argv[i], "--keep-stale"))
+			_keepStale = true;
+		else if (!strncmp(argv[i], "--", 2))
+			std::wcout << _T("WARNING: Unknown argument ") << Str::Utf8ToWide(argv[i]) << std::endl;
+		else
+			_inputPath = argv[i];
+	}
+
+	if (_inputPath.empty() || !std::filesystem::is_directory(Str::Utf8ToWide(_inputPath)))
+	{
+		std::wcerr << _T("ERROR: Shader folder not found: ") << Str::Utf8ToWide(_inputPath) << std::endl;
+		return false;
+	}
+	if (!Str::EndsWith(_C(_inputPath), "/") && !Str::EndsWith(_C(_inputPath), "\\"))
+		_inputPath += "/";
+	if (_outputPath.empty())
+		_outputPath = _inputPath + CGI::ShaderCache::GetPrecompiledFolder();
+	if (!Str::EndsWith(_C(_outputPath), "/") && !Str::EndsWith(_C(_outputPath), "\\"))
+		_outputPath += "/";
+	if (_vQualities.empty())
+		_vQualities = { OverallQuality::low, OverallQuality::medium, OverallQuality::high, OverallQuality::ultra };
+	return true;
+}
+
+void ShaderTool::PrintUsage()
+{
+	std::wcout << _T("Usage: ShaderTool [options] <shader folder>") << std::endl;
+	std::wcout << std::endl;
+	std::wcout << _T("Compiles all branches of all shaders to SPIR-V for Vulkan renderer.") << std::endl;
+	std::wcout << _T("Stages are compiled in parallel, stages which are up to date are skipped.") << std::endl;
+	std::wcout << _T("Pack the shader folder with PAKBuilder to get Shaders.pak with precompiled shaders.") << std::endl;
+	std::wcout << std::endl;
+	std::wcout << _T("Options:") << std::endl;
+	std::wcout << _T("  --output <folder>  Output folder (default is <shader folder>/Precompiled).") << std::endl;
+	std::wcout << _T("  --quality <preset> Quality preset: low, medium, high or ultra (default is all).") << std::endl;
+	std::wcout << _T("                     Can be used more than once.") << std::endl;
+	std::wcout << _T("  --debug            Compile for debug build of the engine.") << std::endl;
+	std::wcout << _T("  --keep-stale       Don't delete files, which are no longer used.") << std::endl;
+}
+
+bool ShaderTool::LoadCompiler()
+{
+#ifdef _WIN32
+	HMODULE hModule = LoadLibraryA("VulkanShaderCompiler.dll");
+	if (hModule)
+	{
+		_pfnInit = reinterpret_cast<PFNVULKANCOMPILERINIT>(GetProcAddress(hModule, "VulkanCompilerInit"));
+		_pfnDone = reinterpret_cast<PFNVULKANCOMPILERDONE>(GetProcAddress(hModule, "VulkanCompilerDone"));
+		_pfnVersion = reinterpret_cast<PFNVULKANCOMPILERVERSION>(GetProcAddress(hModule, "VulkanCompilerVersion"));
+		_pfnCompile = reinterpret_cast<PFNVULKANCOMPILE>(GetProcAddress(hModule, "VulkanCompile"));
+	}
+#else
+	void* pModule = dlopen("./libVulkanShaderCompiler.so", RTLD_LAZY);
+	if (pModule)
+	{
+		_pfnInit = reinterpret_cast<PFNVULKANCOMPILERINIT>(dlsym(pModule, "VulkanCompilerInit"));
+		_pfnDone = reinterpret_cast<PFNVULKANCOMPILERDONE>(dlsym(pModule, "VulkanCompilerDone"));
+		_pfnVersion = reinterpret_cast<PFNVULKANCOMPILERVERSION>(dlsym(pModule, "VulkanCompilerVersion"));
+		_pfnCompile = reinterpret_cast<PFNVULKANCOMPILE>(dlsym(pModule, "VulkanCompile"));
+	}
+#endif
+	if (!_pfnInit || !_pfnDone || !_pfnVersion || !_pfnCompile)
+	{
+		std::wcerr << _T("ERROR: VulkanShaderCompiler not found or too old") << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void ShaderTool::LoadSources()
+{
+	const std::filesystem::path inputPath(Str::Utf8ToWide(_inputPath));
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(inputPath))
+	{
+		if (!entry.is_regular_file() || entry.path().extension() != L".hlsl")
+			continue;
+
+		Source source;
+		source._name = Str::WideToUtf8(entry.path().lexically_relative(inputPath).generic_wstring());
+		IO::File file;
+		if (!file.Open(_C(Str::WideToUtf8(entry.path().wstring()))))
+			throw VERUS_RUNTIME_ERROR << "LoadSources(); Cannot open " << source._name;
+		const INT64 size = file.GetSize();
+		source._vText.resize(size + 1);
+		file.Read(source._vText.data(), size);
+
+		CGI::BaseShader::GetBranches(source._vText.data(), nullptr, source._vBranches);
+		if (source._vBranches.empty()) // Include file?
+			continue;
+		_vSources.push_back(std::move(source));
+	}
+}
+
+void ShaderTool::CreateJobs()
+{
+	Vector<Vector<String>> vSystemDefines;
+	for (const auto& quality : _vQualities)
+	{
+		App::QualitySettings qs;
+		qs.SetQuality(quality);
+		Vector<String> v;
+		CGI::BaseShader::GetSystemDefines(qs, v);
+		v.push_back("_VULKAN");
+		v.push_back("1");
+		vSystemDefines.push_back(std::move(v));
+	}
+
+	const int sourceCount = Utils::Cast32(_vSources.size());
+	VERUS_FOR(sourceIndex, sourceCount)
+	{
+		for (const auto& branchDesc : _vSources[sourceIndex]._vBranches)
+		{
+			String entry, stageEntries[+Stage::count], stages;
+			Vector<String> vMacroName;
+			Vector<String> vMacroValue;
+			CGI::BaseShader::Parse(_C(branchDesc), entry, stageEntries, stages, vMacroName, vMacroValue, "DEF_");
+
+			VERUS_FOR(i, +Stage::count)
+			{
+				if (!strchr(_C(stages), CGI::BaseShader::GetStageLetter(static_cast<Stage>(i))))
+					continue;
+				for (const auto& v : vSystemDefines)
+				{
+					Job job;
+					job._entry = stageEntries[i];
+					job._sourceIndex = sourceIndex;
+					job._stage = static_cast<Stage>(i);
+					const int count = Utils::Cast32(vMacroName.size());
+					VERUS_FOR(j, count)
+					{
+						job._vDefines.push_back(vMacroName[j]);
+						job._vDefines.push_back(vMacroValue[j]);
+					}
+					job._vDefines.insert(job._vDefines.end(), v.begin(), v.end());
+					job._vDefines.push_back(CGI::BaseShader::GetStageDefine(static_cast<Stage>(i)));
+					job._vDefines.push_back("1");
+					_vJobs.push_back(std::move(job));
+				}
+			}
+		}
+	}
+}
+
+void ShaderTool::RunJobs()
+{
+	struct ShaderInclude : BaseShaderInclude
+	{
+		CGI::PShaderCache                 _pCache = nullptr;
+		Vector<CGI::ShaderCache::Include> _vIncludes;
+
+		virtual void Open(CSZ filename, void** ppData, UINT32* pBytes) override
+		{
+			Vector<BYTE> vData;
+			_pCache->LoadInclude(filename, vData, _vIncludes);
+			char* p = new char[vData.size()];
+			memcpy(p, vData.data(), vData.size());
+			*pBytes = Utils::Cast32(vData.size());
+			*ppData = p;
+		}
+
+		virtual void Close(void* pData) override
+		{
+			delete[] pData;
+		}
+	};
+
+	CSZ stageTargets[] = { "vs", "hs", "ds", "gs", "fs", "cs" };
+	VERUS_CT_ASSERT(VERUS_COUNT_OF(stageTargets) == +Stage::count);
+	const UINT32 flags = _debug ? 1 : 0;
+
+	CGI::ShaderCache cache(_pfnVersion(), "spv");
+	cache.SetPath(_C(_outputPath));
+	cache.SetIncludePath(_C(_inputPath));
+
+	std::atomic_int doneCount;
+	doneCount = 0;
+	const int jobCount = Utils::Cast32(_vJobs.size());
+	if (!jobCount)
+		return;
+	VERUS_P_FOR(i, jobCount)
+	{
+		Job& job = _vJobs[i];
+		const Source& source = _vSources[job._sourceIndex];
+		try
+		{
+			const String params = CGI::ShaderCache::GetParams(_C(job._entry), stageTargets[+job._stage], flags, job._vDefines);
+			job._key = cache.GetKey(source._vText.data(), _C(source._name), params);
+
+			Vector<BYTE> vCode;
+			if (!cache.Load(job._key, vCode))
+			{
+				Vector<CSZ> vDefines;
+				vDefines.reserve(job._vDefines.size() + 1);
+				for (const auto& x : job._vDefines)
+					vDefines.push_back(_C(x));
+				vDefines.push_back(nullptr);
+
+				ShaderInclude inc;
+				inc._pCache = &cache;
+				UINT32* pCode = nullptr;
+				UINT32 size = 0;
+				CSZ pErrorMsgs = nullptr;
+				if (_pfnCompile(source._vText.data(), _C(source._name), vDefines.data(), &inc, _C(job._entry), stageTargets[+job._stage], flags, &pCode, &size, &pErrorMsgs) && pCode && size)
+				{
+					cache.Save(job._key, inc._vIncludes, pCode, size);
+					job._compiled = true;
+				}
+				else
+				{
+					job._errorMsgs = pErrorMsgs ? pErrorMsgs : "";
+					job._failed = true;
+				}
+			}
+		}
+		catch (const std::exception& e)
+		{
+			job._errorMsgs = e.what();
+			job._failed = true;
+		}
+
+		const int done = ++doneCount;
+		if (!(done % 16) || done == jobCount)
+		{
+			wprintf(_T("\rProgress: %3d%%"), done * 100 / jobCount);
+			fflush(stdout);
+		}
+	});
+	wprintf(_T("\n"));
+}
+
+int ShaderTool::DeleteStaleFiles()
+{
+	HashSet<String> usedFilenames;
+	for (const auto& job : _vJobs)
+		usedFilenames.insert(job._key + ".spv");
+
+	int count = 0;
+	const std::filesystem::path outputPath(Str::Utf8ToWide(_outputPath));
+	if (!std::filesystem::is_directory(outputPath))
+		return count;
+	for (const auto& entry : std::filesystem::directory_iterator(outputPath))
+	{
+		if (!entry.is_regular_file() || entry.path().extension() != L".spv")
+			continue;
+		if (usedFilenames.find(Str::WideToUtf8(entry.path().filename().wstring())) == usedFilenames.end())
+		{
+			std::error_code ec;
+			if (std::filesystem::remove(entry.path(), ec))
+				count++;
+		}
+	}
+	return count;
+}
+
+int main(VERUS_MAIN_DEFAULT_ARGS)
+{
+	AlignedAllocator alloc;
+	Utils::MakeEx(&alloc); // For paths.
+	Make_D(); // For log.
+	int ret = EXIT_SUCCESS;
+	try
+	{
+		ShaderTool shaderTool;
+		ret = shaderTool.Main(argc, argv);
+	}
+	catch (const std::exception& e)
+	{
+		std::wcerr << _T("EXCEPTION: ") << e.what() << std::endl;
+		ret = EXIT_FAILURE;
+	}
+	Free_D();
+	Utils::FreeEx(&alloc);
+	return ret;
+}
@@ -39,6 +39,7 @@ class TextureTool
 	bool    _asIs = false;
 	bool    _edgePaddingUsingAlpha = false;
 	bool    _edgePaddingUsingFaces = false;
+	bool    _edgePaddingBenchmark = false;
 	bool    _deleteMip = false;
 
 	static CMP_BOOL FeedbackProc(CMP_FLOAT progress, CMP_DWORD_PTR pUser1, CMP_DWORD_PTR pUser2);
@@ -52,6 +53,7 @@ public:
 	void PrintUsage();
 	void ConvertTexture(TexMode currentTexMode);
 	void ComputeEdgePadding();
+	void BenchmarkEdgePadding();
 };
 
 CMP_BOOL TextureTool::FeedbackProc(CMP_FLOAT progress, CMP_DWORD_PTR pUser1, CMP_DWORD_PTR pUser2)
@@ -91,7 +93,11 @@ void TextureTool::Main(VERUS_MAIN_DEFAULT_ARGS)
 	}
 	ParseCommandLine(argc, argv);
 
-	if (_edgePaddingUsingAlpha || _edgePaddingUsingFaces)
+	if (_edgePaddingBenchmark)
+	{
+		BenchmarkEdgePadding();
+	}
+	else if (_edgePaddingUsingAlpha || _edgePaddingUsingFaces)
 	{
 		ComputeEdgePadding();
 	}
@@ -165,6 +171,8 @@ void TextureTool::ParseCommandLine(VERUS_MAIN_DEFAULT_ARGS)
 			_edgePaddingUsingAlpha = true;
 		else if (!strcmp(argv[i], "--edge-padding-using-faces") || !strcmp(argv[i], "-epuf"))
 			_edgePaddingUsingFaces = true;
+		else if (!strcmp(argv[i], "--edge-padding-benchmark"))
+			_edgePaddingBenchmark = true;
 		else if (!strcmp(argv[i], "--delete-mip"))
 			_deleteMip = true;
 		else if (i > 0 && i < argc - 1)
@@ -201,6 +209,7 @@ void TextureTool::PrintUsage()
 	std::wcout << _T("  --as-is                           Don't use block compression.") << std::endl;
 	std::wcout << _T("  --edge-padding-using-alpha, -epua Add edge padding to an image with alpha.") << std::endl;
 	std::wcout << _T("  --edge-padding-using-faces, -epuf Add edge padding to an image, take alpha from Faces.png.") << std::endl;
+	std::wcout << _T("  --edge-padding-benchmark          Compare edge padding with a brute-force search on a 8192x8192 image.") << std::endl;
 	std::wcout << _T("  --delete-mip                      Delete topmost mip level.") << std::endl;
 }
 
@@ -535,6 +544,96 @@ void TextureTool::ComputeEdgePadding()
 	IO::FileSystem::SaveImage(_C(_pathname), reinterpret_cast<UINT32*>(image._p), image._width, image._height, IO::ImageFormat::tga, image._pixelStride);
 }
 
+// Brute-force search, which was used before, for reference.
+void ComputeEdgePaddingReference(BYTE* pData, int dataPixelStride, const BYTE* pAlpha, int alphaPixelStride, int width, int height, int radius, int channelCount)
+{
+	if (!radius)
+		radius = Math::Clamp((width + height) / 256, 1, 16);
+	const int radiusSq = radius * radius;
+	VERUS_P_FOR(i, height)
+	{
+		const int rowOffset = i * width;
+		VERUS_FOR(j, width)
+		{
+			if (pAlpha[alphaPixelStride * (rowOffset + j)])
+				continue;
+
+			int minRadiusSq = INT_MAX;
+			int nearest = 0;
+			for (int di = -radius; di <= radius; ++di)
+			{
+				const int ki = i + di;
+				if (ki < 0 || ki >= height)
+					continue;
+				for (int dj = -radius; dj <= radius; ++dj)
+				{
+					const int kj = j + dj;
+					if (kj < 0 || kj >= width)
+						continue;
+					const int lenSq = di * di + dj * dj;
+					if (lenSq > radiusSq || !pAlpha[alphaPixelStride * (ki * width + kj)])
+						continue;
+					if (lenSq < minRadiusSq)
+					{
+						minRadiusSq = lenSq;
+						nearest = ki * width + kj;
+					}
+				}
+			}
+
+			if (minRadiusSq != INT_MAX)
+				memcpy(&pData[dataPixelStride * (rowOffset + j)], &pData[dataPixelStride * nearest], channelCount);
+		}
+	});
+}
+
+void TextureTool::BenchmarkEdgePadding()
+{
+	const int side = 8192;
+	const int pixelStride = 4;
+
+	// Lightmap-like image: random islands and some noise.
+	std::wcout << _T("Generating image ") << side << _T("x") << side << _T("...") << std::endl;
+	Vector<BYTE> vImage(side * side * pixelStride);
+	std::mt19937 rng(1);
+	for (auto& x : vImage)
+		x = static_cast<BYTE>(rng());
+	VERUS_FOR(i, side * side)
+		vImage[i * pixelStride + 3] = (rng() % 1000) ? 0 : 0xFF;
+	VERUS_FOR(island, 2000)
+	{
+		const int x = rng() % side;
+		const int y = rng() % side;
+		const int w = 8 + rng() % 256;
+		const int h = 8 + rng() % 256;
+		for (int i = y; i < Math::Min(y + h, side); ++i)
+		{
+			for (int j = x; j < Math::Min(x + w, side); ++j)
+				vImage[(i * side + j) * pixelStride + 3] = 0xFF;
+		}
+	}
+	Vector<BYTE> vImageReference = vImage;
+
+	typedef std::chrono::duration<float, std::milli> TMilliseconds;
+	const auto t0 = std::chrono::steady_clock::now();
+	Utils::ComputeEdgePadding(vImage.data(), pixelStride, vImage.data() + 3, pixelStride, side, side, 0, 3);
+	const auto t1 = std::chrono::steady_clock::now();
+	std::wcout << _T("Distance transform: ") << TMilliseconds(t1 - t0).count() << _T(" ms") << std::endl;
+	ComputeEdgePaddingReference(vImageReference.data(), pixelStride, vImageReference.data() + 3, pixelStride, side, side, 0, 3);
+	const auto t2 = std::chrono::steady_clock::now();
+	std::wcout << _T("Brute force: ") << TMilliseconds(t2 - t1).count() << _T(" ms") << std::endl;
+
+	if (vImage == vImageReference)
+	{
+		std::wcout << _T("Results are identical.") << std::endl;
+	}
+	else
+	{
+		std::wcerr << _T("ERROR: Results are different.") << std::endl;
+		throw std::exception();
+	}
+}
+
 void DeleteMipmap(CWSZ pathname)
 {
 	const String pathnameIn = Str::WideToUtf8(pathname);
@@ -219,9 +219,12 @@ void Settings::Load()
 	_gpuShaderQuality = static_cast<Quality>(GetI("gpuShaderQuality", +_gpuShaderQuality));
 	_gpuTessellation = GetB("gpuTessellation", _gpuTessellation);
 	_gpuTextureLodLevel = GetI("gpuTextureLodLevel", _gpuTextureLodLevel);
+	_gpuTextureStreamingBudget = GetI("gpuTextureStreamingBudget", _gpuTextureStreamingBudget);
 	_gpuTrilinearFilter = GetB("gpuTrilinearFilter", _gpuTrilinearFilter);
 	_inputMouseSensitivity = GetF("inputMouseSensitivity", _inputMouseSensitivity);
 	_openXR = GetB("openXR", _openXR);
+	_physicsDedicatedThread = GetB("physicsDedicatedThread", _physicsDedicatedThread);
+	_physicsMultithreaded = GetB("physicsMultithreaded", _physicsMultithreaded);
 	_postProcessAntiAliasing = GetB("postProcessAntiAliasing", _postProcessAntiAliasing);
 	_postProcessBloom = GetB("postProcessBloom", _postProcessBloom);
 	_postProcessCinema = GetB("postProcessCinema", _postProcessCinema);
@@ -234,6 +237,7 @@ void Settings::Load()
 	_sceneShadowQuality = static_cast<Quality>(GetI("sceneShadowQuality", +_sceneShadowQuality));
 	_sceneWaterQuality = static_cast<WaterQuality>(GetI("sceneWaterQuality", +_sceneWaterQuality));
 	_uiLang = GetS("uiLang", _C(_uiLang));
+	_worldDeferredTransforms = GetB("worldDeferredTransforms", _worldDeferredTransforms);
 	_xrFOV = GetF("xrFOV", _xrFOV);
 	_xrHeight = GetF("xrHeight", _xrHeight);
 }
@@ -303,6 +307,7 @@ void Settings::Validate()
 	_gpuAntiAliasingLevel = Math::Clamp(_gpuAntiAliasingLevel, 0, 16);
 	_gpuShaderQuality = Math::Clamp(_gpuShaderQuality, Quality::low, Quality::ultra);
 	_gpuTextureLodLevel = Math::Clamp(_gpuTextureLodLevel, 0, 4);
+	_gpuTextureStreamingBudget = Math::Clamp(_gpuTextureStreamingBudget, 64, 0x10000);
 	_sceneGrassDensity = Math::Clamp(_sceneGrassDensity, 100, 1000);
 	_sceneShadowQuality = Math::Clamp(_sceneShadowQuality, Quality::low, Quality::ultra);
 	_sceneWaterQuality = Math::Clamp(_sceneWaterQuality, WaterQuality::solidColor, WaterQuality::trueWavesRefraction);
@@ -331,9 +336,12 @@ void Settings::Save()
 	Set("gpuShaderQuality", +_gpuShaderQuality);
 	Set("gpuTessellation", _gpuTessellation);
 	Set("gpuTextureLodLevel", _gpuTextureLodLevel);
+	Set("gpuTextureStreamingBudget", _gpuTextureStreamingBudget);
 	Set("gpuTrilinearFilter", _gpuTrilinearFilter);
 	Set("inputMouseSensitivity", _inputMouseSensitivity);
 	Set("openXR", _openXR);
+	Set("physicsDedicatedThread", _physicsDedicatedThread);
+	Set("physicsMultithreaded", _physicsMultithreaded);
 	Set("postProcessAntiAliasing", _postProcessAntiAliasing);
 	Set("postProcessBloom", _postProcessBloom);
 	Set("postProcessCinema", _postProcessCinema);
@@ -346,6 +354,7 @@ void Settings::Save()
 	Set("sceneShadowQuality", +_sceneShadowQuality);
 	Set("sceneWaterQuality", +_sceneWaterQuality);
 	Set("uiLang", _C(_uiLang));
+	Set("worldDeferredTransforms", _worldDeferredTransforms);
 	Set("xrFOV", _xrFOV);
 	Set("xrHeight", _xrHeight);
 
@@ -89,6 +89,7 @@ namespace verus::App
 		int _ds_ubSubpassFSCapacity = 20;
 		int _ds_ubShadowFSCapacity = 50;
 		int _ds_ubMeshVSCapacity = 20;
+		int _font_vertCapacity = 0x10000;
 		int _forest_ubVSCapacity = 200;
 		int _forest_ubFSCapacity = 200;
 		int _generateMips_ubCapacity = 50;
@@ -147,10 +148,14 @@ namespace verus::App
 		int         _displaySizeWidth = 1280;
 		bool        _displayVSync = true;
 		int         _gapi = 0;
+		int         _gpuTextureStreamingBudget = 1024; // In MB.
 		float       _inputMouseSensitivity = 1;
 		bool        _openXR = false;
+		bool        _physicsDedicatedThread = false;
+		bool        _physicsMultithreaded = false;
 		bool        _physicsSupportDebugDraw = false;
 		String      _uiLang = "EN";
+		bool        _worldDeferredTransforms = false; // See WorldManager::SetDeferredTransformMode().
 		float       _xrFOV = 110;
 		float       _xrHeight = 0;
 		CommandLine _commandLine;
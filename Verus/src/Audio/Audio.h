@@ -4,6 +4,7 @@
 #include "OggCallbacks.h"
 #include "Source.h"
 #include "Sound.h"
+#include "Mixer.h"
 #include "StreamPlayer.h"
 #include "AudioSystem.h"
 
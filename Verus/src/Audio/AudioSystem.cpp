@@ -4,6 +4,8 @@
 using namespace verus;
 using namespace verus::Audio;
 
+const float AudioSystem::s_minAudibility = 0.001f;
+
 AudioSystem::AudioSystem()
 {
 }
@@ -13,12 +15,12 @@ AudioSystem::~AudioSystem()
 	Done();
 }
 
-void AudioSystem::Init()
+void AudioSystem::Init(CSZ deviceName)
 {
 	VERUS_INIT();
 
-	if (!(_pDevice = alcOpenDevice(nullptr)))
-		throw VERUS_RUNTIME_ERROR << "alcOpenDevice()";
+	if (!(_pDevice = alcOpenDevice(deviceName)))
+		throw VERUS_RUNTIME_ERROR << "alcOpenDevice(); deviceName=" << (deviceName ? deviceName : "default");
 
 	if (!(_pContext = alcCreateContext(_pDevice, nullptr)))
 		throw VERUS_RUNTIME_ERROR << "alcCreateContext(); " << alcGetError(_pDevice);
@@ -34,13 +36,49 @@ void AudioSystem::Init()
 	_version = ss.str();
 
 	_deviceSpecifier = alcGetString(_pDevice, ALC_DEVICE_SPECIFIER);
+
+	// Preallocate the voice pool:
+	int monoSources = 0;
+	alcGetIntegerv(_pDevice, ALC_MONO_SOURCES, 1, &monoSources);
+	const int voiceCount = Math::Clamp(monoSources - s_reservedVoiceCount, 1, s_maxVoiceCount);
+	_vVoices.resize(voiceCount);
+	alGenSources(voiceCount, _vVoices.data());
+	if (AL_NO_ERROR != alGetError())
+		throw VERUS_RUNTIME_ERROR << "alGenSources(); voiceCount=" << voiceCount;
+	_vFreeVoices = _vVoices;
+	_stats._voiceCount = voiceCount;
+
+	_stopDecodeThreads = false;
+	_vDecodeThreads.reserve(s_decodeThreadCount);
+	VERUS_FOR(i, s_decodeThreadCount)
+		_vDecodeThreads.push_back(std::thread(&AudioSystem::DecodeThreadProc, this));
 }
 
 void AudioSystem::Done()
 {
 	DeleteAllStreams();
+	_mixer.Done();
 	DeleteAllSounds();
 
+	if (!_vVoices.empty())
+	{
+		alDeleteSources(Utils::Cast32(_vVoices.size()), _vVoices.data());
+		_vVoices.clear();
+	}
+
+	if (!_vDecodeThreads.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(_decodeMutex);
+			_stopDecodeThreads = true;
+			_listDecodeTasks.clear();
+		}
+		_decodeCV.notify_all();
+		for (auto& t : _vDecodeThreads)
+			t.join();
+		_vDecodeThreads.clear();
+	}
+
 	alcMakeContextCurrent(0);
 	if (_pContext)
 	{
@@ -64,18 +102,38 @@ void AudioSystem::Update()
 
 	VERUS_QREF_TIMER;
 
+	{
+		std::exception_ptr ex;
+		{
+			std::lock_guard<std::mutex> lock(_decodeMutex);
+			std::swap(ex, _decodeEx);
+		}
+		if (ex)
+			std::rethrow_exception(ex);
+	}
+
 	VERUS_FOR(i, VERUS_COUNT_OF(_streamPlayers))
 		_streamPlayers[i].Update();
 
-	// Update every frame:
-	for (auto& [key, value] : TStoreSounds::_map)
-		value.Update();
+	// Create buffers for decoded sounds:
+	{
+		std::lock_guard<std::mutex> lock(_decodeMutex);
+		std::swap(_vDecodedSounds, _vTempDecodedSounds);
+	}
+	for (auto pSound : _vTempDecodedSounds)
+		pSound->Update();
+	_vTempDecodedSounds.clear();
+
+	UpdateVoices();
+	_mixer.Update();
 
 	// Update ~15 times per second:
 	if (timer.IsEventEvery(67))
 	{
-		for (auto& [key, value] : TStoreSounds::_map)
-			value.UpdateHRTF();
+		PrioritizeVoices();
+
+		for (auto pSource : _vActiveSources)
+			pSource->UpdateHRTF();
 
 		if (VMath::lengthSqr(_listenerDirection) > 0.1f &&
 			VMath::lengthSqr(_listenerUp) > 0.1f)
@@ -122,6 +180,178 @@ void AudioSystem::DeleteAllSounds()
 	TStoreSounds::DeleteAll();
 }
 
+void AudioSystem::DecodeSound(PSound pSound, RcBlob blob, bool pcmCache)
+{
+	VERUS_RT_ASSERT(!_vDecodeThreads.empty());
+	DecodeTask task;
+	task._pSound = pSound;
+	task._vData.assign(blob._p, blob._p + blob._size);
+	task._pcmCache = pcmCache;
+	{
+		std::lock_guard<std::mutex> lock(_decodeMutex);
+		_listDecodeTasks.push_back(std::move(task));
+	}
+	_decodeCV.notify_one();
+}
+
+void AudioSystem::CancelDecode(PSound pSound)
+{
+	std::unique_lock<std::mutex> lock(_decodeMutex);
+	_listDecodeTasks.remove_if([pSound](const DecodeTask& task) {return task._pSound == pSound; });
+	_decodeDoneCV.wait(lock, [this, pSound]()
+		{
+			return std::find(_vDecodingSounds.begin(), _vDecodingSounds.end(), pSound) == _vDecodingSounds.end();
+		});
+	_vDecodedSounds.erase(std::remove(_vDecodedSounds.begin(), _vDecodedSounds.end(), pSound), _vDecodedSounds.end());
+}
+
+void AudioSystem::PlaySource(PSource pSource)
+{
+	VERUS_RT_ASSERT(!pSource->IsPlaying());
+	pSource->_state = (pSource->_travelDelay > 0) ? Source::State::delayed : Source::State::playing;
+	_vActiveSources.push_back(pSource);
+	if (Source::State::playing == pSource->_state && !_vFreeVoices.empty()) // Don't wait for prioritization?
+	{
+		pSource->Bind(_vFreeVoices.back());
+		_vFreeVoices.pop_back();
+		_stats._realizedCount++;
+	}
+}
+
+void AudioSystem::StopSource(PSource pSource)
+{
+	const ALuint sid = pSource->Unbind();
+	if (sid)
+		_vFreeVoices.push_back(sid);
+	pSource->_state = Source::State::stopped;
+	pSource->_time = 0;
+	auto it = std::find(_vActiveSources.begin(), _vActiveSources.end(), pSource);
+	if (it != _vActiveSources.end())
+	{
+		std::swap(*it, _vActiveSources.back());
+		_vActiveSources.pop_back();
+	}
+}
+
+void AudioSystem::UpdateVoices()
+{
+	VERUS_QREF_TIMER;
+
+	_stats._activeCount = 0;
+	_stats._realCount = 0;
+	_stats._virtualCount = 0;
+	_stats._realizedCount = 0;
+	_stats._virtualizedCount = 0;
+
+	for (int i = 0; i < static_cast<int>(_vActiveSources.size());)
+	{
+		PSource pSource = _vActiveSources[i];
+		if (pSource->Update(dt))
+		{
+			i++;
+		}
+		else
+		{
+			StopSource(pSource); // Swaps with the last one.
+		}
+	}
+
+	for (auto pSource : _vActiveSources)
+	{
+		_stats._activeCount++;
+		if (pSource->_sid)
+			_stats._realCount++;
+		else if (Source::State::playing == pSource->_state)
+			_stats._virtualCount++;
+	}
+}
+
+void AudioSystem::PrioritizeVoices()
+{
+	_vSortedSources.clear();
+	for (auto pSource : _vActiveSources)
+	{
+		if (Source::State::playing == pSource->_state)
+		{
+			pSource->_audibility = pSource->ComputeAudibility(_listenerPosition);
+			_vSortedSources.push_back(pSource);
+		}
+	}
+	std::sort(_vSortedSources.begin(), _vSortedSources.end(), [](PSource pA, PSource pB)
+		{
+			return pA->_audibility > pB->_audibility;
+		});
+
+	// Most audible voices get real sources, first release the rest:
+	const int realCount = Math::Min<int>(Utils::Cast32(_vSortedSources.size()), Utils::Cast32(_vVoices.size()));
+	VERUS_FOR(i, static_cast<int>(_vSortedSources.size()))
+	{
+		PSource pSource = _vSortedSources[i];
+		if (pSource->_sid && (i >= realCount || pSource->_audibility < s_minAudibility))
+		{
+			_vFreeVoices.push_back(pSource->Unbind());
+			_stats._virtualizedCount++;
+		}
+	}
+	VERUS_FOR(i, realCount)
+	{
+		PSource pSource = _vSortedSources[i];
+		if (!pSource->_sid && pSource->_audibility >= s_minAudibility)
+		{
+			VERUS_RT_ASSERT(!_vFreeVoices.empty());
+			pSource->Bind(_vFreeVoices.back());
+			_vFreeVoices.pop_back();
+			_stats._realizedCount++;
+		}
+	}
+}
+
+void AudioSystem::DecodeThreadProc()
+{
+	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+	VERUS_PROFILER_THREAD_NAME("AudioDecoder");
+	while (true)
+	{
+		DecodeTask task;
+		{
+			std::unique_lock<std::mutex> lock(_decodeMutex);
+			_decodeCV.wait(lock, [this]() {return _stopDecodeThreads || !_listDecodeTasks.empty(); });
+			if (_stopDecodeThreads)
+				break;
+			task = std::move(_listDecodeTasks.front());
+			_listDecodeTasks.pop_front();
+			_vDecodingSounds.push_back(task._pSound);
+		}
+
+		bool decoded = false;
+		try
+		{
+			task._pSound->Decode(Blob(task._vData.data(), task._vData.size()), task._pcmCache);
+			decoded = true;
+		}
+		catch (D::RcRuntimeError)
+		{
+			std::lock_guard<std::mutex> lock(_decodeMutex);
+			if (!_decodeEx)
+				_decodeEx = std::current_exception();
+		}
+		catch (const std::exception& e)
+		{
+			std::lock_guard<std::mutex> lock(_decodeMutex);
+			if (!_decodeEx)
+				_decodeEx = std::make_exception_ptr(VERUS_RUNTIME_ERROR << e.what());
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_decodeMutex);
+			if (decoded)
+				_vDecodedSounds.push_back(task._pSound);
+			_vDecodingSounds.erase(std::find(_vDecodingSounds.begin(), _vDecodingSounds.end(), task._pSound));
+		}
+		_decodeDoneCV.notify_all();
+	}
+}
+
 void AudioSystem::UpdateListener(RcPoint3 pos, RcVector3 dir, RcVector3 vel, RcVector3 up)
 {
 	_listenerPosition = pos;
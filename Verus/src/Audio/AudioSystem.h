@@ -6,36 +6,98 @@ namespace verus::Audio
 	typedef StoreUnique<String, Sound> TStoreSounds;
 	class AudioSystem : public Singleton<AudioSystem>, public Object, private TStoreSounds
 	{
-		Point3       _listenerPosition = Point3(0);
-		Vector3      _listenerDirection = Vector3(0, 0, 1);
-		Vector3      _listenerVelocity = Vector3(0);
-		Vector3      _listenerUp = Vector3(0, 1, 0);
-		ALCdevice* _pDevice = nullptr;
-		ALCcontext* _pContext = nullptr;
-		String       _version;
-		String       _deviceSpecifier;
-		StreamPlayer _streamPlayers[4];
+		struct DecodeTask
+		{
+			PSound       _pSound = nullptr;
+			Vector<BYTE> _vData;
+			bool         _pcmCache = false;
+		};
+
+		static const int s_decodeThreadCount = 2;
+		static const int s_maxVoiceCount = 64;
+		static const int s_reservedVoiceCount = 5; // For stream players and the mixer.
+		static const float s_minAudibility;
+
+	public:
+		struct Stats
+		{
+			int _voiceCount = 0; // Size of the voice pool.
+			int _activeCount = 0;
+			int _realCount = 0;
+			int _virtualCount = 0;
+			int _realizedCount = 0; // Voices which became real during this frame.
+			int _virtualizedCount = 0; // Voices which became virtual during this frame.
+		};
+		VERUS_TYPEDEFS(Stats);
+
+	private:
+		Point3                  _listenerPosition = Point3(0);
+		Vector3                 _listenerDirection = Vector3(0, 0, 1);
+		Vector3                 _listenerVelocity = Vector3(0);
+		Vector3                 _listenerUp = Vector3(0, 1, 0);
+		ALCdevice*              _pDevice = nullptr;
+		ALCcontext*             _pContext = nullptr;
+		String                  _version;
+		String                  _deviceSpecifier;
+		StreamPlayer            _streamPlayers[4];
+		Mixer                   _mixer;
+		Vector<ALuint>          _vVoices;
+		Vector<ALuint>          _vFreeVoices;
+		Vector<PSource>         _vActiveSources;
+		Vector<PSource>         _vSortedSources;
+		Stats                   _stats;
+		Vector<std::thread>     _vDecodeThreads;
+		std::mutex              _decodeMutex;
+		std::condition_variable _decodeCV;
+		std::condition_variable _decodeDoneCV;
+		List<DecodeTask>        _listDecodeTasks;
+		Vector<PSound>          _vDecodingSounds;
+		Vector<PSound>          _vDecodedSounds;
+		Vector<PSound>          _vTempDecodedSounds;
+		std::exception_ptr      _decodeEx; // Rethrown once by Update().
+		bool                    _stopDecodeThreads = false;
 
 	public:
 		AudioSystem();
 		~AudioSystem();
 
-		void Init();
+		// Device name can be used to select a specific device, for example "No Output" for OpenAL Soft's null device.
+		void Init(CSZ deviceName = nullptr);
 		void Done();
 
 		void Update();
 
+		RcStats GetStats() const { return _stats; }
+
 		RStreamPlayer GetStreamPlayer(int index) { return _streamPlayers[index]; }
 		void DeleteAllStreams();
 
+		// Software mixer is optional, call its Init() to use it.
+		RMixer GetMixer() { return _mixer; }
+
 		PSound InsertSound(CSZ url);
 		PSound FindSound(CSZ url);
 		void DeleteSound(CSZ url);
 		void DeleteAllSounds();
 
+		// Compressed data is copied and decoded on one of the decoder threads.
+		// Sound is notified by a call to Sound::Decode() on that thread.
+		void DecodeSound(PSound pSound, RcBlob blob, bool pcmCache);
+		// Removes pending tasks and blocks if this sound is being decoded.
+		void CancelDecode(PSound pSound);
+
+		// <Voices>
+		void PlaySource(PSource pSource);
+		void StopSource(PSource pSource);
+		// </Voices>
+
 		void UpdateListener(RcPoint3 pos, RcVector3 dir, RcVector3 vel, RcVector3 up);
 		float ComputeTravelDelay(RcPoint3 pos) const;
 
+		VERUS_P(void UpdateVoices());
+		VERUS_P(void PrioritizeVoices());
+		VERUS_P(void DecodeThreadProc());
+
 		static CSZ GetSingletonFailMessage() { return "Make_Audio(); // FAIL.\r\n"; }
 	};
 	VERUS_TYPEDEFS(AudioSystem);
@@ -0,0 +1,672 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::Audio;
+
+Mixer::Mixer()
+{
+	_processedCount = 0;
+	_activeVoiceCount = 0;
+	_underrunCount = 0;
+	_mixTime = 0;
+}
+
+Mixer::~Mixer()
+{
+	Done();
+}
+
+void Mixer::Init(bool offline)
+{
+	VERUS_INIT();
+
+	_offline = offline;
+
+	_vGenerations.resize(s_maxVoiceCount);
+	_vVoiceSounds.resize(s_maxVoiceCount);
+	_vFreeVoices.reserve(s_maxVoiceCount);
+	for (int i = s_maxVoiceCount - 1; i >= 0; --i)
+		_vFreeVoices.push_back(i);
+
+	_vBusBuffers.resize(s_busCount * 2 * s_blockFrameCount);
+	_vMasterBuffer.resize(2 * s_blockFrameCount);
+	_vReverbBuffer.resize(s_blockFrameCount);
+	_vOutput.resize(2 * s_blockFrameCount);
+
+	// Freeverb's delay lengths:
+	const int combLengths[Reverb::s_combCount] = { 1116, 1188, 1277, 1356 };
+	const int allPassLengths[Reverb::s_allPassCount] = { 556, 441 };
+	VERUS_FOR(i, Reverb::s_combCount)
+		_reverb._vCombs[i].resize(combLengths[i]);
+	VERUS_FOR(i, Reverb::s_allPassCount)
+		_reverb._vAllPasses[i].resize(allPassLengths[i]);
+
+	_stats._blockTime = s_blockFrameCount * 1000.f / s_sampleRate;
+
+	if (!_offline)
+	{
+		alGenBuffers(s_bufferCount, _buffers);
+		alGenSources(1, &_source);
+		alSourcei(_source, AL_SOURCE_RELATIVE, AL_TRUE);
+		alSource3f(_source, AL_POSITION, 0, 0, 0);
+		alSource3f(_source, AL_VELOCITY, 0, 0, 0);
+		alSourcef(_source, AL_ROLLOFF_FACTOR, 0);
+
+		_stopThread = false;
+		_flushRequested = false;
+		_thread = std::thread(&Mixer::ThreadProc, this);
+	}
+}
+
+void Mixer::Done()
+{
+	if (_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopThread = true;
+		}
+		_cv.notify_one();
+		_thread.join();
+	}
+	if (_source)
+	{
+		alSourceStop(_source);
+		alDeleteSources(1, &_source);
+		_source = 0;
+	}
+	if (_buffers[0])
+	{
+		alDeleteBuffers(s_bufferCount, _buffers);
+		VERUS_ZERO_MEM(_buffers);
+	}
+
+	VERUS_DONE(Mixer);
+}
+
+void Mixer::Update()
+{
+	if (!IsInitialized())
+		return;
+
+	// Reclaim voices, which have finished playing:
+	VoiceHandle handle;
+	while (_endedQueue.Pop(handle))
+	{
+		int index = 0;
+		UINT32 generation = 0;
+		if (FindVoice(handle, index, generation))
+		{
+			_vGenerations[index]++;
+			_vVoiceSounds[index] = nullptr;
+			_vFreeVoices.push_back(index);
+		}
+	}
+
+	_stats._voiceCount = _activeVoiceCount.load(std::memory_order_relaxed);
+	_stats._underrunCount = _underrunCount.load(std::memory_order_relaxed);
+	_stats._mixTime = _mixTime.load(std::memory_order_relaxed);
+}
+
+Mixer::VoiceHandle Mixer::Play(PcSound pSound, RcPlayDesc desc)
+{
+	VERUS_RT_ASSERT(IsInitialized());
+	VERUS_RT_ASSERT(desc._bus >= 0 && desc._bus < s_busCount);
+
+	const Blob pcm = pSound->GetPcmBuffer();
+	if (!pcm._size) // Not loaded or no keepPcmBuffer?
+		return 0;
+	if (_vFreeVoices.empty())
+	{
+		_stats._droppedCount++;
+		return 0;
+	}
+
+	const int index = _vFreeVoices.back();
+	_vFreeVoices.pop_back();
+	_vVoiceSounds[index] = pSound;
+
+	Command command;
+	command._type = CommandType::play;
+	command._pData = reinterpret_cast<const short*>(pcm._p);
+	command._channelCount = pSound->GetChannelCount();
+	command._frameCount = static_cast<int>(pcm._size / (sizeof(short) * command._channelCount));
+	command._sampleRate = pSound->GetSampleRate();
+	command._index = index;
+	command._generation = _vGenerations[index];
+	command._playDesc = desc;
+	PushCommand(command);
+
+	// Handle is never zero:
+	return ((_vGenerations[index] & 0xFFFF) << 16) | (index + 1);
+}
+
+void Mixer::Stop(VoiceHandle handle)
+{
+	Command command;
+	if (!FindVoice(handle, command._index, command._generation))
+		return;
+	command._type = CommandType::stop;
+	PushCommand(command);
+}
+
+void Mixer::SetGain(VoiceHandle handle, float gain)
+{
+	Command command;
+	if (!FindVoice(handle, command._index, command._generation))
+		return;
+	command._type = CommandType::setGain;
+	command._value = gain;
+	PushCommand(command);
+}
+
+void Mixer::SetPitch(VoiceHandle handle, float pitch)
+{
+	Command command;
+	if (!FindVoice(handle, command._index, command._generation))
+		return;
+	command._type = CommandType::setPitch;
+	command._value = pitch;
+	PushCommand(command);
+}
+
+void Mixer::SetPan(VoiceHandle handle, float pan)
+{
+	Command command;
+	if (!FindVoice(handle, command._index, command._generation))
+		return;
+	command._type = CommandType::setPan;
+	command._value = pan;
+	PushCommand(command);
+}
+
+void Mixer::SetBusGain(int bus, float gain)
+{
+	Command command;
+	command._type = CommandType::setBusGain;
+	command._index = bus;
+	command._value = gain;
+	PushCommand(command);
+}
+
+void Mixer::SetBusLowPass(int bus, float cutoffFrequency)
+{
+	// One-pole filter's coefficient:
+	Command command;
+	command._type = CommandType::setBusLowPass;
+	command._index = bus;
+	command._value = (cutoffFrequency >= s_sampleRate * 0.5f) ? 1 : 1 - exp(-VERUS_2PI * cutoffFrequency / s_sampleRate);
+	PushCommand(command);
+}
+
+void Mixer::SetBusReverbSend(int bus, float send)
+{
+	Command command;
+	command._type = CommandType::setBusReverbSend;
+	command._index = bus;
+	command._value = send;
+	PushCommand(command);
+}
+
+void Mixer::SetReverbGain(float gain)
+{
+	Command command;
+	command._type = CommandType::setReverbGain;
+	command._value = gain;
+	PushCommand(command);
+}
+
+void Mixer::ForgetSound(PcSound pSound)
+{
+	if (!IsInitialized())
+		return;
+
+	bool found = false;
+	VERUS_FOR(i, s_maxVoiceCount)
+	{
+		if (_vVoiceSounds[i] == pSound)
+		{
+			Command command;
+			command._type = CommandType::stop;
+			command._index = i;
+			command._generation = _vGenerations[i];
+			command._value = 1; // Immediately.
+			PushCommand(command);
+			_vVoiceSounds[i] = nullptr;
+			found = true;
+		}
+	}
+	if (found)
+		Flush();
+}
+
+double Mixer::RenderToWAV(CSZ pathname, float duration)
+{
+	VERUS_RT_ASSERT(IsInitialized());
+	VERUS_RT_ASSERT(_offline);
+
+	const int blockCount = static_cast<int>(ceil(duration * s_sampleRate / s_blockFrameCount));
+	Vector<short> vData;
+	vData.reserve(static_cast<size_t>(blockCount) * 2 * s_blockFrameCount);
+
+	const auto t0 = std::chrono::steady_clock::now();
+	VERUS_FOR(i, blockCount)
+	{
+		ProcessCommands();
+		MixBlock();
+		vData.insert(vData.end(), _vOutput.begin(), _vOutput.end());
+		Update();
+	}
+	const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+	IO::File file;
+	if (!file.Open(pathname, "wb"))
+		throw VERUS_RECOVERABLE << "Open(); pathname=" << pathname;
+	const UINT32 dataSize = Utils::Cast32(vData.size() * sizeof(short));
+	const UINT32 riffSize = 36 + dataSize;
+	const UINT32 fmtSize = 16;
+	const UINT16 format = 1; // PCM.
+	const UINT16 channelCount = 2;
+	const UINT32 sampleRate = s_sampleRate;
+	const UINT32 byteRate = s_sampleRate * channelCount * sizeof(short);
+	const UINT16 blockAlign = channelCount * sizeof(short);
+	const UINT16 bitsPerSample = 16;
+	file.Write("RIFF", 4);
+	file.Write(&riffSize, sizeof(riffSize));
+	file.Write("WAVEfmt ", 8);
+	file.Write(&fmtSize, sizeof(fmtSize));
+	file.Write(&format, sizeof(format));
+	file.Write(&channelCount, sizeof(channelCount));
+	file.Write(&sampleRate, sizeof(sampleRate));
+	file.Write(&byteRate, sizeof(byteRate));
+	file.Write(&blockAlign, sizeof(blockAlign));
+	file.Write(&bitsPerSample, sizeof(bitsPerSample));
+	file.Write("data", 4);
+	file.Write(&dataSize, sizeof(dataSize));
+	file.Write(vData.data(), dataSize);
+
+	VERUS_LOG_INFO("RenderToWAV(); " << blockCount * s_blockFrameCount / static_cast<float>(s_sampleRate) << " s rendered in " << time * 1000 << " ms"
+		<< ", voices=" << _stats._voiceCount << ", mixTime=" << _stats._mixTime << " ms");
+	return time;
+}
+
+void Mixer::PushCommand(const Command& command)
+{
+	while (!_commandQueue.Push(command))
+	{
+		if (_offline)
+			ProcessCommands();
+		else
+			std::this_thread::yield(); // Audio thread is behind.
+	}
+	_pushCount++;
+}
+
+bool Mixer::FindVoice(VoiceHandle handle, int& index, UINT32& generation) const
+{
+	index = (handle & 0xFFFF) - 1;
+	if (index < 0 || index >= s_maxVoiceCount)
+		return false;
+	generation = _vGenerations[index];
+	return (generation & 0xFFFF) == (handle >> 16);
+}
+
+void Mixer::Flush()
+{
+	if (_offline)
+	{
+		ProcessCommands();
+		return;
+	}
+	// Commands are processed before mixing, so after this the audio thread is not using the old data:
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_flushRequested = true;
+	}
+	_cv.notify_one();
+	std::unique_lock<std::mutex> lock(_mutex);
+	_flushCv.wait(lock, [this]() {return static_cast<INT32>(_processedCount.load(std::memory_order_acquire) - _pushCount) >= 0; });
+}
+
+void Mixer::ThreadProc()
+{
+	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+	VERUS_PROFILER_THREAD_NAME("Mixer");
+	const auto period = std::chrono::microseconds(s_blockFrameCount * 1000000 / s_sampleRate / 2);
+	bool started = false;
+	while (true)
+	{
+		bool flush = false;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv.wait_for(lock, period, [this]() {return _stopThread || _flushRequested; });
+			if (_stopThread)
+				break;
+			std::swap(flush, _flushRequested);
+		}
+
+		VERUS_PROFILER_ZONE("Mixer/ThreadProc");
+		ProcessCommands();
+
+		if (flush)
+		{
+			std::lock_guard<std::mutex> lock(_mutex); // Waiter must not miss the notification.
+			_flushCv.notify_all();
+		}
+
+		if (!started)
+		{
+			VERUS_FOR(i, s_bufferCount)
+			{
+				MixBlock();
+				alBufferData(_buffers[i], AL_FORMAT_STEREO16, _vOutput.data(), Utils::Cast32(_vOutput.size() * sizeof(short)), s_sampleRate);
+			}
+			alSourceQueueBuffers(_source, s_bufferCount, _buffers);
+			alSourcePlay(_source);
+			started = true;
+			continue;
+		}
+
+		int processed = 0;
+		alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+		while (processed > 0)
+		{
+			ALuint buffer;
+			alSourceUnqueueBuffers(_source, 1, &buffer);
+			MixBlock();
+			alBufferData(buffer, AL_FORMAT_STEREO16, _vOutput.data(), Utils::Cast32(_vOutput.size() * sizeof(short)), s_sampleRate);
+			alSourceQueueBuffers(_source, 1, &buffer);
+			processed--;
+		}
+
+		int state;
+		alGetSourcei(_source, AL_SOURCE_STATE, &state);
+		if (AL_STOPPED == state) // All buffers were played before new ones were queued?
+		{
+			_underrunCount++;
+			alSourcePlay(_source);
+		}
+	}
+}
+
+void Mixer::ProcessCommands()
+{
+	UINT32 count = 0;
+	Command command;
+	while (_commandQueue.Pop(command))
+	{
+		count++;
+		switch (command._type)
+		{
+		case CommandType::play:
+		{
+			Voice& voice = _voices[command._index];
+			voice = Voice();
+			voice._pData = command._pData;
+			voice._frameCount = command._frameCount;
+			voice._channelCount = command._channelCount;
+			voice._rateRatio = static_cast<float>(command._sampleRate) / s_sampleRate;
+			voice._step = static_cast<UINT64>(voice._rateRatio * Math::Clamp(command._playDesc._pitch, 0.1f, 8.f) * 4294967296.0);
+			voice._gain = command._playDesc._gain;
+			voice._pan = command._playDesc._pan;
+			voice._bus = command._playDesc._bus;
+			voice._looping = command._playDesc._looping;
+			voice._generation = command._generation;
+			voice._active = true;
+			UpdateTargetGains(voice); // Ramp from zero to avoid clicks.
+			_activeVoiceCount++;
+		}
+		break;
+		case CommandType::stop:
+		case CommandType::setGain:
+		case CommandType::setPitch:
+		case CommandType::setPan:
+		{
+			Voice& voice = _voices[command._index];
+			if (!voice._active || voice._generation != command._generation)
+				break;
+			switch (command._type)
+			{
+			case CommandType::stop:
+				if (command._value > 0) // Immediately?
+				{
+					voice._active = false;
+					voice._pData = nullptr;
+					_activeVoiceCount--;
+					_endedQueue.Push(((voice._generation & 0xFFFF) << 16) | (command._index + 1));
+				}
+				else
+				{
+					voice._stopping = true;
+					voice._targetGains[0] = voice._targetGains[1] = 0;
+				}
+				break;
+			case CommandType::setGain:
+				voice._gain = command._value;
+				UpdateTargetGains(voice);
+				break;
+			case CommandType::setPitch:
+				voice._step = static_cast<UINT64>(voice._rateRatio * Math::Clamp(command._value, 0.1f, 8.f) * 4294967296.0);
+				break;
+			case CommandType::setPan:
+				voice._pan = command._value;
+				UpdateTargetGains(voice);
+				break;
+			}
+		}
+		break;
+		case CommandType::setBusGain: _buses[command._index]._gain = command._value; break;
+		case CommandType::setBusLowPass: _buses[command._index]._lowPassCoef = command._value; break;
+		case CommandType::setBusReverbSend: _buses[command._index]._reverbSend = command._value; break;
+		case CommandType::setReverbGain: _reverb._gain = command._value; break;
+		}
+	}
+	_processedCount.fetch_add(count, std::memory_order_release);
+}
+
+void Mixer::MixBlock()
+{
+	const auto t0 = std::chrono::steady_clock::now();
+
+	std::fill(_vBusBuffers.begin(), _vBusBuffers.end(), 0.f);
+	std::fill(_vMasterBuffer.begin(), _vMasterBuffer.end(), 0.f);
+	std::fill(_vReverbBuffer.begin(), _vReverbBuffer.end(), 0.f);
+
+	VERUS_FOR(i, s_maxVoiceCount)
+	{
+		Voice& voice = _voices[i];
+		if (!voice._active)
+			continue;
+		float* pL = &_vBusBuffers[voice._bus * 2 * s_blockFrameCount];
+		MixVoice(voice, pL, pL + s_blockFrameCount);
+		if (!voice._active) // Done?
+		{
+			_activeVoiceCount--;
+			_endedQueue.Push(((voice._generation & 0xFFFF) << 16) | (i + 1));
+		}
+	}
+
+	// Buses:
+	float* pMasterL = _vMasterBuffer.data();
+	float* pMasterR = pMasterL + s_blockFrameCount;
+	VERUS_FOR(b, s_busCount)
+	{
+		Bus& bus = _buses[b];
+		float* pBus[2] = { &_vBusBuffers[b * 2 * s_blockFrameCount], &_vBusBuffers[b * 2 * s_blockFrameCount + s_blockFrameCount] };
+		if (bus._lowPassCoef < 1)
+		{
+			VERUS_FOR(ch, 2)
+			{
+				float state = bus._lowPassState[ch];
+				VERUS_FOR(i, s_blockFrameCount)
+				{
+					state += bus._lowPassCoef * (pBus[ch][i] - state);
+					pBus[ch][i] = state;
+				}
+				bus._lowPassState[ch] = state;
+			}
+		}
+		const __m128 gain = _mm_set1_ps(bus._gain);
+		const __m128 send = _mm_set1_ps(bus._reverbSend * 0.5f);
+		for (int i = 0; i < s_blockFrameCount; i += 4)
+		{
+			const __m128 l = _mm_loadu_ps(pBus[0] + i);
+			const __m128 r = _mm_loadu_ps(pBus[1] + i);
+			_mm_storeu_ps(pMasterL + i, _mm_add_ps(_mm_loadu_ps(pMasterL + i), _mm_mul_ps(l, gain)));
+			_mm_storeu_ps(pMasterR + i, _mm_add_ps(_mm_loadu_ps(pMasterR + i), _mm_mul_ps(r, gain)));
+			if (bus._reverbSend > 0)
+				_mm_storeu_ps(&_vReverbBuffer[i], _mm_add_ps(_mm_loadu_ps(&_vReverbBuffer[i]), _mm_mul_ps(_mm_add_ps(l, r), send)));
+		}
+	}
+
+	ProcessReverb(_vReverbBuffer.data(), pMasterL, pMasterR);
+
+	// Convert to interleaved 16-bit with saturation:
+	const __m128 scale = _mm_set1_ps(32767);
+	for (int i = 0; i < s_blockFrameCount; i += 4)
+	{
+		const __m128 l = _mm_mul_ps(_mm_loadu_ps(pMasterL + i), scale);
+		const __m128 r = _mm_mul_ps(_mm_loadu_ps(pMasterR + i), scale);
+		const __m128i lo = _mm_cvtps_epi32(_mm_unpacklo_ps(l, r));
+		const __m128i hi = _mm_cvtps_epi32(_mm_unpackhi_ps(l, r));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&_vOutput[i * 2]), _mm_packs_epi32(lo, hi));
+	}
+
+	const float mixTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	_mixTime.store(Math::Lerp(_mixTime.load(std::memory_order_relaxed), mixTime, 0.05f), std::memory_order_relaxed);
+}
+
+void Mixer::MixVoice(Voice& voice, float* pL, float* pR)
+{
+	const float inv = 1.f / 32768;
+	const float rampScale = 1.f / s_blockFrameCount;
+	const float gainSteps[2] =
+	{
+		(voice._targetGains[0] - voice._currentGains[0]) * rampScale,
+		(voice._targetGains[1] - voice._currentGains[1]) * rampScale
+	};
+	const __m128 offsets = _mm_set_ps(3, 2, 1, 0);
+	__m128 gainL = _mm_add_ps(_mm_set1_ps(voice._currentGains[0]), _mm_mul_ps(offsets, _mm_set1_ps(gainSteps[0])));
+	__m128 gainR = _mm_add_ps(_mm_set1_ps(voice._currentGains[1]), _mm_mul_ps(offsets, _mm_set1_ps(gainSteps[1])));
+	const __m128 gainStepL = _mm_set1_ps(gainSteps[0] * 4);
+	const __m128 gainStepR = _mm_set1_ps(gainSteps[1] * 4);
+	const __m128 fracScale = _mm_set1_ps(1.f / 4294967296.f);
+	const __m128 sampleScale = _mm_set1_ps(inv);
+
+	const int channelCount = voice._channelCount;
+	const short* pData = voice._pData;
+	const UINT64 end = static_cast<UINT64>(voice._frameCount) << 32;
+
+	// Returns the frame index, which follows this one:
+	auto NextFrame = [&voice](int frame)
+	{
+		frame++;
+		if (frame >= voice._frameCount)
+			return voice._looping ? 0 : voice._frameCount - 1;
+		return frame;
+	};
+
+	for (int i = 0; i < s_blockFrameCount; i += 4)
+	{
+		// Gather 4 frames with their neighbors, the rest is vectorized:
+		alignas(16) float s0[2][4];
+		alignas(16) float s1[2][4];
+		alignas(16) float frac[4];
+		bool ended = false;
+		VERUS_FOR(k, 4)
+		{
+			if (voice._position >= end)
+			{
+				if (voice._looping)
+				{
+					voice._position %= end;
+				}
+				else
+				{
+					ended = true;
+					s0[0][k] = s0[1][k] = s1[0][k] = s1[1][k] = 0;
+					frac[k] = 0;
+					continue;
+				}
+			}
+			const int frame = static_cast<int>(voice._position >> 32);
+			const int next = NextFrame(frame);
+			const short* p0 = pData + frame * channelCount;
+			const short* p1 = pData + next * channelCount;
+			s0[0][k] = p0[0];
+			s1[0][k] = p1[0];
+			s0[1][k] = p0[channelCount - 1];
+			s1[1][k] = p1[channelCount - 1];
+			frac[k] = static_cast<float>(voice._position & 0xFFFFFFFF);
+			voice._position += voice._step;
+		}
+
+		const __m128 t = _mm_mul_ps(_mm_load_ps(frac), fracScale);
+		const __m128 a0 = _mm_load_ps(s0[0]);
+		const __m128 a1 = _mm_load_ps(s0[1]);
+		const __m128 l = _mm_mul_ps(_mm_add_ps(a0, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(s1[0]), a0), t)), sampleScale);
+		const __m128 r = _mm_mul_ps(_mm_add_ps(a1, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(s1[1]), a1), t)), sampleScale);
+		_mm_storeu_ps(pL + i, _mm_add_ps(_mm_loadu_ps(pL + i), _mm_mul_ps(l, gainL)));
+		_mm_storeu_ps(pR + i, _mm_add_ps(_mm_loadu_ps(pR + i), _mm_mul_ps(r, gainR)));
+		gainL = _mm_add_ps(gainL, gainStepL);
+		gainR = _mm_add_ps(gainR, gainStepR);
+
+		if (ended)
+		{
+			voice._active = false;
+			break;
+		}
+	}
+
+	voice._currentGains[0] = voice._targetGains[0];
+	voice._currentGains[1] = voice._targetGains[1];
+	if (voice._stopping) // Faded out?
+		voice._active = false;
+	if (!voice._active)
+		voice._pData = nullptr;
+}
+
+void Mixer::ProcessReverb(const float* pIn, float* pL, float* pR)
+{
+	const float feedback = 0.84f;
+	const float damp = 0.2f;
+	const float allPassFeedback = 0.5f;
+	VERUS_FOR(i, s_blockFrameCount)
+	{
+		const float in = pIn[i] * 0.015f; // Freeverb's fixed gain.
+		float out = 0;
+		VERUS_FOR(c, Reverb::s_combCount)
+		{
+			Vector<float>& vComb = _reverb._vCombs[c];
+			int& cursor = _reverb._combCursors[c];
+			const float delayed = vComb[cursor];
+			_reverb._combStates[c] = delayed * (1 - damp) + _reverb._combStates[c] * damp;
+			vComb[cursor] = in + _reverb._combStates[c] * feedback;
+			VERUS_CIRCULAR_ADD(cursor, static_cast<int>(vComb.size()));
+			out += delayed;
+		}
+		VERUS_FOR(a, Reverb::s_allPassCount)
+		{
+			Vector<float>& vAllPass = _reverb._vAllPasses[a];
+			int& cursor = _reverb._allPassCursors[a];
+			const float delayed = vAllPass[cursor];
+			vAllPass[cursor] = out + delayed * allPassFeedback;
+			VERUS_CIRCULAR_ADD(cursor, static_cast<int>(vAllPass.size()));
+			out = delayed - out;
+		}
+		out *= _reverb._gain;
+		pL[i] += out;
+		pR[i] += out;
+	}
+}
+
+void Mixer::UpdateTargetGains(Voice& voice)
+{
+	if (voice._stopping)
+		return;
+	// Constant power panning:
+	const float angle = (Math::Clamp(voice._pan, -1.f, 1.f) + 1) * VERUS_PI * 0.25f;
+	voice._targetGains[0] = voice._gain * cos(angle) * 1.414213562f; // Center has unity gain.
+	voice._targetGains[1] = voice._gain * sin(angle) * 1.414213562f;
+}
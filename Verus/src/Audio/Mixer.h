@@ -0,0 +1,225 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::Audio
+{
+	// Single producer, single consumer queue without locks.
+	template<typename T, int CAPACITY>
+	class MixerQueue
+	{
+		static_assert(!(CAPACITY & (CAPACITY - 1)), "Capacity must be a power of two.");
+
+		T                   _items[CAPACITY];
+		std::atomic<UINT32> _head; // Written by consumer.
+		std::atomic<UINT32> _tail; // Written by producer.
+
+	public:
+		MixerQueue()
+		{
+			_head = 0;
+			_tail = 0;
+		}
+
+		bool Push(const T& item)
+		{
+			const UINT32 tail = _tail.load(std::memory_order_relaxed);
+			if (tail - _head.load(std::memory_order_acquire) >= CAPACITY)
+				return false; // Full.
+			_items[tail & (CAPACITY - 1)] = item;
+			_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool Pop(T& item)
+		{
+			const UINT32 head = _head.load(std::memory_order_relaxed);
+			if (head == _tail.load(std::memory_order_acquire))
+				return false; // Empty.
+			item = _items[head & (CAPACITY - 1)];
+			_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+	};
+
+	// Software mixer, which mixes many voices into one streaming OpenAL source.
+	// Voices are resampled with linear interpolation, gain changes are ramped over one block.
+	// Each voice goes to a bus, which has a gain, a low-pass filter and a reverb send.
+	// Game thread sends commands through a lock-free queue, mixing is done on a dedicated audio thread.
+	// In offline mode there is no thread and no OpenAL source, use RenderToWAV() to get the output.
+	// Sounds must be created with Sound::Desc::_keepPcmBuffer.
+	class Mixer : public Object
+	{
+	public:
+		typedef UINT32 VoiceHandle;
+
+		static const int s_sampleRate = 44100;
+		static const int s_blockFrameCount = 512; // Must be a multiple of 4.
+		static const int s_bufferCount = 4;
+		static const int s_maxVoiceCount = 256;
+		static const int s_busCount = 4;
+
+		struct Stats
+		{
+			int   _voiceCount = 0;
+			int   _droppedCount = 0; // Play() calls without a free voice.
+			int   _underrunCount = 0;
+			float _mixTime = 0; // Average time to mix one block, in milliseconds.
+			float _blockTime = 0; // Duration of one block, in milliseconds.
+		};
+		VERUS_TYPEDEFS(Stats);
+
+		struct PlayDesc
+		{
+			float _gain = 1;
+			float _pitch = 1;
+			float _pan = 0; // From -1 (left) to 1 (right).
+			int   _bus = 0;
+			bool  _looping = false;
+
+			PlayDesc() {}
+		};
+		VERUS_TYPEDEFS(PlayDesc);
+
+	private:
+		enum class CommandType : BYTE
+		{
+			play,
+			stop,
+			setGain,
+			setPitch,
+			setPan,
+			setBusGain,
+			setBusLowPass,
+			setBusReverbSend,
+			setReverbGain
+		};
+
+		struct Command
+		{
+			const short* _pData = nullptr;
+			int          _frameCount = 0;
+			int          _channelCount = 0;
+			int          _sampleRate = 0;
+			int          _index = 0; // Voice or bus.
+			UINT32       _generation = 0;
+			float        _value = 0;
+			PlayDesc     _playDesc;
+			CommandType  _type = CommandType::play;
+		};
+
+		struct Voice
+		{
+			const short* _pData = nullptr;
+			int          _frameCount = 0;
+			int          _channelCount = 0;
+			UINT64       _position = 0; // Fixed point 32.32, in frames.
+			UINT64       _step = 0;
+			float        _rateRatio = 1;
+			float        _gain = 1;
+			float        _pan = 0;
+			float        _currentGains[2] = {};
+			float        _targetGains[2] = {};
+			int          _bus = 0;
+			UINT32       _generation = 0;
+			bool         _active = false;
+			bool         _looping = false;
+			bool         _stopping = false; // Fading out, then done.
+		};
+
+		struct Bus
+		{
+			float _gain = 1;
+			float _lowPassCoef = 1; // One means no filtering.
+			float _reverbSend = 0;
+			float _lowPassState[2] = {};
+		};
+
+		struct Reverb
+		{
+			static const int s_combCount = 4;
+			static const int s_allPassCount = 2;
+
+			Vector<float> _vCombs[s_combCount];
+			Vector<float> _vAllPasses[s_allPassCount];
+			int           _combCursors[s_combCount] = {};
+			int           _allPassCursors[s_allPassCount] = {};
+			float         _combStates[s_combCount] = {};
+			float         _gain = 0.3f;
+		};
+
+		typedef MixerQueue<Command, 1024> TCommandQueue;
+		typedef MixerQueue<VoiceHandle, 512> TEventQueue;
+
+		// Game thread:
+		Vector<UINT32>          _vGenerations;
+		Vector<int>             _vFreeVoices;
+		Vector<PcSound>         _vVoiceSounds;
+		UINT32                  _pushCount = 0;
+		// Shared:
+		TCommandQueue           _commandQueue;
+		TEventQueue             _endedQueue;
+		std::atomic<UINT32>     _processedCount;
+		// Audio thread:
+		Voice                   _voices[s_maxVoiceCount];
+		Bus                     _buses[s_busCount];
+		Reverb                  _reverb;
+		Vector<float>           _vBusBuffers; // Planar stereo for each bus.
+		Vector<float>           _vMasterBuffer; // Planar stereo.
+		Vector<float>           _vReverbBuffer;
+		Vector<short>           _vOutput; // Interleaved stereo.
+		ALuint                  _buffers[s_bufferCount] = {};
+		ALuint                  _source = 0;
+		std::thread             _thread;
+		std::mutex              _mutex;
+		std::condition_variable _cv;
+		std::condition_variable _flushCv; // Audio thread acknowledges a flush request.
+		Stats                   _stats;
+		std::atomic_int         _activeVoiceCount;
+		std::atomic_int         _underrunCount;
+		std::atomic<float>      _mixTime;
+		bool                    _stopThread = false;
+		bool                    _flushRequested = false;
+		bool                    _offline = false;
+
+	public:
+		Mixer();
+		~Mixer();
+
+		void Init(bool offline = false);
+		void Done();
+
+		// Call this on game thread, once per frame.
+		void Update();
+
+		VoiceHandle Play(PcSound pSound, RcPlayDesc desc = PlayDesc());
+		void Stop(VoiceHandle handle);
+		void SetGain(VoiceHandle handle, float gain);
+		void SetPitch(VoiceHandle handle, float pitch);
+		void SetPan(VoiceHandle handle, float pan);
+
+		void SetBusGain(int bus, float gain);
+		void SetBusLowPass(int bus, float cutoffFrequency);
+		void SetBusReverbSend(int bus, float send);
+		void SetReverbGain(float gain);
+
+		// Stops all voices, which are using this sound, and waits until the audio thread stops using its data.
+		void ForgetSound(PcSound pSound);
+
+		// Mixes on calling thread. Returns the time it took, in seconds.
+		// Useful as a benchmark: compare it with the duration.
+		double RenderToWAV(CSZ pathname, float duration);
+
+		RcStats GetStats() const { return _stats; }
+
+		VERUS_P(void PushCommand(const Command& command));
+		VERUS_P(bool FindVoice(VoiceHandle handle, int& index, UINT32& generation) const);
+		VERUS_P(void Flush());
+		VERUS_P(void ThreadProc());
+		VERUS_P(void ProcessCommands());
+		VERUS_P(void MixBlock());
+		VERUS_P(void MixVoice(Voice& voice, float* pL, float* pR));
+		VERUS_P(void ProcessReverb(const float* pIn, float* pL, float* pR));
+		VERUS_P(static void UpdateTargetGains(Voice& voice));
+	};
+	VERUS_TYPEDEFS(Mixer);
+}
@@ -8,6 +8,7 @@ using namespace verus::Audio;
 
 Sound::Sound()
 {
+	_decoded = false;
 }
 
 Sound::~Sound()
@@ -28,9 +29,11 @@ void Sound::Init(RcDesc desc)
 	if (desc._looping) SetFlag(SoundFlags::looping);
 	if (desc._randomOffset) SetFlag(SoundFlags::randOff);
 	if (desc._keepPcmBuffer) SetFlag(SoundFlags::keepPcmBuffer);
+	if (desc._pcmCache) SetFlag(SoundFlags::pcmCache);
 	_gain = desc._gain;
 	_pitch = desc._pitch;
 	_referenceDistance = desc._referenceDistance;
+	_priority = desc._priority;
 
 	IO::Async::I().Load(desc._url, this);
 }
@@ -41,6 +44,11 @@ bool Sound::Done()
 	if (_refCount <= 0)
 	{
 		IO::Async::Cancel(this);
+		if (AudioSystem::IsValidSingleton())
+		{
+			AudioSystem::I().CancelDecode(this);
+			AudioSystem::I().GetMixer().ForgetSound(this);
+		}
 		VERUS_FOR(i, VERUS_COUNT_OF(_sources))
 			_sources[i].Done();
 		if (_buffer)
@@ -53,29 +61,57 @@ bool Sound::Done()
 
 void Sound::Update()
 {
-	if (!IsLoaded())
-		return;
-	VERUS_UPDATE_ONCE_CHECK;
+	if (!IsLoaded() && _decoded.load(std::memory_order_acquire))
+		CreateBuffer();
+}
 
-	VERUS_FOR(i, VERUS_COUNT_OF(_sources))
-		_sources[i].Update();
+void Sound::Async_WhenLoaded(CSZ url, RcBlob blob)
+{
+	VERUS_RT_ASSERT(_url == url);
+	VERUS_RT_ASSERT(!_buffer);
+	VERUS_RT_ASSERT(blob._size);
+
+	AudioSystem::I().DecodeSound(this, blob, IsFlagSet(SoundFlags::pcmCache));
 }
 
-void Sound::UpdateHRTF()
+void Sound::Decode(RcBlob blob, bool pcmCache)
 {
-	if (!IsLoaded())
-		return;
-	const bool is3D = IsFlagSet(SoundFlags::is3D);
-	VERUS_FOR(i, VERUS_COUNT_OF(_sources))
-		_sources[i].UpdateHRTF(is3D);
+	VERUS_PROFILER_ZONE("Sound/Decode");
+	const auto t0 = std::chrono::steady_clock::now();
+
+	_fromPcmCache = pcmCache && LoadPcmCache(blob);
+	if (!_fromPcmCache)
+	{
+		DecodeVorbis(blob);
+		if (pcmCache && _vPcmBuffer.size() <= s_maxPcmCacheSize)
+			SavePcmCache(blob);
+	}
+
+	_decodeTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - t0).count();
+	_decoded.store(true, std::memory_order_release); // Main thread will create the buffer.
 }
 
-void Sound::Async_WhenLoaded(CSZ url, RcBlob blob)
+void Sound::CreateBuffer()
 {
-	VERUS_RT_ASSERT(_url == url);
 	VERUS_RT_ASSERT(!_buffer);
-	VERUS_RT_ASSERT(blob._size);
 
+	const ALenum format = (_channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+	alGenBuffers(1, &_buffer);
+	alBufferData(_buffer, format, _vPcmBuffer.data(), Utils::Cast32(_vPcmBuffer.size()), _sampleRate);
+
+	if (!IsFlagSet(SoundFlags::keepPcmBuffer))
+	{
+		_vPcmBuffer.clear();
+		_vPcmBuffer.shrink_to_fit();
+	}
+
+	VERUS_LOG_DEBUG("CreateBuffer(); url=" << _url << ", decodeTime=" << _decodeTime * 1000 << " ms" << (_fromPcmCache ? " (PCM cache)" : ""));
+
+	SetFlag(SoundFlags::loaded);
+}
+
+void Sound::DecodeVorbis(RcBlob blob)
+{
 	OggDataSource oggds;
 	oggds._p = blob._p;
 	oggds._size = blob._size;
@@ -87,30 +123,82 @@ void Sound::Async_WhenLoaded(CSZ url, RcBlob blob)
 		throw VERUS_RUNTIME_ERROR << "ov_open_callbacks(); " << ret;
 
 	povi = ov_info(&ovf, -1);
-	const ALenum format = (povi->channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-
-	alGenBuffers(1, &_buffer);
+	_channels = povi->channels;
+	_sampleRate = povi->rate;
 
 	_length = static_cast<float>(ov_time_total(&ovf, -1));
 	const INT64 pcmSize = ov_pcm_total(&ovf, -1) * 2 * povi->channels + 1;
 	_vPcmBuffer.resize(pcmSize);
 	int bitstream, offset = 0;
 	long count = ov_read(&ovf, reinterpret_cast<char*>(_vPcmBuffer.data()), Utils::Cast32(_vPcmBuffer.size()), 0, 2, 1, &bitstream);
-	do
+	while (count > 0)
 	{
 		offset += count;
 		count = ov_read(&ovf, reinterpret_cast<char*>(&_vPcmBuffer[offset]), Utils::Cast32(_vPcmBuffer.size()) - offset, 0, 2, 1, &bitstream);
-	} while (count > 0);
-	alBufferData(_buffer, format, _vPcmBuffer.data(), offset, povi->rate);
+	}
+	_vPcmBuffer.resize(offset);
 	ov_clear(&ovf);
+}
 
-	if (!IsFlagSet(SoundFlags::keepPcmBuffer))
+String Sound::GetPcmCachePathname() const
+{
+	char filename[32];
+	sprintf_s(filename, "PcmCache_%08X.bin", Hash(reinterpret_cast<const BYTE*>(_C(_url)), _url.length()));
+	String pathname = _C(Utils::I().GetWritablePath());
+	pathname += filename;
+	return pathname;
+}
+
+bool Sound::LoadPcmCache(RcBlob blob)
+{
+	IO::File file;
+	if (!file.Open(_C(GetPcmCachePathname()), "rb"))
+		return false;
+
+	PcmCacheHeader header;
+	if (file.Read(&header, sizeof(header)) != sizeof(header) ||
+		header._magic != s_pcmCacheMagic ||
+		header._dataSize != blob._size ||
+		header._dataHash != Hash(blob._p, blob._size) ||
+		header._pcmSize > s_maxPcmCacheSize)
+		return false; // Stale or corrupted, will be overwritten.
+
+	_vPcmBuffer.resize(header._pcmSize);
+	if (file.Read(_vPcmBuffer.data(), header._pcmSize) != header._pcmSize)
+		return false;
+	_channels = header._channels;
+	_sampleRate = header._sampleRate;
+	_length = header._length;
+	return true;
+}
+
+void Sound::SavePcmCache(RcBlob blob)
+{
+	IO::File file;
+	if (!file.Open(_C(GetPcmCachePathname()), "wb"))
+		return; // Cache is optional.
+
+	PcmCacheHeader header;
+	header._magic = s_pcmCacheMagic;
+	header._dataHash = Hash(blob._p, blob._size);
+	header._dataSize = blob._size;
+	header._pcmSize = _vPcmBuffer.size();
+	header._channels = _channels;
+	header._sampleRate = _sampleRate;
+	header._length = _length;
+	file.Write(&header, sizeof(header));
+	file.Write(_vPcmBuffer.data(), _vPcmBuffer.size());
+}
+
+UINT32 Sound::Hash(const BYTE* p, INT64 size)
+{
+	UINT32 hash = 2166136261; // FNV-1a.
+	for (INT64 i = 0; i < size; ++i)
 	{
-		_vPcmBuffer.clear();
-		_vPcmBuffer.shrink_to_fit();
+		hash ^= p[i];
+		hash *= 16777619;
 	}
-
-	SetFlag(SoundFlags::loaded);
+	return hash;
 }
 
 SourcePtr Sound::NewSource(PSourcePtr pID, Source::RcDesc desc)
@@ -121,40 +209,14 @@ SourcePtr Sound::NewSource(PSourcePtr pID, Source::RcDesc desc)
 		source.Attach(_sources + _next, this);
 		VERUS_CIRCULAR_ADD(_next, VERUS_COUNT_OF(_sources));
 
-		if (source->_sid) // Delete existing?
-			alDeleteSources(1, &source->_sid);
-
-		alGenSources(1, &source->_sid);
-		const ALuint sid = source->_sid;
-		if (IsFlagSet(SoundFlags::is3D))
-		{
-			alSourcef(sid, AL_REFERENCE_DISTANCE, _referenceDistance);
-			alSourcef(sid, AL_ROLLOFF_FACTOR, 4);
-		}
-		else // No 3D effect?
-		{
-			alSourcei(sid, AL_SOURCE_RELATIVE, AL_TRUE);
-			alSource3f(sid, AL_POSITION, 0, 0, 0);
-			alSource3f(sid, AL_VELOCITY, 0, 0, 0);
-			alSourcef(sid, AL_ROLLOFF_FACTOR, 0);
-		}
-		alSourcef(sid, AL_PITCH, Math::Clamp<float>(_pitch.GetRandomValue() * desc._pitch, 0.5f, 2));
-		alSourcei(sid, AL_LOOPING, IsFlagSet(SoundFlags::looping) ? 1 : 0);
-		alSourcei(sid, AL_BUFFER, _buffer);
-		alSourcef(sid, AL_GAIN, Math::Clamp<float>(_gain.GetRandomValue() * desc._gain, 0, 1));
+		if (source->IsPlaying()) // Reuse this voice?
+			source->Stop();
 
-		if (desc._secOffset < 0)
-		{
-			VERUS_QREF_UTILS;
-			ALint size = 0;
-			alGetBufferi(_buffer, AL_SIZE, &size);
-			const ALint offset = utils.GetRandom().Next() % size;
-			alSourcei(sid, AL_BYTE_OFFSET, offset);
-		}
-		else if (desc._secOffset > 0)
-		{
-			alSourcef(sid, AL_SEC_OFFSET, desc._secOffset);
-		}
+		source->_pitch = Math::Clamp<float>(_pitch.GetRandomValue() * desc._pitch, 0.5f, 2);
+		source->_gain = Math::Clamp<float>(_gain.GetRandomValue() * desc._gain, 0, 1);
+		source->_looping = IsFlagSet(SoundFlags::looping);
+		source->_travelDelay = 0;
+		source->_time = (desc._secOffset < 0) ? GetRandomOffset() : desc._secOffset;
 	}
 	if (pID) // Adjust this source later?
 	{
@@ -172,6 +234,8 @@ float Sound::GetRandomOffset() const
 
 Blob Sound::GetPcmBuffer() const
 {
+	if (!IsLoaded())
+		return Blob();
 	return Blob(_vPcmBuffer.data(), _vPcmBuffer.size());
 }
 
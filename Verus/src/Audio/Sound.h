@@ -12,22 +12,45 @@ namespace verus::Audio
 			looping = (ObjectFlags::user << 2),
 			randOff = (ObjectFlags::user << 3),
 			keepPcmBuffer = (ObjectFlags::user << 4),
-			user = (ObjectFlags::user << 5)
+			pcmCache = (ObjectFlags::user << 5),
+			user = (ObjectFlags::user << 6)
 		};
 	};
 
+	// Vorbis data is decoded on AudioSystem's decoder threads, only the OpenAL buffer is created on main thread.
+	// Short sounds can have their decoded PCM data cached in the writable folder, which skips decoding next time.
 	class Sound : public Object, public IO::AsyncDelegate
 	{
-		Source       _sources[8];
-		String       _url;
-		Vector<BYTE> _vPcmBuffer;
-		ALuint       _buffer = 0;
-		int          _refCount = 0;
-		int          _next = 0;
-		Interval     _gain = 1;
-		Interval     _pitch = 1;
-		float        _referenceDistance = 4;
-		float        _length = 0;
+		struct PcmCacheHeader
+		{
+			UINT32 _magic = 0;
+			UINT32 _dataHash = 0;
+			INT64  _dataSize = 0;
+			INT64  _pcmSize = 0;
+			INT32  _channels = 0;
+			INT32  _sampleRate = 0;
+			float  _length = 0;
+		};
+
+		static const UINT32 s_pcmCacheMagic = 0x314D4350; // "PCM1".
+		static const int s_maxPcmCacheSize = 1024 * 1024;
+
+		Source           _sources[8];
+		String           _url;
+		Vector<BYTE>     _vPcmBuffer;
+		ALuint           _buffer = 0;
+		int              _refCount = 0;
+		int              _next = 0;
+		int              _channels = 0;
+		int              _sampleRate = 0;
+		Interval         _gain = 1;
+		Interval         _pitch = 1;
+		float            _referenceDistance = 4;
+		float            _priority = 1;
+		float            _length = 0;
+		float            _decodeTime = 0;
+		std::atomic_bool _decoded;
+		bool             _fromPcmCache = false;
 
 	public:
 		// Note that this structure contains some default values for new sources, which can be changed per source.
@@ -37,10 +60,12 @@ namespace verus::Audio
 			Interval _gain = 0.8f;
 			Interval _pitch = 1;
 			float    _referenceDistance = 4;
+			float    _priority = 1; // Category weight for voice prioritization.
 			bool     _is3D = false;
 			bool     _looping = false;
 			bool     _randomOffset = false;
 			bool     _keepPcmBuffer = false;
+			bool     _pcmCache = false; // Use for short, frequently used sounds.
 
 			Desc(CSZ url) : _url(url) {}
 			Desc& Set3D(bool b = true) { _is3D = b; return *this; }
@@ -49,6 +74,8 @@ namespace verus::Audio
 			Desc& SetGain(Interval gain) { _gain = gain; return *this; }
 			Desc& SetPitch(Interval pitch) { _pitch = pitch; return *this; }
 			Desc& SetReferenceDistance(float rd) { _referenceDistance = rd; return *this; }
+			Desc& SetPriority(float priority) { _priority = priority; return *this; }
+			Desc& SetPcmCache(bool b = true) { _pcmCache = b; return *this; }
 		};
 		VERUS_TYPEDEFS(Desc);
 
@@ -61,8 +88,8 @@ namespace verus::Audio
 		void Init(RcDesc desc);
 		bool Done();
 
+		// Creates OpenAL buffer after decoding.
 		void Update();
-		void UpdateHRTF();
 
 		// <Resources>
 		virtual void Async_WhenLoaded(CSZ url, RcBlob blob) override;
@@ -70,18 +97,36 @@ namespace verus::Audio
 		Str GetURL() const { return _C(_url); }
 		// </Resources>
 
+		// Called on decoder thread.
+		void Decode(RcBlob blob, bool pcmCache);
+		// Time spent decoding or reading PCM cache, in seconds.
+		float GetDecodeTime() const { return _decodeTime; }
+		bool IsFromPcmCache() const { return _fromPcmCache; }
+
 		SourcePtr NewSource(PSourcePtr pID = nullptr, Source::RcDesc desc = Source::Desc());
 
 		Interval GetGain() const { return _gain; }
 		Interval GetPitch() const { return _pitch; }
+		float GetReferenceDistance() const { return _referenceDistance; }
+		float GetPriority() const { return _priority; }
+		ALuint GetBuffer() const { return _buffer; }
 
 		float GetLength() const { return _length; }
+		int GetChannelCount() const { return _channels; }
+		int GetSampleRate() const { return _sampleRate; }
 
 		float GetRandomOffset() const;
 		void SetRandomOffset(bool b) { b ? SetFlag(SoundFlags::randOff) : ResetFlag(SoundFlags::randOff); }
 		bool HasRandomOffset() const { return IsFlagSet(SoundFlags::randOff); }
 
 		Blob GetPcmBuffer() const;
+
+		VERUS_P(void CreateBuffer());
+		VERUS_P(void DecodeVorbis(RcBlob blob));
+		VERUS_P(String GetPcmCachePathname() const);
+		VERUS_P(bool LoadPcmCache(RcBlob blob));
+		VERUS_P(void SavePcmCache(RcBlob blob));
+		VERUS_P(static UINT32 Hash(const BYTE* p, INT64 size));
 	};
 	VERUS_TYPEDEFS(Sound);
 
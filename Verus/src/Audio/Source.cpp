@@ -6,6 +6,8 @@ using namespace verus::Audio;
 
 // Source:
 
+const float Source::s_rolloffFactor = 4;
+
 Source::Source()
 {
 }
@@ -17,64 +19,24 @@ Source::~Source()
 
 void Source::Done()
 {
-	if (_sid)
-	{
-		alDeleteSources(1, &_sid);
-		_sid = 0;
-		_pSound = nullptr;
-	}
-}
-
-void Source::Update()
-{
-	if (!_sid)
-		return;
-
-	VERUS_QREF_TIMER;
-
-	int state;
-	alGetSourcei(_sid, AL_SOURCE_STATE, &state);
-	if (AL_INITIAL == state)
-	{
-		_travelDelay -= dt;
-		if (_travelDelay <= 0)
-		{
-			if (_pSound->HasRandomOffset())
-				alSourcef(_sid, AL_SEC_OFFSET, _pSound->GetRandomOffset());
-			alSourcePlay(_sid);
-		}
-	}
-}
-
-void Source::UpdateHRTF(bool is3D)
-{
-	if (!_sid)
-		return;
-
-	int state;
-	alGetSourcei(_sid, AL_SOURCE_STATE, &state);
-	if (AL_STOPPED == state)
-	{
-		alDeleteSources(1, &_sid);
-		_sid = 0;
-	}
-	else if (is3D)
-	{
-		alSourcefv(_sid, AL_POSITION, _position.ToPointer());
-		alSourcefv(_sid, AL_DIRECTION, _direction.ToPointer());
-		alSourcefv(_sid, AL_VELOCITY, _velocity.ToPointer());
-	}
+	if (IsPlaying() && AudioSystem::IsValidSingleton())
+		AudioSystem::I().StopSource(this);
+	_pSound = nullptr;
 }
 
 void Source::Play()
 {
 	if (!this)
 		return; // For NewSource()-> pattern.
+	VERUS_QREF_ASYS;
 	if (_pSound && _pSound->IsLoaded())
 	{
+		if (IsPlaying()) // Restart?
+			asys.StopSource(this);
 		if (_pSound->HasRandomOffset())
-			alSourcef(_sid, AL_SEC_OFFSET, _pSound->GetRandomOffset());
-		alSourcePlay(_sid);
+			_time = _pSound->GetRandomOffset();
+		_travelDelay = 0;
+		asys.PlaySource(this);
 	}
 }
 
@@ -85,16 +47,18 @@ void Source::PlayAt(RcPoint3 pos, RcVector3 dir, RcVector3 vel, float delay)
 	VERUS_QREF_ASYS;
 	if (_pSound && _pSound->IsLoaded())
 	{
+		if (IsPlaying()) // Restart?
+			asys.StopSource(this);
 		_travelDelay = asys.ComputeTravelDelay(pos) + delay;
 		MoveTo(pos, dir, vel);
-		UpdateHRTF(_pSound->IsFlagSet(SoundFlags::is3D));
+		asys.PlaySource(this);
 	}
 }
 
 void Source::Stop()
 {
-	if (_pSound && _pSound->IsLoaded())
-		alSourceStop(_sid);
+	if (IsPlaying())
+		AudioSystem::I().StopSource(this);
 }
 
 void Source::MoveTo(RcPoint3 pos, RcVector3 dir, RcVector3 vel)
@@ -110,19 +74,127 @@ void Source::MoveTo(RcPoint3 pos, RcVector3 dir, RcVector3 vel)
 void Source::SetGain(float gain)
 {
 	if (_pSound && _pSound->IsLoaded())
-		alSourcef(_sid, AL_GAIN, Math::Clamp<float>(gain * _pSound->GetGain().GetRandomValue(), 0, 1));
+	{
+		_gain = Math::Clamp<float>(gain * _pSound->GetGain().GetRandomValue(), 0, 1);
+		if (_sid)
+			alSourcef(_sid, AL_GAIN, _gain);
+	}
 }
 
 void Source::SetPitch(float pitch)
 {
 	if (_pSound && _pSound->IsLoaded())
-		alSourcef(_sid, AL_PITCH, Math::Clamp<float>(pitch * _pSound->GetPitch().GetRandomValue(), 0.5f, 2));
+	{
+		_pitch = Math::Clamp<float>(pitch * _pSound->GetPitch().GetRandomValue(), 0.5f, 2);
+		if (_sid)
+			alSourcef(_sid, AL_PITCH, _pitch);
+	}
 }
 
 void Source::SetLooping(bool loop)
 {
 	if (_pSound && _pSound->IsLoaded())
-		alSourcei(_sid, AL_LOOPING, loop ? AL_TRUE : AL_FALSE);
+	{
+		_looping = loop;
+		if (_sid)
+			alSourcei(_sid, AL_LOOPING, loop ? AL_TRUE : AL_FALSE);
+	}
+}
+
+bool Source::Update(float dt)
+{
+	if (State::delayed == _state)
+	{
+		_travelDelay -= dt;
+		if (_travelDelay > 0)
+			return true;
+		_state = State::playing;
+		if (_pSound->HasRandomOffset())
+			_time = _pSound->GetRandomOffset();
+		return true; // AudioSystem will decide if it gets a real voice.
+	}
+
+	if (_sid)
+	{
+		int state;
+		alGetSourcei(_sid, AL_SOURCE_STATE, &state);
+		return AL_STOPPED != state;
+	}
+
+	// Virtual voice:
+	const float length = _pSound->GetLength();
+	_time += dt * _pitch;
+	if (_time >= length)
+	{
+		if (!_looping || length <= 0)
+			return false;
+		_time = fmod(_time, length);
+	}
+	return true;
+}
+
+void Source::UpdateHRTF()
+{
+	if (_sid && _pSound->IsFlagSet(SoundFlags::is3D))
+	{
+		alSourcefv(_sid, AL_POSITION, _position.ToPointer());
+		alSourcefv(_sid, AL_DIRECTION, _direction.ToPointer());
+		alSourcefv(_sid, AL_VELOCITY, _velocity.ToPointer());
+	}
+}
+
+float Source::ComputeAudibility(RcPoint3 listenerPosition) const
+{
+	// Same as AL_INVERSE_DISTANCE_CLAMPED model:
+	float audibility = _gain * _pSound->GetPriority();
+	if (_pSound->IsFlagSet(SoundFlags::is3D))
+	{
+		const float referenceDistance = _pSound->GetReferenceDistance();
+		const float dist = VMath::dist(_position, listenerPosition);
+		if (dist > referenceDistance)
+			audibility *= referenceDistance / (referenceDistance + s_rolloffFactor * (dist - referenceDistance));
+	}
+	return audibility;
+}
+
+void Source::Bind(ALuint sid)
+{
+	VERUS_RT_ASSERT(!_sid);
+	_sid = sid;
+	if (_pSound->IsFlagSet(SoundFlags::is3D))
+	{
+		alSourcei(_sid, AL_SOURCE_RELATIVE, AL_FALSE);
+		alSourcef(_sid, AL_REFERENCE_DISTANCE, _pSound->GetReferenceDistance());
+		alSourcef(_sid, AL_ROLLOFF_FACTOR, s_rolloffFactor);
+		UpdateHRTF();
+	}
+	else // No 3D effect?
+	{
+		alSourcei(_sid, AL_SOURCE_RELATIVE, AL_TRUE);
+		alSource3f(_sid, AL_POSITION, 0, 0, 0);
+		alSource3f(_sid, AL_DIRECTION, 0, 0, 0);
+		alSource3f(_sid, AL_VELOCITY, 0, 0, 0);
+		alSourcef(_sid, AL_ROLLOFF_FACTOR, 0);
+	}
+	alSourcef(_sid, AL_PITCH, _pitch);
+	alSourcei(_sid, AL_LOOPING, _looping ? AL_TRUE : AL_FALSE);
+	alSourcei(_sid, AL_BUFFER, _pSound->GetBuffer());
+	alSourcef(_sid, AL_GAIN, _gain);
+	alSourcef(_sid, AL_SEC_OFFSET, _time);
+	alSourcePlay(_sid);
+}
+
+ALuint Source::Unbind()
+{
+	const ALuint sid = _sid;
+	if (_sid)
+	{
+		alGetSourcef(_sid, AL_SEC_OFFSET, &_time);
+		alSourceStop(_sid);
+		alSourcei(_sid, AL_BUFFER, 0);
+		_sid = 0;
+	}
+	return sid;
 }
 
 // SourcePtr:
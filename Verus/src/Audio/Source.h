@@ -3,17 +3,35 @@
 
 namespace verus::Audio
 {
+	// Source is a voice. It gets a real OpenAL source from AudioSystem's voice pool only when it is among the most audible voices.
+	// Virtual voice keeps track of time, so that it can continue from the right position when it becomes real again.
 	class Source
 	{
 		friend class SourcePtr; // _pSound @ Attach().
-		friend class Sound; // _sid @ NewSource().
+		friend class Sound; // State @ NewSource().
+		friend class AudioSystem; // Voice management.
+
+		enum class State : BYTE
+		{
+			stopped,
+			delayed,
+			playing
+		};
+
+		static const float s_rolloffFactor;
 
 		Point3  _position = Point3(0);
 		Vector3 _direction = Vector3(0);
 		Vector3 _velocity = Vector3(0);
 		Sound* _pSound = nullptr;
-		ALuint  _sid = 0;
+		ALuint  _sid = 0; // Zero for virtual voice.
 		float   _travelDelay = 0;
+		float   _time = 0; // Playback position in seconds, updated when voice is virtual.
+		float   _gain = 1;
+		float   _pitch = 1;
+		float   _audibility = 0;
+		State   _state = State::stopped;
+		bool    _looping = false;
 
 	public:
 		struct Desc
@@ -30,9 +48,6 @@ namespace verus::Audio
 
 		void Done();
 
-		void Update();
-		void UpdateHRTF(bool is3D);
-
 		void Play();
 		void PlayAt(RcPoint3 pos, RcVector3 dir = Vector3(0), RcVector3 vel = Vector3(0), float delay = 0);
 		void Stop();
@@ -41,6 +56,16 @@ namespace verus::Audio
 		void SetGain(float gain);
 		void SetPitch(float pitch);
 		void SetLooping(bool loop);
+
+		bool IsPlaying() const { return State::stopped != _state; }
+		bool IsVirtual() const { return IsPlaying() && !_sid; }
+
+		// Returns false when the voice has finished playing.
+		VERUS_P(bool Update(float dt));
+		VERUS_P(void UpdateHRTF());
+		VERUS_P(float ComputeAudibility(RcPoint3 listenerPosition) const);
+		VERUS_P(void Bind(ALuint sid));
+		VERUS_P(ALuint Unbind());
 	};
 	VERUS_TYPEDEFS(Source);
 
@@ -66,7 +66,6 @@ void StreamPlayer::Init()
 	alSourcef(_source, AL_GAIN, _gain);
 	alSourcef(_source, AL_ROLLOFF_FACTOR, 0);
 
-	_vSmallBuffer.resize(441 * 32);
 	_vMediumBuffer.resize(441 * 32 * 32);
 	_vTracks.reserve(8);
 
@@ -212,6 +211,7 @@ void StreamPlayer::ThreadProc()
 	try
 	{
 		SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+		VERUS_PROFILER_THREAD_NAME("StreamPlayer");
 		while (!IsFlagSet(StreamPlayerFlags::stopThread))
 		{
 			VERUS_LOCK(*this);
@@ -220,6 +220,7 @@ void StreamPlayer::ThreadProc()
 
 			if (IsFlagSet(StreamPlayerFlags::play))
 			{
+				VERUS_PROFILER_ZONE("StreamPlayer/ThreadProc");
 				SetFlag(StreamPlayerFlags::noLock);
 				if (_pTrack)
 				{
@@ -297,15 +298,15 @@ void StreamPlayer::StopThread()
 void StreamPlayer::FillBuffer(ALuint buffer)
 {
 	VERUS_RT_ASSERT(IsInitialized());
-	int bitstream, oggCursor = 0, safeSize = Utils::Cast32(_vMediumBuffer.size() - _vSmallBuffer.size());
-	while (oggCursor < safeSize)
+	// Decode directly into the buffer, which is sent to OpenAL:
+	int bitstream, oggCursor = 0, size = Utils::Cast32(_vMediumBuffer.size());
+	while (oggCursor < size)
 	{
 		long count = -1;
 		if (_pTrack && _pTrack->IsLoaded())
-			count = ov_read(&_oggVorbisFile, reinterpret_cast<char*>(_vSmallBuffer.data()), Utils::Cast32(_vSmallBuffer.size()), 0, 2, 1, &bitstream);
+			count = ov_read(&_oggVorbisFile, reinterpret_cast<char*>(&_vMediumBuffer[oggCursor]), size - oggCursor, 0, 2, 1, &bitstream);
 		if (count > 0)
 		{
-			memcpy(&_vMediumBuffer[oggCursor], _vSmallBuffer.data(), count);
 			oggCursor += count;
 		}
 		else if (0 == count) // No more data?
@@ -320,7 +321,7 @@ void StreamPlayer::FillBuffer(ALuint buffer)
 				ov_raw_seek(&_oggVorbisFile, 0); // Start from the beginning.
 		}
 		else
-			safeSize = 0; // Still loading? Exit.
+			size = 0; // Still loading? Exit.
 	}
 	if (_pVorbisInfo)
 		alBufferData(buffer, _format, _vMediumBuffer.data(), oggCursor, _pVorbisInfo->rate);
@@ -36,7 +36,6 @@ namespace verus::Audio
 	{
 		Track                   _nativeTrack;
 		Vector<PTrack>          _vTracks;
-		Vector<BYTE>            _vSmallBuffer;
 		Vector<BYTE>            _vMediumBuffer;
 		std::thread             _thread;
 		std::condition_variable _cv;
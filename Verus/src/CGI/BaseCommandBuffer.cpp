@@ -63,6 +63,14 @@ void CommandBufferPtr::InitOneTimeSubmit()
 	_p->InitOneTimeSubmit();
 }
 
+void CommandBufferPtr::InitSecondary()
+{
+	VERUS_QREF_RENDERER;
+	VERUS_RT_ASSERT(!_p);
+	_p = renderer->InsertCommandBuffer();
+	_p->InitSecondary();
+}
+
 void CommandBufferPwn::Done()
 {
 	if (_p)
@@ -18,11 +18,26 @@ namespace verus::CGI
 		setAllForCurrentViewScaled = setAllForCurrentView | applyOffscreenScale
 	};
 
+	// Subpass can either be recorded directly or consist of secondary command buffers only.
+	enum class SubpassContents : int
+	{
+		inlined,
+		secondaryCommandBuffers
+	};
+
+	class CommandBufferPtr;
+
 	class BaseCommandBuffer : public Object, public Scheduled
 	{
 	protected:
-		Vector4 _viewportSize = Vector4(0);
-		Vector4 _viewScaleBias = Vector4(0);
+		Vector4         _viewportSize = Vector4(0);
+		Vector4         _viewScaleBias = Vector4(0);
+		RPHandle        _renderPassHandle; // Current render pass, secondary command buffers continue it.
+		FBHandle        _framebufferHandle;
+		int             _subpass = 0;
+		SubpassContents _subpassContents = SubpassContents::inlined;
+		int             _uniformAllocator = 0; // Primary command buffers use the first one.
+		bool            _secondary = false;
 
 		void SetViewportAndScissor(ViewportScissorFlags vsf, int width, int height);
 
@@ -36,16 +51,24 @@ namespace verus::CGI
 		virtual void InitOneTimeSubmit() = 0;
 		virtual void DoneOneTimeSubmit() = 0;
 
+		// Secondary command buffer can be recorded on another thread, each thread must use its own command buffer.
+		// It continues a subpass, which was started with SubpassContents::secondaryCommandBuffers.
+		virtual void InitSecondary() = 0;
+
 		virtual void Begin() = 0;
 		virtual void End() = 0;
+		virtual void BeginSecondary(RPHandle renderPassHandle, int subpass, FBHandle framebufferHandle,
+			ViewportScissorFlags vsf = ViewportScissorFlags::setAllForCurrentViewScaled) = 0;
+		virtual void ExecuteSecondary(const CommandBufferPtr* pCommandBuffers, int count) = 0;
 
 		virtual void PipelineImageMemoryBarrier(TexturePtr tex, ImageLayout oldLayout, ImageLayout newLayout,
 			Range mipLevels, Range arrayLayers = 0) = 0;
 
 		// <RenderPass>
 		virtual void BeginRenderPass(RPHandle renderPassHandle, FBHandle framebufferHandle,
-			std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf = ViewportScissorFlags::setAllForCurrentViewScaled) = 0;
-		virtual void NextSubpass() = 0;
+			std::initializer_list<Vector4> ilClearValues, ViewportScissorFlags vsf = ViewportScissorFlags::setAllForCurrentViewScaled,
+			SubpassContents contents = SubpassContents::inlined) = 0;
+		virtual void NextSubpass(SubpassContents contents = SubpassContents::inlined) = 0;
 		virtual void EndRenderPass() = 0;
 		// </RenderPass>
 
@@ -62,7 +85,9 @@ namespace verus::CGI
 		// </VertexInput>
 
 		// <Descriptors>
-		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle = CSHandle()) = 0;
+		// Uniform buffer's data is taken from pSrc, if it's not null, otherwise from the pointer given to CreateDescriptorSet().
+		// Use pSrc when recording on multiple threads.
+		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, CSHandle complexSetHandle = CSHandle(), const void* pSrc = nullptr) = 0;
 		virtual bool BindDescriptors(ShaderPtr shader, int setNumber, GeometryPtr geo, int sbIndex) = 0;
 		virtual void PushConstants(ShaderPtr shader, int offset, int size, const void* p, ShaderStageFlags stageFlags = ShaderStageFlags::vs_fs) = 0;
 		// </Descriptors>
@@ -84,6 +109,14 @@ namespace verus::CGI
 
 		RcVector4 GetViewportSize() const { return _viewportSize; }
 		RcVector4 GetViewScaleBias() const { return _viewScaleBias; }
+
+		RPHandle GetRenderPassHandle() const { return _renderPassHandle; }
+		FBHandle GetFramebufferHandle() const { return _framebufferHandle; }
+		int GetSubpass() const { return _subpass; }
+		SubpassContents GetSubpassContents() const { return _subpassContents; }
+
+		int GetUniformAllocator() const { return _uniformAllocator; }
+		bool IsSecondary() const { return _secondary; }
 	};
 	VERUS_TYPEDEFS(BaseCommandBuffer);
 
@@ -92,6 +125,7 @@ namespace verus::CGI
 	public:
 		void Init();
 		void InitOneTimeSubmit();
+		void InitSecondary();
 	};
 	VERUS_TYPEDEFS(CommandBufferPtr);
 
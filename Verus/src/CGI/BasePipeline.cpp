@@ -11,7 +11,8 @@ void PipelinePtr::Init(RcPipelineDesc desc)
 	VERUS_QREF_RENDERER;
 	VERUS_RT_ASSERT(!_p);
 	_p = renderer->InsertPipeline();
-	_p->Init(desc);
+	if (!renderer.AddToPipelineBatch(_p, desc))
+		_p->Init(desc);
 }
 
 void PipelinePwn::Done()
@@ -45,6 +45,54 @@ PBaseRenderer BaseRenderer::Load(CSZ dll, RBaseRendererDesc desc)
 #endif
 }
 
+int BaseRenderer::AcquireUniformAllocator()
+{
+	VERUS_FOR(i, s_uniformAllocatorCount)
+	{
+		if (!((_uniformAllocatorMask >> i) & 0x1))
+		{
+			_uniformAllocatorMask |= (1U << i);
+			return i;
+		}
+	}
+	throw VERUS_RUNTIME_ERROR << "AcquireUniformAllocator(); Too many secondary command buffers";
+}
+
+void BaseRenderer::ReleaseUniformAllocator(int index)
+{
+	VERUS_RT_ASSERT(index > 0 && index < s_uniformAllocatorCount);
+	_uniformAllocatorMask &= ~(1U << index);
+}
+
+void BaseRenderer::ScheduleUniformBufferGrowth(PBaseShader p)
+{
+	std::lock_guard<std::mutex> lock(_growingShadersMutex);
+	if (_vGrowingShaders.end() != std::find(_vGrowingShaders.begin(), _vGrowingShaders.end(), p))
+		return;
+	_vGrowingShaders.push_back(p);
+}
+
+void BaseRenderer::UnscheduleUniformBufferGrowth(PBaseShader p)
+{
+	std::lock_guard<std::mutex> lock(_growingShadersMutex);
+	_vGrowingShaders.erase(std::remove(_vGrowingShaders.begin(), _vGrowingShaders.end(), p), _vGrowingShaders.end());
+}
+
+void BaseRenderer::GrowUniformBuffers()
+{
+	Vector<PBaseShader> vShaders;
+	{
+		std::lock_guard<std::mutex> lock(_growingShadersMutex);
+		if (_vGrowingShaders.empty())
+			return;
+		vShaders.swap(_vGrowingShaders);
+	}
+
+	WaitIdle(); // Previous frames can still use these buffers.
+	for (auto p : vShaders)
+		p->GrowUniformBuffers();
+}
+
 void BaseRenderer::Schedule(PScheduled p)
 {
 	if (_vScheduled.end() != std::find(_vScheduled.begin(), _vScheduled.end(), p))
@@ -25,17 +25,22 @@ namespace verus::CGI
 	class BaseRenderer : public Object
 	{
 	protected:
-		Vector<PScheduled> _vScheduled;
-		BaseRendererDesc   _desc;
-		int                _swapChainBufferCount = 0;
-		int                _swapChainBufferIndex = 0;
-		int                _ringBufferIndex = 0;
+		Vector<PScheduled>  _vScheduled;
+		Vector<PBaseShader> _vGrowingShaders;
+		std::mutex          _growingShadersMutex;
+		BaseRendererDesc    _desc;
+		int                 _swapChainBufferCount = 0;
+		int                 _swapChainBufferIndex = 0;
+		int                 _ringBufferIndex = 0;
+		UINT64              _ringBufferFrameCount = 0; // Also counts frames, which were not presented.
+		UINT32              _uniformAllocatorMask = 0x1; // First one is for primary command buffers.
 
 		BaseRenderer();
 		virtual ~BaseRenderer();
 
 	public:
 		static const int s_ringBufferSize = 3;
+		static const int s_uniformAllocatorCount = 32; // Primary command buffers and secondary ones, which can be recorded in parallel.
 
 		static BaseRenderer* Load(CSZ dll, RBaseRendererDesc desc);
 		virtual void ReleaseMe() = 0;
@@ -45,6 +50,7 @@ namespace verus::CGI
 		int GetSwapChainBufferCount() const { return _swapChainBufferCount; }
 		int GetSwapChainBufferIndex() const { return _swapChainBufferIndex; }
 		int GetRingBufferIndex() const { return _ringBufferIndex; }
+		UINT64 GetRingBufferFrameCount() const { return _ringBufferFrameCount; }
 
 		void Schedule(PScheduled p);
 		void Unschedule(PScheduled p);
@@ -68,6 +74,17 @@ namespace verus::CGI
 		virtual void OnMinimized() = 0;
 		// </FrameCycle>
 
+		// <ParallelRecording>
+		virtual bool IsParallelRecordingSupported() const { return false; }
+		int AcquireUniformAllocator();
+		void ReleaseUniformAllocator(int index);
+		// Uniform buffers can only grow when the GPU is not using them, this is done by GrowUniformBuffers() at the beginning of the next frame.
+		// Schedule is thread-safe.
+		void ScheduleUniformBufferGrowth(PBaseShader p);
+		void UnscheduleUniformBufferGrowth(PBaseShader p);
+		void GrowUniformBuffers();
+		// </ParallelRecording>
+
 		// <Resources>
 		virtual PBaseCommandBuffer InsertCommandBuffer() = 0;
 		virtual PBaseGeometry      InsertGeometry() = 0;
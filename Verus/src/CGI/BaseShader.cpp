@@ -12,41 +12,46 @@ void BaseShader::Load(CSZ url)
 	IO::FileSystem::LoadResource(url, vData, IO::FileSystem::LoadDesc(true));
 
 	Vector<String> vBranches;
-	CSZ pSource = reinterpret_cast<CSZ>(vData.data());
-	CSZ p = strstr(pSource, s_branchCommentMarker);
+	GetBranches(reinterpret_cast<CSZ>(vData.data()), _userDefines, vBranches);
+
+	Vector<CSZ> vBranchPtrs;
+	vBranchPtrs.reserve(vBranches.size() + 1);
+	VERUS_FOREACH_CONST(Vector<String>, vBranches, it)
+		vBranchPtrs.push_back(_C(*it));
+	vBranchPtrs.push_back(nullptr);
+
+	const size_t pakPos = IO::FileSystem::FindPosForPAK(url);
+	if (pakPos != String::npos)
+		url = url + pakPos + 2;
+	Init(reinterpret_cast<CSZ>(vData.data()), url, vBranchPtrs.data());
+}
+
+void BaseShader::GetBranches(CSZ source, CSZ userDefines, Vector<String>& vBranches)
+{
+	vBranches.clear();
+	CSZ p = strstr(source, s_branchCommentMarker);
 	const size_t branchCommentMarkerLen = strlen(s_branchCommentMarker);
 	while (p)
 	{
 		const size_t span = strcspn(p, VERUS_CRNL);
 		String value(p + branchCommentMarkerLen, span - branchCommentMarkerLen);
-		if (_userDefines)
+		if (userDefines)
 		{
 			if (Str::EndsWith(_C(value), ")"))
 			{
 				const size_t pos = value.rfind("(");
 				value.insert(pos, " ");
-				value.insert(pos, _userDefines);
+				value.insert(pos, userDefines);
 			}
 			else
 			{
 				value += " ";
-				value += _userDefines;
+				value += userDefines;
 			}
 		}
 		vBranches.push_back(value);
 		p = strstr(p + span, s_branchCommentMarker);
 	}
-
-	Vector<CSZ> vBranchPtrs;
-	vBranchPtrs.reserve(vBranches.size() + 1);
-	VERUS_FOREACH_CONST(Vector<String>, vBranches, it)
-		vBranchPtrs.push_back(_C(*it));
-	vBranchPtrs.push_back(nullptr);
-
-	const size_t pakPos = IO::FileSystem::FindPosForPAK(url);
-	if (pakPos != String::npos)
-		url = url + pakPos + 2;
-	Init(reinterpret_cast<CSZ>(vData.data()), url, vBranchPtrs.data());
 }
 
 String BaseShader::Parse(
@@ -146,6 +151,34 @@ void BaseShader::TestParse()
 		entry, stageEntries, stages, vMacroName, vMacroValue, "DEF_");
 }
 
+void BaseShader::GetSystemDefines(App::RcQualitySettings qs, Vector<String>& vDefines)
+{
+	vDefines.push_back("_ANISOTROPY_LEVEL");
+	vDefines.push_back(std::to_string(qs._gpuAnisotropyLevel));
+	vDefines.push_back("_SHADER_QUALITY");
+	vDefines.push_back(std::to_string(+qs._gpuShaderQuality));
+	vDefines.push_back("_SHADOW_QUALITY");
+	vDefines.push_back(std::to_string(+qs._sceneShadowQuality));
+	vDefines.push_back("_WATER_QUALITY");
+	vDefines.push_back(std::to_string(+qs._sceneWaterQuality));
+	vDefines.push_back("VERUS_MAX_BONES");
+	vDefines.push_back(std::to_string(VERUS_MAX_BONES));
+}
+
+char BaseShader::GetStageLetter(Stage stage)
+{
+	static const char letters[] = "VHDGFC";
+	VERUS_CT_ASSERT(sizeof(letters) == +Stage::count + 1);
+	return letters[+stage];
+}
+
+CSZ BaseShader::GetStageDefine(Stage stage)
+{
+	static CSZ defines[] = { "_VS", "_HS", "_DS", "_GS", "_FS", "_CS" };
+	VERUS_CT_ASSERT(VERUS_COUNT_OF(defines) == +Stage::count);
+	return defines[+stage];
+}
+
 bool BaseShader::IsInIgnoreList(CSZ name) const
 {
 	if (!_ignoreList)
@@ -55,6 +55,12 @@ namespace verus::CGI
 			Vector<String>& vMacroValue,
 			CSZ prefix);
 		static void TestParse();
+		// Finds branch descriptions (//@ comments) in the source, user defines are added to each branch.
+		static void GetBranches(CSZ source, CSZ userDefines, Vector<String>& vBranches);
+		// Adds macros, which depend on quality settings, as name-value pairs.
+		static void GetSystemDefines(App::RcQualitySettings qs, Vector<String>& vDefines);
+		static char GetStageLetter(Stage stage);
+		static CSZ GetStageDefine(Stage stage);
 
 		virtual void CreateDescriptorSet(int setNumber, const void* pSrc, int size,
 			int capacity = 1, std::initializer_list<Sampler> il = {}, ShaderStageFlags stageFlags = ShaderStageFlags::vs_fs) = 0;
@@ -66,6 +72,9 @@ namespace verus::CGI
 		virtual void BeginBindDescriptors() = 0;
 		virtual void EndBindDescriptors() = 0;
 
+		// Called by the renderer between frames, when the GPU is idle, see BaseRenderer::ScheduleUniformBufferGrowth().
+		virtual void GrowUniformBuffers() {}
+
 		Str GetSourceName() const { return _C(_sourceName); }
 
 		void SetIgnoreList(CSZ* list) { _ignoreList = list; }
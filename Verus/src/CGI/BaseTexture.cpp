@@ -53,6 +53,30 @@ void BaseTexture::LoadDDS(CSZ url, int texturePart)
 	IO::Async::I().Load(url, this, IO::Async::TaskDesc(false, false, texturePart));
 }
 
+void BaseTexture::LoadDDSParts(CSZ url, int texturePart, int texturePartCount)
+{
+	VERUS_RT_ASSERT(IsLoaded() && (_desc._flags & TextureDesc::Flags::fullMipChain));
+	VERUS_RT_ASSERT(texturePart >= GetMipChainPart() && texturePart + texturePartCount <= _loadedPart);
+	// Missing parts are not fatal, the texture keeps what it has:
+	IO::Async::TaskDesc taskDesc(false, true, texturePart);
+	taskDesc._texturePartCount = texturePartCount;
+	_loadingPart = texturePart;
+	IO::Async::I().Load(url, this, taskDesc);
+}
+
+void BaseTexture::SetPart(int part)
+{
+	VERUS_RT_ASSERT(_desc._flags & TextureDesc::Flags::fullMipChain);
+	VERUS_RT_ASSERT(part >= _loadedPart);
+	_part = part;
+	SetMostDetailedMip(Math::Clamp(part - GetMipChainPart() - _lod, 0, _desc._mipLevels - 1));
+}
+
+void BaseTexture::SetMostDetailedMip(int mipLevel)
+{
+	_mostDetailedMip = mipLevel;
+}
+
 void BaseTexture::LoadDDS(CSZ url, RcBlob blob)
 {
 	_name = url;
@@ -75,20 +99,31 @@ void BaseTexture::LoadDDS(CSZ url, RcBlob blob)
 	if (!header._mipMapCount)
 		header._mipMapCount = 1;
 
-	const int maxLod = Math::Max<int>(header._mipMapCount - 4, 0); // Keep 1x1, 2x2, 4x4.
-	const int lod = Math::Min(settings._gpuTextureLodLevel, maxLod);
+	// With full mip chain the first level in blob is not necessarily the most detailed level:
+	const bool fullMipChain = header.IsBC() && (_desc._flags & TextureDesc::Flags::fullMipChain);
+	const bool loadingMoreParts = fullMipChain && IsLoaded();
+	const int mipChainPart = (fullMipChain && _desc._mipChainPart >= 0) ? Math::Min<int>(_desc._mipChainPart, _part) : _part;
+	const int firstMip = _part - mipChainPart;
+
+	const int maxLod = Math::Max<int>(header._mipMapCount + firstMip - 4, 0); // Keep 1x1, 2x2, 4x4.
+	const int lod = loadingMoreParts ? _lod : Math::Min(settings._gpuTextureLodLevel, maxLod);
 
 	if (header.IsBC())
 	{
-		TextureDesc desc;
-		desc._format = ToTextureBcFormat(header, header10);
-		desc._width = header._width >> lod;
-		desc._height = header._height >> lod;
-		desc._mipLevels = header._mipMapCount - lod;
-		desc._flags = _desc._flags;
-		desc._pSamplerDesc = _desc._pSamplerDesc;
+		if (!loadingMoreParts)
+		{
+			TextureDesc desc;
+			desc._format = ToTextureBcFormat(header, header10);
+			desc._width = (header._width << firstMip) >> lod;
+			desc._height = (header._height << firstMip) >> lod;
+			desc._mipLevels = header._mipMapCount + firstMip - lod;
+			desc._flags = _desc._flags;
+			desc._mipChainPart = mipChainPart;
+			desc._pSamplerDesc = _desc._pSamplerDesc;
 
-		Init(desc);
+			Init(desc);
+			_lod = lod;
+		}
 
 		for (UINT32 i = 0; i < header._mipMapCount; ++i)
 		{
@@ -98,11 +133,18 @@ void BaseTexture::LoadDDS(CSZ url, RcBlob blob)
 			const int levelSize = IO::DDSHeader::ComputeBcLevelSize(w, h, header.Is4BitsBC());
 			VERUS_RT_ASSERT(offset + levelSize <= blob._size);
 
-			if (static_cast<int>(i) >= lod)
-				UpdateSubresource(blob._p + offset, i - lod);
+			const int mip = static_cast<int>(i) + firstMip;
+			if (mip >= lod)
+				UpdateSubresource(blob._p + offset, mip - lod);
 
 			offset += levelSize;
 		}
+
+		if (fullMipChain)
+		{
+			_loadedPart = _part;
+			SetPart(_part);
+		}
 	}
 	else // Not DXTn?
 	{
@@ -294,6 +336,16 @@ void BaseTexture::LoadDDSArray(CSZ* urls)
 void BaseTexture::Async_WhenLoaded(CSZ url, RcBlob blob)
 {
 	LoadDDS(url, blob);
+	_loadingPart = -1;
+}
+
+void BaseTexture::Async_WhenFailed(CSZ url)
+{
+	if (IsLoadingParts())
+	{
+		VERUS_LOG_WARN("Async_WhenFailed(); Failed to load part " << _loadingPart << " (" << url << ").");
+		_loadingPart = -1;
+	}
 }
 
 int BaseTexture::FormatToBytesPerPixel(Format format)
@@ -364,6 +416,7 @@ void TexturePtr::Init(RcTextureDesc desc)
 	_p = renderer->InsertTexture();
 	_p->SetLoadingFlags(desc._flags);
 	_p->SetLoadingSamplerDesc(desc._pSamplerDesc);
+	_p->SetLoadingMipChainPart(desc._mipChainPart);
 	if (desc._flags & TextureDesc::Flags::sync)
 	{
 		Vector<BYTE> vData;
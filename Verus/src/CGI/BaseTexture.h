@@ -38,7 +38,8 @@ namespace verus::CGI
 			forceArrayTexture = (1 << 6), // Create array texture even if arrayLayers=1.
 			sync = (1 << 7), // Load image data synchronously.
 			exposureMips = (1 << 8), // Internal flag for automatic exposure.
-			cubeMap = (1 << 9)
+			cubeMap = (1 << 9),
+			fullMipChain = (1 << 10) // Allocate mip levels starting at _mipChainPart, so that more detailed parts can be loaded later.
 		};
 
 		Vector4       _clearValue = Vector4(0);
@@ -55,6 +56,7 @@ namespace verus::CGI
 		short         _sampleCount = 1;
 		Flags         _flags = Flags::none;
 		short         _texturePart = 0;
+		short         _mipChainPart = -1; // With fullMipChain: part which becomes mip level 0, -1 means the loaded part.
 		short         _readbackMip = SHRT_MAX; // -1 means the smallest one, SHRT_MAX means readback is disabled.
 
 		TextureDesc(CSZ url = nullptr) : _url(url) {}
@@ -78,6 +80,10 @@ namespace verus::CGI
 		UINT64      _initAtFrame = 0;
 		ImageLayout _mainLayout = ImageLayout::fsReadOnly;
 		int         _part = 0;
+		int         _loadedPart = 0;
+		int         _loadingPart = -1; // Requested by LoadDDSParts().
+		int         _lod = 0;
+		int         _mostDetailedMip = 0;
 		int         _bytesPerPixel = 0;
 
 		BaseTexture();
@@ -100,18 +106,30 @@ namespace verus::CGI
 		int GetArrayLayerCount() const { return _desc._arrayLayers; }
 
 		int GetPart() const { return _part; }
+		int GetLoadedPart() const { return _loadedPart; }
+		int GetMipChainPart() const { return _desc._mipChainPart; }
+		int GetMostDetailedMip() const { return _mostDetailedMip; }
 		RcVector4 GetSize() const { return _size; }
 		bool IsSRGB() const;
 		Format ToTextureBcFormat(IO::RcDDSHeader header, IO::RcDDSHeaderDXT10 header10) const;
 
 		void SetLoadingFlags(TextureDesc::Flags flags) { _desc._flags = flags; }
 		void SetLoadingSamplerDesc(PcSamplerDesc pSamplerDesc) { _desc._pSamplerDesc = pSamplerDesc; }
+		void SetLoadingMipChainPart(int part) { _desc._mipChainPart = part; }
 
 		void LoadDDS(CSZ url, int texturePart = 0);
 		void LoadDDS(CSZ url, RcBlob blob);
 		void LoadDDSArray(CSZ* urls);
 
+		// <FullMipChain>
+		void LoadDDSParts(CSZ url, int texturePart, int texturePartCount);
+		bool IsLoadingParts() const { return _loadingPart >= 0; } // False also when loading has failed.
+		void SetPart(int part);
+		virtual void SetMostDetailedMip(int mipLevel);
+		// </FullMipChain>
+
 		virtual void Async_WhenLoaded(CSZ url, RcBlob blob) override;
+		virtual void Async_WhenFailed(CSZ url) override;
 
 		virtual void UpdateSubresource(const void* p, int mipLevel = 0, int arrayLayer = 0, BaseCommandBuffer* pCB = nullptr) = 0;
 		virtual bool ReadbackSubresource(void* p, bool recordCopyCommand = true, BaseCommandBuffer* pCB = nullptr) = 0;
@@ -9,6 +9,7 @@
 #include "BaseGeometry.h"
 #include "BaseTexture.h"
 #include "BaseShader.h"
+#include "ShaderCache.h"
 #include "BasePipeline.h"
 #include "BaseCommandBuffer.h"
 #include "BaseExtReality.h"
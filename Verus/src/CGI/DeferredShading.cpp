@@ -624,7 +624,7 @@ void DeferredShading::Draw(int gbuffer,
 	shader->EndBindDescriptors();
 }
 
-void DeferredShading::BeginGeometryPass()
+void DeferredShading::BeginGeometryPass(SubpassContents contents)
 {
 	VERUS_QREF_RENDERER;
 	VERUS_RT_ASSERT(!_activeGeometryPass && !_activeLightingPass && !_activeForwardRendering);
@@ -645,7 +645,8 @@ void DeferredShading::BeginGeometryPass()
 			_tex[TEX_LIGHT_ACC_DIFFUSE]->GetClearValue(),
 			_tex[TEX_LIGHT_ACC_SPECULAR]->GetClearValue(),
 			renderer.GetTexDepthStencil()->GetClearValue()
-		});
+		},
+		ViewportScissorFlags::setAllForCurrentViewScaled, contents);
 }
 
 void DeferredShading::EndGeometryPass()
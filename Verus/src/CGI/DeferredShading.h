@@ -162,7 +162,9 @@ namespace verus::CGI
 		RPHandle GetRenderPassHandle_ForwardRendering() const { return _rphForwardRendering; }
 
 		// <Steps>
-		void BeginGeometryPass();
+		// With secondaryCommandBuffers contents, everything in this pass must be recorded by Renderer::RecordInParallel(),
+		// like WorldManager::Draw(), Terrain::Draw(), Forest::Draw() and Grass::Draw() do.
+		void BeginGeometryPass(SubpassContents contents = SubpassContents::inlined);
 		void EndGeometryPass();
 		bool BeginLightingPass(bool ambient = true, bool terrainOcclusion = true);
 		void EndLightingPass();
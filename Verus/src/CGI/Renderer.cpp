@@ -239,6 +239,9 @@ void Renderer::Done()
 		_pipe.Done();
 		_shader.Done();
 		_geoQuad.Done();
+		for (auto& cb : _vSecondaryCommandBuffers)
+			_pBaseRenderer->DeleteCommandBuffer(cb.Get());
+		_vSecondaryCommandBuffers.clear();
 		_commandBuffer.Done();
 
 		Effects::Particles::DoneStatic();
@@ -363,6 +366,7 @@ void Renderer::BeginFrame()
 		pExtReality->BeginFrame();
 
 	_pBaseRenderer->BeginFrame();
+	_pBaseRenderer->GrowUniformBuffers();
 
 	auto cb = GetCommandBuffer();
 
@@ -630,6 +634,153 @@ void Renderer::DrawOffscreenColorSwitchRenderPass(PBaseCommandBuffer pCB)
 	DrawOffscreenColor(pCB, false);
 }
 
+SubpassContents Renderer::GetParallelSubpassContents() const
+{
+	return _pBaseRenderer->IsParallelRecordingSupported() ? SubpassContents::secondaryCommandBuffers : SubpassContents::inlined;
+}
+
+bool Renderer::IsRecordingInParallel() const
+{
+	return _pBaseRenderer->IsParallelRecordingSupported() &&
+		SubpassContents::secondaryCommandBuffers == _commandBuffer->GetSubpassContents();
+}
+
+int Renderer::GetParallelPartCount(int itemCount, int minItemCount) const
+{
+	if (!IsRecordingInParallel())
+		return 1;
+	const int threadCount = TaskScheduler::IsValidSingleton() && TaskScheduler::I().IsInitialized() ? TaskScheduler::I().GetThreadCount() : 1;
+	const int maxPartCount = Math::Min(threadCount, BaseRenderer::s_uniformAllocatorCount - 1);
+	return Math::Clamp(itemCount / Math::Max(minItemCount, 1), 1, maxPartCount);
+}
+
+void Renderer::RecordInParallel(int partCount, std::function<void(CommandBufferPtr cb, int part)> fn, ViewportScissorFlags vsf)
+{
+	if (partCount <= 0)
+		return;
+	if (!IsRecordingInParallel())
+	{
+		VERUS_FOR(i, partCount)
+			fn(_commandBuffer, i);
+		return;
+	}
+
+	// Part uses the same secondary command buffer in each call, it can begin many times per frame:
+	VERUS_RT_ASSERT(partCount < BaseRenderer::s_uniformAllocatorCount);
+	while (Utils::Cast32(_vSecondaryCommandBuffers.size()) < partCount)
+	{
+		CommandBufferPtr cb;
+		cb.InitSecondary();
+		_vSecondaryCommandBuffers.push_back(cb);
+	}
+
+	const RPHandle renderPassHandle = _commandBuffer->GetRenderPassHandle();
+	const FBHandle framebufferHandle = _commandBuffer->GetFramebufferHandle();
+	const int subpass = _commandBuffer->GetSubpass();
+	std::exception_ptr pException;
+	std::mutex mutex;
+	auto RecordParts = [this, &fn, &pException, &mutex, renderPassHandle, framebufferHandle, subpass, vsf](int from, int to)
+	{
+		for (int i = from; i < to; ++i)
+		{
+			auto cb = _vSecondaryCommandBuffers[i];
+			try
+			{
+				cb->BeginSecondary(renderPassHandle, subpass, framebufferHandle, vsf);
+				try
+				{
+					fn(cb, i);
+				}
+				catch (...)
+				{
+					cb->End();
+					throw;
+				}
+				cb->End();
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!pException)
+					pException = std::current_exception();
+			}
+		}
+	};
+	if (TaskScheduler::IsValidSingleton() && TaskScheduler::I().IsInitialized())
+		TaskScheduler::I().ParallelFor(0, partCount, 1, RecordParts);
+	else
+		RecordParts(0, partCount);
+	if (pException)
+		std::rethrow_exception(pException);
+
+	_commandBuffer->ExecuteSecondary(_vSecondaryCommandBuffers.data(), partCount);
+}
+
+void Renderer::BeginPipelineBatch()
+{
+	_pipelineBatchDepth++;
+}
+
+void Renderer::EndPipelineBatch()
+{
+	VERUS_RT_ASSERT(_pipelineBatchDepth > 0);
+	if (--_pipelineBatchDepth > 0 || _vPipelineBatch.empty())
+		return;
+
+	// Drivers compile shaders when pipelines are created, this is the slow part of loading:
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	const int count = Utils::Cast32(_vPipelineBatch.size());
+	std::exception_ptr pException;
+	std::mutex mutex;
+	auto InitPipelines = [this, &pException, &mutex](int from, int to)
+	{
+		for (int i = from; i < to; ++i)
+		{
+			try
+			{
+				RBatchedPipeline bp = _vPipelineBatch[i];
+				PipelineDesc desc = bp._desc;
+				if (desc._shaderBranch)
+					desc._shaderBranch = _C(bp._shaderBranch);
+				bp._p->Init(desc);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!pException)
+					pException = std::current_exception();
+			}
+		}
+	};
+	if (TaskScheduler::IsValidSingleton() && TaskScheduler::I().IsInitialized())
+		TaskScheduler::I().ParallelFor(0, count, 1, InitPipelines);
+	else
+		InitPipelines(0, count);
+	const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	_vPipelineBatch.clear();
+
+	VERUS_LOG_INFO("EndPipelineBatch(); count=" << count << ", time=" << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << " ms");
+	if (pException)
+		std::rethrow_exception(pException);
+}
+
+void Renderer::AbortPipelineBatch()
+{
+	VERUS_RT_ASSERT(_pipelineBatchDepth > 0);
+	if (--_pipelineBatchDepth > 0)
+		return;
+	_vPipelineBatch.clear();
+}
+
+bool Renderer::AddToPipelineBatch(PBasePipeline p, RcPipelineDesc desc)
+{
+	if (!_pipelineBatchDepth)
+		return false;
+	BatchedPipeline bp = { p, desc, desc._shaderBranch ? desc._shaderBranch : "" };
+	_vPipelineBatch.push_back(std::move(bp));
+	return true;
+}
+
 TexturePtr Renderer::GetTexOffscreenColor() const
 {
 	return _tex[TEX_OFFSCREEN_COLOR];
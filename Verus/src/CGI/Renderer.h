@@ -55,11 +55,21 @@ namespace verus::CGI
 			glm::vec2 _pos;
 		};
 
+		struct BatchedPipeline
+		{
+			PBasePipeline _p = nullptr;
+			PipelineDesc  _desc;
+			String        _shaderBranch; // Copy, desc's pointer can be temporary.
+		};
+		VERUS_TYPEDEFS(BatchedPipeline);
+
 		Vector<Utilization>      _vUtilization;
+		Vector<BatchedPipeline>  _vPipelineBatch;
 		App::PWindow             _pMainWindow = nullptr;
 		PBaseRenderer            _pBaseRenderer = nullptr;
 		PRendererDelegate        _pRendererDelegate = nullptr;
 		CommandBufferPwn         _commandBuffer;
+		Vector<CommandBufferPtr> _vSecondaryCommandBuffers;
 		GeometryPwn              _geoQuad;
 		ShaderPwns<SHADER_COUNT> _shader;
 		PipelinePwns<PIPE_COUNT> _pipe;
@@ -77,6 +87,7 @@ namespace verus::CGI
 		int                      _currentViewHeight = 0;
 		int                      _currentViewX = 0;
 		int                      _currentViewY = 0;
+		int                      _pipelineBatchDepth = 0;
 		float                    _preferredZNear = 0.1f;
 		float                    _preferredZFar = 10000;
 		float                    _fps = 30;
@@ -147,6 +158,32 @@ namespace verus::CGI
 		void DrawOffscreenColorSwitchRenderPass(PBaseCommandBuffer pCB = nullptr);
 
 		CommandBufferPtr GetCommandBuffer() const { return _commandBuffer; }
+
+		// Parallel recording:
+		// Subpass must be started with these contents, otherwise RecordInParallel() records inline.
+		SubpassContents GetParallelSubpassContents() const;
+		// Current subpass of the primary command buffer consists of secondary command buffers.
+		bool IsRecordingInParallel() const;
+		// Suggests how many parts should be used for some items, if each part should get at least minItemCount of them.
+		int GetParallelPartCount(int itemCount, int minItemCount) const;
+		// Calls fn for each part on the task scheduler, each part is recorded to its own secondary command buffer,
+		// which continues the current subpass of the primary command buffer. They are executed in order.
+		// If the current subpass is inlined, all parts are recorded sequentially to the primary command buffer.
+		// Each part needs its own uniform allocator, so there can be at most 31 parts per call.
+		// Parts must not call BeginBindDescriptors() or EndBindDescriptors() and must not write static uniform buffers,
+		// data, which changes within a part, must be passed as pSrc to BindDescriptors().
+		void RecordInParallel(int partCount, std::function<void(CommandBufferPtr cb, int part)> fn,
+			ViewportScissorFlags vsf = ViewportScissorFlags::setAllForCurrentViewScaled);
+
+		// Pipeline batch:
+		// Pipelines, which are initialized between these calls, are created on multiple threads by EndPipelineBatch().
+		// Use them only after that. Batches can be nested, the outermost one creates the pipelines.
+		// Prefer PipelineBatch, which also ends the batch if an exception is thrown.
+		void BeginPipelineBatch();
+		void EndPipelineBatch();
+		void AbortPipelineBatch(); // Ends the batch without creating anything.
+		bool AddToPipelineBatch(PBasePipeline p, RcPipelineDesc desc);
+
 		TexturePtr GetTexOffscreenColor() const;
 		TexturePtr GetTexDepthStencil() const;
 		RDeferredShading GetDS() { return _ds; }
@@ -203,4 +240,28 @@ namespace verus::CGI
 		void AddUtilization(CSZ name, INT64 value, INT64 total);
 	};
 	VERUS_TYPEDEFS(Renderer);
+
+	// Begins a pipeline batch, End() creates the pipelines.
+	// If End() was not called, for example because of an exception, the destructor aborts the batch.
+	class PipelineBatch
+	{
+		bool _active = true;
+
+	public:
+		PipelineBatch() { Renderer::I().BeginPipelineBatch(); }
+		~PipelineBatch()
+		{
+			if (_active)
+				Renderer::I().AbortPipelineBatch();
+		}
+		PipelineBatch(const PipelineBatch&) = delete;
+		PipelineBatch& operator=(const PipelineBatch&) = delete;
+
+		void End()
+		{
+			VERUS_RT_ASSERT(_active);
+			_active = false;
+			Renderer::I().EndPipelineBatch();
+		}
+	};
 }
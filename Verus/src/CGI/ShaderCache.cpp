@@ -0,0 +1,245 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::CGI;
+
+CSZ ShaderCache::s_precompiledFolder = "Precompiled/";
+
+ShaderCache::ShaderCache(CSZ compilerVersion, CSZ extension) :
+	_compilerVersion(compilerVersion),
+	_extension(extension),
+	_path(GetPath())
+{
+	_hitCount = 0;
+	_missCount = 0;
+}
+
+ShaderCache::~ShaderCache()
+{
+}
+
+String ShaderCache::GetParams(CSZ entry, CSZ target, UINT32 flags, const Vector<String>& vDefines)
+{
+	StringStream ss;
+	ss << entry << " " << target << " " << flags;
+	for (size_t i = 0; i + 1 < vDefines.size(); i += 2)
+		ss << " " << vDefines[i] << "=" << vDefines[i + 1];
+	return ss.str();
+}
+
+String ShaderCache::GetKey(CSZ source, CSZ sourceName, RcString params) const
+{
+	const size_t sourceLen = strlen(source);
+	const size_t sourceNameLen = strlen(sourceName);
+	Vector<BYTE> vData;
+	vData.reserve(_compilerVersion.size() + sourceNameLen + params.size() + sourceLen + 3);
+	vData.insert(vData.end(), _compilerVersion.begin(), _compilerVersion.end());
+	vData.push_back(0);
+	vData.insert(vData.end(), sourceName, sourceName + sourceNameLen);
+	vData.push_back(0);
+	vData.insert(vData.end(), params.begin(), params.end());
+	vData.push_back(0);
+	vData.insert(vData.end(), source, source + sourceLen);
+	return Convert::ToMd5String(vData);
+}
+
+bool ShaderCache::Load(RcString key, Vector<BYTE>& vCode)
+{
+	vCode.clear();
+
+	Vector<BYTE> vData;
+	IO::File file;
+	if (file.Open(_C(GetPathname(key))))
+	{
+		const INT64 size = file.GetSize();
+		vData.resize(size);
+		if (file.Read(vData.data(), size) != size)
+			vData.clear();
+		file.Close();
+	}
+	if (ReadEntry(vData, vCode))
+	{
+		_hitCount++;
+		return true;
+	}
+
+	if (_usePrecompiled)
+	{
+		const String url = String("[Shaders]:") + s_precompiledFolder + key + "." + _extension;
+		vData.clear();
+		IO::FileSystem::LoadResource(_C(url), vData, IO::FileSystem::LoadDesc(false, 0, false));
+		if (ReadEntry(vData, vCode))
+		{
+			_hitCount++;
+			return true;
+		}
+	}
+
+	_missCount++;
+	return false;
+}
+
+void ShaderCache::Save(RcString key, const Vector<Include>& vIncludes, const void* p, INT64 size)
+{
+	if (!p || !size)
+		return;
+
+	std::error_code ec;
+	std::filesystem::create_directories(Str::Utf8ToWide(_path), ec);
+
+	// Another process can read this file, write it under a temporary name first:
+	const String pathname = GetPathname(key);
+	const String tempPathname = pathname + ".tmp";
+	{
+		IO::File file;
+		if (!file.Open(_C(tempPathname), "wb"))
+		{
+			VERUS_LOG_WARN("Save(); Failed to create " << tempPathname);
+			return;
+		}
+		file << s_magic;
+		file << s_version;
+		file << Utils::Cast32(vIncludes.size());
+		for (const auto& include : vIncludes)
+		{
+			file.WriteString(_C(include._name));
+			file.WriteString(_C(include._hash));
+		}
+		file << static_cast<UINT32>(size);
+		file.Write(p, size);
+	}
+	std::filesystem::rename(Str::Utf8ToWide(tempPathname), Str::Utf8ToWide(pathname), ec);
+	if (ec)
+		IO::FileSystem::Delete(_C(tempPathname));
+}
+
+void ShaderCache::LoadInclude(CSZ filename, Vector<BYTE>& vData, Vector<Include>& vIncludes)
+{
+	LoadIncludeData(filename, vData, true);
+
+	for (const auto& include : vIncludes)
+	{
+		if (include._name == filename)
+			return;
+	}
+
+	Include include;
+	include._name = filename;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _mapIncludeHashes.find(include._name);
+		if (it != _mapIncludeHashes.end())
+			include._hash = it->second;
+	}
+	if (include._hash.empty())
+	{
+		include._hash = Convert::ToMd5String(vData);
+		std::lock_guard<std::mutex> lock(_mutex);
+		_mapIncludeHashes[include._name] = include._hash;
+	}
+	vIncludes.push_back(std::move(include));
+}
+
+ShaderCache::Stats ShaderCache::GetStats() const
+{
+	Stats stats;
+	stats._hitCount = _hitCount;
+	stats._missCount = _missCount;
+	return stats;
+}
+
+String ShaderCache::GetPath()
+{
+	return String(_C(Utils::I().GetWritablePath())) + "ShaderCache/";
+}
+
+bool ShaderCache::ReadEntry(const Vector<BYTE>& vData, Vector<BYTE>& vCode)
+{
+	size_t offset = 0;
+	auto ReadUINT32 = [&vData, &offset](UINT32& x)
+	{
+		if (offset + sizeof(UINT32) > vData.size())
+			return false;
+		memcpy(&x, vData.data() + offset, sizeof(UINT32));
+		offset += sizeof(UINT32);
+		return true;
+	};
+	auto ReadString = [&vData, &offset](String& s)
+	{
+		if (offset + 1 > vData.size() || offset + 1 + vData[offset] > vData.size())
+			return false;
+		const BYTE len = vData[offset];
+		s.assign(reinterpret_cast<CSZ>(vData.data() + offset + 1), len);
+		offset += 1 + len;
+		return true;
+	};
+
+	UINT32 magic = 0;
+	UINT32 version = 0;
+	UINT32 includeCount = 0;
+	if (!ReadUINT32(magic) || magic != s_magic)
+		return false;
+	if (!ReadUINT32(version) || version != s_version)
+		return false;
+	if (!ReadUINT32(includeCount))
+		return false;
+	String name, hash;
+	VERUS_U_FOR(i, includeCount)
+	{
+		if (!ReadString(name) || !ReadString(hash))
+			return false;
+		if (GetIncludeHash(_C(name)) != hash)
+			return false;
+	}
+	UINT32 size = 0;
+	if (!ReadUINT32(size) || !size || offset + size > vData.size())
+		return false;
+	vCode.assign(vData.begin() + offset, vData.begin() + offset + size);
+	return true;
+}
+
+void ShaderCache::LoadIncludeData(CSZ filename, Vector<BYTE>& vData, bool mandatory) const
+{
+	if (_includePath.empty())
+	{
+		const String url = String("[Shaders]:") + filename;
+		IO::FileSystem::LoadResource(_C(url), vData, IO::FileSystem::LoadDesc(false, 0, mandatory));
+		return;
+	}
+
+	vData.clear();
+	const String pathname = _includePath + filename;
+	IO::File file;
+	if (file.Open(_C(pathname)))
+	{
+		const INT64 size = file.GetSize();
+		vData.resize(size);
+		file.Read(vData.data(), size);
+	}
+	else if (mandatory)
+		throw VERUS_RUNTIME_ERROR << "LoadIncludeData(); File not found: " << pathname;
+}
+
+String ShaderCache::GetIncludeHash(CSZ filename)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _mapIncludeHashes.find(filename);
+		if (it != _mapIncludeHashes.end())
+			return it->second;
+	}
+
+	Vector<BYTE> vData;
+	LoadIncludeData(filename, vData, false);
+	const String hash = Convert::ToMd5String(vData);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_mapIncludeHashes[filename] = hash;
+	return hash;
+}
+
+String ShaderCache::GetPathname(RcString key) const
+{
+	return _path + key + "." + _extension;
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::CGI
+{
+	// Content-addressed cache of compiled shader code, one file per shader stage in writable path's ShaderCache folder.
+	// Key is a hash of the source, the compiler version and the parameters (entry point, stage, macros, flags).
+	// Each file also stores the hashes of included files, file is rejected if any of them has changed.
+	// If the file is not in writable path, it is loaded from [Shaders]:Precompiled/, which is filled by ShaderTool.
+	// Create one cache object for shader's Init(), its methods can be called from multiple threads.
+	class ShaderCache
+	{
+	public:
+		static const UINT32 s_version = 1; // Change this when file format changes.
+
+		struct Include
+		{
+			String _name;
+			String _hash;
+		};
+		VERUS_TYPEDEFS(Include);
+
+		struct Stats
+		{
+			int _hitCount = 0;
+			int _missCount = 0;
+		};
+		VERUS_TYPEDEFS(Stats);
+
+	private:
+		static const UINT32 s_magic = 0x43485356; // VSHC.
+		static CSZ s_precompiledFolder;
+
+		typedef Map<String, String> TMapIncludeHashes;
+
+		String            _compilerVersion;
+		String            _extension;
+		String            _path;
+		String            _includePath;
+		TMapIncludeHashes _mapIncludeHashes;
+		std::mutex        _mutex;
+		std::atomic_int   _hitCount;
+		std::atomic_int   _missCount;
+		bool              _usePrecompiled = true;
+
+	public:
+		ShaderCache(CSZ compilerVersion, CSZ extension);
+		~ShaderCache();
+
+		// Tools can use a different folder, precompiled files are not used then.
+		void SetPath(CSZ path) { _path = path; _usePrecompiled = false; }
+		// Read included files from this folder instead of [Shaders].
+		void SetIncludePath(CSZ path) { _includePath = path; }
+
+		static String GetParams(CSZ entry, CSZ target, UINT32 flags, const Vector<String>& vDefines);
+		String GetKey(CSZ source, CSZ sourceName, RcString params) const;
+
+		// Returns true if the code was found and all included files are the same.
+		bool Load(RcString key, Vector<BYTE>& vCode);
+		void Save(RcString key, const Vector<Include>& vIncludes, const void* p, INT64 size);
+
+		// Use this in shader's include handler, it also adds file's hash to vIncludes.
+		void LoadInclude(CSZ filename, Vector<BYTE>& vData, Vector<Include>& vIncludes);
+
+		Stats GetStats() const;
+
+		static String GetPath();
+		static CSZ GetPrecompiledFolder() { return s_precompiledFolder; }
+
+		VERUS_P(bool ReadEntry(const Vector<BYTE>& vData, Vector<BYTE>& vCode));
+		VERUS_P(void LoadIncludeData(CSZ filename, Vector<BYTE>& vData, bool mandatory) const);
+		VERUS_P(String GetIncludeHash(CSZ filename));
+		VERUS_P(String GetPathname(RcString key) const);
+	};
+	VERUS_TYPEDEFS(ShaderCache);
+}
@@ -6,9 +6,11 @@ namespace verus
 	void Make_D()
 	{
 		D::Log::Make();
+		D::Profiler::Make();
 	}
 	void Free_D()
 	{
+		D::Profiler::Free();
 		D::Log::Free();
 	}
 }
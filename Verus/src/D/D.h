@@ -12,6 +12,7 @@
 #include "RuntimeError.h"
 #include "Recoverable.h"
 #include "Log.h"
+#include "Profiler.h"
 
 namespace verus
 {
@@ -0,0 +1,324 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::D;
+
+Profiler::Profiler()
+{
+	_enabled = false;
+	_threadBufferCount = 0;
+	_t0 = std::chrono::steady_clock::now();
+	VERUS_ZERO_MEM(_frameTimes);
+	strcpy(GetThreadBuffer()->_name, "Main");
+}
+
+Profiler::~Profiler()
+{
+}
+
+void Profiler::SetThreadName(CSZ name)
+{
+	if (!IsValidSingleton())
+		return;
+	ThreadBuffer* pThreadBuffer = I().GetThreadBuffer();
+	if (!pThreadBuffer)
+		return;
+	strncpy(pThreadBuffer->_name, name, sizeof(pThreadBuffer->_name) - 1);
+}
+
+void Profiler::BeginFrame()
+{
+	const INT64 time = GetTime();
+	if (_frameCount)
+		UpdateFrameZones(_frameTimes[(_frameCount - 1) % s_frameCapacity], time);
+	_frameTimes[_frameCount % s_frameCapacity] = time;
+	_frameCount++;
+	if (IsEnabled())
+		Write(EventType::marker, "Frame", VERUS_COLOR_WHITE);
+}
+
+INT64 Profiler::GetTime() const
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _t0).count();
+}
+
+void Profiler::SaveChromeTrace(CSZ pathname, int frameCount)
+{
+	INT64 from = 0;
+	if (frameCount > 0 && _frameCount)
+	{
+		const UINT64 firstFrame = (_frameCount > static_cast<UINT64>(frameCount)) ? _frameCount - frameCount : 0;
+		if (_frameCount - firstFrame <= s_frameCapacity)
+			from = _frameTimes[firstFrame % s_frameCapacity];
+	}
+
+	auto WriteName = [](StringStream& ss, CSZ name)
+	{
+		for (CSZ p = name; *p; ++p)
+		{
+			if ('\"' == *p || '\\' == *p)
+				ss << '\\';
+			ss << *p;
+		}
+	};
+
+	StringStream ss;
+	ss << std::fixed << std::setprecision(3);
+	ss << "{\"traceEvents\":[" << std::endl;
+	bool first = true;
+
+	std::vector<Event> vEvents;
+	const int threadBufferCount = _threadBufferCount.load(std::memory_order_acquire);
+	VERUS_FOR(i, threadBufferCount)
+	{
+		ThreadBuffer* pThreadBuffer = _threadBuffers[i].get();
+		ReadEvents(*pThreadBuffer, vEvents);
+
+		if (!first)
+			ss << "," << std::endl;
+		first = false;
+		ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pThreadBuffer->_index << ",\"args\":{\"name\":\"";
+		WriteName(ss, pThreadBuffer->_name);
+		ss << "\"}}";
+
+		int depth = 0;
+		for (const auto& e : vEvents)
+		{
+			if (e._time < from)
+				continue;
+			if (EventType::end == e._type && !depth)
+				continue; // Zone started before the first event.
+
+			ss << "," << std::endl;
+			ss << "{";
+			switch (e._type)
+			{
+			case EventType::begin:
+			{
+				ss << "\"name\":\"";
+				WriteName(ss, e._name);
+				ss << "\",\"ph\":\"B\",";
+				depth++;
+			}
+			break;
+			case EventType::end:
+			{
+				ss << "\"ph\":\"E\",";
+				depth--;
+			}
+			break;
+			case EventType::marker:
+			{
+				ss << "\"name\":\"";
+				WriteName(ss, e._name);
+				ss << "\",\"ph\":\"i\",\"s\":\"t\",";
+			}
+			break;
+			}
+			ss << "\"pid\":1,\"tid\":" << pThreadBuffer->_index << ",\"ts\":" << e._time * 0.001 << "}";
+		}
+	}
+	ss << std::endl << "]}" << std::endl;
+
+	const String s = ss.str();
+	IO::File file;
+	if (!file.Open(pathname, "wb"))
+		throw VERUS_RECOVERABLE << "Open(); pathname=" << pathname;
+	file.Write(_C(s), s.length());
+}
+
+void Profiler::DrawOverlay()
+{
+	if (!_showOverlay)
+		return;
+
+	ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("CPU Profiler", &_showOverlay))
+	{
+		bool enabled = IsEnabled();
+		if (ImGui::Checkbox("Enabled", &enabled))
+			Enable(enabled);
+		ImGui::SameLine();
+		if (ImGui::Button("Save trace"))
+		{
+			String pathname = _C(Utils::I().GetWritablePath());
+			pathname += "Trace.json";
+			try
+			{
+				SaveChromeTrace(_C(pathname), 60);
+			}
+			catch (D::RcRecoverable e)
+			{
+				VERUS_LOG_WARN(e.what());
+			}
+		}
+
+		ImGui::Text("Frame: %.3f ms", _lastFrameTime * 0.000001);
+		ImGui::Separator();
+		for (const auto& zone : _vFrameZones)
+		{
+			const double ms = (zone._end - zone._begin) * 0.000001;
+			const float fraction = _lastFrameTime ? static_cast<float>(zone._end - zone._begin) / _lastFrameTime : 0;
+			const float indent = zone._depth * ImGui::GetStyle().IndentSpacing;
+			char text[16];
+			sprintf_s(text, "%.3f ms", ms);
+			if (indent > 0)
+				ImGui::Indent(indent);
+			ImGui::ProgressBar(fraction, ImVec2(120, 0), text);
+			ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
+			ImGui::TextUnformatted(zone._name);
+			if (indent > 0)
+				ImGui::Unindent(indent);
+		}
+		if (!_vThreadLoads.empty())
+		{
+			ImGui::Separator();
+			for (const auto& load : _vThreadLoads)
+			{
+				const float fraction = _lastFrameTime ? static_cast<float>(load._busyTime) / _lastFrameTime : 0;
+				char text[16];
+				sprintf_s(text, "%.3f ms", load._busyTime * 0.000001);
+				ImGui::ProgressBar(fraction, ImVec2(120, 0), text);
+				ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
+				ImGui::TextUnformatted(_C(load._name));
+			}
+		}
+	}
+	ImGui::End();
+}
+
+void Profiler::Write(EventType type, CSZ name, UINT32 color)
+{
+	ThreadBuffer* pThreadBuffer = GetThreadBuffer();
+	if (!pThreadBuffer)
+		return; // Too many threads.
+	const UINT64 index = pThreadBuffer->_writeCount.load(std::memory_order_relaxed);
+	REvent e = pThreadBuffer->_vEvents[index & (s_threadCapacity - 1)];
+	e._time = GetTime();
+	e._name = name;
+	e._color = color;
+	e._type = type;
+	pThreadBuffer->_writeCount.store(index + 1, std::memory_order_release); // Publish this event.
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+	// Buffers are never removed, only this thread can add a buffer with its ID:
+	const std::thread::id threadID = std::this_thread::get_id();
+	const int count = _threadBufferCount.load(std::memory_order_acquire);
+	VERUS_FOR(i, count)
+	{
+		if (_threadBuffers[i]->_threadID == threadID)
+			return _threadBuffers[i].get();
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	const int index = _threadBufferCount.load(std::memory_order_relaxed);
+	if (index >= s_maxThreadCount)
+		return nullptr;
+	auto pThreadBuffer = std::make_unique<ThreadBuffer>();
+	pThreadBuffer->_vEvents.resize(s_threadCapacity);
+	pThreadBuffer->_writeCount = 0;
+	pThreadBuffer->_threadID = threadID;
+	pThreadBuffer->_index = index;
+	sprintf_s(pThreadBuffer->_name, "Thread %d", index);
+	_threadBuffers[index] = std::move(pThreadBuffer);
+	_threadBufferCount.store(index + 1, std::memory_order_release); // Publish this buffer.
+	return _threadBuffers[index].get();
+}
+
+void Profiler::ReadEvents(ThreadBuffer& tb, std::vector<Event>& vEvents)
+{
+	vEvents.clear();
+	const UINT64 end = tb._writeCount.load(std::memory_order_acquire);
+	const UINT64 begin = (end > s_threadCapacity) ? end - s_threadCapacity : 0;
+	vEvents.reserve(end - begin);
+	for (UINT64 i = begin; i < end; ++i)
+		vEvents.push_back(tb._vEvents[i & (s_threadCapacity - 1)]);
+
+	// Events, which could be overwritten while reading, are dropped.
+	// Slot of event endCheck-capacity is shared with event endCheck, which can be written right now:
+	const UINT64 endCheck = tb._writeCount.load(std::memory_order_acquire);
+	const UINT64 safeBegin = (endCheck >= s_threadCapacity) ? endCheck - s_threadCapacity + 1 : 0;
+	if (safeBegin > begin)
+		vEvents.erase(vEvents.begin(), vEvents.begin() + static_cast<size_t>(Math::Min<UINT64>(safeBegin - begin, vEvents.size())));
+}
+
+void Profiler::UpdateFrameZones(INT64 from, INT64 to)
+{
+	_lastFrameTime = to - from;
+	_vFrameZones.clear();
+	_vThreadLoads.clear();
+	if (!_showOverlay || !IsEnabled())
+		return;
+
+	// Main thread shows the hierarchy:
+	ThreadBuffer* pMainThreadBuffer = GetThreadBuffer();
+	ReadEvents(*pMainThreadBuffer, _vTempEvents);
+	std::vector<int> vStack;
+	for (const auto& e : _vTempEvents)
+	{
+		if (e._time < from || e._time >= to)
+			continue;
+		switch (e._type)
+		{
+		case EventType::begin:
+		{
+			Zone zone;
+			zone._name = e._name;
+			zone._color = e._color;
+			zone._begin = e._time;
+			zone._end = to; // Not closed in this frame.
+			zone._depth = static_cast<int>(vStack.size());
+			vStack.push_back(static_cast<int>(_vFrameZones.size()));
+			_vFrameZones.push_back(zone);
+		}
+		break;
+		case EventType::end:
+		{
+			if (!vStack.empty())
+			{
+				_vFrameZones[vStack.back()]._end = e._time;
+				vStack.pop_back();
+			}
+		}
+		break;
+		}
+	}
+
+	// Other threads show the time spent in top-level zones:
+	const int threadBufferCount = _threadBufferCount.load(std::memory_order_acquire);
+	VERUS_FOR(i, threadBufferCount)
+	{
+		ThreadBuffer* pThreadBuffer = _threadBuffers[i].get();
+		if (pThreadBuffer == pMainThreadBuffer)
+			continue;
+		ReadEvents(*pThreadBuffer, _vTempEvents);
+		ThreadLoad load;
+		load._name = pThreadBuffer->_name;
+		int depth = 0;
+		INT64 zoneBegin = from;
+		for (const auto& e : _vTempEvents)
+		{
+			if (e._time >= to)
+				break;
+			if (EventType::begin == e._type)
+			{
+				if (!depth)
+					zoneBegin = Math::Max(e._time, from);
+				depth++;
+			}
+			else if (EventType::end == e._type && depth)
+			{
+				depth--;
+				if (!depth && e._time > from)
+					load._busyTime += e._time - zoneBegin;
+			}
+		}
+		if (depth)
+			load._busyTime += to - zoneBegin;
+		if (load._busyTime)
+			_vThreadLoads.push_back(std::move(load));
+	}
+}
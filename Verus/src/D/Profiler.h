@@ -0,0 +1,116 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+#ifdef VERUS_PROFILER_CALLS
+#	define VERUS_PROFILER_ZONE(text)        verus::D::ProfilerZone profilerZone(text)
+#	define VERUS_PROFILER_THREAD_NAME(name) verus::D::Profiler::SetThreadName(name)
+#else
+#	define VERUS_PROFILER_ZONE(text)
+#	define VERUS_PROFILER_THREAD_NAME(name)
+#endif
+
+namespace verus::D
+{
+	// CPU profiler with hierarchical zones. Each thread writes to its own ring buffer without locking.
+	// Buffers are found by thread ID, because thread_local variables are not shared by modules, which share this singleton.
+	// Zone names are not copied, they must be string literals. Timestamps are in nanoseconds.
+	// VERUS_PROFILER_* macros also write to this profiler, when it is enabled.
+	class Profiler : public Singleton<Profiler>
+	{
+	public:
+		enum class EventType : BYTE
+		{
+			begin,
+			end,
+			marker
+		};
+
+		struct Event
+		{
+			INT64     _time = 0;
+			CSZ       _name = nullptr;
+			UINT32    _color = 0;
+			EventType _type = EventType::begin;
+		};
+		VERUS_TYPEDEFS(Event);
+
+		static const int s_threadCapacity = 0x10000; // Events per thread, must be a power of two.
+		static const int s_frameCapacity = 256;
+		static const int s_maxThreadCount = 64;
+
+	private:
+		struct ThreadBuffer
+		{
+			std::vector<Event>  _vEvents;
+			std::atomic<UINT64> _writeCount;
+			std::thread::id     _threadID;
+			int                 _index = 0;
+			char                _name[32] = {};
+		};
+
+		struct Zone
+		{
+			CSZ    _name = nullptr;
+			UINT32 _color = 0;
+			INT64  _begin = 0;
+			INT64  _end = 0;
+			int    _depth = 0;
+		};
+
+		struct ThreadLoad
+		{
+			std::string _name;
+			INT64       _busyTime = 0;
+		};
+
+		std::mutex                                 _mutex;
+		std::unique_ptr<ThreadBuffer>              _threadBuffers[s_maxThreadCount];
+		std::atomic_int                            _threadBufferCount;
+		std::chrono::steady_clock::time_point      _t0;
+		INT64                                      _frameTimes[s_frameCapacity];
+		UINT64                                     _frameCount = 0;
+		std::vector<Event>                         _vTempEvents;
+		std::vector<Zone>                          _vFrameZones; // Main thread's zones of the last frame.
+		std::vector<ThreadLoad>                    _vThreadLoads;
+		INT64                                      _lastFrameTime = 0;
+		std::atomic_bool                           _enabled;
+		bool                                       _showOverlay = false;
+
+	public:
+		Profiler();
+		~Profiler();
+
+		static void Enable(bool b = true) { if (IsValidSingleton()) I()._enabled = b; }
+		static bool IsEnabled() { return IsValidSingleton() && I()._enabled.load(std::memory_order_relaxed); }
+
+		static void BeginZone(CSZ name, UINT32 color = 0) { if (IsEnabled()) I().Write(EventType::begin, name, color); }
+		static void EndZone() { if (IsEnabled()) I().Write(EventType::end, nullptr, 0); }
+		static void SetMarker(CSZ name, UINT32 color = 0) { if (IsEnabled()) I().Write(EventType::marker, name, color); }
+		static void SetThreadName(CSZ name);
+
+		// Call this at the beginning of each frame on main thread.
+		void BeginFrame();
+
+		INT64 GetTime() const;
+
+		// Writes buffered events in Chrome's trace event format (chrome://tracing, Perfetto).
+		// Zero frame count means all events, which are still in the buffers.
+		void SaveChromeTrace(CSZ pathname, int frameCount = 0);
+
+		void ToggleOverlay() { _showOverlay = !_showOverlay; }
+		void DrawOverlay();
+
+		VERUS_P(void Write(EventType type, CSZ name, UINT32 color));
+		VERUS_P(ThreadBuffer* GetThreadBuffer());
+		VERUS_P(static void ReadEvents(ThreadBuffer& tb, std::vector<Event>& vEvents));
+		VERUS_P(void UpdateFrameZones(INT64 from, INT64 to));
+	};
+	VERUS_TYPEDEFS(Profiler);
+
+	class ProfilerZone
+	{
+	public:
+		ProfilerZone(CSZ name, UINT32 color = 0) { Profiler::BeginZone(name, color); }
+		~ProfilerZone() { Profiler::EndZone(); }
+	};
+}
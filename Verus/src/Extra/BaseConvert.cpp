@@ -6,6 +6,8 @@ using namespace verus::Extra;
 
 // BaseConvert::Mesh::UberVertex:
 
+const float BaseConvert::Mesh::UberVertex::s_weldEpsilon = 0.001f;
+
 BaseConvert::Mesh::UberVertex::UberVertex()
 {
 	VERUS_ZERO_MEM(_bw);
@@ -14,7 +16,7 @@ BaseConvert::Mesh::UberVertex::UberVertex()
 
 bool BaseConvert::Mesh::UberVertex::operator==(RcUberVertex that) const
 {
-	const float e = 0.001f;
+	const float e = s_weldEpsilon;
 	return
 		glm::all(glm::epsilonEqual(_pos, that._pos, e)) &&
 		glm::all(glm::epsilonEqual(_nrm, that._nrm, e)) &&
@@ -79,6 +81,76 @@ UINT32 BaseConvert::Mesh::UberVertex::GetDominantIndex()
 	return _bi[i];
 }
 
+// BaseConvert::Mesh::WeldGrid:
+
+UINT64 BaseConvert::Mesh::WeldGrid::GetCell(int x, int y, int z)
+{
+	// Far away cells can share the key, which only makes the search longer:
+	return
+		(static_cast<UINT64>(x & 0x1FFFFF) << 42) |
+		(static_cast<UINT64>(y & 0x1FFFFF) << 21) |
+		(static_cast<UINT64>(z & 0x1FFFFF));
+}
+
+void BaseConvert::Mesh::WeldGrid::Reserve(int count)
+{
+	_mapLastInCell.reserve(count);
+	_vCells.reserve(count);
+	_vPrevInCell.reserve(count);
+}
+
+int BaseConvert::Mesh::WeldGrid::Find(const Vector<UberVertex>& vVerts, RcUberVertex test) const
+{
+	// Similar position is less than half a cell away, so only the nearest neighbour on each axis is checked:
+	const float scale = 0.5f / UberVertex::s_weldEpsilon;
+	int cells[3][2];
+	VERUS_FOR(axis, 3)
+	{
+		const float x = test._pos[axis] * scale;
+		const float cell = floor(x);
+		cells[axis][0] = static_cast<int>(cell);
+		cells[axis][1] = cells[axis][0] + ((x - cell < 0.5f) ? -1 : 1);
+	}
+
+	int found = -1;
+	VERUS_FOR(i, 8)
+	{
+		const auto it = _mapLastInCell.find(GetCell(cells[0][i & 0x1], cells[1][(i >> 1) & 0x1], cells[2][(i >> 2) & 0x1]));
+		if (it == _mapLastInCell.end())
+			continue;
+		for (int index = it->second; index >= 0; index = _vPrevInCell[index])
+		{
+			if ((found < 0 || index < found) && vVerts[index] == test)
+				found = index;
+		}
+	}
+	return found;
+}
+
+void BaseConvert::Mesh::WeldGrid::PushBack(RcUberVertex vertex)
+{
+	const float scale = 0.5f / UberVertex::s_weldEpsilon;
+	const UINT64 cell = GetCell(
+		static_cast<int>(floor(vertex._pos.x * scale)),
+		static_cast<int>(floor(vertex._pos.y * scale)),
+		static_cast<int>(floor(vertex._pos.z * scale)));
+	const auto it = _mapLastInCell.find(cell);
+	_vPrevInCell.push_back((it != _mapLastInCell.end()) ? it->second : -1);
+	_mapLastInCell[cell] = Utils::Cast32(_vCells.size());
+	_vCells.push_back(cell);
+}
+
+void BaseConvert::Mesh::WeldGrid::PopBack()
+{
+	const UINT64 cell = _vCells.back();
+	if (_vPrevInCell.back() >= 0)
+		_mapLastInCell[cell] = _vPrevInCell.back();
+	else
+		_mapLastInCell.erase(cell);
+	_vCells.pop_back();
+	_vPrevInCell.pop_back();
+}
+
 // BaseConvert::Mesh::Aabb:
 
 void BaseConvert::Mesh::Aabb::Reset()
@@ -195,21 +267,24 @@ void BaseConvert::Mesh::Optimize()
 	int degenerateFaceCount = 0;
 	Vector<UberVertex> vVbOpt; // This will not contain equal vertices.
 	Vector<Face> vIbOpt; // This can get smaller than current IB, if there are zero-area triangles.
+	WeldGrid weldGrid; // Same vertices as vVbOpt.
 	vVbOpt.reserve(_vertCount);
 	vIbOpt.reserve(_faceCount);
+	weldGrid.Reserve(_vertCount);
 	VERUS_FOR(face, _faceCount) // For each triangle:
 	{
-		_pBaseConvert->OnProgress(float(face) / _faceCount * 100);
+		if (!(face & 0xFFF))
+			_pBaseConvert->OnProgress(float(face) / _faceCount * 50);
 		Face newFace;
 		int pushedCount = 0;
 		VERUS_FOR(i, 3) // For each vertex in triangle:
 		{
 			RcUberVertex test = _vUberVerts[_vFaces[face]._indices[i]]; // Fetch vertex.
-			const auto similar = std::find(vVbOpt.begin(), vVbOpt.end(), test);
-			const int index = (similar == vVbOpt.end()) ? -1 : Utils::Cast32(std::distance(vVbOpt.begin(), similar));
+			const int index = weldGrid.Find(vVbOpt, test);
 			if (index < 0) // No similar vertex found.
 			{
 				newFace._indices[i] = Utils::Cast32(vVbOpt.size());
+				weldGrid.PushBack(test);
 				vVbOpt.push_back(test);
 				pushedCount++;
 			}
@@ -228,7 +303,11 @@ void BaseConvert::Mesh::Optimize()
 		else
 		{
 			degenerateFaceCount++;
-			vVbOpt.resize(vVbOpt.size() - pushedCount); // Rollback.
+			VERUS_FOR(i, pushedCount) // Rollback.
+			{
+				weldGrid.PopBack();
+				vVbOpt.pop_back();
+			}
 		}
 	}
 	_vUberVerts.assign(vVbOpt.begin(), vVbOpt.end());
@@ -245,12 +324,157 @@ void BaseConvert::Mesh::Optimize()
 		_pBaseConvert->OnProgressText(_C(ss.str()));
 	}
 
-	// Optimize (using AMD Tootle):
-	StringStream ss2;
-	ss2 << _name << ": Optimize (Tootle)";
-	_pBaseConvert->OnProgressText(_C(ss2.str()));
+	// Meshes are optimized concurrently, delegate calls are serialized:
+	bool useBuiltInOptimizer = true;
 	if (_pBaseConvert->_pDelegate)
+	{
+		VERUS_LOCK(*_pBaseConvert);
+		useBuiltInOptimizer = _pBaseConvert->_pDelegate->BaseConvert_UseBuiltInOptimizer();
+	}
+	if (useBuiltInOptimizer)
+		OptimizeCacheAndOverdraw();
+	if (_pBaseConvert->_pDelegate)
+	{
+		VERUS_LOCK(*_pBaseConvert);
 		_pBaseConvert->_pDelegate->BaseConvert_Optimize(_vUberVerts, _vFaces);
+	}
+}
+
+void BaseConvert::Mesh::OptimizeCacheAndOverdraw()
+{
+	StringStream ssOpt;
+	ssOpt << _name << ": Optimize (cache, overdraw, fetch)";
+	_pBaseConvert->OnProgressText(_C(ssOpt.str()));
+
+	Vector<UINT32> vIndices;
+	vIndices.resize(_faceCount * 3);
+	VERUS_FOR(i, _faceCount)
+	{
+		vIndices[i * 3 + 0] = _vFaces[i]._indices[0];
+		vIndices[i * 3 + 1] = _vFaces[i]._indices[1];
+		vIndices[i * 3 + 2] = _vFaces[i]._indices[2];
+	}
+	Vector<glm::vec3> vPositions;
+	vPositions.resize(_vertCount);
+	VERUS_FOR(i, _vertCount)
+		vPositions[i] = _vUberVerts[i]._pos;
+
+	const float acmr = Math::MeshOptimizer::ComputeACMR(vIndices, _vertCount);
+	Math::MeshOptimizer::OptimizeVertexCache(vIndices, _vertCount);
+	_pBaseConvert->OnProgress(75);
+	Math::MeshOptimizer::OptimizeOverdraw(vIndices, vPositions);
+	_pBaseConvert->OnProgress(90);
+	Vector<int> vRemap;
+	Math::MeshOptimizer::OptimizeVertexFetch(vIndices, _vertCount, vRemap);
+	Math::MeshOptimizer::ApplyRemap(_vUberVerts, vRemap);
+	VERUS_FOR(i, _faceCount)
+	{
+		_vFaces[i]._indices[0] = vIndices[i * 3 + 0];
+		_vFaces[i]._indices[1] = vIndices[i * 3 + 1];
+		_vFaces[i]._indices[2] = vIndices[i * 3 + 2];
+	}
+
+	StringStream ssCacheReport;
+	ssCacheReport << "Cache report: ACMR " << acmr << " -> " << Math::MeshOptimizer::ComputeACMR(vIndices, _vertCount);
+	_pBaseConvert->OnProgressText(_C(ssCacheReport.str()));
+}
+
+void BaseConvert::Mesh::GenerateLODs()
+{
+	_vLODs.clear();
+	const int lodCount = Math::Min(_pBaseConvert->GetLODCount(), World::BaseMesh::s_maxLODCount - 1);
+	if (lodCount <= 0 || _faceCount < s_minLODFaceCount)
+		return;
+
+	StringStream ss;
+	ss << _name << ": GenerateLODs";
+	_pBaseConvert->OnProgressText(_C(ss.str()));
+
+	Vector<UINT32> vIndices;
+	vIndices.resize(_faceCount * 3);
+	VERUS_FOR(i, _faceCount)
+	{
+		vIndices[i * 3 + 0] = _vFaces[i]._indices[0];
+		vIndices[i * 3 + 1] = _vFaces[i]._indices[1];
+		vIndices[i * 3 + 2] = _vFaces[i]._indices[2];
+	}
+	Vector<glm::vec3> vPositions;
+	vPositions.resize(_vertCount);
+	VERUS_FOR(i, _vertCount)
+		vPositions[i] = _vUberVerts[i]._pos;
+
+	// Each level has half the triangles of the previous one and is simplified from it:
+	StringStream ssReport;
+	ssReport << "LOD report: " << _faceCount;
+	float error = 0;
+	VERUS_FOR(lod, lodCount)
+	{
+		const int prevFaceCount = Utils::Cast32(vIndices.size() / 3);
+		const int targetFaceCount = _faceCount >> (lod + 1);
+		if (targetFaceCount < s_minLODFaceCount / 2)
+			break;
+		error = Math::Max(error, Math::MeshOptimizer::Simplify(vIndices, vPositions, targetFaceCount * 3));
+		const int faceCount = Utils::Cast32(vIndices.size() / 3);
+		if (faceCount > prevFaceCount * 3 / 4)
+			break; // Mostly locked vertices, not worth it.
+		Math::MeshOptimizer::OptimizeVertexCache(vIndices, _vertCount);
+
+		LOD lodData;
+		lodData._error = error;
+		lodData._vFaces.resize(faceCount);
+		VERUS_FOR(i, faceCount)
+		{
+			lodData._vFaces[i]._indices[0] = vIndices[i * 3 + 0];
+			lodData._vFaces[i]._indices[1] = vIndices[i * 3 + 1];
+			lodData._vFaces[i]._indices[2] = vIndices[i * 3 + 2];
+		}
+		_vLODs.push_back(std::move(lodData));
+		ssReport << " -> " << faceCount << " (" << error << ")";
+		_pBaseConvert->OnProgress(float(lod + 1) / lodCount * 100);
+	}
+	_pBaseConvert->OnProgressText(_C(ssReport.str()));
+}
+
+void BaseConvert::Mesh::GenerateClusters()
+{
+	_vClusters.clear();
+	if (_faceCount < s_minClusterFaceCount || _boneCount > 0)
+		return;
+
+	StringStream ss;
+	ss << _name << ": GenerateClusters";
+	_pBaseConvert->OnProgressText(_C(ss.str()));
+
+	Vector<UINT32> vIndices;
+	vIndices.resize(_faceCount * 3);
+	VERUS_FOR(i, _faceCount)
+	{
+		vIndices[i * 3 + 0] = _vFaces[i]._indices[0];
+		vIndices[i * 3 + 1] = _vFaces[i]._indices[1];
+		vIndices[i * 3 + 2] = _vFaces[i]._indices[2];
+	}
+	Vector<glm::vec3> vPositions;
+	vPositions.resize(_vertCount);
+	VERUS_FOR(i, _vertCount)
+		vPositions[i] = _vUberVerts[i]._pos;
+
+	// Triangles are reordered, so that each cluster is a range of the main index buffer:
+	Math::MeshOptimizer::BuildClusters(vIndices, vPositions, _vClusters);
+	VERUS_FOR(i, _faceCount)
+	{
+		_vFaces[i]._indices[0] = vIndices[i * 3 + 0];
+		_vFaces[i]._indices[1] = vIndices[i * 3 + 1];
+		_vFaces[i]._indices[2] = vIndices[i * 3 + 2];
+	}
+
+	const int coneCount = Utils::Cast32(std::count_if(_vClusters.begin(), _vClusters.end(), [](const Math::MeshOptimizer::Cluster& x)
+		{
+			return x._coneCutoff < 1;
+		}));
+	StringStream ssReport;
+	ssReport << "Cluster report: " << _vClusters.size() << " clusters, " << coneCount << " with normal cone, ACMR ";
+	ssReport << Math::MeshOptimizer::ComputeACMR(vIndices, _vertCount);
+	_pBaseConvert->OnProgressText(_C(ssReport.str()));
 }
 
 void BaseConvert::Mesh::RecalculateTangentSpace()
@@ -391,6 +615,8 @@ void BaseConvert::Mesh::SerializeX3D3(IO::RFile file)
 
 	CleanBones();
 	Optimize();
+	GenerateClusters();
+	GenerateLODs();
 	RecalculateTangentSpace();
 	Compress();
 
@@ -406,6 +632,38 @@ void BaseConvert::Mesh::SerializeX3D3(IO::RFile file)
 		file.Write(&_vFaces[i], 6);
 	file.EndBlock();
 
+	if (!_vLODs.empty())
+	{
+		file.WriteText(VERUS_CRNL VERUS_CRNL "<LD>");
+		file.BeginBlock();
+		const BYTE lodCount = BYTE(_vLODs.size());
+		file << lodCount;
+		for (const auto& lod : _vLODs)
+		{
+			file << lod._error;
+			file.WriteString(_C(std::to_string(lod._vFaces.size())));
+			file.Write(lod._vFaces.data(), lod._vFaces.size() * 6);
+		}
+		file.EndBlock();
+	}
+
+	if (!_vClusters.empty())
+	{
+		file.WriteText(VERUS_CRNL VERUS_CRNL "<CL>");
+		file.BeginBlock();
+		file.WriteString(_C(std::to_string(_vClusters.size())));
+		for (const auto& cluster : _vClusters)
+		{
+			const UINT16 faceCount = cluster._indexCount / 3;
+			file.Write(&cluster._center, 12);
+			file << cluster._radius;
+			file.Write(&cluster._coneAxis, 12);
+			file << cluster._coneCutoff;
+			file << faceCount;
+		}
+		file.EndBlock();
+	}
+
 	file.WriteText(VERUS_CRNL VERUS_CRNL "<VX>");
 	file.BeginBlock();
 	file.WriteString(_C(std::to_string(_vertCount)));
@@ -468,7 +726,7 @@ void BaseConvert::Mesh::SerializeX3D3(IO::RFile file)
 		VERUS_FOR(i, _boneCount)
 			ssDebug << "Bone: " << _vBones[i]._name << "; Parent: " << _vBones[i]._parentName << ";" VERUS_CRNL;
 		String pathname = _C(_pBaseConvert->GetPathname());
-		Str::ReplaceExtension(pathname, "_Bones.txt");
+		Str::ReplaceFilename(pathname, _C(_name + "_Bones.txt")); // Each mesh has its own file.
 		IO::File fileDebug;
 		if (fileDebug.Open(_C(pathname), "wb"))
 			fileDebug.Write(_C(ssDebug.str()), ssDebug.str().length());
@@ -663,19 +921,51 @@ void BaseConvert::DeleteAll()
 
 void BaseConvert::OnProgress(float percent)
 {
-	if (_pDelegate)
-		_pDelegate->BaseConvert_OnProgress(percent);
+	if (!_concurrentProgress) // Progress of a single task is meaningless when many tasks are running.
+		ReportProgress(percent);
 }
 
 void BaseConvert::OnProgressText(CSZ txt)
 {
 	if (_pDelegate)
+	{
+		VERUS_LOCK(*this);
 		_pDelegate->BaseConvert_OnProgressText(txt);
+	}
+}
+
+void BaseConvert::ReportProgress(float percent)
+{
+	if (!_pDelegate)
+		return;
+	VERUS_LOCK(*this);
+	const auto now = std::chrono::steady_clock::now();
+	if (percent < 100 && now - _progressTime < std::chrono::milliseconds(s_progressInterval))
+		return;
+	_progressTime = now;
+	_pDelegate->BaseConvert_OnProgress(percent);
+}
+
+void BaseConvert::SerializeMeshes(const Vector<MeshTask>& vTasks)
+{
+	const int count = Utils::Cast32(vTasks.size());
+	std::atomic_int doneCount = 0;
+	RunConcurrently(count, [this, &vTasks, &doneCount, count](int index)
+		{
+			RcMeshTask task = vTasks[index];
+			IO::File file;
+			if (file.Open(_C(task._pathname), "wb"))
+				task._pMesh->SerializeX3D3(file);
+			else
+				throw VERUS_RECOVERABLE << "SerializeMeshes(); Failed to create file: " << task._pathname;
+			ReportProgress(float(++doneCount) / count * 100);
+		});
 }
 
 void BaseConvert::SerializeMotions(SZ pathname)
 {
-	int animTotal = 0, animCount = 0;
+	int animTotal = 0;
+	std::atomic_int animCount = 0;
 	if (!_vAnimSets.empty())
 	{
 		OnProgressText("Saving motions");
@@ -687,141 +977,187 @@ void BaseConvert::SerializeMotions(SZ pathname)
 		}
 	}
 
-	VERUS_FOREACH(Vector<AnimationSet>, _vAnimSets, itSet)
+	// Check files on this thread, delegate can ask the user:
+	Vector<int> vSetIndices;
+	Vector<String> vPathnames;
+	VERUS_FOR(i, _vAnimSets.size())
 	{
-		AnimationSet& set = *itSet;
-
-		int maxFrames = 0;
-		VERUS_FOREACH_CONST(Vector<Animation>, set._vAnimations, it)
-		{
-			maxFrames = Math::Max(maxFrames, static_cast<int>((*it)._vAnimKeys[0]._vFrame.size()));
-			maxFrames = Math::Max(maxFrames, static_cast<int>((*it)._vAnimKeys[1]._vFrame.size()));
-			maxFrames = Math::Max(maxFrames, static_cast<int>((*it)._vAnimKeys[2]._vFrame.size()));
-		}
-
-		strcpy(strrchr(pathname, '\\') + 1, _C(set._name));
+		strcpy(strrchr(pathname, '\\') + 1, _C(_vAnimSets[i]._name));
 		strcat(pathname, ".xan");
 		if (_pDelegate && !_pDelegate->BaseConvert_CanOverwriteFile(pathname))
 			continue;
+		vSetIndices.push_back(i);
+		vPathnames.push_back(pathname);
+	}
 
-		IO::File file;
-		if (file.Open(pathname, "wb"))
+	RunConcurrently(Utils::Cast32(vSetIndices.size()), [this, &vSetIndices, &vPathnames, &animCount, animTotal](int taskIndex)
 		{
-			const UINT32 magic = '2NAX';
-			file << magic;
+			AnimationSet& set = _vAnimSets[vSetIndices[taskIndex]];
+			CSZ pathname = _C(vPathnames[taskIndex]);
 
-			const UINT16 version = 0x0102;
-			file << version;
+			int maxFrames = 0;
+			VERUS_FOREACH_CONST(Vector<Animation>, set._vAnimations, it)
+			{
+				maxFrames = Math::Max(maxFrames, static_cast<int>((*it)._vAnimKeys[0]._vFrame.size()));
+				maxFrames = Math::Max(maxFrames, static_cast<int>((*it)._vAnimKeys[1]._vFrame.size()));
+				maxFrames = Math::Max(maxFrames, static_cast<int>((*it)._vAnimKeys[2]._vFrame.size()));
+			}
 
-			const UINT32 frameCount = maxFrames;
-			file << frameCount;
+			IO::File file;
+			if (file.Open(pathname, "wb"))
+			{
+				const UINT32 magic = '2NAX';
+				file << magic;
 
-			const UINT32 fps = 10;
-			file << fps;
+				const UINT16 version = 0x0102;
+				file << version;
 
-			const int boneCount = Utils::Cast32(set._vAnimations.size());
-			file << boneCount;
+				const UINT32 frameCount = maxFrames;
+				file << frameCount;
 
-			VERUS_FOREACH(Vector<Animation>, set._vAnimations, itAnim) // For each bone:
-			{
-				Animation& anim = *itAnim;
+				const UINT32 fps = 10;
+				file << fps;
 
-				String name;
-				const size_t startAt = anim._name.rfind("-");
-				if (startAt != String::npos)
-				{
-					name = anim._name.substr(startAt + 1);
-				}
-				else
+				const int boneCount = Utils::Cast32(set._vAnimations.size());
+				file << boneCount;
+
+				VERUS_FOREACH(Vector<Animation>, set._vAnimations, itAnim) // For each bone:
 				{
-					name = anim._name;
-				}
+					Animation& anim = *itAnim;
 
-				name = RenameBone(_C(name));
-				file.WriteString(_C(name)); // Bone's name.
+					String name;
+					const size_t startAt = anim._name.rfind("-");
+					if (startAt != String::npos)
+					{
+						name = anim._name.substr(startAt + 1);
+					}
+					else
+					{
+						name = anim._name;
+					}
 
-				UINT32 flags = 0;
-				file << flags;
+					name = RenameBone(_C(name));
+					file.WriteString(_C(name)); // Bone's name.
 
-				VERUS_FOREACH(Vector<AnimationKey>, anim._vAnimKeys, itKey)
-				{
-					AnimationKey& key = *itKey;
-					if (key._type == 0) // Rotation:
-					{
-						key.DetectRedundantFrames();
-						const int keyframeCount = key._logicFrameCount;
-						file << keyframeCount;
+					UINT32 flags = 0;
+					file << flags;
 
-						int frame = 0;
-						VERUS_FOREACH(Vector<SubKey>, key._vFrame, itSK)
+					VERUS_FOREACH(Vector<AnimationKey>, anim._vAnimKeys, itKey)
+					{
+						AnimationKey& key = *itKey;
+						if (key._type == 0) // Rotation:
 						{
-							SubKey& sk = *itSK;
-							if (!sk._redundant)
+							key.DetectRedundantFrames();
+							const int keyframeCount = key._logicFrameCount;
+							file << keyframeCount;
+
+							int frame = 0;
+							VERUS_FOREACH(Vector<SubKey>, key._vFrame, itSK)
 							{
-								file << frame;
-								file.Write(sk._q.ToPointer(), 16);
+								SubKey& sk = *itSK;
+								if (!sk._redundant)
+								{
+									file << frame;
+									file.Write(sk._q.ToPointer(), 16);
+								}
+								frame++;
 							}
-							frame++;
 						}
 					}
-				}
 
-				VERUS_FOREACH(Vector<AnimationKey>, anim._vAnimKeys, itKey)
-				{
-					AnimationKey& key = *itKey;
-					if (key._type == 2) // Position:
+					VERUS_FOREACH(Vector<AnimationKey>, anim._vAnimKeys, itKey)
 					{
-						key.DetectRedundantFrames();
-						const int keyframeCount = key._logicFrameCount;
-						file << keyframeCount;
-
-						int frame = 0;
-						VERUS_FOREACH(Vector<SubKey>, key._vFrame, itSK)
+						AnimationKey& key = *itKey;
+						if (key._type == 2) // Position:
 						{
-							SubKey& sk = *itSK;
-							if (!sk._redundant)
+							key.DetectRedundantFrames();
+							const int keyframeCount = key._logicFrameCount;
+							file << keyframeCount;
+
+							int frame = 0;
+							VERUS_FOREACH(Vector<SubKey>, key._vFrame, itSK)
 							{
-								file << frame;
-								file.Write(sk._q.ToPointer(), 12);
+								SubKey& sk = *itSK;
+								if (!sk._redundant)
+								{
+									file << frame;
+									file.Write(sk._q.ToPointer(), 12);
+								}
+								frame++;
 							}
-							frame++;
 						}
 					}
-				}
 
-				VERUS_FOREACH(Vector<AnimationKey>, anim._vAnimKeys, itKey)
-				{
-					AnimationKey& key = *itKey;
-					if (key._type == 1) // Scale:
+					VERUS_FOREACH(Vector<AnimationKey>, anim._vAnimKeys, itKey)
 					{
-						PMesh pMesh = _vMeshes[0];
-						if (!pMesh->FindBone(_C(name)))
-							break;
-
-						VERUS_FOREACH(Vector<SubKey>, key._vFrame, itSK)
+						AnimationKey& key = *itKey;
+						if (key._type == 1) // Scale:
 						{
-							SubKey& sk = *itSK;
-							const glm::vec3 scale = glm::make_vec3(sk._q.ToPointer());
-							const float e = 0.001f;
-							if (!glm::all(glm::epsilonEqual(scale, glm::vec3(1, 1, 1), e)))
-							{
-								StringStream ss;
-								ss << "Scaling detected: " << name;
-								OnProgressText(_C(ss.str()));
+							PMesh pMesh = _vMeshes[0];
+							if (!pMesh->FindBone(_C(name)))
 								break;
+
+							VERUS_FOREACH(Vector<SubKey>, key._vFrame, itSK)
+							{
+								SubKey& sk = *itSK;
+								const glm::vec3 scale = glm::make_vec3(sk._q.ToPointer());
+								const float e = 0.001f;
+								if (!glm::all(glm::epsilonEqual(scale, glm::vec3(1, 1, 1), e)))
+								{
+									StringStream ss;
+									ss << "Scaling detected: " << name;
+									OnProgressText(_C(ss.str()));
+									break;
+								}
 							}
 						}
 					}
-				}
 
-				// Scale/trigger:
-				const int keyframeSTCount = 0;
-				file << keyframeSTCount;
-				file << keyframeSTCount;
+					// Scale/trigger:
+					const int keyframeSTCount = 0;
+					file << keyframeSTCount;
+					file << keyframeSTCount;
 
-				animCount++;
-				OnProgress(float(animCount) / animTotal * 100);
+					ReportProgress(float(++animCount) / animTotal * 100);
+				}
 			}
-		}
+		});
+}
+
+void BaseConvert::RunConcurrently(int count, std::function<void(int)> func)
+{
+	if (count <= 0)
+		return;
+
+	_concurrentProgress = true;
+
+	const int threadCount = Math::Clamp<int>(std::thread::hardware_concurrency(), 1, count);
+	std::atomic_int nextIndex = 0;
+	std::atomic_bool failed = false;
+	Vector<std::future<void>> vFutures;
+	vFutures.reserve(threadCount);
+	VERUS_FOR(i, threadCount)
+	{
+		vFutures.push_back(Async([&nextIndex, &failed, &func, count]()
+			{
+				int index = 0;
+				while (!failed && (index = nextIndex++) < count)
+				{
+					try
+					{
+						func(index);
+					}
+					catch (...)
+					{
+						failed = true;
+						throw;
+					}
+				}
+			}));
 	}
+	for (auto& f : vFutures)
+		f.wait();
+	_concurrentProgress = false;
+	for (auto& f : vFutures)
+		f.get(); // Rethrow.
 }
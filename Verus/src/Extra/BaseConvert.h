@@ -5,12 +5,17 @@ namespace verus::Extra
 {
 	struct BaseConvertDelegate;
 
-	class BaseConvert
+	// Meshes and motions are independent, so they are processed concurrently.
+	// Delegate callbacks are serialized, progress callbacks are also throttled.
+	class BaseConvert : public Lockable
 	{
 	public:
 		class Mesh
 		{
 		public:
+			static const int s_minLODFaceCount = 64; // Simple meshes don't need levels of detail.
+			static const int s_minClusterFaceCount = 2048; // Only large meshes are worth culling by parts.
+
 			enum class Found : int
 			{
 				null = 0,
@@ -24,6 +29,8 @@ namespace verus::Extra
 
 			struct UberVertex
 			{
+				static const float s_weldEpsilon;
+
 				glm::vec3 _pos;
 				glm::vec3 _nrm;
 				glm::vec2 _tc0;
@@ -42,12 +49,36 @@ namespace verus::Extra
 			};
 			VERUS_TYPEDEFS(UberVertex);
 
+			// Finds similar vertices among the ones already welded.
+			// Grid cell is twice the epsilon, so a similar vertex is in one of the 8 nearest cells.
+			class WeldGrid
+			{
+				HashMap<UINT64, int> _mapLastInCell;
+				Vector<UINT64>       _vCells;
+				Vector<int>          _vPrevInCell;
+
+				static UINT64 GetCell(int x, int y, int z);
+
+			public:
+				void Reserve(int count);
+				int Find(const Vector<UberVertex>& vVerts, RcUberVertex test) const; // Returns the lowest index or -1.
+				void PushBack(RcUberVertex vertex); // Must match the vertex added to the end.
+				void PopBack();
+			};
+
 			struct Face
 			{
 				UINT16 _indices[3];
 			};
 			VERUS_TYPEDEFS(Face);
 
+			struct LOD // Extra level of detail, which shares the vertex buffer.
+			{
+				Vector<Face> _vFaces;
+				float        _error = 0; // Relative to mesh size.
+			};
+			VERUS_TYPEDEFS(LOD);
+
 			struct Bone
 			{
 				String    _name;
@@ -95,6 +126,8 @@ namespace verus::Extra
 			String             _copyOf;
 			Vector<UberVertex> _vUberVerts;
 			Vector<Face>       _vFaces;
+			Vector<LOD>        _vLODs;
+			Vector<Math::MeshOptimizer::Cluster> _vClusters;
 			Vector<Vec3Short>  _vZipPos;
 			Vector<Vec3Char>   _vZipNormal;
 			Vector<Vec3Char>   _vZipTan;
@@ -125,6 +158,9 @@ namespace verus::Extra
 
 			VERUS_P(void CleanBones());
 			VERUS_P(void Optimize());
+			VERUS_P(void OptimizeCacheAndOverdraw());
+			VERUS_P(void GenerateLODs());
+			VERUS_P(void GenerateClusters());
 			VERUS_P(void RecalculateTangentSpace());
 			VERUS_P(void Compress());
 			void SerializeX3D3(IO::RFile file);
@@ -199,11 +235,22 @@ namespace verus::Extra
 	protected:
 		typedef Map<String, String> TMapBoneNames;
 
+		struct MeshTask
+		{
+			PMesh  _pMesh = nullptr;
+			String _pathname;
+		};
+		VERUS_TYPEDEFS(MeshTask);
+
+		static const int s_progressInterval = 50; // Milliseconds.
+
 		TMapBoneNames         _mapBoneNames;
 		BaseConvertDelegate* _pDelegate = nullptr;
 		Vector<PMesh>         _vMeshes;
 		Vector<AnimationSet>  _vAnimSets;
 		std::unique_ptr<Mesh> _pCurrentMesh;
+		std::chrono::steady_clock::time_point _progressTime;
+		bool                  _concurrentProgress = false; // Only overall progress is reported.
 
 	public:
 		BaseConvert();
@@ -219,12 +266,19 @@ namespace verus::Extra
 
 		void OnProgress(float percent);
 		void OnProgressText(CSZ txt);
+		void ReportProgress(float percent);
 
 		virtual bool UseAreaBasedNormals() { return false; }
 		virtual bool UseRigidBones() { return false; }
+		virtual int GetLODCount() { return 0; }
 		virtual Str GetPathname() { return ""; }
 
+		void SerializeMeshes(const Vector<MeshTask>& vTasks);
 		void SerializeMotions(SZ pathname);
+
+		// Runs tasks on a pool of worker threads, each thread takes the next task when it's done.
+		// The first exception is rethrown after all threads are finished.
+		void RunConcurrently(int count, std::function<void(int)> func);
 	};
 	VERUS_TYPEDEFS(BaseConvert);
 
@@ -234,7 +288,8 @@ namespace verus::Extra
 		virtual void BaseConvert_OnProgressText(CSZ txt) = 0;
 		virtual void BaseConvert_Optimize(
 			Vector<BaseConvert::Mesh::UberVertex>& vVB,
-			Vector<BaseConvert::Mesh::Face>& vIB) = 0;
+			Vector<BaseConvert::Mesh::Face>& vIB) = 0; // Called after the built-in optimizer, one mesh at a time, other delegate calls are blocked.
+		virtual bool BaseConvert_UseBuiltInOptimizer() { return true; }
 		virtual bool BaseConvert_CanOverwriteFile(CSZ filename) { return true; }
 	};
 	VERUS_TYPEDEFS(BaseConvertDelegate);
@@ -36,6 +36,11 @@ bool ConvertGLTF::UseRigidBones()
 	return _desc._useRigidBones;
 }
 
+int ConvertGLTF::GetLODCount()
+{
+	return _desc._lodCount;
+}
+
 Str ConvertGLTF::GetPathname()
 {
 	return _C(_pathname);
@@ -45,13 +50,9 @@ void ConvertGLTF::ParseData(CSZ pathname)
 {
 	VERUS_RT_ASSERT(IsInitialized());
 
+	_pathname = pathname;
 	LoadFromFile(pathname);
 
-	const String baseDir = IO::FileSystem::ReplaceFilename(pathname, "");
-	std::string err, warn;
-	if (!_context.LoadASCIIFromString(&_model, &err, &warn, _vData.data(), Utils::Cast32(_vData.size()), _C(baseDir)))
-		throw VERUS_RECOVERABLE << "LoadASCIIFromString(); err=" << err << ", warn=" << warn;
-
 	_vNodeExtraData.resize(_model.nodes.size());
 	const auto& scene = _model.scenes[_model.defaultScene];
 	for (int nodeIndex : scene.nodes) // Root nodes:
@@ -79,6 +80,8 @@ void ConvertGLTF::SerializeAll(CSZ pathname)
 
 	pathname = path;
 
+	Vector<MeshTask> vTasks;
+	vTasks.reserve(_vMeshes.size());
 	for (const auto& pMesh : _vMeshes)
 	{
 		strcpy(strrchr(path, '\\') + 1, _C(pMesh->GetName()));
@@ -94,13 +97,13 @@ void ConvertGLTF::SerializeAll(CSZ pathname)
 
 		if (!pMesh->IsCopy())
 		{
-			IO::File file;
-			if (file.Open(path, "wb"))
-				pMesh->SerializeX3D3(file);
-			else
-				throw VERUS_RECOVERABLE << "SerializeAll(); Failed to create file: " << path;
+			MeshTask task;
+			task._pMesh = pMesh;
+			task._pathname = path;
+			vTasks.push_back(task);
 		}
 	}
+	SerializeMeshes(vTasks);
 
 	SerializeMotions(path);
 
@@ -133,15 +136,15 @@ bool ConvertGLTF::IsAsyncFinished() const
 
 void ConvertGLTF::LoadFromFile(CSZ pathname)
 {
-	IO::File file;
-	if (file.Open(pathname, "rb"))
-	{
-		const INT64 size = file.GetSize();
-		_vData.resize(size);
-		file.Read(_vData.data(), size);
-	}
+	// Let the loader read the file and buffers directly, without an extra copy:
+	std::string err, warn;
+	bool ret = false;
+	if (Str::EndsWith(pathname, ".glb", false))
+		ret = _context.LoadBinaryFromFile(&_model, &err, &warn, pathname);
 	else
-		throw VERUS_RECOVERABLE << "LoadFromFile(); " << pathname;
+		ret = _context.LoadASCIIFromFile(&_model, &err, &warn, pathname);
+	if (!ret)
+		throw VERUS_RECOVERABLE << "LoadFromFile(); " << pathname << ", err=" << err << ", warn=" << warn;
 }
 
 void ConvertGLTF::ProcessNodeRecursive(const tinygltf::Node& node, int nodeIndex, bool computeExtraData)
@@ -12,6 +12,7 @@ namespace verus::Extra
 			float     _scaleFactor = 1;
 			float     _angle = 0;
 			float     _areaBasedNormals = 0;
+			int       _lodCount = 3; // Extra levels of detail.
 			bool      _flipNormals = false;
 			bool      _flipFaces = false;
 			bool      _useRigidBones = false;
@@ -30,7 +31,6 @@ namespace verus::Extra
 		tinygltf::TinyGLTF    _context;
 		tinygltf::Model       _model;
 		String                _pathname;
-		Vector<char>          _vData;
 		Vector<NodeExtraData> _vNodeExtraData;
 		std::future<void>     _future;
 		Desc                  _desc;
@@ -44,6 +44,7 @@ namespace verus::Extra
 
 		virtual bool UseAreaBasedNormals() override;
 		virtual bool UseRigidBones() override;
+		virtual int GetLODCount() override;
 		virtual Str GetPathname() override;
 
 		void ParseData(CSZ pathname);
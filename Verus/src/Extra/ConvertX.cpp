@@ -37,6 +37,11 @@ bool ConvertX::UseRigidBones()
 	return _desc._useRigidBones;
 }
 
+int ConvertX::GetLODCount()
+{
+	return _desc._lodCount;
+}
+
 Str ConvertX::GetPathname()
 {
 	return _C(_pathname);
@@ -46,6 +51,7 @@ void ConvertX::ParseData(CSZ pathname)
 {
 	VERUS_RT_ASSERT(IsInitialized());
 
+	_pathname = pathname;
 	LoadFromFile(pathname);
 
 	char prev[256] = {};
@@ -150,6 +156,8 @@ void ConvertX::SerializeAll(CSZ pathname)
 		ssLevel << "</material>" VERUS_CRNL;
 	}
 
+	Vector<MeshTask> vTasks;
+	vTasks.reserve(_vMeshes.size());
 	for (const auto& pMesh : _vMeshes)
 	{
 		strcpy(strrchr(path, '\\') + 1, _C(pMesh->GetName()));
@@ -178,13 +186,13 @@ void ConvertX::SerializeAll(CSZ pathname)
 
 		if (!_desc._convertAsScene || !pMesh->IsCopy())
 		{
-			IO::File file;
-			if (file.Open(path, "wb"))
-				pMesh->SerializeX3D3(file);
-			else
-				throw VERUS_RECOVERABLE << "SerializeAll(); Failed to create file: " << path;
+			MeshTask task;
+			task._pMesh = pMesh;
+			task._pathname = path;
+			vTasks.push_back(task);
 		}
 	}
+	SerializeMeshes(vTasks);
 
 	ssLevel << "</scene>" VERUS_CRNL;
 
@@ -1412,18 +1420,6 @@ void ConvertX::ParseBlockData_MeshMaterialList()
 	StreamSkipWhitespace();
 }
 
-void ConvertX::OnProgress(float percent)
-{
-	if (_pDelegate)
-		_pDelegate->BaseConvert_OnProgress(percent);
-}
-
-void ConvertX::OnProgressText(CSZ txt)
-{
-	if (_pDelegate)
-		_pDelegate->BaseConvert_OnProgressText(txt);
-}
-
 void ConvertX::Debug(CSZ txt)
 {
 	StringStream ss;
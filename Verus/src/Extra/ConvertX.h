@@ -12,6 +12,7 @@ namespace verus::Extra
 			float     _scaleFactor = 1;
 			float     _angle = 0;
 			float     _areaBasedNormals = 0;
+			int       _lodCount = 3; // Extra levels of detail.
 			bool      _useRigidBones = false;
 			bool      _convertAsScene = false;
 			bool      _useDefaultMaterial = false;
@@ -77,6 +78,7 @@ namespace verus::Extra
 
 		virtual bool UseAreaBasedNormals() override;
 		virtual bool UseRigidBones() override;
+		virtual int GetLODCount() override;
 		virtual Str GetPathname() override;
 
 		void ParseData(CSZ pathname);
@@ -112,9 +114,6 @@ namespace verus::Extra
 		void ParseBlockData_TextureFilename();
 		void ParseBlockData_MeshMaterialList();
 
-		void OnProgress(float percent);
-		void OnProgressText(CSZ txt);
-
 		void Debug(CSZ txt);
 
 		void DetectMaterialCopies();
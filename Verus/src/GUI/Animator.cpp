@@ -149,8 +149,19 @@ void Animator::Parse(pugi::xml_node node, PcWidget pWidget)
 	}
 }
 
+bool Animator::IsAnimating() const
+{
+	return
+		_animatedColor._invDuration > 0 ||
+		_animatedRect._invDuration > 0 ||
+		_video._invDuration > 0 ||
+		_angleSpeed ||
+		(_pulseScaleAdd && _pulseSpeed);
+}
+
 void Animator::Reset(float reverseTime)
 {
+	_changed = true;
 	_reverse = (reverseTime > 0);
 	_animatedColor.Reset(reverseTime);
 	_animatedRect.Reset(reverseTime);
@@ -246,6 +257,7 @@ bool Animator::GetVideoBias(float& ub, float& vb) const
 
 void Animator::SetTimeout(float t)
 {
+	_changed = true;
 	_maxTimeout = t;
 	_timeout = 0;
 }
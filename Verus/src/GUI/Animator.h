@@ -75,6 +75,7 @@ namespace verus::GUI
 		float             _originalW = 0;
 		bool              _reverse = false;
 		bool              _preserveAspectRatio = false;
+		bool              _changed = false; // Changed from outside, not by Update().
 
 	public:
 		Animator();
@@ -83,6 +84,13 @@ namespace verus::GUI
 		bool Update();
 		void Parse(pugi::xml_node node, const Widget* pWidget);
 
+		// Something is moving, so the widget must be updated and redrawn.
+		bool IsAnimating() const;
+		// Nothing to update, not even a timeout.
+		bool IsIdle() const { return !IsAnimating() && _maxTimeout < 0; }
+		bool IsChanged() const { return _changed; }
+		void ClearChanged() { _changed = false; }
+
 		void Reset(float reverseTime = 0);
 
 		RcVector4 GetColor(RcVector4 original) const;
@@ -102,9 +110,9 @@ namespace verus::GUI
 		bool GetVideoBias(float& ub, float& vb) const;
 
 		float GetAngle() const { return _angle; }
-		void  SetAngle(float a) { _angle = a; }
+		void  SetAngle(float a) { _angle = a; _changed = true; }
 		float GetPostAngle() const { return _postAngle; }
-		void  SetPostAngle(float a) { _postAngle = a; }
+		void  SetPostAngle(float a) { _postAngle = a; _changed = true; }
 
 		float GetPulseScale() const { return _pulseScale; }
 		float GetPulseScaleAdd() const { return _pulseScaleAdd; }
@@ -41,26 +41,16 @@ void Bars::Draw()
 	GetAbsolutePosition(x, y);
 
 	auto cb = renderer.GetCommandBuffer();
-	auto shader = vm.GetShader();
 	auto& ubGui = vm.GetUbGui();
 	auto& ubGuiFS = vm.GetUbGuiFS();
 
 	ubGuiFS._color = GetColor().GLM();
 
-	vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-	shader->BeginBindDescriptors();
-
 	ubGui._matWVP = Math::QuadMatrix(x, y, GetW(), GetH() * barRatio).UniformBufferFormat();
-	cb->BindDescriptors(shader, 0);
-	cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-	renderer.DrawQuad(cb.Get());
+	vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 
 	ubGui._matWVP = Math::QuadMatrix(x, y + GetH() * (1 - barRatio), GetW(), GetH() * barRatio).UniformBufferFormat();
-	cb->BindDescriptors(shader, 0);
-	cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-	renderer.DrawQuad(cb.Get());
-
-	shader->EndBindDescriptors();
+	vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 }
 
 void Bars::Parse(pugi::xml_node node)
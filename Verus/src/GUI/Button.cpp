@@ -68,3 +68,21 @@ void Button::Parse(pugi::xml_node node)
 		_icon.Parse(imageNode);
 	}
 }
+
+bool Button::IsDirty() const
+{
+	return Widget::IsDirty() || _label.IsDirty() || _image.IsDirty() || (_hasIcon && _icon.IsDirty());
+}
+
+void Button::ClearDirty()
+{
+	Widget::ClearDirty();
+	_label.ClearDirty();
+	_image.ClearDirty();
+	_icon.ClearDirty();
+}
+
+bool Button::IsIdle() const
+{
+	return Widget::IsIdle() && _label.IsIdle() && _image.IsIdle() && (!_hasIcon || _icon.IsIdle());
+}
@@ -19,6 +19,10 @@ namespace verus::GUI
 		virtual void Update() override;
 		virtual void Draw() override;
 		virtual void Parse(pugi::xml_node node) override;
+
+		virtual bool IsDirty() const override;
+		virtual void ClearDirty() override;
+		virtual bool IsIdle() const override;
 	};
 	VERUS_TYPEDEFS(Button);
 }
@@ -80,6 +80,8 @@ CSZ Chat::GetText()
 	_oldWriteAt = _writeAt; // Confirm new messages.
 	_oldMsgIndex = index; // Confirm messages getting old.
 
+	const auto t0 = std::chrono::steady_clock::now();
+
 	// Build a new string:
 	_compiled.clear();
 	index = _writeAt;
@@ -110,6 +112,10 @@ CSZ Chat::GetText()
 	} while (count);
 
 	_compiledW = Str::Utf8ToWide(_compiled);
+
+	_stats._compileCount++;
+	_stats._compileTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
 	return _C(_compiled);
 }
 
@@ -11,6 +11,15 @@ namespace verus::GUI
 
 	class Chat : public Object
 	{
+	public:
+		struct Stats
+		{
+			int   _compileCount = 0; // How many times the text was rebuilt.
+			float _compileTime = 0; // Last rebuild, in milliseconds.
+		};
+		VERUS_TYPEDEFS(Stats);
+
+	private:
 		struct Message
 		{
 			String          _text;
@@ -25,6 +34,7 @@ namespace verus::GUI
 		String          _nameColor;
 		String          _compiled;
 		WideString      _compiledW;
+		Stats           _stats;
 		float           _keepFor = 0;
 		int             _writeAt = 0;
 		int             _oldWriteAt = -1;
@@ -44,6 +54,8 @@ namespace verus::GUI
 		void SetNormalMessageColor(UINT32 color);
 		void SetSystemMessageColor(UINT32 color);
 		void SetNameColor(UINT32 color);
+
+		RcStats GetStats() const { return _stats; }
 	};
 	VERUS_TYPEDEFS(Chat);
 }
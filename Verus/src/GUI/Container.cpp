@@ -57,6 +57,32 @@ void Container::DrawWidgets()
 	}
 }
 
+bool Container::AreWidgetsDirty() const
+{
+	for (const auto& p : _vWidgets)
+	{
+		if (p->IsDirty())
+			return true;
+	}
+	return false;
+}
+
+void Container::ClearWidgetsDirty()
+{
+	for (const auto& p : _vWidgets)
+		p->ClearDirty();
+}
+
+bool Container::AreWidgetsIdle() const
+{
+	for (const auto& p : _vWidgets)
+	{
+		if (!p->IsIdle())
+			return false;
+	}
+	return true;
+}
+
 void Container::ParseWidgets(pugi::xml_node node, CSZ sizerID)
 {
 	VERUS_QREF_VM;
@@ -22,6 +22,10 @@ namespace verus::GUI
 		void UpdateWidgets();
 		void DrawWidgets();
 
+		bool AreWidgetsDirty() const;
+		void ClearWidgetsDirty();
+		bool AreWidgetsIdle() const;
+
 		void ParseWidgets(pugi::xml_node node, CSZ sizerID);
 
 		void ResetAnimators(float reverseTime = 0);
@@ -46,7 +46,6 @@ void Cursor::Draw()
 	const Vector3 scale(512 / 1920.f, 512 / 1080.f);
 
 	auto cb = renderer.GetCommandBuffer();
-	auto shader = vm.GetShader();
 	auto& ubGui = vm.GetUbGui();
 	auto& ubGuiFS = vm.GetUbGuiFS();
 
@@ -56,12 +55,7 @@ void Cursor::Draw()
 	ubGui._tcMaskScaleBias = Vector4(1, 1, 0, 0).GLM();
 	ubGuiFS._color = Vector4::Replicate(1).GLM();
 
-	vm.BindPipeline(ViewManager::PIPE_MAIN, cb);
-	shader->BeginBindDescriptors();
-	cb->BindDescriptors(shader, 0);
-	cb->BindDescriptors(shader, 1, _csh);
-	shader->EndBindDescriptors();
-	renderer.DrawQuad(cb.Get());
+	vm.DrawQuad(ViewManager::PIPE_MAIN, _csh, cb);
 }
 
 void Cursor::MoveHotspotTo(float x, float y)
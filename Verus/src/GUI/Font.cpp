@@ -38,6 +38,7 @@ void Font::DoneStatic()
 void Font::Init(CSZ url)
 {
 	VERUS_INIT();
+	VERUS_QREF_CONST_SETTINGS;
 	VERUS_QREF_RENDERER;
 
 	_tex.Init(url);
@@ -46,7 +47,156 @@ void Font::Init(CSZ url)
 	Str::ReplaceExtension(xmlUrl, ".xml");
 	Vector<BYTE> vData;
 	IO::FileSystem::LoadResource(_C(xmlUrl), vData, IO::FileSystem::LoadDesc(true));
+	LoadMetrics(vData);
 
+	CGI::GeometryDesc geoDesc;
+	geoDesc._name = "Font.Geo";
+	const CGI::VertexInputAttrDesc viaDesc[] =
+	{
+		{0, offsetof(Vertex, _x),     CGI::ViaType::floats, 2, CGI::ViaUsage::position, 0},
+		{0, offsetof(Vertex, _s),     CGI::ViaType::shorts, 2, CGI::ViaUsage::texCoord, 0},
+		{0, offsetof(Vertex, _color), CGI::ViaType::ubytes, 4, CGI::ViaUsage::color, 0},
+		CGI::VertexInputAttrDesc::End()
+	};
+	geoDesc._pVertexInputAttrDesc = viaDesc;
+	const int strides[] = { sizeof(Vertex), 0 };
+	geoDesc._pStrides = strides;
+	_dynBuffer.Init(geoDesc, settings.GetLimits()._font_vertCapacity);
+	_dynBuffer.CreateVertexBuffer();
+
+	CGI::PipelineDesc pipeDesc(_dynBuffer, s_shader, "#", renderer.GetRenderPassHandle_AutoWithDepth());
+	pipeDesc._colorAttachBlendEqs[0] = VERUS_COLOR_BLEND_ALPHA;
+	pipeDesc.DisableDepthTest();
+	_pipe.Init(pipeDesc);
+}
+
+void Font::InitMetrics(CSZ xml)
+{
+	VERUS_INIT();
+
+	Vector<BYTE> vData(xml, xml + strlen(xml));
+	LoadMetrics(vData);
+}
+
+void Font::Done()
+{
+	if (_csh.IsSet()) // Fonts with only metrics have no shader.
+		s_shader->FreeDescriptorSet(_csh);
+	VERUS_DONE(Font);
+}
+
+void Font::ResetDynamicBuffer()
+{
+	_dynBuffer.Reset();
+	_pending = false;
+
+	_frame++;
+	_stats._layoutCount = Utils::Cast32(_mapLayouts.size());
+	_stats._layoutHitCount = 0;
+	_stats._layoutMissCount = 0;
+	_stats._glyphCount = 0;
+	_stats._drawCallCount = 0;
+
+	// Forget layouts, which are no longer used:
+	if (!(_frame & 0x3F) || _mapLayouts.size() > s_maxLayoutCount)
+	{
+		VERUS_WHILE(TMapLayouts, _mapLayouts, it)
+		{
+			if (_frame - it->second._lastUsedFrame > s_layoutLifetime)
+				it = _mapLayouts.erase(it);
+			else
+				++it;
+		}
+	}
+}
+
+void Font::Draw(RcDrawDesc dd)
+{
+	VERUS_QREF_VM;
+	VERUS_QREF_RENDERER;
+
+	if (PRenderList pRenderList = vm.GetRecordingRenderList())
+		pRenderList->AddText(this, dd); // Even if the texture is not loaded yet.
+
+	if (!_csh.IsSet())
+	{
+		if (_tex->IsLoaded())
+			_csh = s_shader->BindDescriptorSetTextures(1, { _tex });
+		else
+			return;
+	}
+
+	const float yScale = dd._scale * (dd._preserveAspectRatio ? (1080.f / 1920.f) * renderer.GetCurrentViewAspectRatio() : 1.f);
+
+	if (!_pending)
+	{
+		_dynBuffer.Begin();
+		_pending = true;
+	}
+
+	_stats._glyphCount += ForEachQuad(dd, yScale, [this](const Vertex& a0, const Vertex& a1, const Vertex& b0, const Vertex& b1)
+		{
+			_dynBuffer.AddQuad(a0, a1, b0, b1);
+		});
+
+	if (!vm.IsTextBatching())
+		Flush();
+	else
+		vm.AddPendingFont(this);
+}
+
+void Font::Flush()
+{
+	if (!_pending)
+		return;
+	_pending = false;
+
+	VERUS_QREF_VM;
+	VERUS_QREF_RENDERER;
+
+	auto cb = renderer.GetCommandBuffer();
+
+	s_ubFontVS._matWVP = vm.GetXrMatrix().UniformBufferFormat();
+
+	cb->BindPipeline(_pipe);
+	cb->BindVertexBuffers(_dynBuffer);
+
+	s_shader->BeginBindDescriptors();
+	cb->BindDescriptors(s_shader, 0);
+	cb->BindDescriptors(s_shader, 1, _csh);
+	_dynBuffer.End();
+	s_shader->EndBindDescriptors();
+
+	_stats._drawCallCount++;
+}
+
+int Font::GetTextWidth(CWSZ text, int textLen)
+{
+	const int len = (textLen >= 0) ? textLen : static_cast<int>(wcslen(text));
+	int width = 0;
+	VERUS_FOR(i, len)
+	{
+		if (PcCharInfo pCharInfo = FindCharInfo(text[i]))
+		{
+			const int kerning = (i > 0) ? GetKerning(text[i - 1], *pCharInfo) : 0;
+			width += pCharInfo->_xadvance + kerning;
+		}
+	}
+	return width;
+}
+
+float Font::ToFloatX(int size, float scale)
+{
+	return size * (1 / 1920.f) * scale;
+}
+
+float Font::ToFloatY(int size, float scale)
+{
+	return size * (1 / 1080.f) * scale;
+}
+
+void Font::LoadMetrics(Vector<BYTE>& vData)
+{
 	pugi::xml_document doc;
 	const pugi::xml_parse_result result = doc.load_buffer_inplace(vData.data(), vData.size());
 	if (!result)
@@ -57,11 +207,14 @@ void Font::Init(CSZ url)
 	_lineHeight = commonNode.attribute("lineHeight").as_int(_lineHeight);
 	_texSize = commonNode.attribute("scaleW").as_int(_texSize);
 
+	_vCharIndices.resize(0x10000, -1);
 	pugi::xml_node charsNode = root.child("chars");
 	for (auto node : charsNode.children())
 	{
 		CharInfo ci = {};
 		const int id = node.attribute("id").as_int();
+		if (id < 0 || id >= static_cast<int>(_vCharIndices.size()))
+			continue; // Outside of the basic multilingual plane.
 		ci._x = node.attribute("x").as_int();
 		ci._y = node.attribute("y").as_int();
 		ci._w = node.attribute("width").as_int();
@@ -73,107 +226,127 @@ void Font::Init(CSZ url)
 		ci._t = ci._y * SHRT_MAX / _texSize;
 		ci._sEnd = (ci._x + ci._w) * SHRT_MAX / _texSize;
 		ci._tEnd = (ci._y + ci._h) * SHRT_MAX / _texSize;
-		_mapCharInfo[id] = ci;
+		if (_vCharIndices[id] >= 0)
+		{
+			_vCharInfo[_vCharIndices[id]] = ci;
+		}
+		else
+		{
+			_vCharIndices[id] = static_cast<short>(_vCharInfo.size());
+			_vCharInfo.push_back(ci);
+		}
 	}
 
+	// Group kerning pairs by the second char:
+	Map<int, Map<int, int>> mapKerning;
 	pugi::xml_node kerningsNode = root.child("kernings");
 	for (auto node : kerningsNode.children())
 	{
 		const int firstChar = node.attribute("first").as_int();
 		const int secondChar = node.attribute("second").as_int();
 		const int amount = node.attribute("amount").as_int();
-		auto it = _mapKerning.find(secondChar);
-		if (it != _mapKerning.end())
-		{
-			RKerning k = it->second;
-			k._mapAmount[firstChar] = amount;
-		}
-		else
-		{
-			Kerning k;
-			k._mapAmount[firstChar] = amount;
-			_mapKerning[secondChar] = k;
-		}
+		mapKerning[secondChar][firstChar] = amount;
 	}
-
-	CGI::GeometryDesc geoDesc;
-	geoDesc._name = "Font.Geo";
-	const CGI::VertexInputAttrDesc viaDesc[] =
+	for (const auto& [secondChar, mapAmount] : mapKerning)
 	{
-		{0, offsetof(Vertex, _x),     CGI::ViaType::floats, 2, CGI::ViaUsage::position, 0},
-		{0, offsetof(Vertex, _s),     CGI::ViaType::shorts, 2, CGI::ViaUsage::texCoord, 0},
-		{0, offsetof(Vertex, _color), CGI::ViaType::ubytes, 4, CGI::ViaUsage::color, 0},
-		CGI::VertexInputAttrDesc::End()
-	};
-	geoDesc._pVertexInputAttrDesc = viaDesc;
-	const int strides[] = { sizeof(Vertex), 0 };
-	geoDesc._pStrides = strides;
-	_dynBuffer.Init(geoDesc, 0x10000);
-	_dynBuffer.CreateVertexBuffer();
-
-	CGI::PipelineDesc pipeDesc(_dynBuffer, s_shader, "#", renderer.GetRenderPassHandle_AutoWithDepth());
-	pipeDesc._colorAttachBlendEqs[0] = VERUS_COLOR_BLEND_ALPHA;
-	pipeDesc.DisableDepthTest();
-	_pipe.Init(pipeDesc);
+		if (secondChar < 0 || secondChar >= static_cast<int>(_vCharIndices.size()) || _vCharIndices[secondChar] < 0)
+			continue;
+		RCharInfo ci = _vCharInfo[_vCharIndices[secondChar]];
+		ci._kerningOffset = Utils::Cast32(_vKerningPairs.size());
+		ci._kerningCount = Utils::Cast32(mapAmount.size());
+		for (const auto& [firstChar, amount] : mapAmount)
+			_vKerningPairs.push_back({ firstChar, amount });
+	}
 }
 
-void Font::Done()
+Font::PcCharInfo Font::FindCharInfo(int c) const
 {
-	s_shader->FreeDescriptorSet(_csh);
-	VERUS_DONE(Font);
+	if (c < 0 || c >= static_cast<int>(_vCharIndices.size()))
+		return nullptr;
+	const int index = _vCharIndices[c];
+	return (index >= 0) ? &_vCharInfo[index] : nullptr;
 }
 
-void Font::ResetDynamicBuffer()
+int Font::GetKerning(int first, RcCharInfo ci) const
 {
-	_dynBuffer.Reset();
+	if (!ci._kerningCount)
+		return 0;
+	auto itBegin = _vKerningPairs.begin() + ci._kerningOffset;
+	auto itEnd = itBegin + ci._kerningCount;
+	auto it = std::lower_bound(itBegin, itEnd, first, [](RcKerningPair kp, int first) {return kp._first < first; });
+	return (it != itEnd && it->_first == first) ? it->_amount : 0;
 }
 
-void Font::Draw(RcDrawDesc dd)
+Font::RcLayout Font::GetLayout(RcDrawDesc dd, float yScale)
 {
-	VERUS_QREF_VM;
-	VERUS_QREF_RENDERER;
-
-	if (!_csh.IsSet())
+	const WideStringView text(dd._text);
+	size_t hash = std::hash<WideStringView>()(text);
+	auto Combine = [&hash](size_t x)
 	{
-		if (_tex->IsLoaded())
-			_csh = s_shader->BindDescriptorSetTextures(1, { _tex });
-		else
-			return;
+		hash ^= x + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+	};
+	Combine(std::hash<float>()(dd._w));
+	Combine(std::hash<float>()(dd._h));
+	Combine(std::hash<float>()(dd._scale));
+	Combine(std::hash<float>()(yScale));
+	Combine(std::hash<int>()(dd._skippedLineCount));
+	Combine(dd._center ? 1 : 0);
+
+	RLayout layout = _mapLayouts[hash];
+	const bool same =
+		layout._lastUsedFrame &&
+		layout._w == dd._w &&
+		layout._h == dd._h &&
+		layout._scale == dd._scale &&
+		layout._yScale == yScale &&
+		layout._skippedLineCount == dd._skippedLineCount &&
+		layout._center == dd._center &&
+		layout._text == text;
+	if (same)
+	{
+		_stats._layoutHitCount++;
 	}
+	else // New one or hash collision:
+	{
+		_stats._layoutMissCount++;
+		layout._text = text;
+		layout._w = dd._w;
+		layout._h = dd._h;
+		layout._scale = dd._scale;
+		layout._yScale = yScale;
+		layout._skippedLineCount = dd._skippedLineCount;
+		layout._center = dd._center;
+		UpdateLayout(dd, yScale, layout);
+	}
+	layout._lastUsedFrame = _frame + 1; // Never zero.
+	return layout;
+}
 
-	_overrideColor = 0;
+void Font::UpdateLayout(RcDrawDesc dd, float yScale, RLayout layout)
+{
+	layout._vGlyphs.clear();
+
+	// Text box's origin is at zero:
+	UINT32 overrideColor = 0;
 	const wchar_t wrapChars[] = L" \t\r\n-\\";
 	CWSZ text = dd._text;
 	int lineCount = -dd._skippedLineCount;
+	PcCharInfo pWhitespace = FindCharInfo(' ');
 	const float lineHeight = ToFloatY(_lineHeight, dd._scale);
-	const float whitespaceWidth = ToFloatX(_mapCharInfo[' ']._xadvance, dd._scale);
-	const float yLimit = dd._y + dd._h - lineHeight;
-	float xoffset = dd._x;
-	float yoffset = dd._y;
+	const float whitespaceWidth = pWhitespace ? ToFloatX(pWhitespace->_xadvance, dd._scale) : 0;
+	const float yLimit = dd._h - lineHeight;
+	float xoffset = 0;
+	float yoffset = 0;
 	if (dd._center)
 	{
 		const float textWidth = ToFloatX(GetTextWidth(dd._text), dd._scale);
 		xoffset = xoffset + (dd._w - textWidth) * 0.5f;
 	}
 	const float xoffsetInit = xoffset;
-	const float yScale = dd._scale * (dd._preserveAspectRatio ? (1080.f / 1920.f) * renderer.GetCurrentViewAspectRatio() : 1.f);
-
-	auto cb = renderer.GetCommandBuffer();
-
-	s_ubFontVS._matWVP = vm.GetXrMatrix().UniformBufferFormat();
-
-	cb->BindPipeline(_pipe);
-	cb->BindVertexBuffers(_dynBuffer);
 
-	s_shader->BeginBindDescriptors();
-	cb->BindDescriptors(s_shader, 0);
-	cb->BindDescriptors(s_shader, 1, _csh);
-	_dynBuffer.Begin();
-
-	// Draw chars:
 	while (*text)
 	{
-		const float spaceLeft = (dd._x + dd._w) - xoffset;
+		const float spaceLeft = dd._w - xoffset;
 
 		int wordLen = static_cast<int>(wcscspn(text, wrapChars)); // First occurrence of wrap chars.
 
@@ -196,8 +369,8 @@ void Font::Draw(RcDrawDesc dd)
 					buffer[i] = static_cast<char>(*text);
 					text++;
 				}
-				_overrideColor = Convert::ColorTextToInt32(buffer);
-				if (!_overrideColor && *text)
+				overrideColor = Convert::ColorTextToInt32(buffer);
+				if (!overrideColor && *text)
 					text++;
 				wordLen = -1;
 			}
@@ -224,13 +397,13 @@ void Font::Draw(RcDrawDesc dd)
 				if (yoffset >= yLimit)
 					break; // No more vertical space.
 
-				// 2) draw the word:
-				xoffset += DrawWord(text, wordLen, xoffset, yoffset, lineCount < 0, _overrideColor ? _overrideColor : dd._colorFont, dd._scale, yScale);
+				// 2) add the word:
+				xoffset += LayoutWord(text, wordLen, xoffset, yoffset, lineCount < 0, overrideColor, dd._scale, yScale, layout);
 			}
 			else // Word fits in:
 			{
-				// Draw the word:
-				xoffset += DrawWord(text, wordLen, xoffset, yoffset, lineCount < 0, _overrideColor ? _overrideColor : dd._colorFont, dd._scale, yScale);
+				// Add the word:
+				xoffset += LayoutWord(text, wordLen, xoffset, yoffset, lineCount < 0, overrideColor, dd._scale, yScale, layout);
 			}
 
 			text += wordLen; // Next char.
@@ -254,72 +427,32 @@ void Font::Draw(RcDrawDesc dd)
 		if (yoffset >= yLimit && lineCount)
 			break; // No more vertical space.
 	}
-
-	_dynBuffer.End();
-	s_shader->EndBindDescriptors();
 }
 
-float Font::DrawWord(CWSZ word, int wordLen, float xoffset, float yoffset, bool onlyCalcWidth, UINT32 color, float xScale, float yScale)
+float Font::LayoutWord(CWSZ word, int wordLen, float xoffset, float yoffset, bool onlyCalcWidth, UINT32 color, float xScale, float yScale, RLayout layout)
 {
 	const float xbegin = xoffset;
 
 	VERUS_FOR(i, wordLen)
 	{
-		VERUS_IF_FOUND_IN(TMapCharInfo, _mapCharInfo, word[i], itCi)
+		if (PcCharInfo pCharInfo = FindCharInfo(word[i]))
 		{
-			RcCharInfo ci = itCi->second;
-			int kerning = 0;
-			if (i > 0)
-			{
-				VERUS_IF_FOUND_IN(TMapKerning, _mapKerning, word[i], itK)
-				{
-					RcKerning k = itK->second;
-					auto it = k._mapAmount.find(word[i - 1]);
-					if (it != k._mapAmount.end())
-						kerning = it->second;
-				}
-			}
+			RcCharInfo ci = *pCharInfo;
+			const int kerning = (i > 0) ? GetKerning(word[i - 1], ci) : 0;
 
 			if (!onlyCalcWidth)
 			{
-				const float xFloat = xoffset + ToFloatX(ci._xoffset + kerning, xScale);
-				const float yFloat = yoffset + ToFloatY(ci._yoffset, yScale);
-				const float xFloatEnd = xFloat + ToFloatX(ci._w, xScale);
-				const float yFloatEnd = yFloat + ToFloatY(ci._h, yScale);
-
-				const float xScreen = xFloat * 2 - 1;
-				const float yScreen = yFloat * -2 + 1;
-				const float xScreenEnd = xFloatEnd * 2 - 1;
-				const float yScreenEnd = yFloatEnd * -2 + 1;
-
-				Vertex a0, a1, b0, b1;
-
-				// A0:
-				a0._x = xScreen;
-				a0._y = yScreen;
-				a0._s = ci._s;
-				a0._t = ci._t;
-				Utils::CopyColor(a0._color, color);
-				// A1:
-				a1._x = xScreenEnd;
-				a1._y = yScreen;
-				a1._s = ci._sEnd;
-				a1._t = ci._t;
-				Utils::CopyColor(a1._color, color);
-				// B0:
-				b0._x = xScreen;
-				b0._y = yScreenEnd;
-				b0._s = ci._s;
-				b0._t = ci._tEnd;
-				Utils::CopyColor(b0._color, color);
-				// B1:
-				b1._x = xScreenEnd;
-				b1._y = yScreenEnd;
-				b1._s = ci._sEnd;
-				b1._t = ci._tEnd;
-				Utils::CopyColor(b1._color, color);
-
-				_dynBuffer.AddQuad(a0, a1, b0, b1);
+				Glyph glyph;
+				glyph._x = xoffset + ToFloatX(ci._xoffset + kerning, xScale);
+				glyph._y = yoffset + ToFloatY(ci._yoffset, yScale);
+				glyph._xEnd = glyph._x + ToFloatX(ci._w, xScale);
+				glyph._yEnd = glyph._y + ToFloatY(ci._h, yScale);
+				glyph._s = ci._s;
+				glyph._t = ci._t;
+				glyph._sEnd = ci._sEnd;
+				glyph._tEnd = ci._tEnd;
+				glyph._color = color;
+				layout._vGlyphs.push_back(glyph);
 			}
 
 			xoffset += ToFloatX(ci._xadvance + kerning, xScale);
@@ -327,39 +460,3 @@ float Font::DrawWord(CWSZ word, int wordLen, float xoffset, float yoffset, bool
 	}
 	return xoffset - xbegin;
 }
-
-int Font::GetTextWidth(CWSZ text, int textLen)
-{
-	const int len = (textLen >= 0) ? textLen : static_cast<int>(wcslen(text));
-	int width = 0;
-	VERUS_FOR(i, len)
-	{
-		VERUS_IF_FOUND_IN(TMapCharInfo, _mapCharInfo, text[i], itCi)
-		{
-			RcCharInfo ci = itCi->second;
-			int kerning = 0;
-			if (i > 0)
-			{
-				VERUS_IF_FOUND_IN(TMapKerning, _mapKerning, text[i], itK)
-				{
-					RcKerning k = itK->second;
-					auto it = k._mapAmount.find(text[i - 1]);
-					if (it != k._mapAmount.end())
-						kerning = it->second;
-				}
-			}
-			width += ci._xadvance + kerning;
-		}
-	}
-	return width;
-}
-
-float Font::ToFloatX(int size, float scale)
-{
-	return size * (1 / 1920.f) * scale;
-}
-
-float Font::ToFloatY(int size, float scale)
-{
-	return size * (1 / 1080.f) * scale;
-}
@@ -6,6 +6,9 @@ namespace verus::GUI
 	// Module for drawing texture-based fonts.
 	// Use AngelCode Bitmap Font Generator to create required files.
 	// Geometry uses -32767 to 32767 short texture coordinates.
+	// Glyphs are found using a table, which is indexed directly by the character code.
+	// Text layout (word wrapping, colors, kerning) is cached and reused while the text and the box size stay the same.
+	// Draw calls are batched: glyphs are added to the dynamic buffer and drawn when ViewManager flushes text.
 	class Font : public Object
 	{
 	public:
@@ -20,6 +23,8 @@ namespace verus::GUI
 			int   _xoffset;
 			int   _yoffset;
 			int   _xadvance;
+			int   _kerningOffset; // In the kerning pairs array, for this char as the second one.
+			int   _kerningCount;
 			short _s;
 			short _t;
 			short _sEnd;
@@ -27,11 +32,12 @@ namespace verus::GUI
 		};
 		VERUS_TYPEDEFS(CharInfo);
 
-		struct Kerning
+		struct KerningPair
 		{
-			Map<int, int> _mapAmount;
+			int _first;
+			int _amount;
 		};
-		VERUS_TYPEDEFS(Kerning);
+		VERUS_TYPEDEFS(KerningPair);
 
 		struct Vertex
 		{
@@ -40,10 +46,50 @@ namespace verus::GUI
 			BYTE  _color[4];
 		};
 
-		typedef Map<int, CharInfo> TMapCharInfo;
-		typedef Map<int, Kerning> TMapKerning;
+		struct Stats
+		{
+			int _layoutCount = 0;
+			int _layoutHitCount = 0; // Per frame.
+			int _layoutMissCount = 0; // Per frame.
+			int _glyphCount = 0; // Per frame.
+			int _drawCallCount = 0; // Per frame.
+		};
+		VERUS_TYPEDEFS(Stats);
+
+		static const int s_maxLayoutCount = 4096;
+		static const int s_layoutLifetime = 120; // In frames.
 
 	private:
+		// Position is relative to the origin of the text box.
+		struct Glyph
+		{
+			float  _x;
+			float  _y;
+			float  _xEnd;
+			float  _yEnd;
+			short  _s;
+			short  _t;
+			short  _sEnd;
+			short  _tEnd;
+			UINT32 _color; // Zero means default color.
+		};
+
+		struct Layout
+		{
+			Vector<Glyph> _vGlyphs;
+			WideString    _text;
+			float         _w = 0;
+			float         _h = 0;
+			float         _scale = 0;
+			float         _yScale = 0;
+			int           _skippedLineCount = 0;
+			bool          _center = false;
+			UINT64        _lastUsedFrame = 0;
+		};
+		VERUS_TYPEDEFS(Layout);
+
+		typedef HashMap<size_t, Layout> TMapLayouts;
+
 		static CGI::ShaderPwn s_shader;
 		static UB_FontVS      s_ubFontVS;
 		static UB_FontFS      s_ubFontFS;
@@ -52,11 +98,15 @@ namespace verus::GUI
 		CGI::PipelinePwn           _pipe;
 		CGI::TexturePwn            _tex;
 		CGI::CSHandle              _csh;
-		TMapCharInfo               _mapCharInfo;
-		TMapKerning                _mapKerning;
+		Vector<CharInfo>           _vCharInfo;
+		Vector<short>              _vCharIndices; // Direct-indexed by char code, negative means no such char.
+		Vector<KerningPair>        _vKerningPairs; // Grouped by the second char, sorted by the first one.
+		TMapLayouts                _mapLayouts;
+		Stats                      _stats;
+		UINT64                     _frame = 0;
 		int                        _lineHeight = 0;
 		int                        _texSize = 0;
-		UINT32                     _overrideColor = 0;
+		bool                       _pending = false;
 
 	public:
 		struct DrawDesc
@@ -81,18 +131,81 @@ namespace verus::GUI
 		static void DoneStatic();
 
 		void Init(CSZ url);
+		// Font without texture and pipeline, which can lay out text (see ForEachQuad()), but cannot draw it.
+		// Metrics are in AngelCode's XML format:
+		void InitMetrics(CSZ xml);
 		void Done();
 
+		// Call this once per frame.
 		void ResetDynamicBuffer();
 
 		int GetLineHeight() const { return _lineHeight; }
 
 		void Draw(RcDrawDesc dd);
-		float DrawWord(CWSZ word, int wordLen, float xoffset, float yoffset, bool onlyCalcWidth, UINT32 color, float xScale, float yScale);
+		// Lays out the text using the cache and calls fn(a0, a1, b0, b1) for each glyph's quad.
+		// Draw() adds these quads to the dynamic buffer. Returns the number of glyphs.
+		template<typename T>
+		int ForEachQuad(RcDrawDesc dd, float yScale, const T& fn)
+		{
+			RcLayout layout = GetLayout(dd, yScale);
+
+			// Move cached glyphs to the text box:
+			const float xOrigin = dd._x * 2 - 1;
+			const float yOrigin = dd._y * -2 + 1;
+			for (const auto& glyph : layout._vGlyphs)
+			{
+				const UINT32 color = glyph._color ? glyph._color : dd._colorFont;
+				const float xScreen = xOrigin + glyph._x * 2;
+				const float yScreen = yOrigin - glyph._y * 2;
+				const float xScreenEnd = xOrigin + glyph._xEnd * 2;
+				const float yScreenEnd = yOrigin - glyph._yEnd * 2;
+
+				Vertex a0, a1, b0, b1;
+
+				// A0:
+				a0._x = xScreen;
+				a0._y = yScreen;
+				a0._s = glyph._s;
+				a0._t = glyph._t;
+				Utils::CopyColor(a0._color, color);
+				// A1:
+				a1._x = xScreenEnd;
+				a1._y = yScreen;
+				a1._s = glyph._sEnd;
+				a1._t = glyph._t;
+				Utils::CopyColor(a1._color, color);
+				// B0:
+				b0._x = xScreen;
+				b0._y = yScreenEnd;
+				b0._s = glyph._s;
+				b0._t = glyph._tEnd;
+				Utils::CopyColor(b0._color, color);
+				// B1:
+				b1._x = xScreenEnd;
+				b1._y = yScreenEnd;
+				b1._s = glyph._sEnd;
+				b1._t = glyph._tEnd;
+				Utils::CopyColor(b1._color, color);
+
+				fn(a0, a1, b0, b1);
+			}
+			return Utils::Cast32(layout._vGlyphs.size());
+		}
+		// Draws glyphs, which were added since the last flush.
+		void Flush();
 		int GetTextWidth(CWSZ text, int textLen = -1);
 
+		RcStats GetStats() const { return _stats; }
+
 		static float ToFloatX(int size, float scale);
 		static float ToFloatY(int size, float scale);
+
+		VERUS_P(void LoadMetrics(Vector<BYTE>& vData));
+		VERUS_P(PcCharInfo FindCharInfo(int c) const);
+		VERUS_P(int GetKerning(int first, RcCharInfo ci) const);
+		VERUS_P(RcLayout GetLayout(RcDrawDesc dd, float yScale));
+		VERUS_P(void UpdateLayout(RcDrawDesc dd, float yScale, RLayout layout));
+		VERUS_P(float LayoutWord(CWSZ word, int wordLen, float xoffset, float yoffset, bool onlyCalcWidth, UINT32 color, float xScale, float yScale, RLayout layout));
 	};
 	VERUS_TYPEDEFS(Font);
 }
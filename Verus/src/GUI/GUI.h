@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Font.h"
+#include "RenderList.h"
 #include "Animator.h"
 #include "Widget.h"
 #include "Container.h"
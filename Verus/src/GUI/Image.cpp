@@ -25,11 +25,16 @@ void Image::Update()
 	VERUS_QREF_VM;
 
 	if (!_solidColor && !_csh.IsSet() && _tex->GetTex()->IsLoaded())
+	{
 		_csh = vm.GetShader()->BindDescriptorSetTextures(1, { _tex->GetTex() });
+		Invalidate();
+	}
 
 	VERUS_QREF_TIMER_GUI;
 	_tcBias.UpdateUnlimited(dt);
 	_tcBias.WrapFloatV();
+	if (!_tcBias.GetSpeed().IsZero())
+		Invalidate(); // Scrolling texture.
 }
 
 void Image::Draw()
@@ -58,7 +63,6 @@ void Image::Draw()
 		VMath::appendScale(Math::QuadMatrix(x, y, GetW(), GetH()) * Transform3(matPreR, Vector3(0)), scale);
 
 	auto cb = renderer.GetCommandBuffer();
-	auto shader = vm.GetShader();
 	auto& ubGui = vm.GetUbGui();
 	auto& ubGuiFS = vm.GetUbGuiFS();
 
@@ -78,28 +82,26 @@ void Image::Draw()
 		ubGui._tcScaleBias.w = vb;
 	}
 
+	ViewManager::PIPE pipe = _add ? ViewManager::PIPE_MAIN_ADD : ViewManager::PIPE_MAIN;
 	if (_useMask)
 	{
 		ubGui._tcMaskScaleBias.x = _tcScaleMask.getX();
 		ubGui._tcMaskScaleBias.y = _tcScaleMask.getY();
 		ubGui._tcMaskScaleBias.z = _tcBiasMask.getX();
 		ubGui._tcMaskScaleBias.w = _tcBiasMask.getY();
-		vm.BindPipeline(_add ? ViewManager::PIPE_MASK_ADD : ViewManager::PIPE_MASK, cb);
+		pipe = _add ? ViewManager::PIPE_MASK_ADD : ViewManager::PIPE_MASK;
 	}
 	else if (_solidColor)
 	{
-		vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-	}
-	else
-	{
-		vm.BindPipeline(_add ? ViewManager::PIPE_MAIN_ADD : ViewManager::PIPE_MAIN, cb);
+		pipe = ViewManager::PIPE_SOLID_COLOR;
 	}
 
-	shader->BeginBindDescriptors();
-	cb->BindDescriptors(shader, 0);
-	cb->BindDescriptors(shader, 1, _solidColor ? vm.GetDefaultComplexSetHandle() : _csh);
-	shader->EndBindDescriptors();
-	renderer.DrawQuad(cb.Get());
+	vm.DrawQuad(pipe, _solidColor ? vm.GetDefaultComplexSetHandle() : _csh, cb);
+}
+
+bool Image::IsIdle() const
+{
+	return Widget::IsIdle() && (_solidColor || _csh.IsSet()) && _tcBias.GetSpeed().IsZero();
 }
 
 void Image::Parse(pugi::xml_node node)
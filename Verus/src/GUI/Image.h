@@ -25,8 +25,10 @@ namespace verus::GUI
 		virtual void Draw() override;
 		virtual void Parse(pugi::xml_node node) override;
 
-		void SetBiasX(float a) { _tcBias.GetValue().setX(a); }
-		void SetBiasY(float a) { _tcBias.GetValue().setY(a); }
+		virtual bool IsIdle() const override;
+
+		void SetBiasX(float a) { _tcBias.GetValue().setX(a); Invalidate(); }
+		void SetBiasY(float a) { _tcBias.GetValue().setY(a); Invalidate(); }
 	};
 	VERUS_TYPEDEFS(Image);
 }
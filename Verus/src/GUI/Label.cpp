@@ -35,13 +35,8 @@ void Label::Draw()
 	float x, y;
 	GetAbsolutePosition(x, y);
 
-	PFont pFont = vm.FindFont(_C(_font));
-
-	if (_center)
-	{
-		const float textWidth = Font::ToFloatX(pFont->GetTextWidth(_C(GetText())), _fontScale);
-		x = x + (GetW() - textWidth) * 0.5f;
-	}
+	if (!_pFont)
+		_pFont = vm.FindFont(_C(_font));
 
 	Font::DrawDesc dd;
 	dd._text = _C(GetText());
@@ -51,7 +46,8 @@ void Label::Draw()
 	dd._h = GetH();
 	dd._scale = _fontScale;
 	dd._colorFont = GetColor().ToColor();
-	pFont->Draw(dd);
+	dd._center = _center; // Font caches the layout, including centering.
+	_pFont->Draw(dd);
 }
 
 void Label::Parse(pugi::xml_node node)
@@ -62,13 +58,13 @@ void Label::Parse(pugi::xml_node node)
 		_shadowColor = Convert::ColorTextToInt32(attr.value());
 
 	_font = node.attribute("font").value();
+	_pFont = ViewManager::I().FindFont(_C(_font));
 
 	CSZ fontScale = node.attribute("fontScale").value();
 	_fontScale = ViewManager::ParseCoordY(fontScale, 1);
 	if (fontScale && Str::EndsWith(fontScale, "px"))
 	{
-		PFont pFont = ViewManager::I().FindFont(_C(_font));
-		const float lineHeight = Font::ToFloatY(pFont->GetLineHeight(), 1);
+		const float lineHeight = Font::ToFloatY(_pFont->GetLineHeight(), 1);
 		_fontScale = _fontScale / lineHeight;
 	}
 
@@ -88,7 +84,7 @@ void Label::Parse(pugi::xml_node node)
 
 float Label::GetFontH() const
 {
-	PFont pFont = ViewManager::I().FindFont(_C(_font));
+	PFont pFont = _pFont ? _pFont : ViewManager::I().FindFont(_C(_font));
 	return Font::ToFloatY(pFont->GetLineHeight(), _fontScale);
 }
 
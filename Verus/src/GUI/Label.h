@@ -7,6 +7,7 @@ namespace verus::GUI
 	{
 		String         _font;
 		Vector<String> _vChoices;
+		PFont          _pFont = nullptr; // Resolved once, not on every draw.
 		float          _fontScale = 1;
 		UINT32         _shadowColor = VERUS_COLOR_RGBA(0, 0, 0, 64);
 		bool           _center = false;
@@ -0,0 +1,149 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::GUI;
+
+RenderList::RenderList()
+{
+}
+
+RenderList::~RenderList()
+{
+}
+
+void RenderList::Begin(RcMatrix4 matXr, float aspectRatio)
+{
+	_vItems.clear();
+	_matXr = matXr;
+	_aspectRatio = aspectRatio;
+	_quadCount = 0;
+	_textCount = 0;
+	_valid = false;
+}
+
+void RenderList::End()
+{
+	// Group compatible draws, keep the order of overlapping ones:
+	_vTempItems.clear();
+	_vTempItems.reserve(_vItems.size());
+	for (auto& item : _vItems)
+	{
+		int insertAt = Utils::Cast32(_vTempItems.size());
+		for (int i = insertAt - 1; i >= 0; --i)
+		{
+			if (IsSameBatch(_vTempItems[i], item))
+			{
+				insertAt = i + 1;
+				break;
+			}
+			if (IsOverlapping(_vTempItems[i], item))
+				break;
+		}
+		_vTempItems.insert(_vTempItems.begin() + insertAt, std::move(item));
+	}
+	std::swap(_vItems, _vTempItems);
+	_vTempItems.clear();
+
+	_valid = true;
+}
+
+bool RenderList::IsValid(RcMatrix4 matXr, float aspectRatio) const
+{
+	return _valid && _aspectRatio == aspectRatio && !memcmp(&_matXr, &matXr, sizeof(Matrix4));
+}
+
+void RenderList::AddQuad(int pipe, CGI::CSHandle csh, const UB_Gui& ubGui, const UB_GuiFS& ubGuiFS)
+{
+	Item item;
+	item._ubGui = ubGui;
+	item._ubGuiFS = ubGuiFS;
+	item._csh = csh;
+	item._pipe = pipe;
+
+	// Transform the corners of the quad to find the bounds:
+	float bounds[4] = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+	const glm::vec4 corners[4] =
+	{
+		glm::vec4(-1, -1, 0, 1),
+		glm::vec4(+1, -1, 0, 1),
+		glm::vec4(-1, +1, 0, 1),
+		glm::vec4(+1, +1, 0, 1)
+	};
+	for (const auto& corner : corners)
+	{
+		const glm::vec4 pos = corner * ubGui._matWVP; // Uniform buffer format is transposed.
+		if (pos.w <= 0)
+		{
+			bounds[0] = bounds[1] = -FLT_MAX;
+			bounds[2] = bounds[3] = FLT_MAX;
+			break;
+		}
+		const float x = pos.x / pos.w;
+		const float y = pos.y / pos.w;
+		bounds[0] = Math::Min(bounds[0], x);
+		bounds[1] = Math::Min(bounds[1], y);
+		bounds[2] = Math::Max(bounds[2], x);
+		bounds[3] = Math::Max(bounds[3], y);
+	}
+	item._bounds = Vector4(bounds[0], bounds[1], bounds[2], bounds[3]);
+
+	_vItems.push_back(std::move(item));
+	_quadCount++;
+}
+
+void RenderList::AddText(PFont pFont, Font::RcDrawDesc dd)
+{
+	Item item;
+	item._pFont = pFont;
+	item._dd = dd;
+	item._text = dd._text;
+	item._dd._text = nullptr;
+	// Text is expected to stay inside its box:
+	item._bounds = Vector4(
+		dd._x * 2 - 1,
+		(dd._y + dd._h) * -2 + 1,
+		(dd._x + dd._w) * 2 - 1,
+		dd._y * -2 + 1);
+
+	_vItems.push_back(std::move(item));
+	_textCount++;
+}
+
+void RenderList::Draw()
+{
+	VERUS_QREF_RENDERER;
+	VERUS_QREF_VM;
+
+	auto cb = renderer.GetCommandBuffer();
+
+	for (const auto& item : _vItems)
+	{
+		if (item._pFont)
+		{
+			Font::DrawDesc dd = item._dd;
+			dd._text = _C(item._text);
+			item._pFont->Draw(dd);
+		}
+		else
+		{
+			vm.GetUbGui() = item._ubGui;
+			vm.GetUbGuiFS() = item._ubGuiFS;
+			vm.DrawQuad(static_cast<ViewManager::PIPE>(item._pipe), item._csh, cb);
+		}
+	}
+}
+
+bool RenderList::IsSameBatch(RcItem a, RcItem b)
+{
+	if (a._pFont || b._pFont)
+		return a._pFont == b._pFont;
+	return a._pipe == b._pipe && a._csh.Get() == b._csh.Get();
+}
+
+bool RenderList::IsOverlapping(RcItem a, RcItem b)
+{
+	return
+		a._bounds.getX() < b._bounds.getZ() && b._bounds.getX() < a._bounds.getZ() &&
+		a._bounds.getY() < b._bounds.getW() && b._bounds.getY() < a._bounds.getW();
+}
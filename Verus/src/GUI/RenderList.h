@@ -0,0 +1,59 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::GUI
+{
+	// Retained list of draws for one view.
+	// Widgets record it while they are drawn, then the view replays it until some widget changes.
+	// Draws, which use the same pipeline and textures, are grouped together, if this doesn't change the result:
+	// a draw can only move in front of other draws, which it doesn't overlap.
+	class RenderList
+	{
+	public:
+#include "../Shaders/GUI.inc.hlsl"
+
+	private:
+		struct Item
+		{
+			UB_Gui         _ubGui;
+			UB_GuiFS       _ubGuiFS;
+			Vector4        _bounds; // In clip space: left, bottom, right, top.
+			CGI::CSHandle  _csh;
+			PFont          _pFont = nullptr; // Text if not null.
+			Font::DrawDesc _dd;
+			WideString     _text;
+			int            _pipe = 0;
+		};
+		VERUS_TYPEDEFS(Item);
+
+		Vector<Item> _vItems;
+		Vector<Item> _vTempItems;
+		Matrix4      _matXr = Matrix4::identity();
+		float        _aspectRatio = 0;
+		int          _quadCount = 0;
+		int          _textCount = 0;
+		bool         _valid = false;
+
+	public:
+		RenderList();
+		~RenderList();
+
+		void Begin(RcMatrix4 matXr, float aspectRatio);
+		void End();
+		void Invalidate() { _valid = false; }
+		// List depends on XR matrix and aspect ratio.
+		bool IsValid(RcMatrix4 matXr, float aspectRatio) const;
+
+		void AddQuad(int pipe, CGI::CSHandle csh, const UB_Gui& ubGui, const UB_GuiFS& ubGuiFS);
+		void AddText(PFont pFont, Font::RcDrawDesc dd);
+
+		void Draw();
+
+		int GetQuadCount() const { return _quadCount; }
+		int GetTextCount() const { return _textCount; }
+
+		VERUS_P(static bool IsSameBatch(RcItem a, RcItem b));
+		VERUS_P(static bool IsOverlapping(RcItem a, RcItem b));
+	};
+	VERUS_TYPEDEFS(RenderList);
+}
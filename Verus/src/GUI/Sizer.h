@@ -20,6 +20,10 @@ namespace verus::GUI
 		virtual void Draw() override;
 		virtual void Parse(pugi::xml_node node) override;
 
+		virtual bool IsDirty() const override { return Widget::IsDirty() || AreWidgetsDirty(); }
+		virtual void ClearDirty() override { Widget::ClearDirty(); ClearWidgetsDirty(); }
+		virtual bool IsIdle() const override { return Widget::IsIdle() && AreWidgetsIdle(); }
+
 		virtual PContainer AsContainer() override { return this; }
 		virtual bool IsSizer() override { return true; }
 
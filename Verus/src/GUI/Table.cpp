@@ -26,6 +26,10 @@ void Table::Draw()
 	VERUS_QREF_VM;
 	VERUS_QREF_RENDERER;
 
+	const auto t0 = std::chrono::steady_clock::now();
+	const int quadCount = vm.GetStats()._quadCount;
+	int textCount = 0;
+
 	DrawInputStyle();
 
 	// Save:
@@ -50,6 +54,7 @@ void Table::Draw()
 			SetText(_C(_header._vCells[i]._text));
 			Label::DrawInputStyle();
 			Label::Draw();
+			textCount++;
 		}
 		yOffset += _rowHeight;
 	}
@@ -60,17 +65,11 @@ void Table::Draw()
 		if (row == _selectedRow)
 		{
 			auto cb = renderer.GetCommandBuffer();
-			auto shader = vm.GetShader();
 
 			vm.GetUbGui()._matWVP = Matrix4(vm.GetXrMatrix() * Math::QuadMatrix(x, yOffset, w, _rowHeight)).UniformBufferFormat();
 			vm.GetUbGuiFS()._color = Vector4(1, 1, 1, 0.25f).GLM();
 
-			vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-			shader->BeginBindDescriptors();
-			cb->BindDescriptors(shader, 0);
-			cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-			shader->EndBindDescriptors();
-			renderer.DrawQuad(cb.Get());
+			vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 		}
 
 		VERUS_FOR(i, _cols)
@@ -84,6 +83,7 @@ void Table::Draw()
 			SetColor(color);
 			SetText(_C(_vRows[row]._vCells[i]._text));
 			Label::Draw();
+			textCount++;
 		}
 		yOffset += _rowHeight;
 
@@ -97,6 +97,11 @@ void Table::Draw()
 	SetW(w);
 	SetH(h);
 	SetColor(tableColor);
+
+	_stats._drawCount++;
+	_stats._quadCount = vm.GetStats()._quadCount - quadCount;
+	_stats._textCount = textCount;
+	_stats._drawTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
 }
 
 void Table::Parse(pugi::xml_node node)
@@ -135,18 +140,25 @@ void Table::Clear()
 {
 	_selectedRow = -1;
 	_vRows.clear();
+	Invalidate();
 }
 
 void Table::SelectNextRow()
 {
 	if (_selectedRow >= 0 && _selectedRow < static_cast<int>(_vRows.size()) - 1)
+	{
 		_selectedRow++;
+		Invalidate();
+	}
 }
 
 void Table::SelectPreviousRow()
 {
 	if (_selectedRow > 0)
+	{
 		_selectedRow--;
+		Invalidate();
+	}
 }
 
 void Table::GetCellData(int index, int col, CSZ& txt, UINT32& color, const void** ppUser)
@@ -171,10 +183,13 @@ void Table::UpdateRow(int index, int col, CSZ txt, UINT32 color, const void* pUs
 		return;
 	if (col >= _cols)
 		return;
-	_vRows[index]._vCells[col]._text = txt;
-	_vRows[index]._vCells[col]._color = color;
+	RCell cell = _vRows[index]._vCells[col];
+	if (cell._text != txt || cell._color != color)
+		Invalidate();
+	cell._text = txt;
+	cell._color = color;
 	if (pUser)
-		_vRows[index]._vCells[col]._pUser = pUser;
+		cell._pUser = pUser;
 }
 
 int Table::AppendRow()
@@ -182,6 +197,7 @@ int Table::AppendRow()
 	const int size = Utils::Cast32(_vRows.size());
 	_vRows.resize(size + 1);
 	_vRows[size]._vCells.resize(_cols);
+	Invalidate();
 	return size;
 }
 
@@ -190,6 +206,7 @@ void Table::Sort(int col, bool asInt, bool descend)
 	if (col >= _cols)
 		return;
 	_selectedRow = -1;
+	Invalidate();
 	std::sort(_vRows.begin(), _vRows.end(), [col, asInt, descend](RcRow a, RcRow b)
 		{
 			if (asInt)
@@ -218,6 +235,7 @@ bool Table::InvokeOnClick(float x, float y)
 	_selectedRow = -1;
 	if (row >= 0 && row < GetRowCount())
 		_selectedRow = row;
+	Invalidate();
 	return ret;
 }
 
@@ -5,6 +5,17 @@ namespace verus::GUI
 {
 	class Table : public Label
 	{
+	public:
+		struct Stats
+		{
+			int   _drawCount = 0; // Render list rebuilds.
+			int   _quadCount = 0; // Per draw.
+			int   _textCount = 0; // Per draw.
+			float _drawTime = 0; // Per draw, in milliseconds.
+		};
+		VERUS_TYPEDEFS(Stats);
+
+	private:
 		struct Cell
 		{
 			String      _text;
@@ -21,6 +32,7 @@ namespace verus::GUI
 
 		Row         _header;
 		Vector<Row> _vRows;
+		Stats       _stats;
 		int         _offset = 0;
 		int         _selectedRow = -1;
 		int         _cols = 0;
@@ -43,7 +55,7 @@ namespace verus::GUI
 		void Clear();
 		int GetRowCount() const { return Utils::Cast32(_vRows.size()); }
 		int GetSelectedRow() const { return _selectedRow; }
-		void SelectRow(int row) { _selectedRow = row; }
+		void SelectRow(int row) { _selectedRow = row; Invalidate(); }
 		void SelectNextRow();
 		void SelectPreviousRow();
 		void GetCellData(int index, int col, CSZ& txt, UINT32& color, const void** ppUser = nullptr);
@@ -53,6 +65,8 @@ namespace verus::GUI
 
 		virtual bool InvokeOnClick(float x, float y) override;
 		virtual bool InvokeOnKey(int scancode) override;
+
+		RcStats GetStats() const { return _stats; }
 	};
 	VERUS_TYPEDEFS(Table);
 }
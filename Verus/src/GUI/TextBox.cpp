@@ -25,6 +25,7 @@ void TextBox::Update()
 	{
 		_blinkCooldown.Start();
 		_blinkState = !_blinkState;
+		Invalidate(); // Caret.
 	}
 }
 
@@ -46,21 +47,20 @@ void TextBox::Draw()
 		const float caretX = Font::ToFloatX(pFont->GetTextWidth(_C(GetText())), GetFontScale());
 
 		auto cb = renderer.GetCommandBuffer();
-		auto shader = vm.GetShader();
 
 		vm.GetUbGui()._matWVP = Matrix4(vm.GetXrMatrix() * Math::QuadMatrix(x + caretX, y, 0.0015f, GetH())).UniformBufferFormat();
 		vm.GetUbGui()._matTex = Math::ToUVMatrix(0, 0).UniformBufferFormat();
 		vm.GetUbGuiFS()._color = Vector4(1, 1, 1, 1).GLM();
 
-		vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-		shader->BeginBindDescriptors();
-		cb->BindDescriptors(shader, 0);
-		cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-		shader->EndBindDescriptors();
-		renderer.DrawQuad(cb.Get());
+		vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 	}
 }
 
+bool TextBox::IsIdle() const
+{
+	return Label::IsIdle() && GetOwnerView()->GetInFocus() != static_cast<const InputFocus*>(this); // Caret is blinking.
+}
+
 void TextBox::Parse(pugi::xml_node node)
 {
 	Label::Parse(node);
@@ -32,6 +32,8 @@ namespace verus::GUI
 		virtual void Parse(pugi::xml_node node) override;
 		virtual PInputFocus AsInputFocus() override { return this; }
 
+		virtual bool IsIdle() const override;
+
 		void Focus();
 		virtual void InputFocus_AddChar(wchar_t c) override;
 		virtual void InputFocus_DeleteChar() override;
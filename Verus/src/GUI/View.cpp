@@ -58,7 +58,21 @@ void View::Update()
 	if (State::done != _state)
 	{
 		Widget::Update();
-		UpdateWidgets();
+
+		VERUS_QREF_RENDERER;
+		const float aspectRatio = renderer.GetCurrentViewAspectRatio();
+		if (_aspectRatio != aspectRatio)
+		{
+			_aspectRatio = aspectRatio;
+			_idle = false;
+		}
+
+		// Static view doesn't update its widgets until some widget changes:
+		if (!_idle || AreWidgetsDirty())
+		{
+			UpdateWidgets();
+			_idle = AreWidgetsIdle();
+		}
 	}
 }
 
@@ -72,6 +86,7 @@ void View::Draw()
 	auto& ubGui = vm.GetUbGui();
 	auto& ubGuiFS = vm.GetUbGuiFS();
 
+	_rebuilt = false;
 	if (!IsVisible())
 		return;
 
@@ -91,12 +106,7 @@ void View::Draw()
 			ubGui._tcMaskScaleBias = Vector4(1, 1, 0, 0).GLM();
 			ubGuiFS._color = Vector4::Replicate(1).GLM();
 
-			vm.BindPipeline(ViewManager::PIPE_MAIN, cb);
-			shader->BeginBindDescriptors();
-			cb->BindDescriptors(shader, 0);
-			cb->BindDescriptors(shader, 1, _csh);
-			shader->EndBindDescriptors();
-			renderer.DrawQuad(cb.Get());
+			vm.DrawQuad(ViewManager::PIPE_MAIN, _csh, cb);
 		}
 	}
 	else if (!GetColor().IsZero())
@@ -107,27 +117,40 @@ void View::Draw()
 		ubGui._tcMaskScaleBias = Vector4(1, 1, 0, 0).GLM();
 		ubGuiFS._color = GetColor().GLM();
 
-		vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-		shader->BeginBindDescriptors();
-		cb->BindDescriptors(shader, 0);
-		cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-		shader->EndBindDescriptors();
-		renderer.DrawQuad(cb.Get());
+		vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 	}
 
-	DrawWidgets();
+	// Record or replay:
+	if (_pDrawnInputFocus != _pInputFocus)
+	{
+		_pDrawnInputFocus = _pInputFocus;
+		_renderList.Invalidate();
+		_idle = false; // Caret.
+	}
+	const Matrix4 matXr = vm.GetXrMatrix();
+	const float aspectRatio = renderer.GetCurrentViewAspectRatio();
+	_rebuilt = !_renderList.IsValid(matXr, aspectRatio) || IsDirty() || AreWidgetsDirty() || GetAnimator().IsAnimating();
+	if (_rebuilt)
+	{
+		_renderList.Begin(matXr, aspectRatio);
+		vm.BeginRecording(&_renderList);
+		DrawWidgets();
+		vm.EndRecording();
+		_renderList.End();
+		ClearDirty();
+		ClearWidgetsDirty();
+	}
+	else
+	{
+		_renderList.Draw();
+	}
 
 	if (_state == State::fadeIn || _state == State::fadeOut || _state == State::done)
 	{
 		vm.GetUbGui()._matWVP = Transform3::UniformBufferFormatIdentity();
 		vm.GetUbGuiFS()._color = Vector4(0, 0, 0, _fade.GetValue()).GLM();
 
-		vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-		shader->BeginBindDescriptors();
-		cb->BindDescriptors(shader, 0);
-		cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-		shader->EndBindDescriptors();
-		renderer.DrawQuad(cb.Get());
+		vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 	}
 }
 
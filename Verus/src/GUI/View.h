@@ -28,6 +28,8 @@ namespace verus::GUI
 	// Views contain other controls.
 	// By default they have "done" state.
 	// You should call ViewManager::FadeTo() after loading.
+	// Widgets are drawn once into a render list, which is replayed until some widget is invalidated.
+	// When all widgets are idle, the view doesn't update them.
 	class View : public Widget, public Container
 	{
 		friend class ViewManager;
@@ -52,12 +54,17 @@ namespace verus::GUI
 		World::TexturePwn _tex;
 		PWidget           _pLastHovered = nullptr;
 		PInputFocus       _pInputFocus = nullptr;
+		PInputFocus       _pDrawnInputFocus = nullptr;
+		RenderList        _renderList;
 		State             _state = State::done;
 		Linear<float>     _fade;
 		float             _fadeSpeed = 4;
+		float             _aspectRatio = 0;
 		bool              _cursor = true;
 		bool              _debug = false;
 		bool              _skipNextKey = false;
+		bool              _idle = false; // Widgets don't need to be updated.
+		bool              _rebuilt = false; // Render list was recorded during the last draw.
 
 	public:
 		View();
@@ -126,8 +126,16 @@ bool ViewManager::Update()
 	for (auto& [key, value] : TStoreFonts::_map)
 		value.ResetDynamicBuffer();
 
+	const auto t0 = std::chrono::steady_clock::now();
+	_stats = Stats();
+	_stats._viewCount = Utils::Cast32(_vViews.size());
 	for (const auto& p : _vViews)
+	{
 		p->Update();
+		if (p->_idle)
+			_stats._staticViewCount++;
+	}
+	_stats._updateTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
 
 	return SwitchView();
 }
@@ -136,12 +144,22 @@ void ViewManager::Draw()
 {
 	VERUS_UPDATE_ONCE_CHECK_DRAW;
 
+	const auto t0 = std::chrono::steady_clock::now();
+	_textBatching = true;
+	_boundPipe = PIPE_COUNT;
 	PView pView = nullptr;
 	VERUS_FOREACH_REVERSE_CONST(Vector<PView>, _vViews, it)
 	{
 		pView = *it;
 		pView->Draw();
+		if (pView->_rebuilt)
+			_stats._rebuiltViewCount++;
 	}
+	FlushText();
+	_textBatching = false;
+	_boundPipe = PIPE_COUNT;
+	_stats._drawTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
 	if (pView && pView->HasCursor())
 		_cursor.Draw();
 }
@@ -400,7 +418,46 @@ bool ViewManager::SwitchView()
 
 void ViewManager::BindPipeline(PIPE pipe, CGI::CommandBufferPtr cb)
 {
+	FlushText();
+	if (_textBatching && _boundPipe == pipe)
+		return;
 	cb->BindPipeline(_pipe[pipe]);
+	_boundPipe = pipe;
+	_stats._pipelineBindCount++;
+}
+
+void ViewManager::DrawQuad(PIPE pipe, CGI::CSHandle csh, CGI::CommandBufferPtr cb)
+{
+	VERUS_QREF_RENDERER;
+
+	if (_pRecordingRenderList)
+		_pRecordingRenderList->AddQuad(pipe, csh, _ubGui, _ubGuiFS);
+
+	BindPipeline(pipe, cb);
+	_shader->BeginBindDescriptors();
+	cb->BindDescriptors(_shader, 0);
+	cb->BindDescriptors(_shader, 1, csh);
+	_shader->EndBindDescriptors();
+	renderer.DrawQuad(cb.Get());
+	_stats._quadCount++;
+}
+
+void ViewManager::AddPendingFont(PFont pFont)
+{
+	if (_pPendingFont == pFont)
+		return;
+	FlushText(); // Glyphs of the previous font were added earlier and must be drawn first.
+	_pPendingFont = pFont;
+}
+
+void ViewManager::FlushText()
+{
+	if (!_pPendingFont)
+		return;
+	_pPendingFont->Flush();
+	_pPendingFont = nullptr;
+	_boundPipe = PIPE_COUNT; // Font has its own pipeline.
+	_stats._textFlushCount++;
 }
 
 CGI::TexturePtr ViewManager::GetDebugTexture()
@@ -10,7 +10,8 @@ namespace verus::GUI
 	class ViewManager : public Singleton<ViewManager>, public Object, public Input::InputFocus, private TStoreFonts
 	{
 	public:
-#include "../Shaders/GUI.inc.hlsl"
+		typedef RenderList::UB_Gui UB_Gui;
+		typedef RenderList::UB_GuiFS UB_GuiFS;
 
 		enum PIPE
 		{
@@ -29,6 +30,19 @@ namespace verus::GUI
 			TEX_COUNT
 		};
 
+		struct Stats
+		{
+			int   _viewCount = 0;
+			int   _staticViewCount = 0; // Views, which skipped widget updates.
+			int   _rebuiltViewCount = 0; // Views, which recorded new render lists.
+			int   _quadCount = 0;
+			int   _pipelineBindCount = 0;
+			int   _textFlushCount = 0;
+			float _updateTime = 0; // In milliseconds.
+			float _drawTime = 0; // In milliseconds.
+		};
+		VERUS_TYPEDEFS(Stats);
+
 	private:
 		PView                         _pCurrentParseView = nullptr;
 		Vector<PView>                 _vViews;
@@ -38,10 +52,15 @@ namespace verus::GUI
 		CGI::TexturePwns<TEX_COUNT>   _tex;
 		CGI::CSHandle                 _cshDefault;
 		CGI::CSHandle                 _cshDebug;
+		PFont                         _pPendingFont = nullptr; // Font with unflushed glyphs.
+		PRenderList                   _pRecordingRenderList = nullptr;
 		String                        _fadeToView;
 		UB_Gui                        _ubGui;
 		UB_GuiFS                      _ubGuiFS;
+		Stats                         _stats;
+		PIPE                          _boundPipe = PIPE_COUNT;
 		bool                          _xrMatrixEnabled = true;
+		bool                          _textBatching = false;
 
 	public:
 		ViewManager();
@@ -85,7 +104,22 @@ namespace verus::GUI
 		VERUS_P(bool SwitchView());
 
 		CGI::ShaderPtr GetShader() { return _shader; }
+		// While views are drawn, the same pipeline is not bound twice in a row.
 		void BindPipeline(PIPE pipe, CGI::CommandBufferPtr cb);
+		// Draws a quad using current uniform buffers. Adds it to the render list, which is being recorded.
+		void DrawQuad(PIPE pipe, CGI::CSHandle csh, CGI::CommandBufferPtr cb);
+
+		// While views are drawn, text is batched: consecutive text with the same font is submitted with one draw call,
+		// just before some other widget or some other font is drawn. This keeps the drawing order.
+		bool IsTextBatching() const { return _textBatching; }
+		void AddPendingFont(PFont pFont);
+		void FlushText();
+
+		PRenderList GetRecordingRenderList() const { return _pRecordingRenderList; }
+		void BeginRecording(PRenderList p) { _pRecordingRenderList = p; }
+		void EndRecording() { _pRecordingRenderList = nullptr; }
+
+		RcStats GetStats() const { return _stats; }
 		UB_Gui& GetUbGui() { return _ubGui; }
 		UB_GuiFS& GetUbGuiFS() { return _ubGuiFS; }
 		CGI::TexturePtr GetDebugTexture();
@@ -20,17 +20,41 @@ WideStr Widget::GetText() const
 void Widget::SetText(CWSZ text)
 {
 	if (_fixedTextLength)
+	{
+		if (wcsncmp(_vFixedText.data(), text, _fixedTextLength - 1))
+			Invalidate();
 		wcsncpy(_vFixedText.data(), text, Math::Min<int>(Utils::Cast32(wcslen(text)), _fixedTextLength - 1));
-	else
+	}
+	else if (_text != text)
+	{
+		Invalidate();
 		_text = text;
+	}
 }
 
 void Widget::SetText(CSZ text)
 {
 	if (_fixedTextLength)
+	{
+		Invalidate(); // Fixed text is for text, which changes all the time.
 		Str::Utf8ToWide(text, _vFixedText.data(), _fixedTextLength);
+	}
 	else
-		_text = Str::Utf8ToWide(text);
+	{
+		WideString textW = Str::Utf8ToWide(text);
+		if (_text != textW)
+		{
+			Invalidate();
+			_text = std::move(textW);
+		}
+	}
+}
+
+void Widget::SetColor(RcVector4 color)
+{
+	if (memcmp(&_color, &color, sizeof(Vector4)))
+		Invalidate();
+	_color = _animator.SetColor(color);
 }
 
 void Widget::DrawDebug()
@@ -46,7 +70,6 @@ void Widget::DrawDebug()
 	GetAbsolutePosition(x, y);
 
 	auto cb = renderer.GetCommandBuffer();
-	auto shader = vm.GetShader();
 	auto& ubGui = vm.GetUbGui();
 	auto& ubGuiFS = vm.GetUbGuiFS();
 
@@ -56,12 +79,7 @@ void Widget::DrawDebug()
 	ubGui._tcMaskScaleBias = Vector4(1, 1, 0, 0).GLM();
 	ubGuiFS._color = Vector4::Replicate(1).GLM();
 
-	vm.BindPipeline(ViewManager::PIPE_MAIN, cb);
-	shader->BeginBindDescriptors();
-	cb->BindDescriptors(shader, 0);
-	cb->BindDescriptors(shader, 1, vm.GetDebugComplexSetHandle());
-	shader->EndBindDescriptors();
-	renderer.DrawQuad(cb.Get());
+	vm.DrawQuad(ViewManager::PIPE_MAIN, vm.GetDebugComplexSetHandle(), cb);
 }
 
 void Widget::DrawInputStyle()
@@ -73,21 +91,17 @@ void Widget::DrawInputStyle()
 	GetAbsolutePosition(x, y);
 
 	auto cb = renderer.GetCommandBuffer();
-	auto shader = vm.GetShader();
 
 	vm.GetUbGui()._matWVP = Matrix4(vm.GetXrMatrix() * Math::QuadMatrix(x, y, GetW(), GetH())).UniformBufferFormat();
 	vm.GetUbGuiFS()._color = Vector4(0, 0, 0, 0.75f * GetColor().getW()).GLM();
 
-	vm.BindPipeline(ViewManager::PIPE_SOLID_COLOR, cb);
-	shader->BeginBindDescriptors();
-	cb->BindDescriptors(shader, 0);
-	cb->BindDescriptors(shader, 1, vm.GetDefaultComplexSetHandle());
-	shader->EndBindDescriptors();
-	renderer.DrawQuad(cb.Get());
+	vm.DrawQuad(ViewManager::PIPE_SOLID_COLOR, vm.GetDefaultComplexSetHandle(), cb);
 }
 
 void Widget::Update()
 {
+	if (_animator.IsAnimating())
+		Invalidate();
 	if (_animator.Update())
 		InvokeOnTimeout();
 }
@@ -183,7 +197,7 @@ bool Widget::IsHovered(float x, float y)
 		(y >= ymin) && (y < ymax);
 }
 
-PView Widget::GetOwnerView()
+PView Widget::GetOwnerView() const
 {
 	VERUS_QREF_VM;
 	return vm.GetViewByName(_C(_ownerView));
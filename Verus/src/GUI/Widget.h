@@ -53,6 +53,7 @@ namespace verus::GUI
 		float           _hScale = 1;
 		bool            _disabled = false;
 		bool            _hidden = false;
+		bool            _dirty = true; // Render list must be rebuilt.
 
 	public:
 		Widget();
@@ -73,12 +74,20 @@ namespace verus::GUI
 
 		RAnimator GetAnimator() { return _animator; }
 
+		// Retained rendering:
+		// Widget is dirty when it looks different and the render list of the view must be rebuilt.
+		// Widget is idle when it doesn't need to be updated every frame.
+		void Invalidate() { _dirty = true; }
+		virtual bool IsDirty() const { return _dirty || _animator.IsChanged(); }
+		virtual void ClearDirty() { _dirty = false; _animator.ClearChanged(); }
+		virtual bool IsIdle() const { return _animator.IsIdle(); }
+
 		// Cast:
 		virtual InputFocus* AsInputFocus() { return nullptr; }
 		virtual Container* AsContainer() { return nullptr; }
 
 		RcVector4 GetColor(bool original = false) const { return original ? _color : _animator.GetColor(_color); }
-		void      SetColor(RcVector4 color) { _color = _animator.SetColor(color); }
+		void      SetColor(RcVector4 color);
 
 		// Relative:
 		float GetX() const { return _animator.GetX(_x); }
@@ -87,10 +96,10 @@ namespace verus::GUI
 		float GetH() const { return _animator.GetH(_h); }
 
 		// Relative:
-		void SetX(float x) { _x = _animator.SetX(x); }
-		void SetY(float y) { _y = _animator.SetY(y); }
-		void SetW(float w) { _w = _animator.SetW(w); }
-		void SetH(float h) { _h = _animator.SetH(h); }
+		void SetX(float x) { if (_x != x) Invalidate(); _x = _animator.SetX(x); }
+		void SetY(float y) { if (_y != y) Invalidate(); _y = _animator.SetY(y); }
+		void SetW(float w) { if (_w != w) Invalidate(); _w = _animator.SetW(w); }
+		void SetH(float h) { if (_h != h) Invalidate(); _h = _animator.SetH(h); }
 
 		void GetRelativePosition(float& x, float& y);
 		void GetAbsolutePosition(float& x, float& y);
@@ -102,14 +111,14 @@ namespace verus::GUI
 		void Disable(bool disable = true) { _disabled = disable; }
 
 		bool IsVisible() const { return !_hidden; }
-		void Show() { _hidden = false; }
-		void Hide(bool hide = true) { _hidden = hide; }
+		void Show() { Hide(false); }
+		void Hide(bool hide = true) { if (_hidden != hide) Invalidate(); _hidden = hide; }
 
 		float GetWScale() const { return _wScale; }
 		float GetHScale() const { return _hScale; }
-		void SetScale(float x, float y) { _wScale = x; _hScale = y; }
+		void SetScale(float x, float y) { if (_wScale != x || _hScale != y) Invalidate(); _wScale = x; _hScale = y; }
 
-		View* GetOwnerView();
+		View* GetOwnerView() const;
 		void ResetOwnerView();
 		void SetSizer(CSZ sizer) { _sizer = sizer; }
 
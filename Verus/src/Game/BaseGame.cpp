@@ -144,6 +144,12 @@ void BaseGame::Loop(bool relativeMouseMode)
 
 	do // The Game Loop.
 	{
+		D::Profiler::I().BeginFrame();
+
+		// Physics objects can be accessed by any code below:
+		if (Physics::Bullet::IsValidSingleton())
+			Physics::Bullet::I().WaitForSimulation();
+
 		im.ResetInputState(); // Prepare for event polling.
 
 		while (SDL_PollEvent(&event))
@@ -154,6 +160,10 @@ void BaseGame::Loop(bool relativeMouseMode)
 			if ((SDL_KEYDOWN == event.type) && (SDLK_RETURN == event.key.keysym.sym) && (event.key.keysym.mod & KMOD_ALT))
 				ToggleFullscreen();
 
+			// Toggle CPU profiler (Ctrl+F11):
+			if ((SDL_KEYDOWN == event.type) && (SDLK_F11 == event.key.keysym.sym) && (event.key.keysym.mod & KMOD_CTRL))
+				D::Profiler::I().ToggleOverlay();
+
 			// <RawInput>
 			bool keyboardShortcut = false;
 			if (_p->_rawInputEvents)
@@ -306,7 +316,7 @@ void BaseGame::Loop(bool relativeMouseMode)
 			if (_restartApp)
 				continue;
 
-			if (Physics::Bullet::IsValidSingleton())
+			if (Physics::Bullet::IsValidSingleton() && !Physics::Bullet::I().HasDedicatedThread())
 			{
 				VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(246, 154, 0, 255), "BaseGame/Update/Physics");
 				Physics::Bullet::I().Simulate();
@@ -345,6 +355,10 @@ void BaseGame::Loop(bool relativeMouseMode)
 			if (Audio::AudioSystem::IsValidSingleton())
 				Audio::AudioSystem::I().Update();
 			VERUS_PROFILER_END_EVENT(cb);
+
+			// Physics thread will run while the frame is drawn:
+			if (Physics::Bullet::IsValidSingleton() && Physics::Bullet::I().HasDedicatedThread())
+				Physics::Bullet::I().Simulate();
 		}
 		VERUS_PROFILER_END_EVENT(cb);
 
@@ -368,6 +382,9 @@ void BaseGame::Loop(bool relativeMouseMode)
 		}
 	} while (!quit); // The Game Loop.
 
+	if (Physics::Bullet::IsValidSingleton())
+		Physics::Bullet::I().WaitForSimulation();
+
 	BaseGame_UnloadContent();
 
 	if (relativeMouseMode)
@@ -59,6 +59,7 @@ void EngineInit::Free()
 void EngineInit::Init(CGI::RendererDelegate* pRendererDelegate)
 {
 	Timer::I().Init();
+	TaskScheduler::I().Init();
 
 	if (_makeIO)
 		IO::Async::I().Init();
@@ -108,7 +109,10 @@ void EngineInit::Init(CGI::RendererDelegate* pRendererDelegate)
 
 	// Materials & textures:
 	if (_makeWorld)
+	{
+		World::TextureStreamer::I().Init();
 		World::MaterialManager::I().Init();
+	}
 
 	if (_makeGUI)
 		GUI::ViewManager::I().Init();
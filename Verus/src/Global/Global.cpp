@@ -8,9 +8,11 @@ namespace verus
 	void Make_Global()
 	{
 		Timer::Make();
+		TaskScheduler::Make();
 	}
 	void Free_Global()
 	{
+		TaskScheduler::Free();
 		Timer::Free();
 	}
 }
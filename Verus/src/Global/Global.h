@@ -6,6 +6,7 @@
 #include "BaseAllocator.h"
 #include "AlignedAllocator.h"
 #include "STL.h"
+#include "SlotMap.h"
 #include "Store.h"
 #include "BaseHandle.h"
 #include "Blob.h"
@@ -20,11 +21,13 @@
 #include "Linear.h"
 #include "Convert.h"
 #include "Timer.h"
+#include "TaskScheduler.h"
 #include "Cooldown.h"
 #include "EngineInit.h"
 #include "GlobalVarsClipboard.h"
 #include "DifferenceVector.h"
 #include "Pool.h"
+#include "RadixSort.h"
 #include "LocalPtr.h"
 #include "BaseCircularBuffer.h"
 
@@ -13,6 +13,7 @@ void GlobalVarsClipboard::Copy()
 	_vPairs.push_back(Pair(3, CGI::Renderer::P()));
 	_vPairs.push_back(Pair(4, IO::Async::P()));
 	_vPairs.push_back(Pair(5, Input::InputManager::P()));
+	_vPairs.push_back(Pair(6, D::Profiler::P()));
 }
 
 void GlobalVarsClipboard::Paste()
@@ -23,4 +24,5 @@ void GlobalVarsClipboard::Paste()
 	CGI::Renderer::Assign(static_cast<CGI::Renderer*>(_vPairs[3]._p));
 	IO::Async::Assign(static_cast<IO::Async*>(_vPairs[4]._p));
 	Input::InputManager::Assign(static_cast<Input::InputManager*>(_vPairs[5]._p));
+	D::Profiler::Assign(static_cast<D::Profiler*>(_vPairs[6]._p));
 }
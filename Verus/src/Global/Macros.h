@@ -106,12 +106,12 @@
 #	define VERUS_DLL_EXPORT __attribute__ ((visibility("default")))
 #endif
 
-// Profiler (PIX):
+// Profiler (PIX and D::Profiler):
 #ifdef VERUS_PROFILER_CALLS
 #	pragma message("VERUS_PROFILER_CALLS is defined")
-#	define VERUS_PROFILER_BEGIN_EVENT(cb, color, text) cb->ProfilerBeginEvent(color, text)
-#	define VERUS_PROFILER_END_EVENT(cb)                cb->ProfilerEndEvent()
-#	define VERUS_PROFILER_SET_MARKER(cb, color, text)  cb->ProfilerSetMarker(color, text)
+#	define VERUS_PROFILER_BEGIN_EVENT(cb, color, text) (cb->ProfilerBeginEvent(color, text), verus::D::Profiler::BeginZone(text, color))
+#	define VERUS_PROFILER_END_EVENT(cb)                (cb->ProfilerEndEvent(), verus::D::Profiler::EndZone())
+#	define VERUS_PROFILER_SET_MARKER(cb, color, text)  (cb->ProfilerSetMarker(color, text), verus::D::Profiler::SetMarker(text, color))
 #else
 #	define VERUS_PROFILER_BEGIN_EVENT(cb, color, text)
 #	define VERUS_PROFILER_END_EVENT(cb)
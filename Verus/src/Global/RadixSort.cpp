@@ -0,0 +1,95 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+
+// RadixSort:
+
+void RadixSort::Sort(PSortKey p, PSortKey pTemp, int count)
+{
+	if (count < 2)
+		return;
+
+	const int passCount = sizeof(UINT64);
+	UINT32 histogram[passCount][256] = {};
+
+	// Build all histograms in one pass:
+	VERUS_FOR(i, count)
+	{
+		UINT64 key = p[i]._key;
+		VERUS_FOR(pass, passCount)
+		{
+			histogram[pass][key & 0xFF]++;
+			key >>= 8;
+		}
+	}
+
+	PSortKey pSrc = p;
+	PSortKey pDst = pTemp;
+	VERUS_FOR(pass, passCount)
+	{
+		UINT32* pHistogram = histogram[pass];
+		const int shift = pass * 8;
+
+		// All keys have the same digit?
+		if (pHistogram[(pSrc[0]._key >> shift) & 0xFF] == static_cast<UINT32>(count))
+			continue;
+
+		// Histogram to offsets:
+		UINT32 offset = 0;
+		VERUS_FOR(i, 256)
+		{
+			const UINT32 digitCount = pHistogram[i];
+			pHistogram[i] = offset;
+			offset += digitCount;
+		}
+
+		VERUS_FOR(i, count)
+		{
+			const UINT32 digit = (pSrc[i]._key >> shift) & 0xFF;
+			pDst[pHistogram[digit]++] = pSrc[i];
+		}
+		std::swap(pSrc, pDst);
+	}
+
+	if (pSrc != p)
+		memcpy(p, pSrc, count * sizeof(SortKey));
+}
+
+void RadixSort::Sort(Vector<SortKey>& v, Vector<SortKey>& vTemp, int count)
+{
+	VERUS_RT_ASSERT(count <= v.size());
+	if (vTemp.size() < count)
+		vTemp.resize(count);
+	Sort(v.data(), vTemp.data(), count);
+}
+
+UINT32 RadixSort::QuantizeFloat(float x, int bitCount)
+{
+	VERUS_RT_ASSERT(bitCount > 0 && bitCount <= 32);
+	if (!(x > 0)) // Also handles NaN.
+		return 0;
+	UINT32 bits;
+	memcpy(&bits, &x, sizeof(bits));
+	return static_cast<UINT32>(bits >> (32 - bitCount));
+}
+
+// SortIdAllocator:
+
+UINT16 SortIdAllocator::Allocate()
+{
+	if (!_vFree.empty())
+	{
+		const UINT16 id = _vFree.back();
+		_vFree.pop_back();
+		return id;
+	}
+	VERUS_RT_ASSERT(_next < USHRT_MAX);
+	return _next++;
+}
+
+void SortIdAllocator::Release(UINT16 id)
+{
+	VERUS_RT_ASSERT(id < _next);
+	_vFree.push_back(id);
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus
+{
+	// Packed key, which is compared as unsigned integer, and the index of the item being sorted.
+	struct SortKey
+	{
+		UINT64 _key = 0;
+		UINT32 _index = 0;
+	};
+	VERUS_TYPEDEFS(SortKey);
+
+	// LSD radix sort, 8 bits per pass. It is stable and runs in linear time.
+	// Passes, where all keys have the same digit, are skipped, so unused bits are almost free.
+	class RadixSort
+	{
+	public:
+		static void Sort(PSortKey p, PSortKey pTemp, int count);
+		static void Sort(Vector<SortKey>& v, Vector<SortKey>& vTemp, int count);
+
+		// Order-preserving conversion of a non-negative float to the most significant bits of its representation:
+		static UINT32 QuantizeFloat(float x, int bitCount);
+	};
+
+	// Hands out small IDs, which stay the same for the lifetime of an object. Released IDs are reused.
+	class SortIdAllocator
+	{
+		Vector<UINT16> _vFree;
+		UINT16         _next = 0;
+
+	public:
+		UINT16 Allocate();
+		void Release(UINT16 id);
+	};
+	VERUS_TYPEDEFS(SortIdAllocator);
+}
@@ -0,0 +1,222 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus
+{
+	// Generational handle for SlotMap. Handle becomes stale when the object is deleted,
+	// even if the slot gets reused later (generation will not match).
+	class SlotHandle
+	{
+		UINT32 _index = UINT32_MAX;
+		UINT32 _generation = 0;
+
+	public:
+		SlotHandle() = default;
+		SlotHandle(UINT32 index, UINT32 generation) : _index(index), _generation(generation) {}
+
+		UINT32 GetIndex() const { return _index; }
+		UINT32 GetGeneration() const { return _generation; }
+		bool IsSet() const { return UINT32_MAX != _index; }
+
+		bool operator==(const SlotHandle& that) const { return _index == that._index && _generation == that._generation; }
+		bool operator!=(const SlotHandle& that) const { return !(*this == that); }
+	};
+	VERUS_TYPEDEFS(SlotHandle);
+
+	// Pool-allocated container with O(1) insert, delete and lookup.
+	// Objects are allocated in fixed-size pages and never move, so raw pointers stay valid.
+	// Dense array of pointers is used for iteration, delete swaps the last object into the hole.
+	template<typename TValue, int PAGE_SIZE = 256>
+	class SlotMap
+	{
+		static const UINT32 s_invalid = UINT32_MAX;
+
+		struct Slot
+		{
+			alignas(TValue) BYTE _storage[sizeof(TValue)]; // Must be the first member.
+			UINT32 _index = s_invalid;
+			UINT32 _generation = 0;
+			UINT32 _denseIndex = s_invalid; // Invalid means that this slot is free.
+			UINT32 _nextFree = s_invalid;
+
+			TValue* GetValue() { return reinterpret_cast<TValue*>(_storage); }
+		};
+
+		Vector<Vector<Slot>> _vPages;
+		Vector<TValue*>      _vDense;
+		UINT32               _freeHead = s_invalid;
+		UINT32               _slotCount = 0;
+
+		static Slot* GetSlot(const TValue* p)
+		{
+			return reinterpret_cast<Slot*>(const_cast<TValue*>(p));
+		}
+
+		Slot& GetSlotAt(UINT32 index)
+		{
+			return _vPages[index / PAGE_SIZE][index % PAGE_SIZE];
+		}
+
+		UINT32 AllocSlot()
+		{
+			if (s_invalid != _freeHead)
+			{
+				const UINT32 index = _freeHead;
+				_freeHead = GetSlotAt(index)._nextFree;
+				return index;
+			}
+			if (_slotCount == _vPages.size() * PAGE_SIZE)
+			{
+				_vPages.emplace_back(PAGE_SIZE);
+				Vector<Slot>& page = _vPages.back();
+				VERUS_FOR(i, PAGE_SIZE)
+					page[i]._index = _slotCount + i;
+			}
+			return _slotCount++;
+		}
+
+	public:
+		class Iterator
+		{
+			typename Vector<TValue*>::iterator _it;
+
+		public:
+			Iterator(typename Vector<TValue*>::iterator it) : _it(it) {}
+
+			TValue& operator*() const { return **_it; }
+			TValue* operator->() const { return *_it; }
+			Iterator& operator++() { ++_it; return *this; }
+			bool operator==(const Iterator& that) const { return _it == that._it; }
+			bool operator!=(const Iterator& that) const { return _it != that._it; }
+		};
+
+		SlotMap() = default;
+		SlotMap(const SlotMap&) = delete;
+		SlotMap& operator=(const SlotMap&) = delete;
+		~SlotMap()
+		{
+			DeleteAll();
+		}
+
+		template<typename... Args>
+		TValue* Insert(Args&&... args)
+		{
+			const UINT32 index = AllocSlot();
+			Slot& slot = GetSlotAt(index);
+			TValue* p = new(slot._storage) TValue(std::forward<Args>(args)...);
+			slot._denseIndex = static_cast<UINT32>(_vDense.size());
+			slot._nextFree = s_invalid;
+			_vDense.push_back(p);
+			return p;
+		}
+
+		void Delete(TValue* p)
+		{
+			if (!p)
+				return;
+			Slot* pSlot = GetSlot(p);
+			VERUS_RT_ASSERT(s_invalid != pSlot->_denseIndex);
+
+			// Swap with the last one:
+			const UINT32 denseIndex = pSlot->_denseIndex;
+			TValue* pLast = _vDense.back();
+			_vDense[denseIndex] = pLast;
+			GetSlot(pLast)->_denseIndex = denseIndex;
+			_vDense.pop_back();
+
+			p->~TValue();
+			pSlot->_generation++;
+			pSlot->_denseIndex = s_invalid;
+			pSlot->_nextFree = _freeHead;
+			_freeHead = pSlot->_index;
+		}
+
+		bool Delete(SlotHandle handle)
+		{
+			TValue* p = Find(handle);
+			Delete(p);
+			return !!p;
+		}
+
+		void DeleteAll()
+		{
+			for (auto p : _vDense)
+			{
+				Slot* pSlot = GetSlot(p);
+				p->~TValue();
+				pSlot->_generation++;
+				pSlot->_denseIndex = s_invalid;
+			}
+			_vDense.clear();
+
+			// Rebuild the free list, so that low indices are reused first:
+			_freeHead = s_invalid;
+			for (UINT32 i = _slotCount; i > 0; --i)
+			{
+				Slot& slot = GetSlotAt(i - 1);
+				slot._nextFree = _freeHead;
+				_freeHead = slot._index;
+			}
+		}
+
+		SlotHandle GetHandle(const TValue* p) const
+		{
+			if (!p)
+				return SlotHandle();
+			const Slot* pSlot = GetSlot(p);
+			return SlotHandle(pSlot->_index, pSlot->_generation);
+		}
+
+		TValue* Find(SlotHandle handle)
+		{
+			if (handle.GetIndex() >= _slotCount)
+				return nullptr;
+			Slot& slot = GetSlotAt(handle.GetIndex());
+			if (slot._generation != handle.GetGeneration() || s_invalid == slot._denseIndex)
+				return nullptr;
+			return slot.GetValue();
+		}
+
+		void GetHandles(Vector<SlotHandle>& v) const
+		{
+			v.clear();
+			v.reserve(_vDense.size());
+			for (auto p : _vDense)
+				v.push_back(GetHandle(p));
+		}
+
+		TValue& GetAt(int index)
+		{
+			return *_vDense[index];
+		}
+
+		int FindIndex(const TValue* p) const
+		{
+			if (!p)
+				return -1;
+			const UINT32 denseIndex = GetSlot(p)->_denseIndex;
+			return (s_invalid != denseIndex) ? static_cast<int>(denseIndex) : -1;
+		}
+
+		int GetCount() const
+		{
+			return static_cast<int>(_vDense.size());
+		}
+
+		void Swap(int indexA, int indexB)
+		{
+			std::swap(_vDense[indexA], _vDense[indexB]);
+			GetSlot(_vDense[indexA])->_denseIndex = indexA;
+			GetSlot(_vDense[indexB])->_denseIndex = indexB;
+		}
+
+		void Reserve(int count)
+		{
+			_vDense.reserve(count);
+			_vPages.reserve((count + PAGE_SIZE - 1) / PAGE_SIZE);
+		}
+
+		Iterator begin() { return Iterator(_vDense.begin()); }
+		Iterator end() { return Iterator(_vDense.end()); }
+	};
+}
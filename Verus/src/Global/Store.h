@@ -5,6 +5,7 @@ namespace verus
 {
 	// A convenient way to store a collection of objects.
 	// It's a good idea not to use new/delete explicitly. Use STL allocator.
+	// 'SlotMap' class has O(1) insert, delete and lookup, objects never move, but delete changes the order of the rest.
 	// 'Unique' class uses map and supports reference counting.
 	// The Insert method returns a raw pointer which should be wrapped inside a Ptr.
 	// Types of pointers:
@@ -87,6 +88,74 @@ namespace verus
 		}
 	};
 
+	template<typename TValue>
+	class StoreSlotMap
+	{
+	protected:
+		typedef SlotMap<TValue> TSlotMap;
+
+		TSlotMap _slotMap;
+
+	public:
+		TValue* Insert()
+		{
+			return _slotMap.Insert();
+		}
+
+		void Delete(TValue* p)
+		{
+			_slotMap.Delete(p);
+		}
+
+		void DeleteAll()
+		{
+			_slotMap.DeleteAll();
+		}
+
+		TValue& GetStoredAt(int index)
+		{
+			return _slotMap.GetAt(index);
+		}
+
+		int FindStoredIndex(TValue* p) const
+		{
+			return _slotMap.FindIndex(p);
+		}
+
+		int GetStoredCount() const
+		{
+			return _slotMap.GetCount();
+		}
+
+		SlotHandle GetStoredHandle(TValue* p) const
+		{
+			return _slotMap.GetHandle(p);
+		}
+
+		TValue* FindStored(SlotHandle handle)
+		{
+			return _slotMap.Find(handle);
+		}
+
+		void GetStoredHandles(Vector<SlotHandle>& v) const
+		{
+			_slotMap.GetHandles(v);
+		}
+
+		void MoveStoredUp(int index)
+		{
+			if (index <= 0 || index >= _slotMap.GetCount())
+				return;
+			_slotMap.Swap(index, index - 1);
+		}
+		void MoveStoredDown(int index)
+		{
+			if (index < 0 || index + 1 >= _slotMap.GetCount())
+				return;
+			_slotMap.Swap(index, index + 1);
+		}
+	};
+
 	template<typename TKey, typename TValue>
 	class StoreUnique
 	{
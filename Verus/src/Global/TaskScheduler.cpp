@@ -0,0 +1,128 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+
+static thread_local bool g_taskSchedulerBusyThread = false; // Worker thread or the thread, which runs a job.
+
+TaskScheduler::TaskScheduler()
+{
+	_next = 0;
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	Done();
+}
+
+void TaskScheduler::Init(int workerCount)
+{
+	VERUS_INIT();
+
+	if (workerCount < 0)
+		workerCount = Math::Max<int>(std::thread::hardware_concurrency(), 1) - 1;
+
+	_stopThreads = false;
+	_vThreads.reserve(workerCount);
+	VERUS_FOR(i, workerCount)
+		_vThreads.push_back(std::thread(&TaskScheduler::ThreadProc, this));
+}
+
+void TaskScheduler::Done()
+{
+	if (!_vThreads.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopThreads = true;
+		}
+		_cvWork.notify_all();
+		for (auto& t : _vThreads)
+			t.join();
+		_vThreads.clear();
+	}
+	VERUS_DONE(TaskScheduler);
+}
+
+void TaskScheduler::ParallelFor(int from, int to, int grainSize, const TFunc& func)
+{
+	if (from >= to)
+		return;
+	grainSize = Math::Max(grainSize, 1);
+
+	if (_vThreads.empty() || to - from <= grainSize || g_taskSchedulerBusyThread || !_jobMutex.try_lock())
+	{
+		for (int i = from; i < to; i += grainSize)
+			func(i, Math::Min(i + grainSize, to));
+		return;
+	}
+	std::lock_guard<std::mutex> lockJob(_jobMutex, std::adopt_lock);
+	g_taskSchedulerBusyThread = true;
+
+	_pFunc = &func;
+	_next = from;
+	_to = to;
+	_grainSize = grainSize;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_busyCount = static_cast<int>(_vThreads.size());
+		_jobID++;
+	}
+	_cvWork.notify_all();
+
+	RunChunks();
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cvDone.wait(lock, [this]() {return !_busyCount; });
+	}
+	_pFunc = nullptr;
+
+	g_taskSchedulerBusyThread = false;
+}
+
+bool TaskScheduler::IsWorkerThread()
+{
+	return g_taskSchedulerBusyThread;
+}
+
+void TaskScheduler::ThreadProc()
+{
+	g_taskSchedulerBusyThread = true;
+	VERUS_PROFILER_THREAD_NAME("Worker");
+	UINT32 jobID = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cvWork.wait(lock, [this, jobID]() {return _stopThreads || _jobID != jobID; });
+			if (_stopThreads)
+				break;
+			jobID = _jobID;
+		}
+
+		{
+			VERUS_PROFILER_ZONE("TaskScheduler/Job");
+			RunChunks();
+		}
+
+		bool done = false;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			done = !--_busyCount;
+		}
+		if (done)
+			_cvDone.notify_one();
+	}
+}
+
+void TaskScheduler::RunChunks()
+{
+	while (true)
+	{
+		const int from = _next.fetch_add(_grainSize);
+		if (from >= _to)
+			break;
+		(*_pFunc)(from, Math::Min(from + _grainSize, _to));
+	}
+}
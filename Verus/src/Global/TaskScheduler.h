@@ -0,0 +1,50 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus
+{
+	// Persistent worker threads, which are shared by engine systems (physics, etc.).
+	// Unlike Parallel::For, threads are not created for each call, so it can be used every frame.
+	// Calling thread also takes part in the work. One job runs at a time, nested and concurrent calls run on the calling thread.
+	class TaskScheduler : public Singleton<TaskScheduler>, public Object
+	{
+	public:
+		typedef std::function<void(int from, int to)> TFunc;
+
+	private:
+		Vector<std::thread>     _vThreads;
+		std::mutex              _mutex;
+		std::mutex              _jobMutex;
+		std::condition_variable _cvWork;
+		std::condition_variable _cvDone;
+		const TFunc*            _pFunc = nullptr;
+		std::atomic_int         _next;
+		int                     _to = 0;
+		int                     _grainSize = 1;
+		int                     _busyCount = 0;
+		UINT32                  _jobID = 0;
+		bool                    _stopThreads = false;
+
+	public:
+		TaskScheduler();
+		~TaskScheduler();
+
+		// Negative worker count means one worker per core, minus the calling thread.
+		void Init(int workerCount = -1);
+		void Done();
+
+		// Number of threads, which can run a job, including the calling thread.
+		int GetThreadCount() const { return static_cast<int>(_vThreads.size()) + 1; }
+
+		// Calls func for subranges of [from, to), each subrange is at most grainSize long. Blocks until all subranges are done.
+		// Func must not throw.
+		void ParallelFor(int from, int to, int grainSize, const TFunc& func);
+
+		// True for worker threads and for the thread, which is running a job.
+		static bool IsWorkerThread();
+
+		VERUS_P(void ThreadProc());
+		VERUS_P(void RunChunks());
+	};
+	VERUS_TYPEDEFS(TaskScheduler);
+}
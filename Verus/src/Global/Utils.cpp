@@ -115,51 +115,129 @@ void Utils::ComputeEdgePadding(BYTE* pData, int dataPixelStride, const BYTE* pAl
 	VERUS_RT_ASSERT(channelCount >= 1 && channelCount <= 4);
 	if (!radius)
 		radius = Math::Clamp((width + height) / 256, 1, 16);
-	const int radiusSq = radius * radius;
-	VERUS_P_FOR(i, height)
+	if (width <= 0 || height <= 0)
+		return;
+	VERUS_RT_ASSERT(radius < SHRT_MAX);
+	const INT64 radiusSq = radius * radius;
+
+	// Each transparent pixel gets the color of the nearest opaque pixel within the radius.
+	// This is an exact Euclidean distance transform in two passes, which takes linear time:
+	// 1. For each column find the nearest opaque pixel in that column (vertical offset).
+	// 2. For each row find the lower envelope of parabolas (j - q)^2 + offset(q)^2 (Felzenszwalb & Huttenlocher).
+	// Ties are resolved like a kernel search would do it: upper row first, then left column.
+	// Image is split into bands of rows, each band is processed by one thread. Only opaque pixels are read.
+
+	const short noOffset = SHRT_MAX;
+	const int bandHeight = Math::Max(radius * 8, 64);
+	const int bandCount = (height + bandHeight - 1) / bandHeight;
+	auto IsOpaque = [pAlpha, alphaPixelStride, width](int i, int j)
 	{
-		const int rowOffset = i * width;
-		VERUS_FOR(j, width)
+		return 0 != pAlpha[alphaPixelStride * (i * width + j)];
+	};
+
+	VERUS_P_FOR(band, bandCount)
+	{
+		const int bandBegin = band * bandHeight;
+		const int bandEnd = Math::Min(bandBegin + bandHeight, height);
+		const int bandRowCount = bandEnd - bandBegin;
+
+		// Pass 1, columns:
+		Vector<short> vOffsets(width * bandRowCount, noOffset); // Row offset to the nearest opaque pixel.
+		Vector<int> vLastRows(width, bandBegin - radius - 1); // Out of reach.
+		const int scanBegin = Math::Max(bandBegin - radius, 0);
+		const int scanEnd = Math::Min(bandEnd + radius, height);
+		for (int i = scanBegin; i < bandEnd; ++i) // Down, nearest from above.
 		{
-			const BYTE alpha = pAlpha[alphaPixelStride * (rowOffset + j)];
-			if (alpha)
-				continue;
-			BYTE* pDataChannels = &pData[dataPixelStride * (rowOffset + j)];
+			short* pOffsets = (i >= bandBegin) ? &vOffsets[(i - bandBegin) * width] : nullptr;
+			VERUS_FOR(j, width)
+			{
+				if (IsOpaque(i, j))
+					vLastRows[j] = i;
+				if (pOffsets && i - vLastRows[j] <= radius)
+					pOffsets[j] = static_cast<short>(vLastRows[j] - i);
+			}
+		}
+		std::fill(vLastRows.begin(), vLastRows.end(), bandEnd + radius);
+		for (int i = scanEnd - 1; i >= bandBegin; --i) // Up, nearest from below.
+		{
+			short* pOffsets = (i < bandEnd) ? &vOffsets[(i - bandBegin) * width] : nullptr;
+			VERUS_FOR(j, width)
+			{
+				if (IsOpaque(i, j))
+					vLastRows[j] = i;
+				if (pOffsets && vLastRows[j] - i <= radius && vLastRows[j] - i < abs(pOffsets[j]))
+					pOffsets[j] = static_cast<short>(vLastRows[j] - i); // Strictly closer, upper one wins ties.
+			}
+		}
+
+		// Pass 2, rows:
+		Vector<int> vColumns(width);
+		Vector<INT64> vStartNum(width); // Where the parabola starts to be the lowest, as a fraction.
+		Vector<INT64> vStartDen(width);
+		for (int i = bandBegin; i < bandEnd; ++i)
+		{
+			const short* pOffsets = &vOffsets[(i - bandBegin) * width];
+			auto GetF = [pOffsets](int q) -> INT64
+			{
+				return static_cast<INT64>(pOffsets[q]) * pOffsets[q] + static_cast<INT64>(q) * q;
+			};
 
-			int minRadiusSq = INT_MAX;
-			BYTE color[4] = {};
-			// Kernel:
-			for (int di = -radius; di <= radius; ++di)
+			// Build the lower envelope:
+			int count = 0;
+			VERUS_FOR(q, width)
 			{
-				const int ki = i + di;
-				if (ki < 0 || ki >= height)
+				if (noOffset == pOffsets[q])
 					continue;
-				for (int dj = -radius; dj <= radius; ++dj)
+				INT64 num = 0;
+				INT64 den = 1;
+				while (count > 0)
 				{
-					const int kj = j + dj;
-					if (kj < 0 || kj >= width)
-						continue;
-
-					if (!di && !dj)
-						continue; // Skip origin.
-					const int lenSq = di * di + dj * dj;
-					if (lenSq > radiusSq)
-						continue;
-					const BYTE kernelAlpha = pAlpha[alphaPixelStride * (ki * width + kj)];
-					if (!kernelAlpha)
-						continue;
-
-					if (lenSq < minRadiusSq)
-					{
-						minRadiusSq = lenSq;
-						BYTE* pKernelChannels = &pData[dataPixelStride * (ki * width + kj)];
-						memcpy(color, pKernelChannels, channelCount);
-					}
+					const int p = vColumns[count - 1];
+					num = GetF(q) - GetF(p);
+					den = 2 * (q - p);
+					// Parabola, which is never the lowest one, is removed. If it touches the envelope, it's kept for ties:
+					if (count > 1 && num * vStartDen[count - 1] < vStartNum[count - 1] * den)
+						count--;
+					else
+						break;
 				}
+				vColumns[count] = q;
+				vStartNum[count] = num;
+				vStartDen[count] = den;
+				count++;
 			}
+			if (!count)
+				continue;
+
+			// Find the nearest opaque pixel for each transparent one:
+			int k = 0;
+			VERUS_FOR(j, width)
+			{
+				while (k + 1 < count && vStartNum[k + 1] <= j * vStartDen[k + 1])
+					k++;
+				if (IsOpaque(i, j))
+					continue;
 
-			if (minRadiusSq != INT_MAX)
-				memcpy(pDataChannels, color, channelCount);
+				int bestColumn = vColumns[k];
+				const INT64 dj = j - bestColumn;
+				const INT64 lenSq = dj * dj + static_cast<INT64>(pOffsets[bestColumn]) * pOffsets[bestColumn];
+				if (lenSq > radiusSq)
+					continue;
+				for (int t = k; t > 0 && vStartNum[t] == j * vStartDen[t]; --t) // Other parabolas at the same distance?
+				{
+					const int column = vColumns[t - 1];
+					const int row = i + pOffsets[column];
+					const int bestRow = i + pOffsets[bestColumn];
+					if (row < bestRow || (row == bestRow && column < bestColumn))
+						bestColumn = column;
+				}
+
+				const int nearestRow = i + pOffsets[bestColumn];
+				memcpy(
+					&pData[dataPixelStride * (i * width + j)],
+					&pData[dataPixelStride * (nearestRow * width + bestColumn)],
+					channelCount);
+			}
 		}
 	});
 }
@@ -65,6 +65,7 @@ namespace verus
 		static void CopyByteToInt4(const BYTE src[4], int dest[4]);
 		static void CopyIntToByte4(const int src[4], BYTE dest[4]);
 
+		// Fills transparent pixels with the color of the nearest opaque pixel within the radius (zero means automatic).
 		static void ComputeEdgePadding(BYTE* pData, int dataPixelStride, const BYTE* pAlpha, int alphaPixelStride,
 			int width, int height, int radius = 0, int channelCount = 3);
 
@@ -134,6 +134,11 @@ void Async::Update()
 				for (const auto& pOwner : task._vOwners)
 					pOwner->Async_WhenLoaded(_C(itTask->first) + s_orderLength, Blob(task._v.data(), task._v.size()));
 			}
+			else
+			{
+				for (const auto& pOwner : task._vOwners)
+					pOwner->Async_WhenFailed(_C(itTask->first) + s_orderLength);
+			}
 			itTask = _mapTasks.erase(itTask);
 			// Task complete.
 			if (_onePerUpdateMode)
@@ -177,6 +182,7 @@ void Async::ThreadProc()
 	try
 	{
 		SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+		VERUS_PROFILER_THREAD_NAME("Async");
 		while (true)
 		{
 			CSZ key = nullptr;
@@ -206,10 +212,12 @@ void Async::ThreadProc()
 
 			if (key && (!pTask->_desc._checkExist || FileSystem::FileExist(key + s_orderLength)))
 			{
+				VERUS_PROFILER_ZONE("Async/ThreadProc/Load");
 				try
 				{
-					FileSystem::LoadResource(key + s_orderLength, pTask->_v,
-						FileSystem::LoadDesc(pTask->_desc._nullTerm, pTask->_desc._texturePart));
+					FileSystem::LoadDesc loadDesc(pTask->_desc._nullTerm, pTask->_desc._texturePart);
+					loadDesc._texturePartCount = pTask->_desc._texturePartCount;
+					FileSystem::LoadResource(key + s_orderLength, pTask->_v, loadDesc);
 				}
 				catch (D::RcRuntimeError)
 				{
@@ -237,6 +245,11 @@ void Async::ThreadProc()
 						for (const auto& pOwner : pTask->_vOwners)
 							pOwner->Async_WhenLoaded(key + s_orderLength, Blob(pTask->_v.data(), pTask->_v.size()));
 					}
+					else
+					{
+						for (const auto& pOwner : pTask->_vOwners)
+							pOwner->Async_WhenFailed(key + s_orderLength);
+					}
 					_mapTasks.erase(itTask);
 					// Task complete.
 					if (_mapTasks.empty())
@@ -6,6 +6,7 @@ namespace verus::IO
 	struct AsyncDelegate
 	{
 		virtual void Async_WhenLoaded(CSZ url, RcBlob blob) = 0;
+		virtual void Async_WhenFailed(CSZ url) {} // With checkExist, when the resource couldn't be loaded.
 	};
 	VERUS_TYPEDEFS(AsyncDelegate);
 
@@ -19,6 +20,7 @@ namespace verus::IO
 		struct TaskDesc
 		{
 			int  _texturePart = 0;
+			int  _texturePartCount = 0; // Zero means all remaining parts.
 			bool _nullTerm = false;
 			bool _checkExist = false;
 			bool _runOnMainThread = true;
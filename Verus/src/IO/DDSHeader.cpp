@@ -151,6 +151,16 @@ int DDSHeader::SkipParts(int skipCount)
 	return skipCount;
 }
 
+int DDSHeader::KeepParts(int keepCount)
+{
+	// Call this after SkipParts. Every part except the last one is a single mip level.
+	const int partCount = GetPartCount();
+	if (keepCount <= 0 || keepCount >= partCount)
+		return partCount;
+	_mipMapCount = keepCount;
+	return keepCount;
+}
+
 bool DDSHeaderDXT10::IsBC7() const
 {
 	return Format::bc7 == _dxgiFormat;
@@ -109,6 +109,7 @@ namespace verus::IO
 		static int ComputeBcPitch(int w, int h, bool is4Bits);
 		int GetPartCount() const;
 		int SkipParts(int skipCount);
+		int KeepParts(int keepCount);
 	};
 	VERUS_TYPEDEFS(DDSHeader);
 
@@ -190,7 +190,7 @@ void FileSystem::LoadResourceFromFile(CSZ url, Vector<BYTE>& vData, RcLoadDesc d
 		{
 			if (Str::EndsWith(url, ".dds", false))
 			{
-				LoadTextureParts(file, url, desc._texturePart, vData);
+				LoadTextureParts(file, url, desc._texturePart, vData, desc._texturePartCount);
 			}
 			else
 			{
@@ -277,6 +277,7 @@ void FileSystem::LoadResourceFromPAK(CSZ url, Vector<BYTE>& vData, RcLoadDesc de
 		}
 		const int partCount = header.GetPartCount();
 		const int skipPartCount = header.SkipParts(desc._texturePart);
+		const int endPart = skipPartCount + header.KeepParts(desc._texturePartCount);
 
 		if (partCount > maxParts)
 			throw VERUS_RUNTIME_ERROR << "LoadResourceFromPAK(); Too many parts in PAK";
@@ -287,7 +288,7 @@ void FileSystem::LoadResourceFromPAK(CSZ url, Vector<BYTE>& vData, RcLoadDesc de
 			file >> partEntries[part * 3 + 0];
 			file >> partEntries[part * 3 + 1];
 			file >> partEntries[part * 3 + 2];
-			if (part >= skipPartCount)
+			if (part >= skipPartCount && part < endPart)
 				totalSize += partEntries[part * 3 + 1];
 		}
 
@@ -304,7 +305,7 @@ void FileSystem::LoadResourceFromPAK(CSZ url, Vector<BYTE>& vData, RcLoadDesc de
 			const INT64 partSize = partEntries[part * 3 + 1];
 			const INT64 partZipSize = partEntries[part * 3 + 2];
 			INT64 size = 0;
-			if (part >= skipPartCount)
+			if (part >= skipPartCount && part < endPart)
 			{
 				file.Seek(pakDataOffset + partOffset, SEEK_SET);
 				file >> size;
@@ -339,7 +340,7 @@ void FileSystem::LoadResourceFromPAK(CSZ url, Vector<BYTE>& vData, RcLoadDesc de
 	}
 }
 
-void FileSystem::LoadTextureParts(RFile file, CSZ url, int texturePart, Vector<BYTE>& vData)
+void FileSystem::LoadTextureParts(RFile file, CSZ url, int texturePart, Vector<BYTE>& vData, int texturePartCount)
 {
 	int headerSize = sizeof(DDSHeader);
 	DDSHeader header;
@@ -358,9 +359,11 @@ void FileSystem::LoadTextureParts(RFile file, CSZ url, int texturePart, Vector<B
 
 	const int partCount = header.GetPartCount();
 	const int skipPartCount = header.SkipParts(texturePart);
+	const int endPart = skipPartCount + header.KeepParts(texturePartCount);
 	const int partCheckCount = partCount - 1;
 
 	size_t skipSize = 0;
+	size_t keepSize = 0;
 	VERUS_FOR(part, partCheckCount)
 	{
 		const int w = maxW >> part;
@@ -368,15 +371,19 @@ void FileSystem::LoadTextureParts(RFile file, CSZ url, int texturePart, Vector<B
 		const size_t partSize = DDSHeader::ComputeBcLevelSize(w, h, header.Is4BitsBC());
 		if (part < skipPartCount)
 			skipSize += partSize;
+		else if (part < endPart)
+			keepSize += partSize;
 	}
 
+	// Read only the required byte range:
 	const INT64 size = file.GetSize();
-	vData.resize(size - skipSize);
+	const INT64 readSize = (endPart < partCount) ? keepSize : size - headerSize - skipSize;
+	vData.resize(headerSize + readSize);
 	memcpy(vData.data(), &header, sizeof(header));
 	if (header.IsDXT10())
 		memcpy(vData.data() + sizeof(header), &header10, sizeof(header10));
 	file.Seek(skipSize, SEEK_CUR);
-	file.Read(vData.data() + headerSize, size - headerSize - skipSize);
+	file.Read(vData.data() + headerSize, readSize);
 }
 
 String FileSystem::ConvertFilenameToPassword(CSZ fileEntry)
@@ -25,6 +25,7 @@ namespace verus::IO
 		struct LoadDesc
 		{
 			int  _texturePart = 0;
+			int  _texturePartCount = 0; // Zero means all remaining parts.
 			bool _nullTerm = false;
 			bool _mandatory = true;
 
@@ -52,7 +53,7 @@ namespace verus::IO
 
 		VERUS_P(static void LoadResourceFromPAK(CSZ url, Vector<BYTE>& vData, RcLoadDesc desc, RFile file, CSZ pakEntry));
 
-		static void LoadTextureParts(RFile file, CSZ url, int texturePart, Vector<BYTE>& vData);
+		static void LoadTextureParts(RFile file, CSZ url, int texturePart, Vector<BYTE>& vData, int texturePartCount = 0);
 		static String ConvertFilenameToPassword(CSZ fileEntry);
 
 		static bool FileExist(CSZ url);
@@ -5,6 +5,7 @@
 #include "Stream.h"
 #include "StreamPtr.h"
 #include "File.h"
+#include "MemoryStream.h"
 #include "FileSystem.h"
 #include "Async.h"
 #include "Json.h"
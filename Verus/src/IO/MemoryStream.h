@@ -0,0 +1,54 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::IO
+{
+	// Seekable stream, which writes to memory. Useful for serializing data, which will be compressed later.
+	class MemoryStream : public SeekableStream
+	{
+		Vector<BYTE> _v;
+		INT64        _offset = 0;
+
+	public:
+		MemoryStream() {}
+		~MemoryStream() {}
+
+		virtual BYTE* GetPointer() override { return _v.data(); }
+
+		Vector<BYTE>& GetData() { return _v; }
+		INT64 GetSize() const { return _v.size(); }
+
+		virtual INT64 Read(void* p, INT64 size) override
+		{
+			VERUS_RT_ASSERT(_offset + size <= GetSize());
+			memcpy(p, _v.data() + _offset, size);
+			_offset += size;
+			return size;
+		}
+
+		virtual INT64 Write(const void* p, INT64 size) override
+		{
+			if (_offset + size > GetSize())
+				_v.resize(_offset + size);
+			memcpy(_v.data() + _offset, p, size);
+			_offset += size;
+			return size;
+		}
+
+		virtual void Seek(INT64 offset, int origin) override
+		{
+			switch (origin)
+			{
+			case SEEK_SET: _offset = offset; break;
+			case SEEK_CUR: _offset += offset; break;
+			case SEEK_END: _offset = GetSize() + offset; break;
+			}
+		}
+
+		virtual INT64 GetPosition() override
+		{
+			return _offset;
+		}
+	};
+	VERUS_TYPEDEFS(MemoryStream);
+}
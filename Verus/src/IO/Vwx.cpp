@@ -52,6 +52,11 @@ void Vwx::Async_WhenLoaded(CSZ url, RcBlob blob)
 			wm.Deserialize(sp);
 		}
 		break;
+		case '>CW<':
+		{
+			wm.DeserializeChunks(sp);
+		}
+		break;
 		default:
 		{
 			sp.Advance(blockSize);
@@ -60,7 +65,7 @@ void Vwx::Async_WhenLoaded(CSZ url, RcBlob blob)
 	}
 }
 
-void Vwx::Serialize(CSZ url)
+void Vwx::Serialize(CSZ url, bool chunked)
 {
 	File file;
 	if (!file.Open(url, "wb"))
@@ -73,7 +78,10 @@ void Vwx::Serialize(CSZ url)
 	file.WriteText(VERUS_CRNL VERUS_CRNL "<VN>");
 	file.WriteString("1.0.0");
 
-	wm.Serialize(file);
+	if (chunked)
+		wm.SerializeChunks(file);
+	else
+		wm.Serialize(file);
 }
 
 void Vwx::Deserialize(CSZ url, bool sync)
@@ -11,7 +11,7 @@ namespace verus::IO
 
 		virtual void Async_WhenLoaded(CSZ url, RcBlob blob) override;
 
-		void Serialize(CSZ url);
+		void Serialize(CSZ url, bool chunked = true);
 		void Deserialize(CSZ url, bool sync);
 
 		void Deserialize_LegacyXXX(CSZ url, RcBlob blob);
@@ -83,6 +83,7 @@ namespace verus
 #include "Plane.h"
 #include "Frustum.h"
 #include "TangentSpaceTools.h"
+#include "MeshOptimizer.h"
 #include "QuadtreeIntegral.h"
 #include "Quadtree.h"
 #include "Octree.h"
@@ -0,0 +1,780 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::Math;
+
+const float MeshOptimizer::s_borderWeight = 10;
+
+namespace
+{
+	const int   g_scoringCacheSize = 32;
+	const float g_cacheDecayPower = 1.5f;
+	const float g_lastTriScore = 0.75f;
+	const float g_valenceBoostScale = 2;
+	const float g_valenceBoostPower = 0.5f;
+
+	float ComputeVertexScore(int cachePos, int activeTriCount)
+	{
+		if (!activeTriCount)
+			return -1; // No triangles need this vertex.
+
+		float score = 0;
+		if (cachePos >= 0)
+		{
+			if (cachePos < 3) // Used by the last triangle.
+			{
+				score = g_lastTriScore;
+			}
+			else
+			{
+				const float scaler = 1.f / (g_scoringCacheSize - 3);
+				score = pow(1 - (cachePos - 3) * scaler, g_cacheDecayPower);
+			}
+		}
+
+		// Bonus points for having a low number of triangles left, so that lone vertices are removed quickly:
+		score += g_valenceBoostScale * pow(static_cast<float>(activeTriCount), -g_valenceBoostPower);
+		return score;
+	}
+
+	struct Quadric // Double precision, because small errors are a difference of large numbers.
+	{
+		double _a00 = 0, _a11 = 0, _a22 = 0;
+		double _a10 = 0, _a20 = 0, _a21 = 0;
+		double _b0 = 0, _b1 = 0, _b2 = 0;
+		double _c = 0;
+		double _w = 0;
+
+		void AddPlane(const glm::vec3& n, float d, float weight)
+		{
+			const glm::dvec3 dn(n);
+			_a00 += weight * dn.x * dn.x;
+			_a11 += weight * dn.y * dn.y;
+			_a22 += weight * dn.z * dn.z;
+			_a10 += weight * dn.y * dn.x;
+			_a20 += weight * dn.z * dn.x;
+			_a21 += weight * dn.z * dn.y;
+			_b0 += weight * dn.x * d;
+			_b1 += weight * dn.y * d;
+			_b2 += weight * dn.z * d;
+			_c += weight * static_cast<double>(d) * d;
+			_w += weight;
+		}
+
+		void Add(const Quadric& that)
+		{
+			_a00 += that._a00;
+			_a11 += that._a11;
+			_a22 += that._a22;
+			_a10 += that._a10;
+			_a20 += that._a20;
+			_a21 += that._a21;
+			_b0 += that._b0;
+			_b1 += that._b1;
+			_b2 += that._b2;
+			_c += that._c;
+			_w += that._w;
+		}
+
+		// Returns weighted average of squared distances to planes:
+		float Evaluate(const glm::vec3& v) const
+		{
+			const glm::dvec3 dv(v);
+			const double rx = _a00 * dv.x + _a10 * dv.y + _a20 * dv.z;
+			const double ry = _a10 * dv.x + _a11 * dv.y + _a21 * dv.z;
+			const double rz = _a20 * dv.x + _a21 * dv.y + _a22 * dv.z;
+			const double r = rx * dv.x + ry * dv.y + rz * dv.z + 2 * (_b0 * dv.x + _b1 * dv.y + _b2 * dv.z) + _c;
+			return (_w > 0) ? static_cast<float>(abs(r) / _w) : 0;
+		}
+	};
+
+	struct Collapse
+	{
+		UINT32 _from;
+		UINT32 _to;
+		float  _error;
+	};
+
+	enum class VertexKind : BYTE
+	{
+		manifold,
+		border, // Can only move along the border.
+		locked // Attribute seam, must not move.
+	};
+
+	UINT64 MakeEdgeKey(UINT32 a, UINT32 b)
+	{
+		return (static_cast<UINT64>(a) << 32) | b;
+	}
+
+	UINT64 MakePositionKey(const glm::vec3& v)
+	{
+		UINT32 bits[3];
+		memcpy(bits, &v, sizeof(bits));
+		UINT64 hash = 14695981039346656037ULL;
+		VERUS_FOR(i, 3)
+		{
+			hash ^= bits[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+}
+
+void MeshOptimizer::OptimizeVertexCache(Vector<UINT32>& vIndices, int vertCount)
+{
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	if (!faceCount)
+		return;
+
+	// Vertex to triangle adjacency:
+	Vector<int> vActiveTriCount(vertCount);
+	Vector<int> vOffsets(vertCount + 1);
+	Vector<int> vAdjacency(faceCount * 3);
+	for (auto index : vIndices)
+		vActiveTriCount[index]++;
+	VERUS_FOR(i, vertCount)
+		vOffsets[i + 1] = vOffsets[i] + vActiveTriCount[i];
+	{
+		Vector<int> vCursor(vOffsets.begin(), vOffsets.end() - 1);
+		VERUS_FOR(i, faceCount * 3)
+			vAdjacency[vCursor[vIndices[i]]++] = i / 3;
+	}
+
+	Vector<float> vVertScores(vertCount);
+	VERUS_FOR(i, vertCount)
+		vVertScores[i] = ComputeVertexScore(-1, vActiveTriCount[i]);
+
+	Vector<BYTE> vEmitted(faceCount);
+	int bestTri = -1;
+	float bestScore = -FLT_MAX;
+	VERUS_FOR(i, faceCount)
+	{
+		const float score =
+			vVertScores[vIndices[i * 3 + 0]] +
+			vVertScores[vIndices[i * 3 + 1]] +
+			vVertScores[vIndices[i * 3 + 2]];
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestTri = i;
+		}
+	}
+
+	Vector<UINT32> vOutput;
+	vOutput.reserve(vIndices.size());
+	int cache[g_scoringCacheSize + 3];
+	int newCache[g_scoringCacheSize + 3];
+	int cacheCount = 0;
+	int nextTri = 0; // For triangles, which are not connected to the cache.
+	while (bestTri >= 0)
+	{
+		const UINT32* pTri = &vIndices[bestTri * 3];
+		vEmitted[bestTri] = 1;
+		vOutput.insert(vOutput.end(), pTri, pTri + 3);
+
+		// Remove this triangle from adjacency:
+		VERUS_FOR(i, 3)
+		{
+			const int vert = pTri[i];
+			int* pAdj = &vAdjacency[vOffsets[vert]];
+			const int count = vActiveTriCount[vert];
+			VERUS_FOR(j, count)
+			{
+				if (pAdj[j] == bestTri)
+				{
+					std::swap(pAdj[j], pAdj[count - 1]);
+					vActiveTriCount[vert]--;
+					break;
+				}
+			}
+		}
+
+		// Move triangle's vertices to the front of the cache:
+		int newCacheCount = 0;
+		VERUS_FOR(i, 3)
+			newCache[newCacheCount++] = pTri[i];
+		VERUS_FOR(i, cacheCount)
+		{
+			const int vert = cache[i];
+			if (vert != pTri[0] && vert != pTri[1] && vert != pTri[2])
+				newCache[newCacheCount++] = vert;
+		}
+
+		// Update scores, vertices at the end are evicted:
+		VERUS_FOR(i, newCacheCount)
+		{
+			const int vert = newCache[i];
+			const int cachePos = (i < g_scoringCacheSize) ? i : -1;
+			vVertScores[vert] = ComputeVertexScore(cachePos, vActiveTriCount[vert]);
+		}
+		cacheCount = Math::Min(newCacheCount, g_scoringCacheSize);
+		memcpy(cache, newCache, cacheCount * sizeof(int));
+
+		// Find the best triangle, which uses vertices from the cache:
+		bestTri = -1;
+		bestScore = -FLT_MAX;
+		VERUS_FOR(i, newCacheCount)
+		{
+			const int vert = newCache[i];
+			const int* pAdj = &vAdjacency[vOffsets[vert]];
+			VERUS_FOR(j, vActiveTriCount[vert])
+			{
+				const int tri = pAdj[j];
+				const float score =
+					vVertScores[vIndices[tri * 3 + 0]] +
+					vVertScores[vIndices[tri * 3 + 1]] +
+					vVertScores[vIndices[tri * 3 + 2]];
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTri = tri;
+				}
+			}
+		}
+
+		if (bestTri < 0) // Cache has nothing to offer, take any remaining triangle:
+		{
+			while (nextTri < faceCount && vEmitted[nextTri])
+				nextTri++;
+			if (nextTri < faceCount)
+				bestTri = nextTri;
+		}
+	}
+
+	vIndices = std::move(vOutput);
+}
+
+void MeshOptimizer::OptimizeOverdraw(
+	Vector<UINT32>& vIndices,
+	const Vector<glm::vec3>& vPositions,
+	float threshold)
+{
+	const int vertCount = Utils::Cast32(vPositions.size());
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	if (faceCount < 2)
+		return;
+
+	const float acmr = ComputeACMR(vIndices, vertCount);
+
+	// Cluster starts where the cache has no vertices of the triangle (hard boundary):
+	Vector<int> vClusterStarts;
+	{
+		Vector<int> vTimestamps(vertCount, -s_cacheSize - 1);
+		int time = 0;
+		VERUS_FOR(i, faceCount)
+		{
+			int missCount = 0;
+			VERUS_FOR(j, 3)
+			{
+				const int vert = vIndices[i * 3 + j];
+				if (time - vTimestamps[vert] > s_cacheSize)
+				{
+					vTimestamps[vert] = time++;
+					missCount++;
+				}
+			}
+			if (!i || 3 == missCount)
+				vClusterStarts.push_back(i);
+		}
+	}
+	const int clusterCount = Utils::Cast32(vClusterStarts.size());
+	if (clusterCount < 2)
+		return;
+	vClusterStarts.push_back(faceCount);
+
+	// Area-weighted centroids and normals:
+	Vector<glm::vec3> vCentroids(clusterCount);
+	Vector<glm::vec3> vNormals(clusterCount);
+	glm::vec3 meshCentroid(0);
+	float meshArea = 0;
+	VERUS_FOR(i, clusterCount)
+	{
+		glm::vec3 centroid(0);
+		glm::vec3 normal(0);
+		float area = 0;
+		for (int tri = vClusterStarts[i]; tri < vClusterStarts[i + 1]; ++tri)
+		{
+			const glm::vec3& a = vPositions[vIndices[tri * 3 + 0]];
+			const glm::vec3& b = vPositions[vIndices[tri * 3 + 1]];
+			const glm::vec3& c = vPositions[vIndices[tri * 3 + 2]];
+			const glm::vec3 n = glm::cross(b - a, c - a);
+			const float triArea = glm::length(n);
+			centroid += (a + b + c) * (triArea / 3);
+			normal += n;
+			area += triArea;
+		}
+		meshCentroid += centroid;
+		meshArea += area;
+		vCentroids[i] = (area > 0) ? centroid / area : vPositions[vIndices[vClusterStarts[i] * 3]];
+		vNormals[i] = (glm::length2(normal) > 0) ? glm::normalize(normal) : glm::vec3(0);
+	}
+	if (meshArea > 0)
+		meshCentroid /= meshArea;
+
+	// Clusters, which face away from the center, are more likely to occlude other clusters:
+	Vector<float> vSortKeys(clusterCount);
+	Vector<int> vOrder(clusterCount);
+	VERUS_FOR(i, clusterCount)
+	{
+		vSortKeys[i] = glm::dot(vCentroids[i] - meshCentroid, vNormals[i]);
+		vOrder[i] = i;
+	}
+	std::stable_sort(vOrder.begin(), vOrder.end(), [&vSortKeys](int a, int b)
+		{
+			return vSortKeys[a] > vSortKeys[b];
+		});
+
+	Vector<UINT32> vNewIndices;
+	vNewIndices.reserve(vIndices.size());
+	for (int cluster : vOrder)
+	{
+		vNewIndices.insert(vNewIndices.end(),
+			vIndices.begin() + vClusterStarts[cluster] * 3,
+			vIndices.begin() + vClusterStarts[cluster + 1] * 3);
+	}
+
+	if (ComputeACMR(vNewIndices, vertCount) <= acmr * threshold)
+		vIndices = std::move(vNewIndices);
+}
+
+int MeshOptimizer::OptimizeVertexFetch(Vector<UINT32>& vIndices, int vertCount, Vector<int>& vRemap)
+{
+	vRemap.assign(vertCount, -1);
+	int nextIndex = 0;
+	for (auto& index : vIndices)
+	{
+		if (vRemap[index] < 0)
+			vRemap[index] = nextIndex++;
+		index = vRemap[index];
+	}
+	const int usedCount = nextIndex;
+	for (auto& x : vRemap)
+	{
+		if (x < 0)
+			x = nextIndex++;
+	}
+	return usedCount;
+}
+
+float MeshOptimizer::Simplify(
+	Vector<UINT32>& vIndices,
+	const Vector<glm::vec3>& vPositions,
+	int targetIndexCount,
+	float maxError)
+{
+	const int vertCount = Utils::Cast32(vPositions.size());
+	int indexCount = Utils::Cast32(vIndices.size());
+	if (targetIndexCount >= indexCount || !vertCount)
+		return 0;
+
+	// Normalize positions, so that error is relative:
+	glm::vec3 mn(+FLT_MAX);
+	glm::vec3 mx(-FLT_MAX);
+	for (const auto& pos : vPositions)
+	{
+		mn = glm::min(mn, pos);
+		mx = glm::max(mx, pos);
+	}
+	const glm::vec3 dims = mx - mn;
+	const float maxSide = Math::Max(dims.x, Math::Max(dims.y, dims.z));
+	const float scale = (maxSide > 0) ? 1 / maxSide : 1;
+	Vector<glm::vec3> vPos(vertCount);
+	VERUS_FOR(i, vertCount)
+		vPos[i] = (vPositions[i] - mn) * scale;
+
+	// Vertices, which share position with other vertices, are on attribute seams:
+	Vector<VertexKind> vKinds(vertCount, VertexKind::manifold);
+	{
+		HashMap<UINT64, int> mapPositions;
+		mapPositions.reserve(vertCount);
+		VERUS_FOR(i, vertCount)
+		{
+			auto [it, inserted] = mapPositions.emplace(MakePositionKey(vPositions[i]), i);
+			if (!inserted)
+			{
+				vKinds[i] = VertexKind::locked;
+				vKinds[it->second] = VertexKind::locked;
+			}
+		}
+	}
+
+	// Border edges have no opposite edge:
+	HashSet<UINT64> setEdges;
+	HashSet<UINT64> setBorderEdges;
+	setEdges.reserve(indexCount);
+	for (int i = 0; i < indexCount; i += 3)
+	{
+		VERUS_FOR(j, 3)
+			setEdges.insert(MakeEdgeKey(vIndices[i + j], vIndices[i + (j + 1) % 3]));
+	}
+	Vector<Quadric> vQuadrics(vertCount);
+	for (int i = 0; i < indexCount; i += 3)
+	{
+		const UINT32* pTri = &vIndices[i];
+		const glm::vec3& a = vPos[pTri[0]];
+		const glm::vec3& b = vPos[pTri[1]];
+		const glm::vec3& c = vPos[pTri[2]];
+		glm::vec3 n = glm::cross(b - a, c - a);
+		const float area = glm::length(n);
+		if (area > 0)
+			n /= area;
+		const float d = -glm::dot(n, a);
+		VERUS_FOR(j, 3)
+			vQuadrics[pTri[j]].AddPlane(n, d, area);
+
+		VERUS_FOR(j, 3)
+		{
+			const UINT32 v0 = pTri[j];
+			const UINT32 v1 = pTri[(j + 1) % 3];
+			if (setEdges.find(MakeEdgeKey(v1, v0)) != setEdges.end())
+				continue;
+			setBorderEdges.insert(MakeEdgeKey(v0, v1));
+			VERUS_FOR(k, 2)
+			{
+				const UINT32 v = k ? v1 : v0;
+				if (VertexKind::manifold == vKinds[v])
+					vKinds[v] = VertexKind::border;
+			}
+
+			// Plane, which is perpendicular to the triangle, keeps the outline:
+			const glm::vec3 edge = vPos[v1] - vPos[v0];
+			const float edgeLenSq = glm::length2(edge);
+			if (edgeLenSq > 0)
+			{
+				const glm::vec3 en = glm::normalize(glm::cross(edge, n));
+				const float ed = -glm::dot(en, vPos[v0]);
+				vQuadrics[v0].AddPlane(en, ed, edgeLenSq * s_borderWeight);
+				vQuadrics[v1].AddPlane(en, ed, edgeLenSq * s_borderWeight);
+			}
+		}
+	}
+	setEdges.clear();
+
+	auto IsBorderEdge = [&setBorderEdges](UINT32 a, UINT32 b)
+	{
+		return
+			setBorderEdges.find(MakeEdgeKey(a, b)) != setBorderEdges.end() ||
+			setBorderEdges.find(MakeEdgeKey(b, a)) != setBorderEdges.end();
+	};
+	auto CanCollapse = [&vKinds, &IsBorderEdge](UINT32 from, UINT32 to)
+	{
+		switch (vKinds[from])
+		{
+		case VertexKind::manifold: return true;
+		case VertexKind::border: return IsBorderEdge(from, to);
+		}
+		return false;
+	};
+
+	const float maxErrorSq = maxError * maxError;
+	float resultErrorSq = 0;
+	Vector<int> vActiveTriCount;
+	Vector<int> vOffsets;
+	Vector<int> vAdjacency;
+	Vector<UINT32> vRemap(vertCount);
+	Vector<BYTE> vLocked(vertCount);
+	Vector<Collapse> vCollapses;
+	while (indexCount > targetIndexCount)
+	{
+		const int faceCount = indexCount / 3;
+
+		// Vertex to triangle adjacency:
+		vActiveTriCount.assign(vertCount, 0);
+		vOffsets.assign(vertCount + 1, 0);
+		vAdjacency.resize(indexCount);
+		VERUS_FOR(i, indexCount)
+			vActiveTriCount[vIndices[i]]++;
+		VERUS_FOR(i, vertCount)
+			vOffsets[i + 1] = vOffsets[i] + vActiveTriCount[i];
+		{
+			Vector<int> vCursor(vOffsets.begin(), vOffsets.end() - 1);
+			VERUS_FOR(i, indexCount)
+				vAdjacency[vCursor[vIndices[i]]++] = i / 3;
+		}
+
+		// Collect and sort collapse candidates:
+		vCollapses.clear();
+		VERUS_FOR(i, indexCount)
+		{
+			const UINT32 v0 = vIndices[i];
+			const UINT32 v1 = vIndices[i - i % 3 + (i + 1) % 3];
+			if (CanCollapse(v0, v1))
+				vCollapses.push_back({ v0, v1, vQuadrics[v0].Evaluate(vPos[v1]) });
+			if (VertexKind::border == vKinds[v1] && CanCollapse(v1, v0)) // Opposite edge is missing.
+				vCollapses.push_back({ v1, v0, vQuadrics[v1].Evaluate(vPos[v0]) });
+		}
+		std::sort(vCollapses.begin(), vCollapses.end(), [](const Collapse& a, const Collapse& b)
+			{
+				return a._error < b._error;
+			});
+
+		if (vCollapses.empty())
+			break;
+
+		// Cheap collapses, which are locked in this pass, should not be replaced by expensive ones:
+		const int removeFaceCount = (indexCount - targetIndexCount) / 3;
+		const float passMaxErrorSq = Math::Min(maxErrorSq,
+			vCollapses[Math::Min(removeFaceCount, Utils::Cast32(vCollapses.size()) - 1)]._error);
+
+		// Vertices around each collapse are locked until the next pass, so adjacency stays valid:
+		VERUS_FOR(i, vertCount)
+			vRemap[i] = i;
+		std::fill(vLocked.begin(), vLocked.end(), 0);
+		int removedFaceCount = 0;
+		int collapseCount = 0;
+		// If everything cheap is blocked by flips, the pass is repeated with the full error limit:
+		for (int attempt = 0; attempt < 2 && !collapseCount; ++attempt)
+		{
+			const float errorLimitSq = attempt ? maxErrorSq : passMaxErrorSq;
+			for (const auto& collapse : vCollapses)
+			{
+				if (collapse._error > errorLimitSq)
+					break;
+				if (indexCount - removedFaceCount * 3 <= targetIndexCount)
+					break;
+				const UINT32 from = collapse._from;
+				const UINT32 to = collapse._to;
+				if (vLocked[from] || vLocked[to])
+					continue;
+
+				// Triangles must not flip:
+				const int* pAdj = &vAdjacency[vOffsets[from]];
+				const int adjCount = vActiveTriCount[from];
+				bool flip = false;
+				int degenerateCount = 0;
+				VERUS_FOR(j, adjCount)
+				{
+					const UINT32* pTri = &vIndices[pAdj[j] * 3];
+					if (pTri[0] == to || pTri[1] == to || pTri[2] == to)
+					{
+						degenerateCount++;
+						continue;
+					}
+					glm::vec3 a = vPos[pTri[0]];
+					glm::vec3 b = vPos[pTri[1]];
+					glm::vec3 c = vPos[pTri[2]];
+					const glm::vec3 nOld = glm::cross(b - a, c - a);
+					if (pTri[0] == from) a = vPos[to];
+					if (pTri[1] == from) b = vPos[to];
+					if (pTri[2] == from) c = vPos[to];
+					const glm::vec3 nNew = glm::cross(b - a, c - a);
+					if (glm::dot(nOld, nNew) <= 0.25f * glm::length(nOld) * glm::length(nNew))
+					{
+						flip = true;
+						break;
+					}
+				}
+				if (flip)
+					continue;
+
+				vRemap[from] = to;
+				vQuadrics[to].Add(vQuadrics[from]);
+				VERUS_FOR(j, adjCount)
+				{
+					const UINT32* pTri = &vIndices[pAdj[j] * 3];
+					vLocked[pTri[0]] = 1;
+					vLocked[pTri[1]] = 1;
+					vLocked[pTri[2]] = 1;
+				}
+				resultErrorSq = Math::Max(resultErrorSq, collapse._error);
+				removedFaceCount += degenerateCount;
+				collapseCount++;
+			}
+		}
+		if (!collapseCount)
+			break;
+
+		// Apply remap and remove degenerate triangles:
+		int newIndexCount = 0;
+		VERUS_FOR(i, faceCount)
+		{
+			const UINT32 a = vRemap[vIndices[i * 3 + 0]];
+			const UINT32 b = vRemap[vIndices[i * 3 + 1]];
+			const UINT32 c = vRemap[vIndices[i * 3 + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+			vIndices[newIndexCount++] = a;
+			vIndices[newIndexCount++] = b;
+			vIndices[newIndexCount++] = c;
+		}
+		indexCount = newIndexCount;
+		vIndices.resize(indexCount);
+	}
+
+	return sqrt(resultErrorSq);
+}
+
+void MeshOptimizer::BuildClusters(
+	Vector<UINT32>& vIndices,
+	const Vector<glm::vec3>& vPositions,
+	Vector<Cluster>& vClusters,
+	int maxVertCount,
+	int maxFaceCount)
+{
+	vClusters.clear();
+	const int vertCount = Utils::Cast32(vPositions.size());
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	if (!faceCount)
+		return;
+
+	// Vertex to triangle adjacency:
+	Vector<int> vOffsets(vertCount + 1);
+	Vector<int> vAdjacency(faceCount * 3);
+	for (auto index : vIndices)
+		vOffsets[index + 1]++;
+	VERUS_FOR(i, vertCount)
+		vOffsets[i + 1] += vOffsets[i];
+	{
+		Vector<int> vCursor(vOffsets.begin(), vOffsets.end() - 1);
+		VERUS_FOR(i, faceCount * 3)
+			vAdjacency[vCursor[vIndices[i]]++] = i / 3;
+	}
+
+	Vector<glm::vec3> vNormals(faceCount);
+	VERUS_FOR(i, faceCount)
+	{
+		const glm::vec3& a = vPositions[vIndices[i * 3 + 0]];
+		const glm::vec3& b = vPositions[vIndices[i * 3 + 1]];
+		const glm::vec3& c = vPositions[vIndices[i * 3 + 2]];
+		const glm::vec3 n = glm::cross(b - a, c - a);
+		const float len = glm::length(n);
+		vNormals[i] = (len > 0) ? n / len : glm::vec3(0);
+	}
+
+	Vector<BYTE> vEmitted(faceCount);
+	Vector<int> vVertClusters(vertCount, -1); // Last cluster, which uses this vertex.
+	Vector<int> vCandidates;
+	Vector<UINT32> vClusterVerts;
+	Vector<UINT32> vOutput;
+	vOutput.reserve(vIndices.size());
+	int nextSeed = 0;
+	while (true)
+	{
+		while (nextSeed < faceCount && vEmitted[nextSeed])
+			nextSeed++;
+		if (nextSeed >= faceCount)
+			break;
+
+		const int clusterIndex = Utils::Cast32(vClusters.size());
+		Cluster cluster;
+		cluster._firstIndex = Utils::Cast32(vOutput.size());
+		vClusterVerts.clear();
+		vCandidates.clear();
+		glm::vec3 normalSum(0);
+		int clusterFaceCount = 0;
+
+		auto AddTriangle = [&](int tri)
+		{
+			vEmitted[tri] = 1;
+			normalSum += vNormals[tri];
+			clusterFaceCount++;
+			VERUS_FOR(i, 3)
+			{
+				const UINT32 vert = vIndices[tri * 3 + i];
+				vOutput.push_back(vert);
+				if (vVertClusters[vert] == clusterIndex)
+					continue;
+				vVertClusters[vert] = clusterIndex;
+				vClusterVerts.push_back(vert);
+				for (int j = vOffsets[vert]; j < vOffsets[vert + 1]; ++j)
+				{
+					if (!vEmitted[vAdjacency[j]])
+						vCandidates.push_back(vAdjacency[j]);
+				}
+			}
+		};
+
+		AddTriangle(nextSeed);
+		while (clusterFaceCount < maxFaceCount)
+		{
+			// Prefer triangles, which add fewer vertices and keep the normal cone narrow:
+			const glm::vec3 axis = (glm::length2(normalSum) > 0) ? glm::normalize(normalSum) : glm::vec3(0);
+			int bestTri = -1;
+			float bestScore = FLT_MAX;
+			int candidateCount = 0;
+			VERUS_FOR(i, vCandidates.size())
+			{
+				const int tri = vCandidates[i];
+				if (vEmitted[tri])
+					continue;
+				vCandidates[candidateCount++] = tri;
+				int newVertCount = 0;
+				VERUS_FOR(j, 3)
+				{
+					if (vVertClusters[vIndices[tri * 3 + j]] != clusterIndex)
+						newVertCount++;
+				}
+				if (Utils::Cast32(vClusterVerts.size()) + newVertCount > maxVertCount)
+					continue;
+				const float score = newVertCount + (1 - glm::dot(vNormals[tri], axis));
+				if (score < bestScore)
+				{
+					bestScore = score;
+					bestTri = tri;
+				}
+			}
+			vCandidates.resize(candidateCount);
+			if (bestTri < 0)
+				break;
+			AddTriangle(bestTri);
+		}
+		cluster._indexCount = Utils::Cast32(vOutput.size()) - cluster._firstIndex;
+
+		// Bounding sphere around the center of the box:
+		glm::vec3 mn(+FLT_MAX);
+		glm::vec3 mx(-FLT_MAX);
+		for (auto vert : vClusterVerts)
+		{
+			mn = glm::min(mn, vPositions[vert]);
+			mx = glm::max(mx, vPositions[vert]);
+		}
+		cluster._center = (mn + mx) * 0.5f;
+		float radiusSq = 0;
+		for (auto vert : vClusterVerts)
+			radiusSq = Math::Max(radiusSq, glm::distance2(cluster._center, vPositions[vert]));
+		cluster._radius = sqrt(radiusSq);
+
+		// Normal cone, wide cones are not worth testing:
+		cluster._coneAxis = glm::vec3(0, 1, 0);
+		cluster._coneCutoff = 1;
+		if (glm::length2(normalSum) > 0)
+		{
+			cluster._coneAxis = glm::normalize(normalSum);
+			float minDot = 1;
+			for (int i = cluster._firstIndex; i < cluster._firstIndex + cluster._indexCount; i += 3)
+			{
+				const glm::vec3& a = vPositions[vOutput[i + 0]];
+				const glm::vec3& b = vPositions[vOutput[i + 1]];
+				const glm::vec3& c = vPositions[vOutput[i + 2]];
+				const glm::vec3 n = glm::cross(b - a, c - a);
+				if (glm::length2(n) > 0)
+					minDot = Math::Min(minDot, glm::dot(glm::normalize(n), cluster._coneAxis));
+			}
+			if (minDot > 0.1f)
+				cluster._coneCutoff = sqrt(1 - minDot * minDot);
+		}
+
+		vClusters.push_back(cluster);
+	}
+
+	vIndices = std::move(vOutput);
+}
+
+float MeshOptimizer::ComputeACMR(const Vector<UINT32>& vIndices, int vertCount, int cacheSize)
+{
+	const int faceCount = Utils::Cast32(vIndices.size() / 3);
+	if (!faceCount)
+		return 0;
+
+	// FIFO cache:
+	Vector<int> vTimestamps(vertCount, -cacheSize - 1);
+	int time = 0;
+	for (auto index : vIndices)
+	{
+		if (time - vTimestamps[index] > cacheSize)
+			vTimestamps[index] = time++;
+	}
+	return static_cast<float>(time) / faceCount;
+}
@@ -0,0 +1,72 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::Math
+{
+	// Reorders triangle lists for better GPU performance. Works with any vertex format.
+	// Recommended order: OptimizeVertexCache, OptimizeOverdraw, OptimizeVertexFetch.
+	class MeshOptimizer
+	{
+	public:
+		struct Cluster
+		{
+			glm::vec3 _center;
+			float     _radius = 0;
+			glm::vec3 _coneAxis;
+			float     _coneCutoff = 1; // Sine of the cone's angle, 1 means that the cluster cannot be backface culled.
+			int       _firstIndex = 0;
+			int       _indexCount = 0;
+		};
+		VERUS_TYPEDEFS(Cluster);
+
+		static const int   s_cacheSize = 16; // Typical post-transform cache.
+		static const int   s_clusterMaxVertCount = 64;
+		static const int   s_clusterMaxFaceCount = 124;
+		static const float s_borderWeight; // Border edges are more important than surface.
+
+		// Linear-speed vertex cache optimization (Tom Forsyth).
+		static void OptimizeVertexCache(Vector<UINT32>& vIndices, int vertCount);
+
+		// Splits the triangle list into clusters at cache boundaries and sorts them, so that outer clusters are drawn first.
+		// Clusters are not reordered if average cache miss ratio increases more than threshold times.
+		static void OptimizeOverdraw(
+			Vector<UINT32>& vIndices,
+			const Vector<glm::vec3>& vPositions,
+			float threshold = 1.05f);
+
+		// Vertices are renumbered in the order of first use. Remap table gives new index for each old vertex.
+		// Returns the number of used vertices, unused vertices are moved to the end.
+		static int OptimizeVertexFetch(Vector<UINT32>& vIndices, int vertCount, Vector<int>& vRemap);
+
+		// Quadric error metric edge collapse, which keeps the vertex buffer (half-edge collapse), so that all levels of detail can share it.
+		// Vertices on attribute seams are locked, border vertices can only slide along the border.
+		// Error is relative to the largest side of mesh's bounding box. Returns the error of the result.
+		static float Simplify(
+			Vector<UINT32>& vIndices,
+			const Vector<glm::vec3>& vPositions,
+			int targetIndexCount,
+			float maxError = 1);
+
+		// Greedily grows clusters of connected triangles with similar normals. Triangles are reordered, so that each cluster is a continuous range.
+		// Each cluster gets a bounding sphere and a normal cone for culling.
+		static void BuildClusters(
+			Vector<UINT32>& vIndices,
+			const Vector<glm::vec3>& vPositions,
+			Vector<Cluster>& vClusters,
+			int maxVertCount = s_clusterMaxVertCount,
+			int maxFaceCount = s_clusterMaxFaceCount);
+
+		// Average cache miss ratio, which is the number of transformed vertices per triangle (0.5 to 3).
+		static float ComputeACMR(const Vector<UINT32>& vIndices, int vertCount, int cacheSize = s_cacheSize);
+
+		template<typename T>
+		static void ApplyRemap(Vector<T>& v, const Vector<int>& vRemap)
+		{
+			Vector<T> vNew(v.size());
+			VERUS_FOR(i, v.size())
+				vNew[vRemap[i]] = v[i];
+			v = std::move(vNew);
+		}
+	};
+	VERUS_TYPEDEFS(MeshOptimizer);
+}
@@ -391,9 +391,11 @@ void Multiplayer::ThreadProc()
 	UINT16 size;
 	std::chrono::steady_clock::time_point tpResend = std::chrono::steady_clock::now();
 	std::chrono::steady_clock::time_point tpNat = std::chrono::steady_clock::now();
+	VERUS_PROFILER_THREAD_NAME("Multiplayer");
 	while (true)
 	{
 		_cv.wait_for(lock, std::chrono::milliseconds(10)); // ~100 times per second.
+		VERUS_PROFILER_ZONE("Multiplayer/ThreadProc");
 
 		bool resend = false;
 		if (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - tpResend).count() >= 3)
@@ -4,8 +4,12 @@
 using namespace verus;
 using namespace verus::Physics;
 
+const float Bullet::s_defaultFixedTimeStep = 1 / 60.f;
+
 Bullet::Bullet()
 {
+	_simulating = false;
+	_fixedTimeStep = s_defaultFixedTimeStep;
 }
 
 Bullet::~Bullet()
@@ -18,46 +22,132 @@ void Bullet::Init()
 	VERUS_INIT();
 	VERUS_QREF_CONST_SETTINGS;
 
-	const btVector3 worldAabbMin(-2048, -1024, -2048);
-	const btVector3 worldAabbMax(+2048, +1024, +2048);
+	_taskScheduler.setNumThreads(_taskScheduler.getMaxNumThreads());
+#ifdef BT_THREADSAFE
+	_multithreaded = settings._physicsMultithreaded && _taskScheduler.getNumThreads() > 1;
+#else
+	// Without BT_THREADSAFE Bullet runs the loops on one thread, so the multithreaded world is only slower:
+	if (settings._physicsMultithreaded)
+		VERUS_LOG_WARN("Init(); Bullet is built without BT_THREADSAFE, using single-threaded world");
+	_multithreaded = false;
+#endif
+
+	if (_multithreaded)
+	{
+		btSetTaskScheduler(&_taskScheduler);
+		_stats._threadCount = _taskScheduler.getNumThreads();
+
+		btDefaultCollisionConstructionInfo cci;
+		cci.m_defaultMaxPersistentManifoldPoolSize = s_mtPoolSize;
+		cci.m_defaultMaxCollisionAlgorithmPoolSize = s_mtPoolSize;
+		_pCollisionConfiguration = new(_pCollisionConfiguration.GetData()) btDefaultCollisionConfiguration(cci);
+		_pDispatcherMt = new(_pDispatcherMt.GetData()) btCollisionDispatcherMt(_pCollisionConfiguration.Get());
+		_pDbvtBroadphase = new(_pDbvtBroadphase.GetData()) btDbvtBroadphase();
+		_pConstraintSolverPool = new(_pConstraintSolverPool.GetData()) btConstraintSolverPoolMt(_stats._threadCount);
+		_pConstraintSolverMt = new(_pConstraintSolverMt.GetData()) btSequentialImpulseConstraintSolverMt();
+
+		_pDispatcherBase = _pDispatcherMt.Get();
+		_pBroadphaseInterface = _pDbvtBroadphase.Get();
+		_pConstraintSolverBase = _pConstraintSolverPool.Get();
+	}
+	else
+	{
+		const btVector3 worldAabbMin(-2048, -1024, -2048);
+		const btVector3 worldAabbMax(+2048, +1024, +2048);
+
+		_stats._threadCount = 1;
 
-	_pCollisionConfiguration = new(_pCollisionConfiguration.GetData()) btDefaultCollisionConfiguration();
-	_pDispatcher = new(_pDispatcher.GetData()) btCollisionDispatcher(_pCollisionConfiguration.Get());
-	_pBroadphaseInterface = new(_pBroadphaseInterface.GetData()) btAxisSweep3(worldAabbMin, worldAabbMax);
-	_pConstraintSolver = new(_pConstraintSolver.GetData()) btSequentialImpulseConstraintSolver();
+		_pCollisionConfiguration = new(_pCollisionConfiguration.GetData()) btDefaultCollisionConfiguration();
+		_pDispatcher = new(_pDispatcher.GetData()) btCollisionDispatcher(_pCollisionConfiguration.Get());
+		_pAxisSweep = new(_pAxisSweep.GetData()) btAxisSweep3(worldAabbMin, worldAabbMax);
+		_pConstraintSolver = new(_pConstraintSolver.GetData()) btSequentialImpulseConstraintSolver();
+
+		_pDispatcherBase = _pDispatcher.Get();
+		_pBroadphaseInterface = _pAxisSweep.Get();
+		_pConstraintSolverBase = _pConstraintSolver.Get();
+	}
 
 	_pBroadphaseInterface->getOverlappingPairCache()->setInternalGhostPairCallback(&_ghostPairCallback);
 
-	_pDiscreteDynamicsWorld = new(_pDiscreteDynamicsWorld.GetData()) btDiscreteDynamicsWorld(
-		_pDispatcher.Get(),
-		_pBroadphaseInterface.Get(),
-		_pConstraintSolver.Get(),
-		_pCollisionConfiguration.Get());
+	if (_multithreaded)
+	{
+		_pDiscreteDynamicsWorldMt = new(_pDiscreteDynamicsWorldMt.GetData()) btDiscreteDynamicsWorldMt(
+			_pDispatcherBase,
+			_pBroadphaseInterface,
+			_pConstraintSolverPool.Get(),
+			_pConstraintSolverMt.Get(),
+			_pCollisionConfiguration.Get());
+		_pWorld = _pDiscreteDynamicsWorldMt.Get();
+	}
+	else
+	{
+		_pDiscreteDynamicsWorld = new(_pDiscreteDynamicsWorld.GetData()) btDiscreteDynamicsWorld(
+			_pDispatcherBase,
+			_pBroadphaseInterface,
+			_pConstraintSolverBase,
+			_pCollisionConfiguration.Get());
+		_pWorld = _pDiscreteDynamicsWorld.Get();
+	}
 
 	_pStaticPlaneShape = new(_pStaticPlaneShape.GetData()) btStaticPlaneShape(btVector3(0, 1, 0), 0);
 
 	if (settings._physicsSupportDebugDraw)
 	{
-		_pDiscreteDynamicsWorld->setDebugDrawer(&_debugDraw);
+		_pWorld->setDebugDrawer(&_debugDraw);
 		SetDebugDrawMode(DebugDrawMode::basic);
 	}
 
 	// See: http://bulletphysics.org/Bullet/phpBB3/viewtopic.php?t=6773:
-	_pDiscreteDynamicsWorld->getDispatchInfo().m_allowedCcdPenetration = 0.0001f;
+	_pWorld->getDispatchInfo().m_allowedCcdPenetration = 0.0001f;
+
+	_pWorld->setInternalTickCallback(PreTickCallback, this, true);
+	_stepCount = 0;
+
+	if (settings._physicsDedicatedThread)
+	{
+		_stopThread = false;
+		_thread = std::thread(&Bullet::ThreadProc, this);
+	}
 }
 
 void Bullet::Done()
 {
+	if (_thread.joinable())
+	{
+		{
+			VERUS_LOCK(*this);
+			_stopThread = true;
+		}
+		_cv.notify_all();
+		_thread.join();
+		_simulating = false;
+	}
+
 	EnableDebugPlane(false);
 	DeleteAllCollisionObjects();
 
 	_pStaticPlaneShape.Delete();
+	_pWorld = nullptr;
+	_pDiscreteDynamicsWorldMt.Delete();
 	_pDiscreteDynamicsWorld.Delete();
+	_pConstraintSolverBase = nullptr;
+	_pConstraintSolverMt.Delete();
+	_pConstraintSolverPool.Delete();
 	_pConstraintSolver.Delete();
-	_pBroadphaseInterface.Delete();
+	_pBroadphaseInterface = nullptr;
+	_pDbvtBroadphase.Delete();
+	_pAxisSweep.Delete();
+	_pDispatcherBase = nullptr;
+	_pDispatcherMt.Delete();
 	_pDispatcher.Delete();
 	_pCollisionConfiguration.Delete();
 
+	if (_multithreaded)
+	{
+		btSetTaskScheduler(nullptr);
+		_multithreaded = false;
+	}
+
 	VERUS_DONE(Bullet);
 }
 
@@ -72,6 +162,7 @@ btRigidBody* Bullet::AddNewRigidBody(
 	void* pPlacementRigidBody)
 {
 	btAssert(!pShape || pShape->getShapeType() != INVALID_SHAPE_PROXYTYPE);
+	WaitForSimulation();
 
 	const bool dynamic = (mass != 0);
 
@@ -90,7 +181,7 @@ btRigidBody* Bullet::AddNewRigidBody(
 		pRigidBody = new(pPlacementRigidBody) btRigidBody(rbci);
 	else
 		pRigidBody = new btRigidBody(rbci);
-	_pDiscreteDynamicsWorld->addRigidBody(pRigidBody, group, mask);
+	_pWorld->addRigidBody(pRigidBody, group, mask);
 
 	return pRigidBody;
 }
@@ -105,6 +196,7 @@ btRigidBody* Bullet::AddNewRigidBody(
 	const btTransform* pCenterOfMassOffset)
 {
 	btAssert(!pShape || pShape->getShapeType() != INVALID_SHAPE_PROXYTYPE);
+	WaitForSimulation();
 
 	const bool dynamic = (mass != 0);
 
@@ -116,63 +208,181 @@ btRigidBody* Bullet::AddNewRigidBody(
 		btDefaultMotionState(startTransform, pCenterOfMassOffset ? *pCenterOfMassOffset : btTransform::getIdentity());
 	btRigidBody::btRigidBodyConstructionInfo rbci(mass, pMotionState, pShape, localInertia);
 	btRigidBody* pRigidBody = new(localRigidBody.GetRigidBodyData()) btRigidBody(rbci);
-	_pDiscreteDynamicsWorld->addRigidBody(pRigidBody, group, mask);
+	_pWorld->addRigidBody(pRigidBody, group, mask);
 
 	return pRigidBody;
 }
 
 void Bullet::DeleteAllCollisionObjects()
 {
-	if (!_pDiscreteDynamicsWorld.Get())
+	if (!_pWorld)
 		return;
+	WaitForSimulation();
 
-	for (int i = _pDiscreteDynamicsWorld->getNumCollisionObjects() - 1; i >= 0; --i)
+	for (int i = _pWorld->getNumCollisionObjects() - 1; i >= 0; --i)
 	{
-		btCollisionObject* pObject = _pDiscreteDynamicsWorld->getCollisionObjectArray()[i];
+		btCollisionObject* pObject = _pWorld->getCollisionObjectArray()[i];
 		btRigidBody* pRigidBody = btRigidBody::upcast(pObject);
 		if (pRigidBody && pRigidBody->getMotionState())
 			delete pRigidBody->getMotionState();
-		_pDiscreteDynamicsWorld->removeCollisionObject(pObject);
+		_pWorld->removeCollisionObject(pObject);
 		delete pObject;
 	}
 }
 
 void Bullet::Simulate()
 {
-	if (!_pDiscreteDynamicsWorld.Get())
+	if (!_pWorld)
 		return;
 	VERUS_UPDATE_ONCE_CHECK;
 
 	VERUS_QREF_TIMER;
-	_pDiscreteDynamicsWorld->stepSimulation(_pauseSimulation ? 0 : dt, s_defaultMaxSubSteps);
+	const float delta = _pauseSimulation ? 0 : dt;
+	if (_thread.joinable())
+	{
+		WaitForSimulation();
+		{
+			VERUS_LOCK(*this);
+			_threadDelta = delta;
+			_simulating = true;
+		}
+		_cv.notify_all();
+	}
+	else
+	{
+		Step(delta);
+	}
+}
+
+void Bullet::WaitForSimulation()
+{
+	if (!_thread.joinable() || std::this_thread::get_id() == _thread.get_id())
+		return;
+	VERUS_LOCK(*this);
+	_cv.wait(lock, [this]() {return !_simulating; });
+	if (_ex)
+	{
+		std::exception_ptr ex;
+		std::swap(ex, _ex);
+		std::rethrow_exception(ex);
+	}
+}
+
+void Bullet::Step(float dt)
+{
+	VERUS_PROFILER_ZONE("Bullet/Step");
+	const auto t0 = std::chrono::steady_clock::now();
+	_pWorld->stepSimulation(dt, s_defaultMaxSubSteps, _fixedTimeStep);
+	const auto t1 = std::chrono::steady_clock::now();
+
+	_stats._stepTime = std::chrono::duration<float, std::milli>(t1 - t0).count();
+	_stats._avgStepTime = Math::Lerp(_stats._avgStepTime, _stats._stepTime, 0.05f);
+}
+
+void Bullet::ThreadProc()
+{
+	VERUS_PROFILER_THREAD_NAME("Physics");
+	while (true)
+	{
+		float dt = 0;
+		{
+			VERUS_LOCK(*this);
+			_cv.wait(lock, [this]() {return _simulating || _stopThread; });
+			if (_stopThread)
+				break;
+			dt = _threadDelta;
+		}
+
+		// Thread keeps running after a failed step, so that the next frame doesn't wait forever:
+		std::exception_ptr ex;
+		try
+		{
+			Step(dt);
+		}
+		catch (D::RcRuntimeError)
+		{
+			ex = std::current_exception();
+		}
+		catch (const std::exception& e)
+		{
+			ex = std::make_exception_ptr(VERUS_RUNTIME_ERROR << e.what());
+		}
+
+		{
+			VERUS_LOCK(*this);
+			if (ex && !_ex)
+				_ex = ex;
+			_simulating = false;
+		}
+		_cv.notify_all();
+	}
+}
+
+void Bullet::PreTickCallback(btDynamicsWorld* pWorld, btScalar timeStep)
+{
+	PBullet p = static_cast<PBullet>(pWorld->getWorldUserInfo());
+	if (p->_pDelegate)
+		p->_pDelegate->Bullet_OnFixedStep(p->_stepCount, timeStep);
+	p->_stepCount++;
+}
+
+void Bullet::ResetSimulation()
+{
+	if (!_pWorld)
+		return;
+	WaitForSimulation();
+
+	_stepCount = 0;
+
+	// Contacts and pair cache affect the result:
+	btOverlappingPairCache* pPairCache = _pBroadphaseInterface->getOverlappingPairCache();
+	const int count = _pWorld->getNumCollisionObjects();
+	VERUS_FOR(i, count)
+	{
+		btCollisionObject* pObject = _pWorld->getCollisionObjectArray()[i];
+		if (pObject->getBroadphaseHandle())
+			pPairCache->cleanProxyFromPairs(pObject->getBroadphaseHandle(), _pDispatcherBase);
+		btRigidBody* pRigidBody = btRigidBody::upcast(pObject);
+		if (pRigidBody)
+			pRigidBody->clearForces();
+	}
+	_pBroadphaseInterface->resetPool(_pDispatcherBase);
+	_pConstraintSolverBase->reset();
+}
+
+void Bullet::SetFixedTimeStep(float step)
+{
+	WaitForSimulation();
+	_fixedTimeStep = step;
 }
 
 void Bullet::DebugDraw()
 {
-	if (!_pDiscreteDynamicsWorld.Get() || !_pDiscreteDynamicsWorld->getDebugDrawer())
+	if (!_pWorld || !_pWorld->getDebugDrawer())
 		return;
+	WaitForSimulation();
 
 	VERUS_QREF_DD;
 	dd.Begin(CGI::DebugDraw::Type::lines, nullptr, false);
-	_pDiscreteDynamicsWorld->debugDrawWorld();
+	_pWorld->debugDrawWorld();
 	dd.End();
 }
 
 void Bullet::SetDebugDrawMode(DebugDrawMode mode)
 {
-	if (!_pDiscreteDynamicsWorld->getDebugDrawer())
+	if (!_pWorld->getDebugDrawer())
 		return;
 
 	switch (mode)
 	{
 	case DebugDrawMode::none:
 	{
-		_pDiscreteDynamicsWorld->getDebugDrawer()->setDebugMode(btIDebugDraw::DBG_NoDebug);
+		_pWorld->getDebugDrawer()->setDebugMode(btIDebugDraw::DBG_NoDebug);
 	}
 	break;
 	case DebugDrawMode::basic:
 	{
-		_pDiscreteDynamicsWorld->getDebugDrawer()->setDebugMode(
+		_pWorld->getDebugDrawer()->setDebugMode(
 			btIDebugDraw::DBG_DrawWireframe |
 			btIDebugDraw::DBG_DrawConstraints |
 			btIDebugDraw::DBG_DrawConstraintLimits |
@@ -197,7 +407,7 @@ void Bullet::EnableDebugPlane(bool b)
 	}
 	else
 	{
-		_pDiscreteDynamicsWorld->removeRigidBody(_pStaticPlaneRigidBody.Get());
+		_pWorld->removeRigidBody(_pStaticPlaneRigidBody.Get());
 		_pStaticPlaneRigidBody.Delete();
 	}
 }
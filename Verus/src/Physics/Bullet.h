@@ -64,21 +64,68 @@ namespace verus::Physics
 		basic
 	};
 
-	class Bullet : public Singleton<Bullet>, public Object
+	struct BulletDelegate
 	{
-		static const int s_defaultMaxSubSteps = 8;
+		// Called before each fixed step, apply the input here. In dedicated thread mode it is called on physics thread.
+		virtual void Bullet_OnFixedStep(UINT64 step, float dt) = 0;
+	};
+	VERUS_TYPEDEFS(BulletDelegate);
+
+	// Simulation runs at fixed rate, motion states are interpolated between steps.
+	// Multithreaded mode (see Settings::_physicsMultithreaded) uses btDiscreteDynamicsWorldMt with dbvt broadphase and a pool of solvers.
+	// It requires Bullet libraries and engine, which are both built with BT_THREADSAFE.
+	// Bullet's parallel loops run on engine's TaskScheduler.
+	// Dedicated thread mode (see Settings::_physicsDedicatedThread) runs the simulation on its own thread, while the frame is drawn.
+	// Physics objects must not be accessed after Simulate() and before WaitForSimulation().
+	// GetWorld() and methods, which change rigid bodies, wait for the simulation, so that this also holds in release build.
+	class Bullet : public Singleton<Bullet>, public Object, public Lockable
+	{
+	public:
+		struct Stats
+		{
+			float _stepTime = 0; // In milliseconds.
+			float _avgStepTime = 0;
+			int   _threadCount = 1;
+		};
+		VERUS_TYPEDEFS(Stats);
 
-		LocalPtr<btDefaultCollisionConfiguration>     _pCollisionConfiguration;
-		LocalPtr<btCollisionDispatcher>               _pDispatcher;
-		LocalPtr<btAxisSweep3>                        _pBroadphaseInterface;
-		LocalPtr<btSequentialImpulseConstraintSolver> _pConstraintSolver;
-		LocalPtr<btDiscreteDynamicsWorld>             _pDiscreteDynamicsWorld;
-		LocalPtr<btStaticPlaneShape>                  _pStaticPlaneShape;
-		LocalRigidBody                                _pStaticPlaneRigidBody;
-		btGhostPairCallback                           _ghostPairCallback;
-		BulletDebugDraw                               _debugDraw;
-		Group                                         _staticMask = Group::immovable | Group::terrain | Group::forest;
-		bool                                          _pauseSimulation = false;
+	private:
+		static const int s_defaultMaxSubSteps = 8;
+		static const int s_mtPoolSize = 80000; // Persistent manifolds and collision algorithms.
+		static const float s_defaultFixedTimeStep;
+
+		LocalPtr<btDefaultCollisionConfiguration>       _pCollisionConfiguration;
+		LocalPtr<btCollisionDispatcher>                 _pDispatcher;
+		LocalPtr<btCollisionDispatcherMt>               _pDispatcherMt;
+		LocalPtr<btAxisSweep3>                          _pAxisSweep;
+		LocalPtr<btDbvtBroadphase>                      _pDbvtBroadphase;
+		LocalPtr<btSequentialImpulseConstraintSolver>   _pConstraintSolver;
+		LocalPtr<btConstraintSolverPoolMt>              _pConstraintSolverPool;
+		LocalPtr<btSequentialImpulseConstraintSolverMt> _pConstraintSolverMt;
+		LocalPtr<btDiscreteDynamicsWorld>               _pDiscreteDynamicsWorld;
+		LocalPtr<btDiscreteDynamicsWorldMt>             _pDiscreteDynamicsWorldMt;
+		LocalPtr<btStaticPlaneShape>                    _pStaticPlaneShape;
+		LocalRigidBody                                  _pStaticPlaneRigidBody;
+		btCollisionDispatcher*                          _pDispatcherBase = nullptr;
+		btBroadphaseInterface*                          _pBroadphaseInterface = nullptr;
+		btConstraintSolver*                             _pConstraintSolverBase = nullptr;
+		btDiscreteDynamicsWorld*                        _pWorld = nullptr;
+		btGhostPairCallback                             _ghostPairCallback;
+		BulletDebugDraw                                 _debugDraw;
+		BulletTaskScheduler                             _taskScheduler;
+		Stats                                           _stats;
+		std::thread                                     _thread;
+		std::condition_variable                         _cv;
+		std::exception_ptr                              _ex; // From physics thread, rethrown once by WaitForSimulation().
+		PBulletDelegate                                 _pDelegate = nullptr;
+		UINT64                                          _stepCount = 0;
+		Group                                           _staticMask = Group::immovable | Group::terrain | Group::forest;
+		float                                           _fixedTimeStep = 0;
+		float                                           _threadDelta = 0;
+		std::atomic_bool                                _simulating;
+		bool                                            _stopThread = false;
+		bool                                            _multithreaded = false;
+		bool                                            _pauseSimulation = false;
 
 	public:
 		Bullet();
@@ -88,10 +135,20 @@ namespace verus::Physics
 		void Done();
 
 		btDefaultCollisionConfiguration* GetCollisionConfiguration() { return _pCollisionConfiguration.Get(); }
-		btCollisionDispatcher* GetDispatcher() { return _pDispatcher.Get(); }
-		btAxisSweep3* GetBroadphaseInterface() { return _pBroadphaseInterface.Get(); }
-		btSequentialImpulseConstraintSolver* GetConstraintSolver() { return _pConstraintSolver.Get(); }
-		btDiscreteDynamicsWorld* GetWorld() { return _pDiscreteDynamicsWorld.Get(); }
+		btCollisionDispatcher* GetDispatcher() { return _pDispatcherBase; }
+		btAxisSweep3* GetBroadphaseInterface() { return _pAxisSweep.Get(); } // Single-threaded world.
+		btSequentialImpulseConstraintSolver* GetConstraintSolver() { return _pConstraintSolver.Get(); } // Single-threaded world.
+		btDiscreteDynamicsWorld* GetWorld() { WaitForSimulation(); return _pWorld; }
+
+		// Multithreaded world:
+		btCollisionDispatcherMt* GetDispatcherMt() { return _pDispatcherMt.Get(); }
+		btDbvtBroadphase* GetDbvtBroadphase() { return _pDbvtBroadphase.Get(); }
+		btConstraintSolverPoolMt* GetConstraintSolverPool() { return _pConstraintSolverPool.Get(); }
+		btSequentialImpulseConstraintSolverMt* GetConstraintSolverMt() { return _pConstraintSolverMt.Get(); }
+		btDiscreteDynamicsWorldMt* GetWorldMt() { return _pDiscreteDynamicsWorldMt.Get(); }
+
+		bool IsMultithreaded() const { return _multithreaded; }
+		RcStats GetStats() const { return _stats; }
 
 		btRigidBody* AddNewRigidBody(
 			float mass,
@@ -113,10 +170,21 @@ namespace verus::Physics
 
 		void DeleteAllCollisionObjects();
 
+		// Steps the simulation or, in dedicated thread mode, starts it on physics thread and returns.
 		void Simulate();
+		void WaitForSimulation(); // Does nothing on physics thread.
+		bool IsSimulating() const { return _simulating; }
+		bool HasDedicatedThread() const { return _thread.joinable(); }
 		void PauseSimualtion(bool b) { _pauseSimulation = b; }
 		bool IsSimulationPaused() const { return _pauseSimulation; }
 
+		// Clears cached contacts and solver's state, so that a replay from the same initial state gives the same result.
+		void ResetSimulation();
+		UINT64 GetStepCount() const { return _stepCount; }
+		float GetFixedTimeStep() const { return _fixedTimeStep; }
+		void SetFixedTimeStep(float step);
+		PBulletDelegate SetDelegate(PBulletDelegate p) { return Utils::Swap(_pDelegate, p); }
+
 		void DebugDraw();
 		void SetDebugDrawMode(DebugDrawMode mode);
 		void EnableDebugPlane(bool b);
@@ -126,6 +194,10 @@ namespace verus::Physics
 
 		static CSZ GroupToString(int index);
 
+		VERUS_P(void Step(float dt));
+		VERUS_P(void ThreadProc());
+		VERUS_P(static void PreTickCallback(btDynamicsWorld* pWorld, btScalar timeStep));
+
 		Group GetStaticMask() const { return _staticMask; }
 		Group GetNonStaticMask() const { return ~_staticMask; }
 		void SetStaticMask(Group mask) { _staticMask = mask; }
@@ -0,0 +1,61 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::Physics;
+
+BulletTaskScheduler::BulletTaskScheduler() : btITaskScheduler("Verus")
+{
+}
+
+BulletTaskScheduler::~BulletTaskScheduler()
+{
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const
+{
+	if (!TaskScheduler::IsValidSingleton() || !TaskScheduler::I().IsInitialized())
+		return 1;
+	// Extra thread index for the main thread, when the loops are started on physics thread:
+	return Math::Min(TaskScheduler::I().GetThreadCount() + 1, BT_MAX_THREAD_COUNT);
+}
+
+int BulletTaskScheduler::getNumThreads() const
+{
+	return _threadCount;
+}
+
+void BulletTaskScheduler::setNumThreads(int numThreads)
+{
+	_threadCount = Math::Clamp(numThreads, 1, getMaxNumThreads());
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+{
+	if (_threadCount <= 1)
+	{
+		body.forLoop(iBegin, iEnd);
+		return;
+	}
+	TaskScheduler::I().ParallelFor(iBegin, iEnd, grainSize, [&body](int from, int to)
+		{
+			body.forLoop(from, to);
+		});
+}
+
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
+{
+	if (_threadCount <= 1)
+		return body.sumLoop(iBegin, iEnd);
+
+	// Each subrange adds its partial sum, the order of addition is not deterministic:
+	std::mutex mutex;
+	btScalar sum = 0;
+	TaskScheduler::I().ParallelFor(iBegin, iEnd, grainSize, [&body, &mutex, &sum](int from, int to)
+		{
+			const btScalar partialSum = body.sumLoop(from, to);
+			std::lock_guard<std::mutex> lock(mutex);
+			sum += partialSum;
+		});
+	return sum;
+}
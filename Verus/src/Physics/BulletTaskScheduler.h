@@ -0,0 +1,24 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::Physics
+{
+	// Runs Bullet's parallel loops on engine's TaskScheduler.
+	// Bullet must be built with BT_THREADSAFE, otherwise it calls the loops directly (see Bullet::Init()).
+	class BulletTaskScheduler : public btITaskScheduler
+	{
+		int _threadCount = 1;
+
+	public:
+		BulletTaskScheduler();
+		~BulletTaskScheduler();
+
+		virtual int getMaxNumThreads() const override;
+		virtual int getNumThreads() const override;
+		virtual void setNumThreads(int numThreads) override;
+
+		virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+		virtual btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+	};
+	VERUS_TYPEDEFS(BulletTaskScheduler);
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::Physics;
+
+InputLog::InputLog()
+{
+}
+
+InputLog::~InputLog()
+{
+}
+
+void InputLog::Record(UINT64 step, const void* p, int size)
+{
+	VERUS_RT_ASSERT(_vEntries.empty() || _vEntries.back()._step < step);
+	Entry entry;
+	entry._step = step;
+	entry._offset = Utils::Cast32(_vData.size());
+	entry._size = size;
+	_vEntries.push_back(entry);
+	_vData.insert(_vData.end(), static_cast<const BYTE*>(p), static_cast<const BYTE*>(p) + size);
+}
+
+const BYTE* InputLog::Replay(UINT64 step, int& size)
+{
+	size = 0;
+	while (_cursor < _vEntries.size() && _vEntries[_cursor]._step < step)
+		_cursor++;
+	if (_cursor >= _vEntries.size() || _vEntries[_cursor]._step != step)
+		return nullptr;
+	const Entry& entry = _vEntries[_cursor];
+	size = entry._size;
+	return _vData.data() + entry._offset;
+}
+
+void InputLog::Clear()
+{
+	_vEntries.clear();
+	_vData.clear();
+	_cursor = 0;
+}
+
+void InputLog::Serialize(IO::RStream stream) const
+{
+	stream << Utils::Cast32(_vEntries.size());
+	stream << Utils::Cast32(_vData.size());
+	if (!_vEntries.empty())
+		stream.Write(_vEntries.data(), _vEntries.size() * sizeof(Entry));
+	if (!_vData.empty())
+		stream.Write(_vData.data(), _vData.size());
+}
+
+void InputLog::Deserialize(IO::RStream stream)
+{
+	Clear();
+	UINT32 entryCount = 0;
+	UINT32 dataSize = 0;
+	stream >> entryCount;
+	stream >> dataSize;
+	_vEntries.resize(entryCount);
+	_vData.resize(dataSize);
+	if (entryCount)
+		stream.Read(_vEntries.data(), _vEntries.size() * sizeof(Entry));
+	if (dataSize)
+		stream.Read(_vData.data(), _vData.size());
+}
@@ -0,0 +1,41 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::Physics
+{
+	// Input of each fixed physics step, which can be recorded and replayed later.
+	// Input is any plain data, which the game applies in BulletDelegate::Bullet_OnFixedStep.
+	// Replay gives the same result when the world is restored to the same state,
+	// Bullet::ResetSimulation is called and multithreaded mode is not used.
+	class InputLog
+	{
+		struct Entry
+		{
+			UINT64 _step = 0;
+			UINT32 _offset = 0;
+			UINT32 _size = 0;
+		};
+
+		Vector<Entry> _vEntries;
+		Vector<BYTE>  _vData;
+		int           _cursor = 0;
+
+	public:
+		InputLog();
+		~InputLog();
+
+		// Steps must be recorded in ascending order.
+		void Record(UINT64 step, const void* p, int size);
+		// Returns input of this step or nullptr. Steps must be requested in ascending order.
+		const BYTE* Replay(UINT64 step, int& size);
+
+		void Rewind() { _cursor = 0; }
+		void Clear();
+		bool IsEmpty() const { return _vEntries.empty(); }
+		UINT64 GetLastStep() const { return _vEntries.empty() ? 0 : _vEntries.back()._step; }
+
+		void Serialize(IO::RStream stream) const;
+		void Deserialize(IO::RStream stream);
+	};
+	VERUS_TYPEDEFS(InputLog);
+}
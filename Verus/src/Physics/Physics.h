@@ -5,6 +5,8 @@
 #include "UserPtr.h"
 #include "Spring.h"
 #include "BulletDebugDraw.h"
+#include "BulletTaskScheduler.h"
+#include "InputLog.h"
 #include "Bullet.h"
 #include "KinematicCharacterController.h" // Improved btKinematicCharacterController.
 #include "CharacterController.h"
@@ -181,6 +181,53 @@ void BaseMesh::LoadX3D3(RcBlob blob)
 				sp.Read(&pIB[i * 3], 6);
 		}
 		break;
+		case '>DL<':
+		{
+			BYTE lodCount = 0;
+			sp >> lodCount;
+			VERUS_FOR(lod, lodCount)
+			{
+				float error = 0;
+				sp >> error;
+				sp.ReadString(buffer);
+				const int faceCount = atoi(buffer);
+				const int offset = Utils::Cast32(_vLODIndices.size());
+				_vLODIndices.resize(offset + faceCount * 3);
+				sp.Read(&_vLODIndices[offset], faceCount * 6);
+				if (lod + 1 < s_maxLODCount)
+				{
+					LOD lodData;
+					lodData._firstIndex = _indexCount + offset;
+					lodData._indexCount = faceCount * 3;
+					lodData._error = error;
+					_vLODs.push_back(lodData);
+				}
+				else
+				{
+					_vLODIndices.resize(offset); // Too many levels.
+				}
+			}
+		}
+		break;
+		case '>LC<':
+		{
+			sp.ReadString(buffer);
+			const int clusterCount = atoi(buffer);
+			_vClusters.resize(clusterCount);
+			int firstIndex = 0;
+			for (auto& cluster : _vClusters)
+			{
+				UINT16 faceCount = 0;
+				sp.Read(&cluster._sphere, 16);
+				sp.Read(&cluster._cone, 16);
+				sp >> faceCount;
+				cluster._firstIndex = firstIndex;
+				cluster._indexCount = faceCount * 3;
+				firstIndex += cluster._indexCount;
+			}
+			VERUS_RT_ASSERT(firstIndex == _indexCount);
+		}
+		break;
 		case '>XV<':
 		{
 			sp.ReadString(buffer);
@@ -503,6 +550,70 @@ void BaseMesh::DequantizeTanBin(const short* in, RVector3 out)
 		Convert::Sint16ToSnorm(in[2]));
 }
 
+int BaseMesh::SelectLOD(float sizeInPixels, float maxPixelError) const
+{
+	// Error grows with each level, take the last one, which is still acceptable:
+	int lod = 0;
+	VERUS_FOR(i, _vLODs.size())
+	{
+		if (_vLODs[i]._error * sizeInPixels > maxPixelError)
+			break;
+		lod = i + 1;
+	}
+	return lod;
+}
+
+int BaseMesh::CullClusters(
+	RcTransform3 matW,
+	Math::RcFrustum frustum,
+	PcPoint3 pEyePos,
+	Vector<IndexRange>& vRanges,
+	bool testFrustum) const
+{
+	vRanges.clear();
+
+	const Vector3 scale(
+		VMath::length(matW.getCol0()),
+		VMath::length(matW.getCol1()),
+		VMath::length(matW.getCol2()));
+	const float maxScale = VMath::maxElem(scale);
+	const float minScale = VMath::minElem(scale);
+
+	// Normal cones are only valid with uniform scale, backface test is done in object space:
+	const bool testCone = pEyePos && (maxScale - minScale) <= maxScale * 0.01f;
+	const Point3 eyePos = testCone ? Point3(VMath::inverse(matW) * *pEyePos) : Point3(0);
+
+	int visibleCount = 0;
+	for (const auto& cluster : _vClusters)
+	{
+		const Point3 center(cluster._sphere.x, cluster._sphere.y, cluster._sphere.z);
+		const float radius = cluster._sphere.w;
+		if (testFrustum && Math::Relation::outside == frustum.ContainsSphere(Math::Sphere(matW * center, radius * maxScale)))
+			continue;
+		if (testCone && cluster._cone.w < 1)
+		{
+			const Vector3 axis(cluster._cone.x, cluster._cone.y, cluster._cone.z);
+			const Vector3 toCenter = center - eyePos;
+			if (VMath::dot(toCenter, axis) >= cluster._cone.w * VMath::length(toCenter) + radius)
+				continue;
+		}
+
+		visibleCount++;
+		if (!vRanges.empty() && vRanges.back()._firstIndex + vRanges.back()._indexCount == cluster._firstIndex)
+		{
+			vRanges.back()._indexCount += cluster._indexCount;
+		}
+		else
+		{
+			IndexRange range;
+			range._firstIndex = cluster._firstIndex;
+			range._indexCount = cluster._indexCount;
+			vRanges.push_back(range);
+		}
+	}
+	return visibleCount;
+}
+
 void BaseMesh::RecalculateTangentSpace()
 {
 	Vector<glm::vec3> vV, vN, vTan, vBin;
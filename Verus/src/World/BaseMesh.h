@@ -5,6 +5,9 @@ namespace verus::World
 {
 	class BaseMesh : public Object, public IO::AsyncDelegate, public AllocatorAware
 	{
+	public:
+		static const int s_maxLODCount = 4; // Including the main level, must fit into 2 bits.
+
 	protected:
 		struct VertexInputBinding0 // 16 bytes, common.
 		{
@@ -35,7 +38,27 @@ namespace verus::World
 		};
 		VERUS_TYPEDEFS(VertexInputBinding3);
 
+		struct LOD // Extra level of detail, indices are stored after the main ones.
+		{
+			int   _firstIndex = 0;
+			int   _indexCount = 0;
+			float _error = 0; // Relative to mesh size.
+		};
+		VERUS_TYPEDEFS(LOD);
+
+		struct Cluster // Range of main indices with bounds for culling.
+		{
+			glm::vec4 _sphere; // Center and radius.
+			glm::vec4 _cone; // Axis and cutoff (sine of the angle), cutoff of 1 means no backface culling.
+			int       _firstIndex = 0;
+			int       _indexCount = 0;
+		};
+		VERUS_TYPEDEFS(Cluster);
+
 		Vector<UINT16>              _vIndices;
+		Vector<UINT16>              _vLODIndices;
+		Vector<LOD>                 _vLODs;
+		Vector<Cluster>             _vClusters;
 		Vector<UINT32>              _vIndices32;
 		Vector<VertexInputBinding0> _vBinding0;
 		Vector<VertexInputBinding1> _vBinding1;
@@ -58,6 +81,13 @@ namespace verus::World
 		bool                        _initShape = false;
 
 	public:
+		struct IndexRange
+		{
+			int _firstIndex = 0;
+			int _indexCount = 0;
+		};
+		VERUS_TYPEDEFS(IndexRange);
+
 		struct SourceBuffers
 		{
 			Vector<UINT16>    _vIndices;
@@ -82,6 +112,24 @@ namespace verus::World
 		int GetIndexCount() const { return _indexCount; }
 		int GetBoneCount() const { return _boneCount; }
 
+		// Levels of detail:
+		int GetLODCount() const { return 1 + Utils::Cast32(_vLODs.size()); }
+		int GetLODFirstIndex(int lod) const { return lod ? _vLODs[lod - 1]._firstIndex : 0; }
+		int GetLODIndexCount(int lod) const { return lod ? _vLODs[lod - 1]._indexCount : _indexCount; }
+		int SelectLOD(float sizeInPixels, float maxPixelError) const;
+
+		// Clusters:
+		bool HasClusters() const { return !_vClusters.empty(); }
+		int GetClusterCount() const { return Utils::Cast32(_vClusters.size()); }
+		// Frustum and backface culling (if eye position is given) of the main level of detail.
+		// Returns the number of visible clusters, adjacent ranges are merged.
+		int CullClusters(
+			RcTransform3 matW,
+			Math::RcFrustum frustum,
+			PcPoint3 pEyePos,
+			Vector<IndexRange>& vRanges,
+			bool testFrustum = true) const;
+
 		virtual void Async_WhenLoaded(CSZ url, RcBlob blob) override;
 
 		VERUS_P(void Load(RcBlob blob));
@@ -87,6 +87,8 @@ void Forest::Init(PTerrain pTerrain, CSZ url)
 	_vPlants.reserve(16);
 	_vLayerData.reserve(16);
 	_vDrawPlants.resize(_capacity);
+	_vSortedDrawPlants.resize(_capacity);
+	_vSortKeys.resize(_capacity);
 
 	_vCollisionPlants.Reserve(400);
 	_vCollisionPool.Resize(400);
@@ -390,16 +392,23 @@ void Forest::Layout(bool reflection)
 void Forest::SortVisible()
 {
 	const float tessDistSq = _tessDist * _tessDist;
-	std::sort(_vDrawPlants.begin(), _vDrawPlants.begin() + _visibleCount, [tessDistSq](RDrawPlant plantA, RDrawPlant plantB)
-		{
-			const bool tessA = plantA._distToEyeSq < tessDistSq;
-			const bool tessB = plantB._distToEyeSq < tessDistSq;
-			if (tessA != tessB)
-				return tessA;
-			if (plantA._plantIndex != plantB._plantIndex)
-				return plantA._plantIndex < plantB._plantIndex;
-			return plantA._distToEyeSq < plantB._distToEyeSq;
-		});
+
+	// Sort key is [noTess:1][plantIndex:16][depth:32], tessellated plants go first:
+	VERUS_FOR(i, _visibleCount)
+	{
+		RcDrawPlant drawPlant = _vDrawPlants[i];
+		const UINT64 noTess = (drawPlant._distToEyeSq < tessDistSq) ? 0 : 1;
+		const UINT64 plantIndex = drawPlant._plantIndex & USHRT_MAX;
+		const UINT64 depth = RadixSort::QuantizeFloat(drawPlant._distToEyeSq, 32);
+		_vSortKeys[i]._key = (noTess << 48) | (plantIndex << 32) | depth;
+		_vSortKeys[i]._index = i;
+	}
+
+	RadixSort::Sort(_vSortKeys, _vSortKeysTemp, _visibleCount);
+
+	VERUS_FOR(i, _visibleCount)
+		_vSortedDrawPlants[i] = _vDrawPlants[_vSortKeys[i]._index];
+	std::swap(_vDrawPlants, _vSortedDrawPlants);
 }
 
 void Forest::Draw(bool allowTess)
@@ -425,30 +434,33 @@ void Forest::DrawModels(bool allowTess)
 
 	PMesh pMesh = nullptr;
 	MaterialPtr material;
-	int bindPipelineStage = -1;
 	bool tess = true;
 	const float tessDistSq = _tessDist * _tessDist;
 
-	auto cb = renderer.GetCommandBuffer();
 	auto shader = Mesh::GetShader();
 
-	VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(96, 255, 160, 255), "Forest/DrawModels");
-
-	auto DrawMesh = [cb](PMesh pMesh)
+	// Instance buffers are filled here, parts only record draw calls:
+	auto AddBatch = [this, &pMesh, &material, &tess]()
 	{
 		if (pMesh && !pMesh->IsInstanceBufferEmpty(true))
 		{
 			pMesh->UpdateInstanceBuffer();
-			cb->DrawIndexed(pMesh->GetIndexCount(), pMesh->GetInstanceCount(true), 0, 0, pMesh->GetMarkedInstance());
+			DrawBatch batch;
+			batch._pMesh = pMesh;
+			batch._material = material;
+			batch._firstInstance = pMesh->GetMarkedInstance();
+			batch._instanceCount = pMesh->GetInstanceCount(true);
+			batch._tess = tess;
+			_vDrawBatches.push_back(batch);
 		}
 	};
 
-	shader->BeginBindDescriptors();
+	_vDrawBatches.clear();
 	for (int i = 0; i <= _visibleCount; ++i)
 	{
 		if (i == _visibleCount) // The end?
 		{
-			DrawMesh(pMesh);
+			AddBatch();
 			break;
 		}
 
@@ -463,53 +475,76 @@ void Forest::DrawModels(bool allowTess)
 
 		if (pNextMesh != pMesh || nextTess != tess)
 		{
-			DrawMesh(pMesh);
+			AddBatch();
 
 			pMesh = pNextMesh;
 			pMesh->MarkInstance();
-			if (bindPipelineStage)
+			tess = nextTess;
+		}
+		material = nextMaterial;
+
+		const Transform3 matW = VMath::appendScale(Transform3(drawPlant._basis * Matrix3::rotationY(drawPlant._angle),
+			Vector3(drawPlant._pos + drawPlant._pushBack)), Vector3::Replicate(drawPlant._scale));
+		pMesh->PushInstance(matW, Vector4(Vector3(drawPlant._pos), drawPlant._windBending));
+	}
+
+	Mesh::UB_View ubViewWithTess;
+	Mesh::UB_View ubView;
+	Mesh::UB_Object ubObject;
+	Mesh::UpdateUniformBuffer_View(1 / (_tessDist - 10), &ubViewWithTess);
+	Mesh::UpdateUniformBuffer_View(0, &ubView);
+	Mesh::UpdateUniformBuffer_Object(trBending, Vector4(_phaseY, _phaseXZ), &ubObject);
+
+	const bool gpuTess = allowTess && settings._gpuTessellation;
+	const int batchCount = Utils::Cast32(_vDrawBatches.size());
+	const int partCount = renderer.GetParallelPartCount(batchCount, 4);
+	shader->BeginBindDescriptors();
+	renderer.RecordInParallel(partCount, [this, shader, gpuTess, batchCount, partCount, &ubViewWithTess, &ubView, &ubObject](CGI::CommandBufferPtr cb, int part)
+		{
+			VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(96, 255, 160, 255), "Forest/DrawModels");
+
+			Mesh::UB_MeshVS ubMeshVS{};
+			Mesh::UB_MaterialFS ubMaterialFS{};
+			MaterialPtr material;
+			int bindPipelineStage = -1;
+			const int batchBegin = batchCount * part / partCount;
+			const int batchEnd = batchCount * (part + 1) / partCount;
+			for (int b = batchBegin; b < batchEnd; ++b)
 			{
-				if (-1 == bindPipelineStage)
+				RcDrawBatch batch = _vDrawBatches[b];
+				if (bindPipelineStage)
 				{
-					bindPipelineStage = (nextTess && allowTess && settings._gpuTessellation) ? 1 : 0;
-					pMesh->BindPipelineInstanced(cb, 1 == bindPipelineStage, true);
-					pMesh->UpdateUniformBuffer_View(1 / (_tessDist - 10));
-					cb->BindDescriptors(shader, 0);
-					pMesh->UpdateUniformBuffer_Object(trBending, Vector4(_phaseY, _phaseXZ));
-					cb->BindDescriptors(shader, 4);
+					if (-1 == bindPipelineStage)
+					{
+						bindPipelineStage = (batch._tess && gpuTess) ? 1 : 0;
+						batch._pMesh->BindPipelineInstanced(cb, 1 == bindPipelineStage, true);
+						cb->BindDescriptors(shader, 0, CGI::CSHandle(), &ubViewWithTess);
+						cb->BindDescriptors(shader, 4, CGI::CSHandle(), &ubObject);
+					}
+					else if (1 == bindPipelineStage && !batch._tess)
+					{
+						bindPipelineStage = 0;
+						batch._pMesh->BindPipelineInstanced(cb, false, true);
+						cb->BindDescriptors(shader, 0, CGI::CSHandle(), &ubView);
+						cb->BindDescriptors(shader, 4, CGI::CSHandle(), &ubObject);
+					}
 				}
-				else if (1 == bindPipelineStage && !nextTess)
+				batch._pMesh->BindGeo(cb);
+				batch._pMesh->UpdateUniformBuffer_MeshVS(&ubMeshVS);
+				cb->BindDescriptors(shader, 2, CGI::CSHandle(), &ubMeshVS);
+				if (batch._material != material)
 				{
-					bindPipelineStage = 0;
-					pMesh->BindPipelineInstanced(cb, false, true);
-					pMesh->UpdateUniformBuffer_View();
-					cb->BindDescriptors(shader, 0);
-					pMesh->UpdateUniformBuffer_Object(trBending, Vector4(_phaseY, _phaseXZ));
-					cb->BindDescriptors(shader, 4);
+					material = batch._material;
+					material->UpdateMeshUniformBuffer(1, true, &ubMaterialFS);
+					cb->BindDescriptors(shader, 1, material->GetComplexSetHandle(), &ubMaterialFS);
 				}
+
+				cb->DrawIndexed(batch._pMesh->GetIndexCount(), batch._instanceCount, 0, 0, batch._firstInstance);
 			}
-			tess = nextTess;
-			pMesh->BindGeo(cb);
-			pMesh->UpdateUniformBuffer_MeshVS();
-			cb->BindDescriptors(shader, 2);
-		}
-		if (nextMaterial != material)
-		{
-			material = nextMaterial;
-			material->UpdateMeshUniformBuffer();
-			cb->BindDescriptors(shader, 1, material->GetComplexSetHandle());
-		}
 
-		if (pMesh)
-		{
-			const Transform3 matW = VMath::appendScale(Transform3(drawPlant._basis * Matrix3::rotationY(drawPlant._angle),
-				Vector3(drawPlant._pos + drawPlant._pushBack)), Vector3::Replicate(drawPlant._scale));
-			pMesh->PushInstance(matW, Vector4(Vector3(drawPlant._pos), drawPlant._windBending));
-		}
-	}
+			VERUS_PROFILER_END_EVENT(cb);
+		});
 	shader->EndBindDescriptors();
-
-	VERUS_PROFILER_END_EVENT(cb);
 }
 
 void Forest::DrawSprites()
@@ -524,8 +559,6 @@ void Forest::DrawSprites()
 
 	auto cb = renderer.GetCommandBuffer();
 
-	VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(64, 255, 160, 255), "Forest/DrawSprites");
-
 	s_ubForestVS._matP = wm.GetPassCamera()->GetMatrixP().UniformBufferFormat();
 	s_ubForestVS._matWVP = wm.GetPassCamera()->GetMatrixVP().UniformBufferFormat();
 	s_ubForestVS._viewportSize = cb->GetViewportSize().GLM();
@@ -533,24 +566,34 @@ void Forest::DrawSprites()
 	s_ubForestVS._headPos = float4(wm.GetHeadCamera()->GetEyePosition().GLM(), 0);
 	s_ubForestVS._matRoll = wm.GetPassCamera()->GetMatrixV().ToSpriteRollMatrix();
 
-	cb->BindPipeline(_pipe[drawingDepth ? PIPE_DEPTH : PIPE_MAIN]);
-	cb->BindVertexBuffers(_geo);
+	const int plantCount = Utils::Cast32(_vPlants.size());
+	const int partCount = renderer.GetParallelPartCount(plantCount, 2);
 	s_shader[SHADER_MAIN]->BeginBindDescriptors();
-	cb->BindDescriptors(s_shader[SHADER_MAIN], 0);
-	for (auto& plant : _vPlants)
-	{
-		if (!plant._csh.IsSet())
-			continue;
-		cb->BindDescriptors(s_shader[SHADER_MAIN], 1, plant._csh);
-		for (auto& bc : plant._vBakedChunks)
+	renderer.RecordInParallel(partCount, [this, drawingDepth, plantCount, partCount](CGI::CommandBufferPtr cb, int part)
 		{
-			if (bc._visible && !bc._vSprites.empty())
-				cb->Draw(Utils::Cast32(bc._vSprites.size()), 1, bc._vbOffset);
-		}
-	}
-	s_shader[SHADER_MAIN]->EndBindDescriptors();
+			VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(64, 255, 160, 255), "Forest/DrawSprites");
+
+			cb->BindPipeline(_pipe[drawingDepth ? PIPE_DEPTH : PIPE_MAIN]);
+			cb->BindVertexBuffers(_geo);
+			cb->BindDescriptors(s_shader[SHADER_MAIN], 0);
+			const int plantBegin = plantCount * part / partCount;
+			const int plantEnd = plantCount * (part + 1) / partCount;
+			for (int i = plantBegin; i < plantEnd; ++i)
+			{
+				RcPlant plant = _vPlants[i];
+				if (!plant._csh.IsSet())
+					continue;
+				cb->BindDescriptors(s_shader[SHADER_MAIN], 1, plant._csh);
+				for (auto& bc : plant._vBakedChunks)
+				{
+					if (bc._visible && !bc._vSprites.empty())
+						cb->Draw(Utils::Cast32(bc._vSprites.size()), 1, bc._vbOffset);
+				}
+			}
 
-	VERUS_PROFILER_END_EVENT(cb);
+			VERUS_PROFILER_END_EVENT(cb);
+		});
+	s_shader[SHADER_MAIN]->EndBindDescriptors();
 }
 
 void Forest::DrawSimple(DrawSimpleMode mode, CGI::CubeMapFace cubeMapFace)
@@ -163,6 +163,18 @@ namespace verus::World
 		};
 		VERUS_TYPEDEFS(DrawPlant);
 
+		// Instances of plant's mesh, which are drawn with one call.
+		class DrawBatch
+		{
+		public:
+			PMesh       _pMesh = nullptr;
+			MaterialPtr _material;
+			int         _firstInstance = 0;
+			int         _instanceCount = 0;
+			bool        _tess = false;
+		};
+		VERUS_TYPEDEFS(DrawBatch);
+
 		static CGI::ShaderPwns<SHADER_COUNT> s_shader;
 		static UB_ForestVS                   s_ubForestVS;
 		static UB_ForestFS                   s_ubForestFS;
@@ -177,6 +189,10 @@ namespace verus::World
 		Vector<Plant>                    _vPlants;
 		Vector<LayerData>                _vLayerData;
 		Vector<DrawPlant>                _vDrawPlants;
+		Vector<DrawPlant>                _vSortedDrawPlants;
+		Vector<DrawBatch>                _vDrawBatches;
+		Vector<SortKey>                  _vSortKeys;
+		Vector<SortKey>                  _vSortKeysTemp;
 		DifferenceVector<CollisionPlant> _vCollisionPlants;
 		Pool<CollisionPoolBlock>         _vCollisionPool;
 		const float                      _margin = 1.1f;
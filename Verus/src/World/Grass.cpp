@@ -251,14 +251,6 @@ void Grass::Draw()
 	s_ubGrassVS._warp_turb = Vector4(_warpSpring.GetOffset(), _turbulence).GLM();
 	s_ubGrassVS._matRoll = wm.GetPassCamera()->GetMatrixV().ToSpriteRollMatrix();
 
-	cb->BindVertexBuffers(_geo);
-	cb->BindIndexBuffer(_geo);
-
-	s_shader->BeginBindDescriptors();
-
-	cb->BindPipeline(_pipe[PIPE_BILLBOARDS]);
-	cb->BindDescriptors(s_shader, 0, _cshVS);
-	cb->BindDescriptors(s_shader, 1, _cshFS);
 	int pointSpriteInstCount = 0;
 	VERUS_FOR(i, _visiblePatchCount)
 	{
@@ -273,12 +265,9 @@ void Grass::Draw()
 			pointSpriteInstCount++;
 		}
 	}
-	cb->Draw(_bbVertCount, pointSpriteInstCount, _vertCount, _instanceCount);
+	const int pointSpriteFirstInstance = _instanceCount;
 	_instanceCount += pointSpriteInstCount;
 
-	cb->BindPipeline(_pipe[PIPE_MAIN]);
-	cb->BindDescriptors(s_shader, 0, _cshVS);
-	cb->BindDescriptors(s_shader, 1, _cshFS);
 	int meshInstCount = 0;
 	VERUS_FOR(i, _visiblePatchCount)
 	{
@@ -293,9 +282,31 @@ void Grass::Draw()
 			meshInstCount++;
 		}
 	}
-	cb->DrawIndexed(Utils::Cast32(_vPatchMeshIB.size()), meshInstCount, 0, 0, _instanceCount);
+	const int meshFirstInstance = _instanceCount;
 	_instanceCount += meshInstCount;
 
+	// Billboards and meshes are separate parts, one part draws both when not recording in parallel:
+	const int partCount = renderer.GetParallelPartCount(2, 1);
+	s_shader->BeginBindDescriptors();
+	renderer.RecordInParallel(partCount, [this, pointSpriteInstCount, pointSpriteFirstInstance, meshInstCount, meshFirstInstance, partCount](CGI::CommandBufferPtr cb, int part)
+		{
+			cb->BindVertexBuffers(_geo);
+			cb->BindIndexBuffer(_geo);
+			if (!part)
+			{
+				cb->BindPipeline(_pipe[PIPE_BILLBOARDS]);
+				cb->BindDescriptors(s_shader, 0, _cshVS);
+				cb->BindDescriptors(s_shader, 1, _cshFS);
+				cb->Draw(_bbVertCount, pointSpriteInstCount, _vertCount, pointSpriteFirstInstance);
+			}
+			if (part == partCount - 1)
+			{
+				cb->BindPipeline(_pipe[PIPE_MAIN]);
+				cb->BindDescriptors(s_shader, 0, _cshVS);
+				cb->BindDescriptors(s_shader, 1, _cshFS);
+				cb->DrawIndexed(Utils::Cast32(_vPatchMeshIB.size()), meshInstCount, 0, 0, meshFirstInstance);
+			}
+		});
 	s_shader->EndBindDescriptors();
 
 	_geo->UpdateVertexBuffer(&_vInstanceBuffer[offset], 1, cb.Get(), _instanceCount - offset, offset);
@@ -0,0 +1,151 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::World;
+
+LightClusters::LightClusters()
+{
+}
+
+LightClusters::~LightClusters()
+{
+	Done();
+}
+
+void LightClusters::Init(RcDesc desc)
+{
+	VERUS_INIT();
+
+	_desc = desc;
+	_vClusters.resize(_desc._width * _desc._height * _desc._depth);
+	_vLightIndices.reserve(_vClusters.size() * 4);
+	_vLightNodes.reserve(256);
+	_vLightSpheres.reserve(256);
+	_vLightRanges.reserve(256);
+}
+
+void LightClusters::Done()
+{
+	VERUS_DONE(LightClusters);
+}
+
+void LightClusters::Build(RcCamera camera, const PLightNode* pLightNodes, int count)
+{
+	_vLightNodes.clear();
+	_vLightSpheres.clear();
+	VERUS_FOR(i, count)
+	{
+		PLightNode pLightNode = pLightNodes[i];
+		if (CGI::LightType::dir == pLightNode->GetLightType())
+			continue;
+		_vLightNodes.push_back(pLightNode);
+		_vLightSpheres.push_back(Math::Sphere(pLightNode->GetPosition(), pLightNode->GetRadius()));
+	}
+	BuildFromSpheres(camera, _vLightSpheres.data(), static_cast<int>(_vLightSpheres.size()));
+}
+
+void LightClusters::Build(RcCamera camera, const Math::Sphere* pSpheres, int count)
+{
+	_vLightNodes.clear();
+	BuildFromSpheres(camera, pSpheres, count);
+}
+
+void LightClusters::BuildFromSpheres(RcCamera camera, const Math::Sphere* pSpheres, int count)
+{
+	VERUS_RT_ASSERT(IsInitialized());
+	VERUS_RT_ASSERT(camera.GetYFov() > 0); // Perspective projection only.
+
+	_zNear = camera.GetZNear();
+	_zFar = camera.GetZFar();
+	_logScale = _desc._depth / log(_zFar / _zNear);
+
+	const float tanY = tan(camera.GetYFov() * 0.5f);
+	const float tanX = tanY * camera.GetAspectRatio();
+	RcTransform3 matV = camera.GetMatrixV();
+
+	// Projects view space box to NDC conservatively, a/z is minimal either at near or at far side:
+	auto ProjectRange = [](float a0, float a1, float zMin, float zMax, float tanHalf, float& ndc0, float& ndc1)
+	{
+		ndc0 = ((a0 >= 0) ? a0 / zMax : a0 / zMin) / tanHalf;
+		ndc1 = ((a1 >= 0) ? a1 / zMin : a1 / zMax) / tanHalf;
+	};
+
+	_vLightRanges.resize(count);
+	VERUS_FOR(i, count)
+	{
+		LightRange& range = _vLightRanges[i];
+		range = { 0, 0, 0, 0, 0, -1 }; // Not assigned.
+
+		const Point3 posV = matV * pSpheres[i].GetCenter();
+		const float radius = pSpheres[i].GetRadius();
+		const float depth = -posV.getZ(); // View space looks at -Z.
+		const float zMin = Math::Max(depth - radius, _zNear);
+		const float zMax = Math::Min(depth + radius, _zFar);
+		if (zMin > zMax)
+			continue; // Outside of depth range.
+
+		float ndcX0, ndcX1, ndcY0, ndcY1;
+		ProjectRange(posV.getX() - radius, posV.getX() + radius, zMin, zMax, tanX, ndcX0, ndcX1);
+		ProjectRange(posV.getY() - radius, posV.getY() + radius, zMin, zMax, tanY, ndcY0, ndcY1);
+		if (ndcX1 < -1 || ndcX0 > 1 || ndcY1 < -1 || ndcY0 > 1)
+			continue; // Outside of frustum.
+
+		// Tile row 0 is at the top of the screen:
+		range._x0 = Math::Clamp(static_cast<int>(floor((ndcX0 * 0.5f + 0.5f) * _desc._width)), 0, _desc._width - 1);
+		range._x1 = Math::Clamp(static_cast<int>(floor((ndcX1 * 0.5f + 0.5f) * _desc._width)), 0, _desc._width - 1);
+		range._y0 = Math::Clamp(static_cast<int>(floor((0.5f - ndcY1 * 0.5f) * _desc._height)), 0, _desc._height - 1);
+		range._y1 = Math::Clamp(static_cast<int>(floor((0.5f - ndcY0 * 0.5f) * _desc._height)), 0, _desc._height - 1);
+		range._z0 = GetSliceAt(zMin);
+		range._z1 = GetSliceAt(zMax);
+	}
+
+	// Count lights per cluster:
+	for (auto& cluster : _vClusters)
+		cluster = Cluster();
+	for (const auto& range : _vLightRanges)
+	{
+		for (int z = range._z0; z <= range._z1; ++z)
+		{
+			for (int y = range._y0; y <= range._y1; ++y)
+			{
+				for (int x = range._x0; x <= range._x1; ++x)
+					_vClusters[GetClusterIndex(x, y, z)]._count++;
+			}
+		}
+	}
+
+	// Counts to offsets:
+	UINT32 offset = 0;
+	for (auto& cluster : _vClusters)
+	{
+		cluster._offset = offset;
+		offset += cluster._count;
+		cluster._count = 0;
+	}
+	_vLightIndices.resize(offset);
+
+	// Fill light indices, lights in each cluster keep the input order:
+	VERUS_FOR(i, _vLightRanges.size())
+	{
+		const LightRange& range = _vLightRanges[i];
+		for (int z = range._z0; z <= range._z1; ++z)
+		{
+			for (int y = range._y0; y <= range._y1; ++y)
+			{
+				for (int x = range._x0; x <= range._x1; ++x)
+				{
+					RCluster cluster = _vClusters[GetClusterIndex(x, y, z)];
+					_vLightIndices[cluster._offset + cluster._count++] = i;
+				}
+			}
+		}
+	}
+}
+
+int LightClusters::GetSliceAt(float viewDepth) const
+{
+	if (viewDepth <= _zNear)
+		return 0;
+	return Math::Clamp(static_cast<int>(log(viewDepth / _zNear) * _logScale), 0, _desc._depth - 1);
+}
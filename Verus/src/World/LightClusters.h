@@ -0,0 +1,73 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::World
+{
+	// Assigns lights to clusters (froxels) of the view frustum on CPU.
+	// Screen is split into tiles, depth is split exponentially between near and far planes.
+	// The result is offset and count for each cluster plus a flat list of light indices,
+	// which can be uploaded to a buffer and used by the deferred shading pass.
+	class LightClusters : public Object
+	{
+	public:
+		struct Desc
+		{
+			int _width = 16;
+			int _height = 9;
+			int _depth = 24;
+		};
+		VERUS_TYPEDEFS(Desc);
+
+		struct Cluster
+		{
+			UINT32 _offset = 0;
+			UINT32 _count = 0;
+		};
+		VERUS_TYPEDEFS(Cluster);
+
+	private:
+		struct LightRange // Empty if _z0 > _z1.
+		{
+			short _x0;
+			short _y0;
+			short _z0;
+			short _x1;
+			short _y1;
+			short _z1;
+		};
+
+		Vector<Cluster>      _vClusters;
+		Vector<UINT32>       _vLightIndices;
+		Vector<PLightNode>   _vLightNodes;
+		Vector<Math::Sphere> _vLightSpheres;
+		Vector<LightRange>   _vLightRanges;
+		Desc                 _desc;
+		float                _zNear = 0;
+		float                _zFar = 0;
+		float                _logScale = 0;
+
+	public:
+		LightClusters();
+		~LightClusters();
+
+		void Init(RcDesc desc = Desc());
+		void Done();
+
+		// Omni and spot lights are assigned, directional lights are ignored:
+		void Build(RcCamera camera, const PLightNode* pLightNodes, int count);
+		// Light index is the index of the sphere, which bounds the light:
+		void Build(RcCamera camera, const Math::Sphere* pSpheres, int count);
+		VERUS_P(void BuildFromSpheres(RcCamera camera, const Math::Sphere* pSpheres, int count));
+
+		int GetClusterIndex(int x, int y, int z) const { return (z * _desc._height + y) * _desc._width + x; }
+		int GetSliceAt(float viewDepth) const;
+		RcCluster GetCluster(int index) const { return _vClusters[index]; }
+		const Vector<Cluster>& GetClusters() const { return _vClusters; }
+		const Vector<UINT32>& GetLightIndices() const { return _vLightIndices; }
+		PLightNode GetLightNode(UINT32 index) const { return _vLightNodes[index]; }
+		int GetLightCount() const { return static_cast<int>(_vLightRanges.size()); }
+		bool IsLightAssigned(int index) const { return _vLightRanges[index]._z0 <= _vLightRanges[index]._z1; } // Touches at least one cluster.
+		RcDesc GetDesc() const { return _desc; }
+	};
+	VERUS_TYPEDEFS(LightClusters);
+}
@@ -0,0 +1,117 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::World;
+
+LightGrid::LightGrid()
+{
+}
+
+LightGrid::~LightGrid()
+{
+	Done();
+}
+
+void LightGrid::Init(int worldSide, float cellSize)
+{
+	VERUS_INIT();
+
+	_cellSize = cellSize;
+	_invCellSize = 1 / cellSize;
+	_side = Math::Max(1, static_cast<int>(ceil(worldSide * _invCellSize)));
+	_origin = -0.5f * (_side * _cellSize);
+	_vCells.resize(_side * _side);
+	_vUnboundedLightNodes.reserve(16);
+}
+
+void LightGrid::Done()
+{
+	VERUS_DONE(LightGrid);
+}
+
+void LightGrid::Update(PLightNode pLightNode)
+{
+	if (!IsInitialized())
+		return;
+
+	Remove(pLightNode);
+
+	LightGridBinding& binding = pLightNode->GetLightGridBinding();
+	binding._bound = true;
+
+	const float radius = ComputeInfluenceRadius(pLightNode->GetIntensity());
+	const bool dir = (CGI::LightType::dir == pLightNode->GetLightType());
+	if (!dir)
+	{
+		int range[4];
+		ComputeRange(pLightNode->GetPosition(), radius, range);
+		const int spanX = range[2] - range[0] + 1;
+		const int spanZ = range[3] - range[1] + 1;
+		if (spanX <= _maxCellSpan && spanZ <= _maxCellSpan)
+		{
+			VERUS_FOR(i, 4)
+				binding._range[i] = range[i];
+			for (int j = range[1]; j <= range[3]; ++j)
+			{
+				for (int i = range[0]; i <= range[2]; ++i)
+					_vCells[(j * _side) + i].push_back(pLightNode);
+			}
+			return;
+		}
+	}
+
+	// Too large, must always be checked:
+	binding._unbounded = true;
+	_vUnboundedLightNodes.push_back(pLightNode);
+}
+
+void LightGrid::Remove(PLightNode pLightNode)
+{
+	LightGridBinding& binding = pLightNode->GetLightGridBinding();
+	if (!binding._bound)
+		return;
+
+	auto RemoveFrom = [pLightNode](TCell& v)
+	{
+		auto it = std::find(v.begin(), v.end(), pLightNode);
+		if (it != v.end())
+		{
+			std::swap(*it, v.back());
+			v.pop_back();
+		}
+	};
+
+	if (binding._unbounded)
+	{
+		RemoveFrom(_vUnboundedLightNodes);
+	}
+	else
+	{
+		for (int j = binding._range[1]; j <= binding._range[3]; ++j)
+		{
+			for (int i = binding._range[0]; i <= binding._range[2]; ++i)
+				RemoveFrom(_vCells[(j * _side) + i]);
+		}
+	}
+
+	const UINT32 queryID = binding._queryID;
+	binding = LightGridBinding();
+	binding._queryID = queryID;
+}
+
+float LightGrid::ComputeInfluenceRadius(float intensity)
+{
+	// See LightNode::GetInfluenceAt, influence is intensity with inverse-square law, lights below 1 are ignored:
+	return sqrt(abs(intensity));
+}
+
+void LightGrid::ComputeRange(RcPoint3 pos, float radius, int range[4]) const
+{
+	const float x = pos.getX() - _origin;
+	const float z = pos.getZ() - _origin;
+	range[0] = Math::Clamp(static_cast<int>(floor((x - radius) * _invCellSize)), 0, _side - 1);
+	range[1] = Math::Clamp(static_cast<int>(floor((z - radius) * _invCellSize)), 0, _side - 1);
+	range[2] = Math::Clamp(static_cast<int>(floor((x + radius) * _invCellSize)), 0, _side - 1);
+	range[3] = Math::Clamp(static_cast<int>(floor((z + radius) * _invCellSize)), 0, _side - 1);
+}
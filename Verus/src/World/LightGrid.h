@@ -0,0 +1,65 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::World
+{
+	// Uniform grid on XZ plane, which stores the areas, where lights have influence.
+	// Nearby lights can be found without iterating all lights in the world.
+	// Directional lights and lights with a very large influence area are stored in a separate list, which is always checked.
+	// Lights are updated when they are transformed or their intensity changes.
+	class LightGrid : public Object
+	{
+		typedef Vector<PLightNode> TCell;
+
+		Vector<TCell>      _vCells;
+		Vector<PLightNode> _vUnboundedLightNodes;
+		float              _origin = 0;
+		float              _cellSize = 16;
+		float              _invCellSize = 1 / 16.f;
+		int                _side = 0; // Cells per side.
+		int                _maxCellSpan = 8;
+		UINT32             _queryID = 0;
+
+	public:
+		LightGrid();
+		~LightGrid();
+
+		void Init(int worldSide, float cellSize = 16);
+		void Done();
+
+		void Update(PLightNode pLightNode);
+		void Remove(PLightNode pLightNode);
+
+		// Calls fn for each light, which can have influence on the area, no duplicates:
+		template<typename TFn>
+		void ForEachNear(RcPoint3 pos, float radius, const TFn& fn)
+		{
+			const UINT32 queryID = ++_queryID;
+			for (auto pLightNode : _vUnboundedLightNodes)
+				fn(pLightNode);
+
+			int range[4];
+			ComputeRange(pos, radius, range);
+			for (int j = range[1]; j <= range[3]; ++j)
+			{
+				for (int i = range[0]; i <= range[2]; ++i)
+				{
+					for (auto pLightNode : _vCells[(j * _side) + i])
+					{
+						LightGridBinding& binding = pLightNode->GetLightGridBinding();
+						if (binding._queryID == queryID)
+							continue;
+						binding._queryID = queryID;
+						fn(pLightNode);
+					}
+				}
+			}
+		}
+
+		static float ComputeInfluenceRadius(float intensity);
+
+	private:
+		void ComputeRange(RcPoint3 pos, float radius, int range[4]) const;
+	};
+	VERUS_TYPEDEFS(LightGrid);
+}
@@ -32,6 +32,9 @@ void Texture::Init(CSZ url, bool streamParts, bool sync, CGI::PcSamplerDesc pSam
 		texDesc._flags = CGI::TextureDesc::Flags::sync;
 	_texTiny.Init(texDesc);
 	_refCount = 1;
+
+	if (_streamParts)
+		TextureStreamer::I().Register(this);
 }
 
 bool Texture::Done()
@@ -39,6 +42,8 @@ bool Texture::Done()
 	_refCount--;
 	if (_refCount <= 0)
 	{
+		if (_streamParts && TextureStreamer::IsValidSingleton())
+			TextureStreamer::I().Unregister(this);
 		_texTiny.Done();
 		return true;
 	}
@@ -57,11 +62,20 @@ void Texture::UpdateStreaming()
 
 	VERUS_QREF_RENDERER;
 
+	// Check if missing mip levels are loaded (if loading has failed, the part can be requested again):
+	if (_loading && _loadingInPlace && !_texHuge[_currentHuge]->IsLoadingParts())
+	{
+		_loading = false;
+		_loadingInPlace = false;
+		_loadingPart = -1;
+	}
+
 	// Check if the next huge texture is loaded:
 	const int nextHuge = (_currentHuge + 1) & 0x1;
-	if (_loading && _texHuge[nextHuge] && _texHuge[nextHuge]->IsLoaded())
+	if (_loading && !_loadingInPlace && _texHuge[nextHuge] && _texHuge[nextHuge]->IsLoaded())
 	{
 		_loading = false;
+		_loadingPart = -1;
 		_currentHuge = nextHuge; // Use it.
 		_doneFrame = renderer.GetFrameCount() + CGI::BaseRenderer::s_ringBufferSize + 1;
 	}
@@ -72,37 +86,12 @@ void Texture::UpdateStreaming()
 		if (_texHuge[prevHuge]) // Garbage collection (next huge texture must be empty).
 			_texHuge[prevHuge].Done();
 
-		const int maxPart = _texTiny->GetPart();
-		if (maxPart > 0) // Must have at least two parts: 0 and 1.
+		if (GetMaxPart() > 0) // Must have at least two parts: 0 and 1.
 		{
-			const float reqPart = Math::Min<float>(_requestedPart, SHRT_MAX);
-
-			const bool hugeReady = (_texHuge[_currentHuge] && _texHuge[_currentHuge]->IsLoaded());
-			const int currentPart = hugeReady ? _texHuge[_currentHuge]->GetPart() : maxPart;
-			int newPart = currentPart;
-
-			if (reqPart < currentPart) // Increase texture?
-				newPart = static_cast<int>(reqPart);
-			if (reqPart > currentPart + 1.5f) // Decrease texture?
-				newPart = static_cast<int>(reqPart);
-
-			newPart = Math::Clamp(newPart, 0, maxPart);
-
-			if (_texHuge[_currentHuge] && (newPart == maxPart)) // Unload huge texture, use tiny?
-			{
-				_currentHuge = (_currentHuge + 1) & 0x1; // Go to empty huge texture.
-				_doneFrame = renderer.GetFrameCount() + CGI::BaseRenderer::s_ringBufferSize + 1;
-			}
-			else if (newPart != currentPart) // Change part?
-			{
-				_loading = true;
-				const int nextHuge = (_currentHuge + 1) & 0x1;
-
-				CGI::TextureDesc texDesc;
-				texDesc._url = _C(_texTiny->GetName());
-				texDesc._texturePart = newPart;
-				_texHuge[nextHuge].Init(texDesc);
-			}
+			// Actual loading is scheduled by TextureStreamer:
+			const int newPart = GetDesiredPart();
+			if (newPart != GetResidentPart())
+				TextureStreamer::I().Request(this, newPart);
 		}
 	}
 }
@@ -127,6 +116,148 @@ int Texture::GetPart() const
 	return _texHuge[_currentHuge] ? _texHuge[_currentHuge]->GetPart() : _texTiny->GetPart();
 }
 
+int Texture::GetMaxPart() const
+{
+	return _texTiny->GetPart();
+}
+
+int Texture::GetResidentPart() const
+{
+	const bool hugeReady = (_texHuge[_currentHuge] && _texHuge[_currentHuge]->IsLoaded());
+	return hugeReady ? _texHuge[_currentHuge]->GetPart() : GetMaxPart();
+}
+
+int Texture::GetDesiredPart() const
+{
+	const int maxPart = GetMaxPart();
+	const float reqPart = Math::Min<float>(_requestedPart, SHRT_MAX);
+
+	const int currentPart = GetResidentPart();
+	int newPart = currentPart;
+
+	if (reqPart < currentPart) // Increase texture?
+		newPart = static_cast<int>(reqPart);
+	if (reqPart > currentPart + 1.5f) // Decrease texture?
+		newPart = static_cast<int>(reqPart);
+
+	return Math::Clamp(newPart, 0, maxPart);
+}
+
+bool Texture::IsStreamingBusy() const
+{
+	VERUS_QREF_RENDERER;
+	return _loading || renderer.GetFrameCount() < _doneFrame;
+}
+
+bool Texture::CanReuseMipChain(int part) const
+{
+	CGI::TexturePtr texHuge = _texHuge[_currentHuge];
+	if (!texHuge || part < texHuge->GetMipChainPart())
+		return false;
+	// Keep mip chain unless the new one would be at least 16 times smaller:
+	const int mipChainPart = TextureStreamer::I().ComputeMipChainPart(part);
+	return mipChainPart - texHuge->GetMipChainPart() < 2;
+}
+
+bool Texture::IsLoadRequired(int part) const
+{
+	if (part >= GetMaxPart())
+		return false;
+	return !CanReuseMipChain(part) || part < _texHuge[_currentHuge]->GetLoadedPart();
+}
+
+void Texture::LoadPart(int part)
+{
+	VERUS_RT_ASSERT(!IsStreamingBusy());
+	VERUS_QREF_RENDERER;
+
+	if (part >= GetMaxPart()) // Unload huge texture, use tiny?
+	{
+		if (_texHuge[_currentHuge])
+		{
+			_currentHuge = (_currentHuge + 1) & 0x1; // Go to empty huge texture.
+			_doneFrame = renderer.GetFrameCount() + CGI::BaseRenderer::s_ringBufferSize + 1;
+		}
+		return;
+	}
+
+	if (CanReuseMipChain(part))
+	{
+		CGI::TexturePtr texHuge = _texHuge[_currentHuge];
+		const int loadedPart = texHuge->GetLoadedPart();
+		if (part >= loadedPart) // Already loaded, just change the view.
+		{
+			texHuge->SetPart(part);
+			return;
+		}
+
+		// Load only the missing mip levels:
+		_loading = true;
+		_loadingInPlace = true;
+		_loadingPart = part;
+		texHuge->LoadDDSParts(_C(_texTiny->GetName()), part, loadedPart - part);
+		return;
+	}
+
+	_loading = true;
+	_loadingPart = part;
+	const int nextHuge = (_currentHuge + 1) & 0x1;
+
+	// Allocate extra mip levels, so that the next increase doesn't need a new texture:
+	CGI::TextureDesc texDesc;
+	texDesc._url = _C(_texTiny->GetName());
+	texDesc._flags = CGI::TextureDesc::Flags::fullMipChain;
+	texDesc._texturePart = part;
+	texDesc._mipChainPart = TextureStreamer::I().ComputeMipChainPart(part);
+	_texHuge[nextHuge].Init(texDesc);
+}
+
+UINT64 Texture::ComputeMemoryUsage(int part) const
+{
+	if (!_texTiny->IsLoaded())
+		return 0;
+
+	// Tiny texture is the last part, every other part doubles the size:
+	const int shift = Math::Max(GetMaxPart() - part, 0);
+	const CGI::Format format = _texTiny->GetFormat();
+	const bool bc = CGI::BaseTexture::IsBC(format);
+	const bool is4Bits = CGI::BaseTexture::Is4BitsBC(format);
+	const int bytesPerPixel = CGI::BaseTexture::FormatToBytesPerPixel(format);
+	const int w = _texTiny->GetWidth() << shift;
+	const int h = _texTiny->GetHeight() << shift;
+	const int mipLevels = _texTiny->GetMipLevelCount() + shift;
+
+	UINT64 size = 0;
+	VERUS_FOR(i, mipLevels)
+	{
+		const int levelW = Math::Max(w >> i, 1);
+		const int levelH = Math::Max(h >> i, 1);
+		size += bc ?
+			IO::DDSHeader::ComputeBcLevelSize(levelW, levelH, is4Bits) :
+			static_cast<UINT64>(levelW) * levelH * bytesPerPixel;
+	}
+	return size;
+}
+
+UINT64 Texture::ComputeMemoryUsageForPart(int part) const
+{
+	if (part >= GetMaxPart())
+		return 0;
+	if (CanReuseMipChain(part))
+		return ComputeMemoryUsage(_texHuge[_currentHuge]->GetMipChainPart());
+	return ComputeMemoryUsage(TextureStreamer::I().ComputeMipChainPart(part));
+}
+
+UINT64 Texture::GetMemoryUsage() const
+{
+	UINT64 size = 0;
+	if (_texHuge[_currentHuge])
+		size += ComputeMemoryUsage(_texHuge[_currentHuge]->GetMipChainPart());
+	if (_loading && !_loadingInPlace)
+		size += ComputeMemoryUsage(TextureStreamer::I().ComputeMipChainPart(_loadingPart));
+	return size;
+}
+
 // TexturePtr:
 
 void TexturePtr::Init(CSZ url, bool streamParts, bool sync, CGI::PcSamplerDesc pSamplerDesc)
@@ -205,9 +336,11 @@ void Material::Init(RcDesc desc)
 		return;
 
 	VERUS_INIT();
+	VERUS_QREF_MM;
 
 	_name = desc._name;
 	_refCount = 1;
+	_sortID = mm.AllocateMaterialSortID();
 
 	if (desc._load)
 	{
@@ -233,13 +366,21 @@ bool Material::Done()
 	_refCount--;
 	if (_refCount <= 0)
 	{
-		Mesh::GetSimpleShader()->FreeDescriptorSet(_cshSimple);
-		Mesh::GetShader()->FreeDescriptorSet(_cshTemp);
-		Mesh::GetShader()->FreeDescriptorSet(_cshTiny);
-		Mesh::GetShader()->FreeDescriptorSet(_csh);
+		if (Mesh::GetSimpleShader())
+			Mesh::GetSimpleShader()->FreeDescriptorSet(_cshSimple);
+		if (Mesh::GetShader()) // Tools can use materials without shaders.
+		{
+			for (auto& csh : _vCshTemp)
+				Mesh::GetShader()->FreeDescriptorSet(csh);
+			Mesh::GetShader()->FreeDescriptorSet(_cshTiny);
+			Mesh::GetShader()->FreeDescriptorSet(_csh);
+		}
+		_vCshTemp.clear();
 		_texX.Done();
 		_texN.Done();
 		_texA.Done();
+		if (IsInitialized() && MaterialManager::IsValidSingleton())
+			MaterialManager::I().ReleaseMaterialSortID(_sortID);
 		VERUS_DONE(Material);
 		return true;
 	}
@@ -268,23 +409,31 @@ void Material::Update()
 	VERUS_UPDATE_ONCE_CHECK;
 	VERUS_QREF_RENDERER;
 
-	// Garbage collection:
-	if (_cshTemp.IsSet() && static_cast<INT64>(renderer.GetFrameCount()) >= _cshFreeFrame)
-		Mesh::GetShader()->FreeDescriptorSet(_cshTemp);
+	// Garbage collection (all retired sets are older than the last one):
+	if (!_vCshTemp.empty() && static_cast<INT64>(renderer.GetFrameCount()) >= _cshFreeFrame)
+	{
+		for (auto& csh : _vCshTemp)
+			Mesh::GetShader()->FreeDescriptorSet(csh);
+		_vCshTemp.clear();
+	}
 
 	// Request BindDescriptorSetTextures call by clearing _csh:
+	// The old set must not be used after the part change, since it can reference a retired view.
 	const bool partChanged =
 		_texA && (_aPart != _texA->GetPart()) ||
 		_texN && (_nPart != _texN->GetPart()) ||
 		_texX && (_xPart != _texX->GetPart());
-	if (partChanged && !_cshTemp.IsSet())
+	if (partChanged)
 	{
 		_aPart = _texA->GetPart();
 		_nPart = _texN->GetPart();
 		_xPart = _texX->GetPart();
-		_cshTemp = _csh;
-		_csh = CGI::CSHandle();
-		_cshFreeFrame = renderer.GetFrameCount() + CGI::BaseRenderer::s_ringBufferSize;
+		if (_csh.IsSet())
+		{
+			_vCshTemp.push_back(_csh);
+			_csh = CGI::CSHandle();
+			_cshFreeFrame = renderer.GetFrameCount() + CGI::BaseRenderer::s_ringBufferSize;
+		}
 	}
 
 	// Update _csh:
@@ -433,9 +582,9 @@ void Material::BindDescriptorSetTextures()
 		});
 }
 
-bool Material::UpdateMeshUniformBuffer(float motionBlur, bool resolveDitheringMaskEnabled)
+bool Material::UpdateMeshUniformBuffer(float motionBlur, bool resolveDitheringMaskEnabled, Mesh::UB_MaterialFS* pUB)
 {
-	Mesh::UB_MaterialFS& ub = Mesh::GetUbMaterialFS();
+	Mesh::UB_MaterialFS& ub = pUB ? *pUB : Mesh::GetUbMaterialFS();
 	Mesh::UB_MaterialFS ubPrev;
 	memcpy(&ubPrev, &ub, sizeof(Mesh::UB_MaterialFS));
 
@@ -499,11 +648,11 @@ bool Material::UpdateMeshUniformBufferSimple()
 	return 0 != memcmp(&ubPrev, &ub, sizeof(Mesh::UB_SimpleMaterialFS));
 }
 
-void Material::IncludePart(float part)
+void Material::IncludePart(float part, float importance)
 {
-	_texA->IncludePart(part);
-	_texN->IncludePart(part);
-	_texX->IncludePart(part);
+	_texA->IncludePart(part, importance);
+	_texN->IncludePart(part, importance);
+	_texX->IncludePart(part, importance);
 }
 
 // MaterialPtr:
@@ -608,6 +757,8 @@ void MaterialManager::Update()
 
 	for (auto& [key, value] : TStoreMaterials::_map)
 		value.Update();
+
+	TextureStreamer::I().Update();
 }
 
 PTexture MaterialManager::InsertTexture(CSZ url)
@@ -696,3 +847,10 @@ float MaterialManager::ComputePart(float distSq, float objectRadius)
 	}
 	return 4;
 }
+
+float MaterialManager::ComputeImportance(float distSq, float objectRadius)
+{
+	// Proportional to the projected area of the object, 1 when the camera is inside:
+	const float radiusSq = objectRadius * objectRadius;
+	return (distSq > radiusSq) ? radiusSq / distSq : 1.f;
+}
@@ -3,7 +3,7 @@
 
 namespace verus::World
 {
-	class Texture : public AllocatorAware
+	class Texture : public AllocatorAware, public StreamedTexture
 	{
 		UINT64              _date = 0;
 		UINT64              _doneFrame = 0;
@@ -11,9 +11,12 @@ namespace verus::World
 		CGI::TexturePwns<2> _texHuge;
 		int                 _refCount = 0;
 		int                 _currentHuge = 0;
+		int                 _loadingPart = -1;
 		float               _requestedPart = 0;
+		float               _importance = 0;
 		bool                _streamParts = false;
 		bool                _loading = false;
+		bool                _loadingInPlace = false; // Loading missing mip levels into current huge texture.
 
 	public:
 		Texture();
@@ -31,9 +34,28 @@ namespace verus::World
 		CGI::TexturePtr GetTinyTex() const;
 		CGI::TexturePtr GetHugeTex() const;
 
-		void ResetPart() { _requestedPart = FLT_MAX; }
-		void IncludePart(float part) { _requestedPart = Math::Min(_requestedPart, part); }
+		void ResetPart() { _requestedPart = FLT_MAX; _importance = 0; }
+		void IncludePart(float part, float importance = 1)
+		{
+			_requestedPart = Math::Min(_requestedPart, part);
+			_importance = Math::Max(_importance, importance);
+		}
 		int GetPart() const;
+
+		// TextureStreamer interaction:
+		virtual int GetMaxPart() const override;
+		virtual int GetResidentPart() const override;
+		int GetDesiredPart() const;
+		virtual float GetImportance() const override { return _importance; }
+		virtual bool HasHugeTex() const override { return !!_texHuge[_currentHuge]; }
+		virtual bool IsLoadingPart() const override { return _loading; }
+		virtual bool IsStreamingBusy() const override;
+		bool CanReuseMipChain(int part) const;
+		virtual bool IsLoadRequired(int part) const override;
+		virtual void LoadPart(int part) override;
+		virtual UINT64 ComputeMemoryUsage(int part) const override;
+		virtual UINT64 ComputeMemoryUsageForPart(int part) const override;
+		virtual UINT64 GetMemoryUsage() const override;
 	};
 	VERUS_TYPEDEFS(Texture);
 
@@ -110,12 +132,13 @@ namespace verus::World
 		Blending       _blending = Blending::opaque;
 		CGI::CSHandle  _csh;
 		CGI::CSHandle  _cshTiny;
-		CGI::CSHandle  _cshTemp;
 		CGI::CSHandle  _cshSimple;
+		Vector<CGI::CSHandle> _vCshTemp; // Retired, but can still be used by frames in flight.
 		int            _aPart = -1;
 		int            _nPart = -1;
 		int            _xPart = -1;
 		int            _refCount = 0;
+		UINT16         _sortID = 0;
 
 		Material();
 		~Material();
@@ -126,6 +149,7 @@ namespace verus::World
 		void AddRef() { _refCount++; }
 
 		bool operator<(const Material& that) const;
+		UINT16 GetSortID() const { return _sortID; } // Stable ID for sort keys.
 
 		void Update();
 
@@ -141,10 +165,11 @@ namespace verus::World
 		CGI::CSHandle GetComplexSetHandle() const;
 		CGI::CSHandle GetComplexSetHandleSimple() const;
 		void BindDescriptorSetTextures();
-		bool UpdateMeshUniformBuffer(float motionBlur = 1, bool resolveDitheringMaskEnabled = true);
+		// Writes to pUB, if it's not null, otherwise to the static one. Use pUB when recording on multiple threads.
+		bool UpdateMeshUniformBuffer(float motionBlur = 1, bool resolveDitheringMaskEnabled = true, Mesh::UB_MaterialFS* pUB = nullptr);
 		bool UpdateMeshUniformBufferSimple();
 
-		void IncludePart(float part);
+		void IncludePart(float part, float importance = 1);
 	};
 	VERUS_TYPEDEFS(Material);
 
@@ -176,6 +201,7 @@ namespace verus::World
 		CGI::TexturePwn _texDummyShadow;
 		CGI::CSHandle   _cshDefault; // For missing, non-mandatory materials.
 		CGI::CSHandle   _cshDefaultSimple;
+		SortIdAllocator _sortIdAllocator;
 
 	public:
 		MaterialManager();
@@ -206,6 +232,8 @@ namespace verus::World
 		PMaterial FindMaterial(CSZ name);
 		void      DeleteMaterial(CSZ name);
 		void      DeleteAllMaterials();
+		UINT16    AllocateMaterialSortID() { return _sortIdAllocator.Allocate(); }
+		void      ReleaseMaterialSortID(UINT16 id) { _sortIdAllocator.Release(id); }
 
 		void Serialize(IO::RSeekableStream stream);
 		void Deserialize(IO::RStream stream);
@@ -215,6 +243,7 @@ namespace verus::World
 
 		void ResetPart();
 		static float ComputePart(float distSq, float objectRadius);
+		static float ComputeImportance(float distSq, float objectRadius);
 	};
 	VERUS_TYPEDEFS(MaterialManager);
 }
@@ -6,6 +6,7 @@ using namespace verus::World;
 
 CGI::ShaderPwns<Mesh::SHADER_COUNT> Mesh::s_shader;
 CGI::PipelinePwns<Mesh::PIPE_COUNT> Mesh::s_pipe;
+std::mutex                          Mesh::s_pipeMutex;
 
 Mesh::UB_View                       Mesh::s_ubView;
 Mesh::UB_MaterialFS                 Mesh::s_ubMaterialFS;
@@ -214,6 +215,7 @@ void Mesh::BindPipeline(PIPE pipe, CGI::CommandBufferPtr cb)
 		};
 	}
 
+	std::unique_lock<std::mutex> lock(s_pipeMutex);
 	if (!s_pipe[pipe])
 	{
 		static CSZ branches[] =
@@ -378,6 +380,7 @@ void Mesh::BindPipeline(PIPE pipe, CGI::CommandBufferPtr cb)
 			s_pipe[pipe].Init(pipeDesc);
 		}
 	}
+	lock.unlock();
 	cb->BindPipeline(s_pipe[pipe]);
 }
 
@@ -447,7 +450,7 @@ void Mesh::BindGeo(CGI::CommandBufferPtr cb, UINT32 bindingsFilter)
 	cb->BindIndexBuffer(_geo);
 }
 
-void Mesh::UpdateUniformBuffer_View(float invTessDist)
+void Mesh::UpdateUniformBuffer_View(float invTessDist, UB_View* pUB)
 {
 	VERUS_QREF_RENDERER;
 	VERUS_QREF_WM;
@@ -455,15 +458,25 @@ void Mesh::UpdateUniformBuffer_View(float invTessDist)
 	RcPoint3 headPos = wm.GetHeadCamera()->GetEyePosition();
 	Point3 headPosWV = wm.GetPassCamera()->GetMatrixV() * headPos;
 
-	s_ubView._matV = wm.GetPassCamera()->GetMatrixV().UniformBufferFormat();
-	s_ubView._matVP = wm.GetPassCamera()->GetMatrixVP().UniformBufferFormat();
-	s_ubView._matP = wm.GetPassCamera()->GetMatrixP().UniformBufferFormat();
-	s_ubView._viewportSize = renderer.GetCommandBuffer()->GetViewportSize().GLM();
-	s_ubView._eyePosWV_invTessDistSq = float4(headPosWV.GLM(), invTessDist * invTessDist);
+	UB_View& ub = pUB ? *pUB : s_ubView;
+	ub._matV = wm.GetPassCamera()->GetMatrixV().UniformBufferFormat();
+	ub._matVP = wm.GetPassCamera()->GetMatrixVP().UniformBufferFormat();
+	ub._matP = wm.GetPassCamera()->GetMatrixP().UniformBufferFormat();
+	ub._viewportSize = renderer.GetCommandBuffer()->GetViewportSize().GLM();
+	ub._eyePosWV_invTessDistSq = float4(headPosWV.GLM(), invTessDist * invTessDist);
 }
 
-void Mesh::UpdateUniformBuffer_MeshVS()
+void Mesh::UpdateUniformBuffer_MeshVS(UB_MeshVS* pUB)
 {
+	if (pUB)
+	{
+		memcpy(&pUB->_posDeqScale, _posDeq + 0, 12);
+		memcpy(&pUB->_posDeqBias, _posDeq + 3, 12);
+		memcpy(&pUB->_tc0DeqScaleBias, _tc0Deq, 16);
+		memcpy(&pUB->_tc1DeqScaleBias, _tc1Deq, 16);
+		return;
+	}
+
 	memcpy(&s_ubMeshVS._posDeqScale, _posDeq + 0, 12);
 	memcpy(&s_ubMeshVS._posDeqBias, _posDeq + 3, 12);
 	memcpy(&s_ubMeshVS._tc0DeqScaleBias, _tc0Deq, 16);
@@ -489,8 +502,15 @@ void Mesh::UpdateUniformBuffer_SkeletonVS()
 	_skeleton.UpdateUniformBufferArray(s_ubSkeletonVS._vMatBones);
 }
 
-void Mesh::UpdateUniformBuffer_Object(RcTransform3 tr, RcVector4 color)
+void Mesh::UpdateUniformBuffer_Object(RcTransform3 tr, RcVector4 color, UB_Object* pUB)
 {
+	if (pUB)
+	{
+		pUB->_matW = tr.UniformBufferFormat();
+		pUB->_userColor = color.GLM();
+		return;
+	}
+
 	s_ubObject._matW = tr.UniformBufferFormat();
 	s_ubObject._userColor = color.GLM();
 
@@ -624,8 +644,17 @@ void Mesh::CreateDeviceBuffers()
 		_geo->UpdateVertexBuffer(_vBinding3.data(), 3);
 	}
 
-	// Index buffer:
-	if (!_vIndices.empty())
+	// Index buffer, extra levels of detail go after the main indices:
+	if (!_vIndices.empty() && !_vLODIndices.empty())
+	{
+		Vector<UINT16> vIndices;
+		vIndices.reserve(_vIndices.size() + _vLODIndices.size());
+		vIndices.insert(vIndices.end(), _vIndices.begin(), _vIndices.end());
+		vIndices.insert(vIndices.end(), _vLODIndices.begin(), _vLODIndices.end());
+		_geo->CreateIndexBuffer(Utils::Cast32(vIndices.size()));
+		_geo->UpdateIndexBuffer(vIndices.data());
+	}
+	else if (!_vIndices.empty())
 	{
 		_geo->CreateIndexBuffer(Utils::Cast32(_vIndices.size()));
 		_geo->UpdateIndexBuffer(_vIndices.data());
@@ -78,6 +78,7 @@ namespace verus::World
 	private:
 		static CGI::ShaderPwns<SHADER_COUNT> s_shader;
 		static CGI::PipelinePwns<PIPE_COUNT> s_pipe;
+		static std::mutex                    s_pipeMutex; // Pipelines are created on first use, which can happen during parallel recording.
 
 		static UB_View                       s_ubView;
 		static UB_MaterialFS                 s_ubMaterialFS;
@@ -147,10 +148,12 @@ namespace verus::World
 
 		static CGI::ShaderPtr GetShader() { return s_shader[SHADER_MAIN]; }
 		static UB_MaterialFS& GetUbMaterialFS() { return s_ubMaterialFS; }
-		void UpdateUniformBuffer_View(float invTessDist = 0);
-		void UpdateUniformBuffer_MeshVS();
+		// Uniform buffer is written to pUB, if it's not null, otherwise to the static one.
+		// Use pUB and BindDescriptors() with pSrc when recording on multiple threads.
+		static void UpdateUniformBuffer_View(float invTessDist = 0, UB_View* pUB = nullptr);
+		void UpdateUniformBuffer_MeshVS(UB_MeshVS* pUB = nullptr);
 		void UpdateUniformBuffer_SkeletonVS();
-		void UpdateUniformBuffer_Object(RcTransform3 tr, RcVector4 color = Vector4(0.5f, 0.5f, 0.5f, 1));
+		static void UpdateUniformBuffer_Object(RcTransform3 tr, RcVector4 color = Vector4(0.5f, 0.5f, 0.5f, 1), UB_Object* pUB = nullptr);
 
 		static CGI::ShaderPtr GetSimpleShader() { return s_shader[SHADER_SIMPLE]; }
 		static UB_SimpleMaterialFS& GetUbSimpleMaterialFS() { return s_ubSimpleMaterialFS; }
@@ -524,6 +524,7 @@ void Terrain::Init(RcDesc desc)
 	}
 	_vSortedPatchIndices.resize(patchCount);
 	_vRandomPatchIndices.resize(patchCount);
+	_vSortKeys.resize(patchCount);
 
 	// Init LODs:
 	VERUS_FOR(i, VERUS_COUNT_OF(_lods))
@@ -568,6 +569,7 @@ void Terrain::Init(RcDesc desc)
 	_geo->UpdateVertexBuffer(vVB.data(), 0);
 	_geo->UpdateIndexBuffer(vIB.data());
 
+	CGI::PipelineBatch pipelineBatch;
 	{
 		CGI::PipelineDesc pipeDesc(_geo, s_shader[SHADER_MAIN], "#", renderer.GetDS().GetRenderPassHandle());
 		pipeDesc._colorAttachBlendEqs[0] = VERUS_COLOR_BLEND_OFF;
@@ -631,6 +633,7 @@ void Terrain::Init(RcDesc desc)
 		pipeDesc._primitiveRestartEnable = true;
 		_pipe[PIPE_SIMPLE_ENV_MAP_STRIP].Init(pipeDesc);
 	}
+	pipelineBatch.End();
 
 	CGI::TextureDesc texDesc;
 	texDesc._name = "Terrain.Heightmap";
@@ -689,6 +692,7 @@ void Terrain::InitByWater()
 	if (_pipe[PIPE_SIMPLE_PLANAR_REF_LIST].Get())
 		return;
 
+	CGI::PipelineBatch pipelineBatch;
 	{
 		CGI::PipelineDesc pipeDesc(_geo, s_shader[SHADER_SIMPLE], "#", water.GetRenderPassHandle());
 		pipeDesc._colorAttachBlendEqs[0] = VERUS_COLOR_BLEND_OFF;
@@ -706,6 +710,7 @@ void Terrain::InitByWater()
 		pipeDesc._primitiveRestartEnable = true;
 		_pipe[PIPE_SIMPLE_UNDERWATER_STRIP].Init(pipeDesc);
 	}
+	pipelineBatch.End();
 }
 
 void Terrain::Done()
@@ -753,16 +758,21 @@ void Terrain::Layout()
 void Terrain::SortVisible()
 {
 	_visiblePatchCount = _visibleSortedPatchCount + _visibleRandomPatchCount;
-	std::sort(_vSortedPatchIndices.begin(), _vSortedPatchIndices.begin() + _visibleSortedPatchCount, [this](int a, int b)
-		{
-			RcTerrainPatch patchA = GetPatch(a);
-			RcTerrainPatch patchB = GetPatch(b);
 
-			if (patchA._quadtreeLOD != patchB._quadtreeLOD)
-				return patchA._quadtreeLOD < patchB._quadtreeLOD;
+	// Sort key is [quadtreeLOD:8][distToHeadSq:32]:
+	VERUS_FOR(i, _visibleSortedPatchCount)
+	{
+		RcTerrainPatch patch = GetPatch(_vSortedPatchIndices[i]);
+		const UINT64 lod = static_cast<BYTE>(patch._quadtreeLOD);
+		const UINT64 dist = static_cast<UINT32>(Math::Max(patch._distToHeadSq, 0));
+		_vSortKeys[i]._key = (lod << 32) | dist;
+		_vSortKeys[i]._index = _vSortedPatchIndices[i];
+	}
 
-			return patchA._distToHeadSq < patchB._distToHeadSq;
-		});
+	RadixSort::Sort(_vSortKeys, _vSortKeysTemp, _visibleSortedPatchCount);
+
+	VERUS_FOR(i, _visibleSortedPatchCount)
+		_vSortedPatchIndices[i] = static_cast<UINT16>(_vSortKeys[i]._index);
 	if (_visibleRandomPatchCount)
 		memcpy(&_vSortedPatchIndices[_visibleSortedPatchCount], _vRandomPatchIndices.data(), _visibleRandomPatchCount * sizeof(UINT16));
 }
@@ -782,8 +792,6 @@ void Terrain::Draw(RcDrawDesc dd)
 
 	auto cb = renderer.GetCommandBuffer();
 
-	VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(160, 255, 96, 255), "Terrain/Draw");
-
 	s_ubTerrainVS._matW = matW.UniformBufferFormat();
 	s_ubTerrainVS._matWV = Transform3(wm.GetPassCamera()->GetMatrixV() * matW).UniformBufferFormat();
 	s_ubTerrainVS._matV = wm.GetPassCamera()->GetMatrixV().UniformBufferFormat();
@@ -801,15 +809,11 @@ void Terrain::Draw(RcDrawDesc dd)
 	s_ubTerrainFS._lamScaleBias.x = _lamScale;
 	s_ubTerrainFS._lamScaleBias.y = _lamBias;
 
-	cb->BindVertexBuffers(_geo);
-	cb->BindIndexBuffer(_geo);
-
-	bool bindStrip = true;
-	const int half = _mapSide >> 1;
+	// Patches are drawn in runs with the same level of detail:
+	_vPatchRuns.clear();
 	int firstInstance = 0;
 	int edge = _visiblePatchCount - 1;
 	int lod = _vPatches[_vSortedPatchIndices.front()]._quadtreeLOD;
-	s_shader[SHADER_MAIN]->BeginBindDescriptors();
 	VERUS_FOR(i, _visiblePatchCount)
 	{
 		RcTerrainPatch patch = _vPatches[_vSortedPatchIndices[i]];
@@ -818,70 +822,95 @@ void Terrain::Draw(RcDrawDesc dd)
 			if (i == edge)
 				i++; // Drawing patches [firstInstance, i).
 
-			if (!lod)
-			{
-				const bool tess = dd._allowTess && settings._gpuTessellation;
-				if (dd._wireframe)
-					cb->BindPipeline(_pipe[PIPE_WIREFRAME_LIST]);
-				else if (drawingDepth)
-					cb->BindPipeline(_pipe[tess ? PIPE_DEPTH_TESS : PIPE_DEPTH_LIST]);
-				else
-					cb->BindPipeline(_pipe[tess ? PIPE_TESS : PIPE_LIST]);
-				cb->BindDescriptors(s_shader[SHADER_MAIN], 0, _cshVS);
-				cb->BindDescriptors(s_shader[SHADER_MAIN], 1, _cshFS);
-			}
-			else if (bindStrip)
-			{
-				bindStrip = false;
-				if (dd._wireframe)
-					cb->BindPipeline(_pipe[PIPE_WIREFRAME_STRIP]);
-				else if (drawingDepth)
-					cb->BindPipeline(_pipe[PIPE_DEPTH_STRIP]);
-				else
-					cb->BindPipeline(_pipe[PIPE_STRIP]);
-				cb->BindDescriptors(s_shader[SHADER_MAIN], 0, _cshVS);
-				cb->BindDescriptors(s_shader[SHADER_MAIN], 1, _cshFS);
-			}
+			PatchRun run;
+			run._begin = firstInstance;
+			run._end = i;
+			run._lod = lod;
+			_vPatchRuns.push_back(run);
 
-			const int instanceCount = i - firstInstance; // Drawing patches [firstInstance, i).
-			for (int inst = firstInstance; inst < i; ++inst)
+			lod = patch._quadtreeLOD;
+			firstInstance = i;
+		}
+	}
+
+	// Each part fills its own range of the instance buffer:
+	const int runCount = Utils::Cast32(_vPatchRuns.size());
+	const int partCount = renderer.GetParallelPartCount(runCount, 1);
+	const bool tess = dd._allowTess && settings._gpuTessellation;
+	s_shader[SHADER_MAIN]->BeginBindDescriptors();
+	renderer.RecordInParallel(partCount, [this, &dd, drawingDepth, tess, runCount, partCount](CGI::CommandBufferPtr cb, int part)
+		{
+			VERUS_PROFILER_BEGIN_EVENT(cb, VERUS_COLOR_RGBA(160, 255, 96, 255), "Terrain/Draw");
+
+			cb->BindVertexBuffers(_geo);
+			cb->BindIndexBuffer(_geo);
+
+			bool bindStrip = true;
+			const int half = _mapSide >> 1;
+			const int runBegin = runCount * part / partCount;
+			const int runEnd = runCount * (part + 1) / partCount;
+			for (int r = runBegin; r < runEnd; ++r)
 			{
-				const int at = _instanceCount + inst;
-				RcTerrainPatch patchToDraw = _vPatches[_vSortedPatchIndices[inst]];
-				_vInstanceBuffer[at]._posPatch[0] = patchToDraw._ijCoord[1] - half;
-				_vInstanceBuffer[at]._posPatch[1] = patchToDraw._patchHeight;
-				_vInstanceBuffer[at]._posPatch[2] = patchToDraw._ijCoord[0] - half;
-				_vInstanceBuffer[at]._posPatch[3] = 0;
-				VERUS_ZERO_MEM(_vInstanceBuffer[at]._layers);
-				if (dd._wireframe)
+				const PatchRun& run = _vPatchRuns[r];
+				if (!run._lod)
 				{
-					switch (patchToDraw._usedChannelCount)
-					{
-					case 1: _vInstanceBuffer[at]._layers[0] = 0; _vInstanceBuffer[at]._layers[1] = 0; _vInstanceBuffer[at]._layers[2] = 1; break;
-					case 2: _vInstanceBuffer[at]._layers[0] = 0; _vInstanceBuffer[at]._layers[1] = 1; _vInstanceBuffer[at]._layers[2] = 0; break;
-					case 3: _vInstanceBuffer[at]._layers[0] = 1; _vInstanceBuffer[at]._layers[1] = 1; _vInstanceBuffer[at]._layers[2] = 0; break;
-					case 4: _vInstanceBuffer[at]._layers[0] = 1; _vInstanceBuffer[at]._layers[1] = 0; _vInstanceBuffer[at]._layers[2] = 0; break;
-					}
+					if (dd._wireframe)
+						cb->BindPipeline(_pipe[PIPE_WIREFRAME_LIST]);
+					else if (drawingDepth)
+						cb->BindPipeline(_pipe[tess ? PIPE_DEPTH_TESS : PIPE_DEPTH_LIST]);
+					else
+						cb->BindPipeline(_pipe[tess ? PIPE_TESS : PIPE_LIST]);
+					cb->BindDescriptors(s_shader[SHADER_MAIN], 0, _cshVS);
+					cb->BindDescriptors(s_shader[SHADER_MAIN], 1, _cshFS);
 				}
-				else
+				else if (bindStrip)
 				{
-					VERUS_FOR(ch, 4)
-						_vInstanceBuffer[at]._layers[ch] = patchToDraw._layerForChannel[ch];
+					bindStrip = false;
+					if (dd._wireframe)
+						cb->BindPipeline(_pipe[PIPE_WIREFRAME_STRIP]);
+					else if (drawingDepth)
+						cb->BindPipeline(_pipe[PIPE_DEPTH_STRIP]);
+					else
+						cb->BindPipeline(_pipe[PIPE_STRIP]);
+					cb->BindDescriptors(s_shader[SHADER_MAIN], 0, _cshVS);
+					cb->BindDescriptors(s_shader[SHADER_MAIN], 1, _cshFS);
 				}
-			}
 
-			cb->DrawIndexed(_lods[lod]._indexCount, instanceCount, _lods[lod]._firstIndex, 0, _instanceCount + firstInstance);
+				for (int inst = run._begin; inst < run._end; ++inst)
+				{
+					const int at = _instanceCount + inst;
+					RcTerrainPatch patchToDraw = _vPatches[_vSortedPatchIndices[inst]];
+					_vInstanceBuffer[at]._posPatch[0] = patchToDraw._ijCoord[1] - half;
+					_vInstanceBuffer[at]._posPatch[1] = patchToDraw._patchHeight;
+					_vInstanceBuffer[at]._posPatch[2] = patchToDraw._ijCoord[0] - half;
+					_vInstanceBuffer[at]._posPatch[3] = 0;
+					VERUS_ZERO_MEM(_vInstanceBuffer[at]._layers);
+					if (dd._wireframe)
+					{
+						switch (patchToDraw._usedChannelCount)
+						{
+						case 1: _vInstanceBuffer[at]._layers[0] = 0; _vInstanceBuffer[at]._layers[1] = 0; _vInstanceBuffer[at]._layers[2] = 1; break;
+						case 2: _vInstanceBuffer[at]._layers[0] = 0; _vInstanceBuffer[at]._layers[1] = 1; _vInstanceBuffer[at]._layers[2] = 0; break;
+						case 3: _vInstanceBuffer[at]._layers[0] = 1; _vInstanceBuffer[at]._layers[1] = 1; _vInstanceBuffer[at]._layers[2] = 0; break;
+						case 4: _vInstanceBuffer[at]._layers[0] = 1; _vInstanceBuffer[at]._layers[1] = 0; _vInstanceBuffer[at]._layers[2] = 0; break;
+						}
+					}
+					else
+					{
+						VERUS_FOR(ch, 4)
+							_vInstanceBuffer[at]._layers[ch] = patchToDraw._layerForChannel[ch];
+					}
+				}
 
-			lod = patch._quadtreeLOD;
-			firstInstance = i;
-		}
-	}
+				cb->DrawIndexed(_lods[run._lod]._indexCount, run._end - run._begin, _lods[run._lod]._firstIndex, 0, _instanceCount + run._begin);
+			}
+
+			VERUS_PROFILER_END_EVENT(cb);
+		});
 	s_shader[SHADER_MAIN]->EndBindDescriptors();
 
 	_geo->UpdateVertexBuffer(&_vInstanceBuffer[_instanceCount], 1, cb.Get(), _visiblePatchCount, _instanceCount);
 	_instanceCount += _visiblePatchCount;
-
-	VERUS_PROFILER_END_EVENT(cb);
 }
 
 void Terrain::DrawSimple(DrawSimpleMode mode)
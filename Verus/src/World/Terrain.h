@@ -130,6 +130,14 @@ namespace verus::World
 			short _layers[4];
 		};
 
+		// Patches with the same level of detail, which are drawn with one call.
+		struct PatchRun
+		{
+			int _begin = 0;
+			int _end = 0;
+			int _lod = 0;
+		};
+
 		struct LayerData
 		{
 			float _detailStrength = 0.1f;
@@ -150,7 +158,10 @@ namespace verus::World
 		Vector<TerrainPatch::TBN>     _vPatchTBNs;
 		Vector<UINT16>                _vSortedPatchIndices;
 		Vector<UINT16>                _vRandomPatchIndices;
+		Vector<SortKey>               _vSortKeys;
+		Vector<SortKey>               _vSortKeysTemp;
 		Vector<PerInstanceData>       _vInstanceBuffer;
+		Vector<PatchRun>              _vPatchRuns;
 		Vector<String>                _vLayerUrls;
 		Vector<short>                 _vHeightBuffer;
 		Vector<half>                  _vHeightmapSubresData;
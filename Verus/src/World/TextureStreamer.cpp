@@ -0,0 +1,218 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#include "verus.h"
+
+using namespace verus;
+using namespace verus::World;
+
+TextureStreamer::TextureStreamer()
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	Done();
+}
+
+void TextureStreamer::Init()
+{
+	VERUS_INIT();
+	VERUS_QREF_CONST_SETTINGS;
+
+	_budget = static_cast<UINT64>(settings._gpuTextureStreamingBudget) << 20;
+	_vTextures.reserve(1000);
+	_vRequests.reserve(1000);
+}
+
+void TextureStreamer::Done()
+{
+	VERUS_DONE(TextureStreamer);
+}
+
+void TextureStreamer::Update()
+{
+	VERUS_UPDATE_ONCE_CHECK;
+
+	ProcessRequests();
+}
+
+void TextureStreamer::ProcessRequests()
+{
+	_stats = Stats();
+	_stats._budget = _budget;
+	_stats._textureCount = Utils::Cast32(_vTextures.size());
+	_stats._requestCount = Utils::Cast32(_vRequests.size());
+
+	_usedMemory = 0;
+	for (auto pTexture : _vTextures)
+		_usedMemory += pTexture->GetMemoryUsage();
+
+	_vEvictionCandidates.clear();
+	_nextEvictionCandidate = -1; // Prepare on demand.
+	_maxEvictedImportance = -FLT_MAX;
+
+	// Most important requests go first:
+	std::sort(_vRequests.begin(), _vRequests.end(), [](RcPartRequest a, RcPartRequest b)
+		{
+			return a._importance > b._importance;
+		});
+
+	int loadCount = 0;
+	for (const auto& request : _vRequests)
+	{
+		PStreamedTexture pTexture = request._pTexture;
+		if (pTexture->IsStreamingBusy()) // Could have been evicted by a more important request.
+			continue;
+
+		const int currentPart = pTexture->GetResidentPart();
+		const UINT64 currentSize = pTexture->GetMemoryUsage();
+
+		if (request._part >= currentPart) // Decrease texture? This will free some memory.
+		{
+			if (pTexture->IsLoadRequired(request._part)) // Smaller huge texture must be loaded?
+			{
+				if (loadCount >= _maxLoadsPerFrame)
+				{
+					_stats._deferredCount++;
+					continue;
+				}
+				loadCount++;
+			}
+			pTexture->LoadPart(request._part);
+			_usedMemory = _usedMemory - currentSize + pTexture->GetMemoryUsage();
+			continue;
+		}
+
+		// Increase texture:
+		if (loadCount >= _maxLoadsPerFrame)
+		{
+			_stats._deferredCount++;
+			continue;
+		}
+		if (request._importance <= _maxEvictedImportance) // Memory was freed for more important textures.
+		{
+			_stats._rejectedCount++;
+			continue;
+		}
+
+		// Find the largest part, which fits into the budget:
+		int part = request._part;
+		for (; part < currentPart; ++part)
+		{
+			const UINT64 newSize = pTexture->ComputeMemoryUsageForPart(part);
+			const UINT64 newUsedMemory = _usedMemory - currentSize + newSize;
+			if (newUsedMemory <= _budget)
+				break;
+			if (Evict(newUsedMemory - _budget, request._importance, pTexture) && _usedMemory - currentSize + newSize <= _budget)
+				break;
+		}
+		if (part >= currentPart)
+		{
+			_stats._rejectedCount++;
+			continue;
+		}
+
+		if (pTexture->IsLoadRequired(part))
+			loadCount++;
+		pTexture->LoadPart(part);
+		_usedMemory = _usedMemory - currentSize + pTexture->GetMemoryUsage();
+	}
+	_vRequests.clear();
+
+	// Budget could have been reduced, enforce it:
+	if (_usedMemory > _budget)
+		Evict(_usedMemory - _budget, FLT_MAX, nullptr, true);
+
+	_stats._usedMemory = _usedMemory;
+	_stats._loadCount = loadCount;
+	for (auto pTexture : _vTextures)
+	{
+		_stats._tinyMemory += pTexture->ComputeMemoryUsage(pTexture->GetMaxPart());
+		if (pTexture->HasHugeTex())
+			_stats._residentCount++;
+		if (pTexture->IsLoadingPart())
+			_stats._loadingCount++;
+	}
+}
+
+void TextureStreamer::Register(PStreamedTexture pTexture)
+{
+	_vTextures.push_back(pTexture);
+}
+
+void TextureStreamer::Unregister(PStreamedTexture pTexture)
+{
+	auto it = std::find(_vTextures.begin(), _vTextures.end(), pTexture);
+	if (it != _vTextures.end())
+	{
+		std::swap(*it, _vTextures.back());
+		_vTextures.pop_back();
+	}
+	_vRequests.erase(std::remove_if(_vRequests.begin(), _vRequests.end(), [pTexture](RcPartRequest request)
+		{
+			return request._pTexture == pTexture;
+		}), _vRequests.end());
+}
+
+void TextureStreamer::Request(PStreamedTexture pTexture, int part)
+{
+	PartRequest request;
+	request._pTexture = pTexture;
+	request._importance = pTexture->GetImportance();
+	request._part = part;
+	_vRequests.push_back(request);
+}
+
+void TextureStreamer::PrepareEvictionCandidates()
+{
+	_vEvictionCandidates.clear();
+	for (auto pTexture : _vTextures)
+	{
+		if (pTexture->HasHugeTex() && !pTexture->IsStreamingBusy())
+			_vEvictionCandidates.push_back(pTexture);
+	}
+	// Least important first:
+	std::sort(_vEvictionCandidates.begin(), _vEvictionCandidates.end(), [](PStreamedTexture pA, PStreamedTexture pB)
+		{
+			return pA->GetImportance() < pB->GetImportance();
+		});
+	_nextEvictionCandidate = 0;
+}
+
+UINT64 TextureStreamer::Evict(UINT64 size, float importance, PStreamedTexture pExcept, bool partial)
+{
+	if (_nextEvictionCandidate < 0)
+		PrepareEvictionCandidates();
+
+	// Only less important textures can be evicted:
+	const int candidateCount = Utils::Cast32(_vEvictionCandidates.size());
+	int end = _nextEvictionCandidate;
+	UINT64 evictableSize = 0;
+	for (; evictableSize < size && end < candidateCount; ++end)
+	{
+		PStreamedTexture pTexture = _vEvictionCandidates[end];
+		if (pTexture->GetImportance() >= importance)
+			break;
+		if (pTexture != pExcept && !pTexture->IsStreamingBusy())
+			evictableSize += pTexture->GetMemoryUsage();
+	}
+	if (evictableSize < size && !partial)
+		return 0; // Evicting would not help.
+
+	UINT64 freedSize = 0;
+	while (freedSize < size && _nextEvictionCandidate < end)
+	{
+		PStreamedTexture pTexture = _vEvictionCandidates[_nextEvictionCandidate];
+		_nextEvictionCandidate++;
+		if (pTexture == pExcept || pTexture->IsStreamingBusy())
+			continue;
+
+		const UINT64 currentSize = pTexture->GetMemoryUsage();
+		pTexture->LoadPart(pTexture->GetMaxPart()); // Use tiny texture.
+		const UINT64 newSize = pTexture->GetMemoryUsage();
+		freedSize += currentSize - newSize;
+		_usedMemory = _usedMemory - currentSize + newSize;
+		_maxEvictedImportance = Math::Max(_maxEvictedImportance, pTexture->GetImportance());
+		_stats._evictionCount++;
+	}
+	return freedSize;
+}
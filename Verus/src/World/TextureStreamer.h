@@ -0,0 +1,100 @@
+// Copyright (C) 2021-2022, Dmitry Maluev (dmaluev@gmail.com). All rights reserved.
+#pragma once
+
+namespace verus::World
+{
+	// What TextureStreamer needs to know about a texture with parts. Part 0 is the most detailed one.
+	// Implemented by Texture, BenchmarkTool uses synthetic textures.
+	class StreamedTexture
+	{
+	public:
+		virtual int GetMaxPart() const = 0; // Tiny texture.
+		virtual int GetResidentPart() const = 0;
+		virtual float GetImportance() const = 0;
+		virtual bool HasHugeTex() const = 0;
+		virtual bool IsLoadingPart() const = 0;
+		virtual bool IsStreamingBusy() const = 0;
+		virtual bool IsLoadRequired(int part) const = 0;
+		virtual void LoadPart(int part) = 0;
+		virtual UINT64 ComputeMemoryUsage(int part) const = 0;
+		virtual UINT64 ComputeMemoryUsageForPart(int part) const = 0;
+		virtual UINT64 GetMemoryUsage() const = 0;
+	};
+	VERUS_TYPEDEFS(StreamedTexture);
+
+	// Global manager for streamed textures (textures with parts).
+	// Each frame textures request the part they want. Requests are ranked by screen-space importance,
+	// loads are rate-limited and the total size of huge textures is kept within a memory budget.
+	// Less important textures are evicted (fall back to tiny texture) when the budget is exceeded.
+	class TextureStreamer : public Singleton<TextureStreamer>, public Object
+	{
+	public:
+		struct Stats
+		{
+			UINT64 _budget = 0;
+			UINT64 _usedMemory = 0; // Huge textures, including the ones being loaded.
+			UINT64 _tinyMemory = 0; // Tiny textures, always resident.
+			int    _textureCount = 0;
+			int    _residentCount = 0; // Textures with huge texture.
+			int    _loadingCount = 0;
+			int    _requestCount = 0;
+			int    _loadCount = 0;
+			int    _deferredCount = 0; // Requests postponed due to rate limit.
+			int    _rejectedCount = 0; // Requests which didn't fit into the budget.
+			int    _evictionCount = 0;
+		};
+		VERUS_TYPEDEFS(Stats);
+
+	private:
+		struct PartRequest
+		{
+			PStreamedTexture _pTexture = nullptr;
+			float            _importance = 0;
+			int              _part = 0;
+		};
+		VERUS_TYPEDEFS(PartRequest);
+
+		Vector<PStreamedTexture> _vTextures;
+		Vector<PartRequest>      _vRequests;
+		Vector<PStreamedTexture> _vEvictionCandidates;
+		Stats                    _stats;
+		UINT64                   _budget = 0;
+		UINT64                   _usedMemory = 0;
+		float                    _maxEvictedImportance = -FLT_MAX; // During this update.
+		int                      _maxLoadsPerFrame = 2;
+		int                      _mipChainHeadroom = 1;
+		int                      _nextEvictionCandidate = 0;
+
+	public:
+		TextureStreamer();
+		~TextureStreamer();
+
+		void Init();
+		void Done();
+
+		void Update();
+		void ProcessRequests(); // Update() without the frame check.
+
+		void Register(PStreamedTexture pTexture);
+		void Unregister(PStreamedTexture pTexture);
+		void Request(PStreamedTexture pTexture, int part);
+
+		UINT64 GetBudget() const { return _budget; }
+		void SetBudget(UINT64 budget) { _budget = budget; }
+		int GetMaxLoadsPerFrame() const { return _maxLoadsPerFrame; }
+		void SetMaxLoadsPerFrame(int count) { _maxLoadsPerFrame = Math::Max(count, 1); }
+
+		// Huge textures allocate extra mip levels for more detailed parts, which can be streamed in later without a new texture:
+		int GetMipChainHeadroom() const { return _mipChainHeadroom; }
+		void SetMipChainHeadroom(int partCount) { _mipChainHeadroom = Math::Max(partCount, 0); }
+		int ComputeMipChainPart(int part) const { return Math::Max(part - _mipChainHeadroom, 0); }
+
+		RcStats GetStats() const { return _stats; }
+
+	private:
+		void PrepareEvictionCandidates();
+		// Without partial nothing is evicted, unless the size can be freed:
+		UINT64 Evict(UINT64 size, float importance, PStreamedTexture pExcept, bool partial = false);
+	};
+	VERUS_TYPEDEFS(TextureStreamer);
+}
@@ -9,6 +9,7 @@ namespace verus
 		World::EditorOverlays::Make();
 		World::CascadedShadowMapBaker::Make();
 		World::ShadowMapBakerPool::Make();
+		World::TextureStreamer::Make();
 		World::MaterialManager::Make();
 		World::WorldManager::Make();
 		World::Atmosphere::Make();
@@ -22,6 +23,7 @@ namespace verus
 		World::Atmosphere::Free();
 		World::WorldManager::Free();
 		World::MaterialManager::Free();
+		World::TextureStreamer::Free();
 		World::ShadowMapBakerPool::Free();
 		World::CascadedShadowMapBaker::Free();
 		World::EditorOverlays::Free();
@@ -38,6 +38,16 @@ namespace verus::World
 		generated = (1 << 2)
 	};
 
+	enum class NodeEvent : int
+	{
+		deleted,
+		duplicated,
+		parentChanged,
+		rigidBodyTransformUpdated,
+		transformed,
+		count
+	};
+
 	class ShadowMapHandle : public BaseHandle<ShadowMapHandle>
 	{
 	public:
@@ -57,8 +67,11 @@ namespace verus::World
 #include "Terrain.h"
 #include "EditorTerrain.h"
 
+#include "TextureStreamer.h"
 #include "MaterialManager.h"
 #include "WorldNodes/WorldNodes.h"
+#include "LightGrid.h"
+#include "LightClusters.h"
 #include "WorldManager.h"
 
 #include "CubeMapBaker.h"
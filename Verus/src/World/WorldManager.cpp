@@ -41,6 +41,14 @@ void WorldManager::Init(RcDesc desc)
 	_octree.Init(bounds, limit);
 	_octree.SetDelegate(this);
 
+	_deferredTransformMode = settings._worldDeferredTransforms;
+
+	_lightGrid.Done();
+	_lightGrid.Init(_worldSide);
+	_lightClusters.Done();
+	_lightClusters.Init();
+	_vShadowReservedLightNodes.reserve(64);
+
 	_smbpDynamicMax = 0;
 	switch (settings._sceneShadowQuality)
 	{
@@ -61,6 +69,11 @@ void WorldManager::Done()
 {
 	DeleteAllNodes();
 
+	_lightClusters.Done();
+	_lightGrid.Done();
+	_vShadowReservedLightNodes.clear();
+	_vDirtyTransformNodes.clear();
+
 	_pPickingShape.Delete();
 
 	VERUS_DONE(WorldManager);
@@ -70,13 +83,14 @@ void WorldManager::ResetInstanceCount()
 {
 	for (auto& [key, value] : TStoreModelNodes::_map)
 		value.GetMesh().ResetInstanceCount();
-	for (auto& x : TStoreTerrainNodes::_list)
+	for (auto& x : TStoreTerrainNodes::_slotMap)
 		x.GetTerrain().ResetInstanceCount();
 }
 
 void WorldManager::Update()
 {
 	VERUS_UPDATE_ONCE_CHECK;
+	VERUS_PROFILER_ZONE("WorldManager/Update");
 	VERUS_QREF_RENDERER;
 
 	if (!_async_loaded)
@@ -94,11 +108,20 @@ void WorldManager::Update()
 			_async_loaded = true;
 	}
 
+	UpdateWorldChunks();
+
+	_lodStats = LODStats();
+	_clusterStats = ClusterStats();
+	_lightStats = LightStats();
+	_lightStats._lightCount = TStoreLightNodes::GetStoredCount();
+
 	const RcPoint3 headPos = _pHeadCamera->GetEyePosition();
 
 	VERUS_FOR(i, _vNodes.size()) // Must check size every loop iteration.
 		_vNodes[i]->Update(); // Can add/remove child nodes.
 
+	UpdateTransforms();
+
 	// <ShadowMaps>
 	_pSmbpStatic = nullptr;
 	if (_async_loaded)
@@ -106,37 +129,114 @@ void WorldManager::Update()
 		float minDistToLightSq = FLT_MAX;
 		const float lightsReserveShadowDistSq = _lightsReserveShadowDist * _lightsReserveShadowDist;
 		const float lightsFreeShadowDistSq = _lightsFreeShadowDist * _lightsFreeShadowDist;
-		for (auto& lightNode : TStoreLightNodes::_list)
+
+		// Only nearby lights can reserve shadow:
+		_lightGrid.ForEachNear(headPos, _lightsReserveShadowDist, [this, &headPos, lightsReserveShadowDistSq](PLightNode pLightNode)
+			{
+				if (pLightNode->CanReserveShadow())
+					return;
+				const float distSq = VMath::distSqr(pLightNode->GetPosition(), headPos);
+				if (distSq < lightsReserveShadowDistSq)
+				{
+					pLightNode->SetReserveShadowFlag(true);
+					_vShadowReservedLightNodes.push_back(pLightNode);
+				}
+			});
+
+		// Shadow map handle is required for static shadow map baker, so only lights with reserved shadow are checked:
+		VERUS_WHILE(Vector<PLightNode>, _vShadowReservedLightNodes, it)
 		{
-			const float distSq = VMath::distSqr(lightNode.GetPosition(), headPos);
-			if (distSq < lightsReserveShadowDistSq)
-				lightNode.SetReserveShadowFlag(true);
-			else if (distSq >= lightsFreeShadowDistSq)
-				lightNode.SetReserveShadowFlag(false); // Invalidates shadow map handle.
+			PLightNode pLightNode = *it;
+			const float distSq = VMath::distSqr(pLightNode->GetPosition(), headPos);
+			if (distSq >= lightsFreeShadowDistSq)
+			{
+				pLightNode->SetReserveShadowFlag(false); // Invalidates shadow map handle.
+				it = _vShadowReservedLightNodes.erase(it);
+				continue;
+			}
 
-			if (lightNode.CanBeSmbpStatic() && lightNode.GetDistToHeadSq() < minDistToLightSq)
+			if (pLightNode->CanBeSmbpStatic() && pLightNode->GetDistToHeadSq() < minDistToLightSq)
 			{
-				minDistToLightSq = lightNode.GetDistToHeadSq();
-				_pSmbpStatic = &lightNode;
+				minDistToLightSq = pLightNode->GetDistToHeadSq();
+				_pSmbpStatic = pLightNode;
 			}
+			++it;
 		}
 	}
 	// </ShadowMaps>
 }
 
+void WorldManager::SetDeferredTransformMode(bool deferred)
+{
+	if (_deferredTransformMode && !deferred)
+		UpdateTransforms();
+	_deferredTransformMode = deferred;
+}
+
+void WorldManager::AddDirtyTransformNode(PBaseNode pNode)
+{
+	const int depth = pNode->GetDepth();
+	if (_vDirtyTransformNodes.size() <= depth)
+		_vDirtyTransformNodes.resize(depth + 1);
+	_vDirtyTransformNodes[depth].push_back(pNode);
+}
+
+void WorldManager::RemoveDirtyTransformNode(PBaseNode pNode)
+{
+	for (auto& v : _vDirtyTransformNodes) // Depth could have changed.
+		v.erase(std::remove(v.begin(), v.end(), pNode), v.end());
+}
+
+void WorldManager::UpdateTransforms()
+{
+	const int parallelMinCount = 4096;
+
+	// Parents are processed before children, children are added to the next level:
+	for (int depth = 0; depth < _vDirtyTransformNodes.size(); ++depth)
+	{
+		const int count = Utils::Cast32(_vDirtyTransformNodes[depth].size());
+		if (!count)
+			continue;
+
+		// Global transforms of one level depend only on the previous level:
+		const bool parallel = count >= parallelMinCount;
+		if (parallel)
+		{
+			Parallel::For(0, count, [this, depth](int i)
+				{
+					PBaseNode pNode = _vDirtyTransformNodes[depth][i];
+					pNode->UpdateGlobalTransform(false);
+				}, 0, parallelMinCount / 4);
+		}
+
+		// Bounds, octree and events are not thread-safe:
+		int index = 0;
+		for (; index < _vDirtyTransformNodes[depth].size(); ++index)
+		{
+			PBaseNode pNode = _vDirtyTransformNodes[depth][index];
+			pNode->UpdateDeferredTransform(!parallel || index >= count);
+		}
+		auto& v = _vDirtyTransformNodes[depth];
+		v.erase(v.begin(), v.begin() + index);
+	}
+}
+
 void WorldManager::UpdateParts()
 {
 	const RcPoint3 headPos = _pHeadCamera->GetEyePosition();
-	for (auto& blockNode : TStoreBlockNodes::_list)
+	for (auto& blockNode : TStoreBlockNodes::_slotMap)
 	{
 		const float distSq = VMath::distSqr(blockNode.GetBounds().GetCenter(), headPos);
-		const float part = MaterialManager::ComputePart(distSq, blockNode.GetBounds().GetAverageSize() * 0.5f);
-		blockNode.GetMaterial()->IncludePart(part);
+		const float radius = blockNode.GetBounds().GetAverageSize() * 0.5f;
+		const float part = MaterialManager::ComputePart(distSq, radius);
+		const float importance = MaterialManager::ComputeImportance(distSq, radius);
+		blockNode.GetMaterial()->IncludePart(part, importance);
 	}
 }
 
 void WorldManager::Layout()
 {
+	VERUS_PROFILER_ZONE("WorldManager/Layout");
 	VERUS_QREF_ATMO;
 	VERUS_QREF_CONST_SETTINGS;
 
@@ -151,97 +251,113 @@ void WorldManager::Layout()
 
 	SortVisible();
 
-	for (auto& x : TStoreTerrainNodes::_list)
+	for (auto& x : TStoreTerrainNodes::_slotMap)
 		x.Layout();
 }
 
 void WorldManager::SortVisible()
 {
 	VERUS_RT_ASSERT(!_visibleCountPerType[+NodeType::unknown]);
-	std::sort(_vVisibleNodes.begin(), _vVisibleNodes.begin() + _visibleCount, [](PBaseNode pA, PBaseNode pB)
+	static_assert(+NodeType::count <= 32, "NodeType must fit into 5 bits.");
+
+	if (_vSortKeys.size() < _visibleCount)
+		_vSortKeys.resize(_visibleCount);
+
+	SelectLODs();
+
+	VERUS_FOR(i, _visibleCount)
+	{
+		PBaseNode pNode = _vVisibleNodes[i];
+		const NodeType type = pNode->GetType();
+		UINT64 group = 0;
+		switch (type)
 		{
-			// Sort by node type?
-			const NodeType typeA = pA->GetType();
-			const NodeType typeB = pB->GetType();
-			if (typeA != typeB)
-				return typeA < typeB;
+		case NodeType::ambient:
+		{
+			group = +static_cast<PAmbientNode>(pNode)->GetPriority();
+		}
+		break;
+		case NodeType::block:
+		{
+			PBlockNode pBlockNode = static_cast<PBlockNode>(pNode);
+			ModelNodePtr modelNode = pBlockNode->GetModelNode();
+			group = MakeBlockSortGroup(pBlockNode->GetMaterial(), modelNode ? modelNode->GetSortID() : USHRT_MAX, pBlockNode->GetLOD());
+		}
+		break;
+		case NodeType::light:
+		{
+			PLightNode pLightNode = static_cast<PLightNode>(pNode);
+			const UINT64 lightType = +pLightNode->GetLightType();
+			// Lights without shadow map have UINT16_MAX block index and go last:
+			const UINT64 shadowMapBlock = pLightNode->GetShadowMapHandle().GetBlockIndex() & USHRT_MAX;
+			group = (lightType << 16) | shadowMapBlock;
+		}
+		break;
+		}
 
-			// Both are ambient?
-			if (NodeType::ambient == typeA)
-			{
-				PAmbientNode pAmbientNodeA = static_cast<PAmbientNode>(pA);
-				PAmbientNode pAmbientNodeB = static_cast<PAmbientNode>(pB);
+		_vSortKeys[i]._key = MakeSortKey(type, group, pNode->GetDistToHeadSq());
+		_vSortKeys[i]._index = i;
+	}
 
-				if (pAmbientNodeA->GetPriority() != pAmbientNodeB->GetPriority())
-					return pAmbientNodeA->GetPriority() < pAmbientNodeB->GetPriority();
-			}
+	RadixSort::Sort(_vSortKeys, _vSortKeysTemp, _visibleCount);
 
-			// Both are blocks?
-			if (NodeType::block == typeA)
-			{
-				PBlockNode pBlockNodeA = static_cast<PBlockNode>(pA);
-				PBlockNode pBlockNodeB = static_cast<PBlockNode>(pB);
-				MaterialPtr materialA = pBlockNodeA->GetMaterial();
-				MaterialPtr materialB = pBlockNodeB->GetMaterial();
+	if (_vSortedNodes.size() < _visibleCount)
+		_vSortedNodes.resize(_visibleCount);
+	VERUS_FOR(i, _visibleCount)
+		_vSortedNodes[i] = _vVisibleNodes[_vSortKeys[i]._index];
+	std::copy(_vSortedNodes.begin(), _vSortedNodes.begin() + _visibleCount, _vVisibleNodes.begin());
+}
 
-				if (materialA && materialB) // A and B have materials, compare them.
-				{
-					const bool ab = *materialA < *materialB;
-					const bool ba = *materialB < *materialA;
-					if (ab || ba)
-						return ab;
-				}
-				else if (materialA) // A is with material, B is without, so A goes first.
-				{
-					return true;
-				}
-				else if (materialB) // A is without material, B is with, so B goes first.
-				{
-					return false;
-				}
+UINT64 WorldManager::MakeSortKey(NodeType type, UINT64 group, float distToHeadSq)
+{
+	// Draw same node types front-to-back:
+	const UINT64 depth = RadixSort::QuantizeFloat(distToHeadSq, 22);
+	return (static_cast<UINT64>(type) << 59) | (group << 22) | depth;
+}
 
-				// Equal materials or none have any material, compare models used:
-				ModelNodePtr modelNodeA = pBlockNodeA->GetModelNode();
-				ModelNodePtr modelNodeB = pBlockNodeB->GetModelNode();
-				if (modelNodeA != modelNodeB)
-					return modelNodeA < modelNodeB;
-			}
+UINT64 WorldManager::MakeBlockSortGroup(MaterialPtr material, int modelSortID, int lod)
+{
+	// Blocks without material go last:
+	const UINT64 blending = material ? +material->_blending : 0x7;
+	const UINT64 materialID = material ? material->GetSortID() : USHRT_MAX;
+	const UINT64 modelID = modelSortID & USHRT_MAX;
+	// Same level of detail can be drawn with one call:
+	return (blending << 34) | (materialID << 18) | (modelID << 2) | static_cast<UINT64>(lod);
+}
 
-			// Both are lights?
-			if (NodeType::light == typeA)
-			{
-				PLightNode pLightNodeA = static_cast<PLightNode>(pA);
-				PLightNode pLightNodeB = static_cast<PLightNode>(pB);
+void WorldManager::SelectLODs()
+{
+	VERUS_QREF_RENDERER;
 
-				const CGI::LightType lightTypeA = pLightNodeA->GetLightType();
-				const CGI::LightType lightTypeB = pLightNodeB->GetLightType();
-				if (lightTypeA != lightTypeB)
-					return lightTypeA < lightTypeB;
+	const auto t0 = std::chrono::steady_clock::now();
 
-				const UINT16 shadowMapBlockA = pLightNodeA->GetShadowMapHandle().GetBlockIndex();
-				const UINT16 shadowMapBlockB = pLightNodeB->GetShadowMapHandle().GetBlockIndex();
+	// Size in pixels is projected using head camera, so that all passes agree:
+	const float yFov = _pHeadCamera->GetYFov();
+	const float screenScale = (yFov > 0) ? renderer.GetScreenSwapChainHeight() / (2 * tan(yFov * 0.5f)) : 0;
+	const float zNear = _pHeadCamera->GetZNear();
+	const RcPoint3 headPos = _pHeadCamera->GetEyePosition();
+	const bool enabled = _lodPixelError > 0 && screenScale > 0;
 
-				// Similar to material comparison above:
-				if (shadowMapBlockA != UINT16_MAX && shadowMapBlockB != UINT16_MAX)
-				{
-					const bool ab = shadowMapBlockA < shadowMapBlockB;
-					const bool ba = shadowMapBlockB < shadowMapBlockA;
-					if (ab || ba)
-						return ab;
-				}
-				else if (shadowMapBlockA != UINT16_MAX)
-				{
-					return true;
-				}
-				else if (shadowMapBlockB != UINT16_MAX)
-				{
-					return false;
-				}
-			}
+	VERUS_FOR(i, _visibleCount)
+	{
+		PBaseNode pNode = _vVisibleNodes[i];
+		if (NodeType::block != pNode->GetType())
+			continue;
+		PBlockNode pBlockNode = static_cast<PBlockNode>(pNode);
+		int lod = 0;
+		ModelNodePtr modelNode = pBlockNode->GetModelNode();
+		if (enabled && modelNode && modelNode->IsLoaded() && modelNode->GetMesh().GetLODCount() > 1)
+		{
+			Math::RcBounds bounds = pBlockNode->GetBounds();
+			const float dist = Math::Max(zNear, VMath::dist(bounds.GetCenter(), headPos));
+			const float sizeInPixels = bounds.GetMaxSide() * screenScale / dist;
+			lod = modelNode->GetMesh().SelectLOD(sizeInPixels, _lodPixelError);
+		}
+		pBlockNode->SetLOD(lod);
+	}
 
-			// Draw same node types front-to-back:
-			return pA->GetDistToHeadSq() < pB->GetDistToHeadSq();
-		});
+	const auto t1 = std::chrono::steady_clock::now();
+	_lodStats._selectTime += std::chrono::duration<float, std::milli>(t1 - t0).count();
 }
 
 void WorldManager::Draw()
@@ -251,22 +367,42 @@ void WorldManager::Draw()
 
 	VERUS_QREF_RENDERER;
 
-	auto cb = renderer.GetCommandBuffer();
 	auto shader = Mesh::GetShader();
 
 	ModelNodePtr modelNode;
 	MaterialPtr material;
-	bool bindPipeline = true;
+	int lod = 0;
 
+	// Instance buffers are filled here, parts only record draw calls:
+	auto AddBatch = [this, &modelNode, &material, &lod](int firstClusterRange = 0, int clusterRangeCount = 0)
+	{
+		if (!modelNode)
+			return;
+		RMesh mesh = modelNode->GetMesh();
+		if (!mesh.IsInstanceBufferEmpty(true))
+		{
+			mesh.UpdateInstanceBuffer();
+			BlockBatch batch;
+			batch._modelNode = modelNode;
+			batch._material = material;
+			batch._lod = lod;
+			batch._firstInstance = mesh.GetMarkedInstance();
+			batch._instanceCount = mesh.GetInstanceCount(true);
+			batch._firstClusterRange = firstClusterRange;
+			batch._clusterRangeCount = clusterRangeCount;
+			_vBlockBatches.push_back(batch);
+		}
+	};
+
+	_vBlockBatches.clear();
+	_vBlockBatchClusterRanges.clear();
 	const int begin = FindOffsetFor(NodeType::block);
 	const int end = begin + _visibleCountPerType[+NodeType::block];
-	shader->BeginBindDescriptors();
 	for (int i = begin; i <= end; ++i)
 	{
 		if (i == end)
 		{
-			if (modelNode)
-				modelNode->Draw(cb); // Finish with this one.
+			AddBatch(); // Finish with this one.
 			break;
 		}
 
@@ -274,41 +410,94 @@ void WorldManager::Draw()
 		PBlockNode pBlockNode = static_cast<PBlockNode>(pNode);
 		ModelNodePtr nextModelNode = pBlockNode->GetModelNode();
 		MaterialPtr nextMaterial = pBlockNode->GetMaterial();
+		const int nextLOD = pBlockNode->GetLOD();
 
 		if (!nextModelNode->IsLoaded() || !nextMaterial->IsLoaded())
 			continue; // Not ready.
 
-		const bool changeModelNode = nextModelNode != modelNode;
-		const bool changeMaterial = nextMaterial != material;
-		if (changeModelNode || changeMaterial)
+		if (nextModelNode != modelNode || nextMaterial != material || nextLOD != lod)
 		{
-			if (modelNode)
-				modelNode->Draw(cb); // Finish with this one.
+			AddBatch(); // Finish with this one.
+			modelNode = nextModelNode;
+			material = nextMaterial;
+			lod = nextLOD;
+			modelNode->MarkInstance();
 		}
-		if (changeModelNode)
+
+		if (!lod && _clusterCulling && modelNode->GetMesh().HasClusters())
 		{
-			modelNode = nextModelNode;
+			AddBatch(); // Finish with previous instances.
 			modelNode->MarkInstance();
-			if (bindPipeline)
+			modelNode->PushInstance(pBlockNode->GetTransform(), pBlockNode->GetColor());
+			CullClusters(pBlockNode);
+			if (!_vClusterRanges.empty())
 			{
-				bindPipeline = false;
-				modelNode->BindPipeline(cb);
-				cb->BindDescriptors(shader, 0);
+				const int firstClusterRange = Utils::Cast32(_vBlockBatchClusterRanges.size());
+				_vBlockBatchClusterRanges.insert(_vBlockBatchClusterRanges.end(), _vClusterRanges.begin(), _vClusterRanges.end());
+				AddBatch(firstClusterRange, Utils::Cast32(_vClusterRanges.size()));
 			}
-			modelNode->BindGeo(cb);
-			cb->BindDescriptors(shader, 2);
-		}
-		if (changeMaterial)
-		{
 			modelNode->MarkInstance();
-			material = nextMaterial;
-			material->UpdateMeshUniformBuffer();
-			cb->BindDescriptors(shader, 1, material->GetComplexSetHandle());
 		}
-
-		if (modelNode)
+		else
+		{
 			modelNode->PushInstance(pBlockNode->GetTransform(), pBlockNode->GetColor());
+			_lodStats._triangleCount += modelNode->GetMesh().GetLODIndexCount(lod) / 3;
+		}
+		_lodStats._fullTriangleCount += modelNode->GetMesh().GetFaceCount();
+		_lodStats._instanceCount[lod]++;
 	}
+
+	Mesh::UB_View ubView;
+	Mesh::UpdateUniformBuffer_View(0, &ubView);
+
+	const int batchCount = Utils::Cast32(_vBlockBatches.size());
+	const int partCount = renderer.GetParallelPartCount(batchCount, 32);
+	shader->BeginBindDescriptors();
+	renderer.RecordInParallel(partCount, [this, shader, batchCount, partCount, &ubView](CGI::CommandBufferPtr cb, int part)
+		{
+			Mesh::UB_MeshVS ubMeshVS{};
+			Mesh::UB_MaterialFS ubMaterialFS{};
+			ModelNodePtr modelNode;
+			MaterialPtr material;
+			const int batchBegin = batchCount * part / partCount;
+			const int batchEnd = batchCount * (part + 1) / partCount;
+			for (int b = batchBegin; b < batchEnd; ++b)
+			{
+				RcBlockBatch batch = _vBlockBatches[b];
+				RMesh mesh = batch._modelNode->GetMesh();
+				if (batchBegin == b)
+				{
+					mesh.BindPipelineInstanced(cb, false);
+					cb->BindDescriptors(shader, 0, CGI::CSHandle(), &ubView);
+				}
+				if (batch._modelNode != modelNode)
+				{
+					modelNode = batch._modelNode;
+					mesh.BindGeo(cb);
+					mesh.UpdateUniformBuffer_MeshVS(&ubMeshVS);
+					cb->BindDescriptors(shader, 2, CGI::CSHandle(), &ubMeshVS);
+				}
+				if (batch._material != material)
+				{
+					material = batch._material;
+					material->UpdateMeshUniformBuffer(1, true, &ubMaterialFS);
+					cb->BindDescriptors(shader, 1, material->GetComplexSetHandle(), &ubMaterialFS);
+				}
+
+				if (batch._clusterRangeCount)
+				{
+					VERUS_FOR(r, batch._clusterRangeCount)
+					{
+						const auto& range = _vBlockBatchClusterRanges[batch._firstClusterRange + r];
+						cb->DrawIndexed(range._indexCount, batch._instanceCount, range._firstIndex, 0, batch._firstInstance);
+					}
+				}
+				else
+				{
+					cb->DrawIndexed(mesh.GetLODIndexCount(batch._lod), batch._instanceCount, mesh.GetLODFirstIndex(batch._lod), 0, batch._firstInstance);
+				}
+			}
+		});
 	shader->EndBindDescriptors();
 }
 
@@ -324,6 +513,7 @@ void WorldManager::DrawSimple(DrawSimpleMode mode)
 
 	ModelNodePtr modelNode;
 	MaterialPtr material;
+	int lod = 0;
 	bool bindPipeline = true;
 
 	const int begin = FindOffsetFor(NodeType::block);
@@ -334,7 +524,7 @@ void WorldManager::DrawSimple(DrawSimpleMode mode)
 		if (i == end)
 		{
 			if (modelNode)
-				modelNode->Draw(cb); // Finish with this one.
+				modelNode->Draw(cb, lod); // Finish with this one.
 			break;
 		}
 
@@ -342,16 +532,18 @@ void WorldManager::DrawSimple(DrawSimpleMode mode)
 		PBlockNode pBlockNode = static_cast<PBlockNode>(pNode);
 		ModelNodePtr nextModelNode = pBlockNode->GetModelNode();
 		MaterialPtr nextMaterial = pBlockNode->GetMaterial();
+		const int nextLOD = pBlockNode->GetLOD();
 
 		if (!nextModelNode->IsLoaded() || !nextMaterial->IsLoaded())
 			continue; // Not ready.
 
 		const bool changeModelNode = nextModelNode != modelNode;
 		const bool changeMaterial = nextMaterial != material;
-		if (changeModelNode || changeMaterial)
+		const bool changeLOD = nextLOD != lod;
+		if (changeModelNode || changeMaterial || changeLOD)
 		{
 			if (modelNode)
-				modelNode->Draw(cb); // Finish with this one.
+				modelNode->Draw(cb, lod); // Finish with this one.
 		}
 		if (changeModelNode)
 		{
@@ -373,16 +565,66 @@ void WorldManager::DrawSimple(DrawSimpleMode mode)
 			material->UpdateMeshUniformBufferSimple();
 			cb->BindDescriptors(shader, 1, material->GetComplexSetHandleSimple());
 		}
+		if (changeLOD)
+		{
+			modelNode->MarkInstance();
+			lod = nextLOD;
+		}
 
 		if (modelNode)
-			modelNode->PushInstance(pBlockNode->GetTransform(), pBlockNode->GetColor());
+		{
+			if (!lod && _clusterCulling && modelNode->GetMesh().HasClusters())
+			{
+				modelNode->Draw(cb, lod); // Finish with previous instances.
+				modelNode->MarkInstance();
+				modelNode->PushInstance(pBlockNode->GetTransform(), pBlockNode->GetColor());
+				CullClusters(pBlockNode);
+				modelNode->Draw(cb, _vClusterRanges);
+				modelNode->MarkInstance();
+			}
+			else
+			{
+				modelNode->PushInstance(pBlockNode->GetTransform(), pBlockNode->GetColor());
+				_lodStats._triangleCount += modelNode->GetMesh().GetLODIndexCount(lod) / 3;
+			}
+			_lodStats._fullTriangleCount += modelNode->GetMesh().GetFaceCount();
+			_lodStats._instanceCount[lod]++;
+		}
 	}
 	shader->EndBindDescriptors();
 }
 
+void WorldManager::CullClusters(PBlockNode pBlockNode)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+
+	ModelNodePtr modelNode = pBlockNode->GetModelNode();
+	RcMesh mesh = modelNode->GetMesh();
+	Math::RcFrustum frustum = _pPassCamera->GetFrustum();
+
+	// Backface culling needs a perspective view of the actual surface (shadow maps can use front faces):
+	const bool backface = _pPassCamera->GetYFov() > 0 && !IsDrawingDepth(DrawDepth::automatic);
+	const Point3 eyePos = _pPassCamera->GetEyePosition();
+	const bool testFrustum = Math::Relation::inside != frustum.ContainsAabb(pBlockNode->GetBounds());
+	const int visibleCount = mesh.CullClusters(pBlockNode->GetTransform(), frustum, backface ? &eyePos : nullptr, _vClusterRanges, testFrustum);
+
+	const auto t1 = std::chrono::steady_clock::now();
+
+	int drawnIndexCount = 0;
+	for (const auto& range : _vClusterRanges)
+		drawnIndexCount += range._indexCount;
+	_lodStats._triangleCount += drawnIndexCount / 3;
+	_clusterStats._blockCount++;
+	_clusterStats._clusterCount += mesh.GetClusterCount();
+	_clusterStats._visibleClusterCount += visibleCount;
+	_clusterStats._rangeCount += Utils::Cast32(_vClusterRanges.size());
+	_clusterStats._culledTriangleCount += (mesh.GetIndexCount() - drawnIndexCount) / 3;
+	_clusterStats._cullTime += std::chrono::duration<float, std::milli>(t1 - t0).count();
+}
+
 void WorldManager::DrawTerrainNodes(Terrain::RcDrawDesc dd)
 {
-	for (auto& x : TStoreTerrainNodes::_list)
+	for (auto& x : TStoreTerrainNodes::_slotMap)
 	{
 		if (!x.IsDisabled())
 			x.GetTerrain().Draw(dd);
@@ -391,7 +633,7 @@ void WorldManager::DrawTerrainNodes(Terrain::RcDrawDesc dd)
 
 void WorldManager::DrawTerrainNodesSimple(DrawSimpleMode mode)
 {
-	for (auto& x : TStoreTerrainNodes::_list)
+	for (auto& x : TStoreTerrainNodes::_slotMap)
 	{
 		if (!x.IsDisabled())
 			x.GetTerrain().DrawSimple(mode);
@@ -424,6 +666,12 @@ void WorldManager::DrawLights()
 			}
 		};
 
+	// Omni and spot lights, which are not in any cluster, don't affect visible pixels:
+	const bool useClusters = _pPassCamera->GetYFov() > 0;
+	if (useClusters)
+		BuildLightClusters();
+	int clusterLightIndex = 0;
+
 	const int begin = FindOffsetFor(NodeType::light);
 	const int end = begin + _visibleCountPerType[+NodeType::light];
 	for (int i = begin; i <= end; ++i)
@@ -437,6 +685,13 @@ void WorldManager::DrawLights()
 		PBaseNode pNode = _vVisibleNodes[i];
 		PLightNode pLightNode = static_cast<PLightNode>(pNode);
 		const CGI::LightType nextType = pLightNode->GetLightType();
+		if (useClusters && CGI::LightType::dir != nextType)
+		{
+			// Same order as in BuildLightClusters:
+			if (!_lightClusters.IsLightAssigned(clusterLightIndex++))
+				continue;
+			_lightStats._clusteredLightCount++;
+		}
 		const ShadowMapHandle nextShadowMapHandle = pLightNode->GetShadowMapHandle();
 
 		const bool changeType = nextType != type;
@@ -696,43 +951,79 @@ bool WorldManager::IsSmbpDynamic(PcLightNode pLightNode) const
 
 int WorldManager::GetInfluentialLightsAt(Math::RcSphere sphere, PLightNode lightNodes[], int maxLights, bool forShadow, bool incDir)
 {
+	const auto t0 = std::chrono::steady_clock::now();
+
 	int count = 0;
-	for (auto& lightNode : TStoreLightNodes::_list)
-	{
-		if (forShadow && !lightNode.CanBeSmbpDynamic())
-			continue;
-		if (!incDir && CGI::LightType::dir == lightNode.GetLightType())
-			continue;
-		const float influence = lightNode.GetInfluenceAt(sphere);
-		if (influence < 1)
-			continue; // This light is too weak.
-		if (count < maxLights)
+	int visitedCount = 0;
+	// Only lights, which are close enough, are checked:
+	_lightGrid.ForEachNear(sphere.GetCenter(), sphere.GetRadius(), [&](PLightNode pLightNode)
 		{
-			lightNodes[count++] = &lightNode;
-		}
-		else
-		{
-			float minInfluence = FLT_MAX;
-			int index = 0;
-			VERUS_FOR(i, maxLights)
+			visitedCount++;
+			if (forShadow && !pLightNode->CanBeSmbpDynamic())
+				return;
+			if (!incDir && CGI::LightType::dir == pLightNode->GetLightType())
+				return;
+			const float influence = pLightNode->GetInfluenceAt(sphere);
+			if (influence < 1)
+				return; // This light is too weak.
+			if (count < maxLights)
+			{
+				lightNodes[count++] = pLightNode;
+			}
+			else
 			{
-				if (lightNodes[i]->GetCachedInfluence() < minInfluence)
+				float minInfluence = FLT_MAX;
+				int index = 0;
+				VERUS_FOR(i, maxLights)
 				{
-					minInfluence = lightNodes[i]->GetCachedInfluence();
-					index = i;
+					if (lightNodes[i]->GetCachedInfluence() < minInfluence)
+					{
+						minInfluence = lightNodes[i]->GetCachedInfluence();
+						index = i;
+					}
 				}
+				if (influence > minInfluence)
+					lightNodes[index] = pLightNode; // Replace the weakest light.
 			}
-			if (influence > minInfluence)
-				lightNodes[index] = &lightNode; // Replace the weakest light.
-		}
-	}
+		});
 	std::sort(lightNodes, lightNodes + count, [](PLightNode pA, PLightNode pB)
 		{
 			return pA->GetCachedInfluence() > pB->GetCachedInfluence();
 		});
+
+	const auto t1 = std::chrono::steady_clock::now();
+	_lightStats._visitedLightCount += visitedCount;
+	_lightStats._queryCount++;
+	_lightStats._queryTime += std::chrono::duration<float, std::milli>(t1 - t0).count();
 	return count;
 }
 
+void WorldManager::BindLightNode(PLightNode pLightNode)
+{
+	_lightGrid.Update(pLightNode);
+}
+
+void WorldManager::UnbindLightNode(PLightNode pLightNode)
+{
+	_lightGrid.Remove(pLightNode);
+	auto it = std::find(_vShadowReservedLightNodes.begin(), _vShadowReservedLightNodes.end(), pLightNode);
+	if (it != _vShadowReservedLightNodes.end())
+		_vShadowReservedLightNodes.erase(it);
+	if (_pSmbpStatic == pLightNode)
+		_pSmbpStatic = nullptr;
+}
+
+void WorldManager::BuildLightClusters()
+{
+	// Visible lights are sorted by type, so they are stored together:
+	_vVisibleLightNodes.clear();
+	const int begin = FindOffsetFor(NodeType::light);
+	const int end = begin + _visibleCountPerType[+NodeType::light];
+	for (int i = begin; i < end; ++i)
+		_vVisibleLightNodes.push_back(static_cast<PLightNode>(_vVisibleNodes[i]));
+	_lightClusters.Build(*_pPassCamera, _vVisibleLightNodes.data(), static_cast<int>(_vVisibleLightNodes.size()));
+}
+
 void WorldManager::InfluentialLightsToSmbpDynamic(Math::RcSphere sphere)
 {
 	PLightNode newSmbpDynamic[VERUS_COUNT_OF(_pSmbpDynamic)];
@@ -1045,6 +1336,12 @@ int WorldManager::GetNodeCount(int* pPerType, bool excludeGenerated) const
 
 int WorldManager::GetIndexOf(PcBaseNode pTargetNode, bool excludeGenerated) const
 {
+	if (excludeGenerated && !_mapWorldChunkIndices.empty()) // Saving chunks?
+	{
+		auto it = _mapWorldChunkIndices.find(pTargetNode);
+		return (it != _mapWorldChunkIndices.end()) ? it->second : -1;
+	}
+
 	int offset = 0;
 	const int nodeCount = GetNodeCount();
 	VERUS_FOR(i, nodeCount)
@@ -1063,6 +1360,8 @@ int WorldManager::GetIndexOf(PcBaseNode pTargetNode, bool excludeGenerated) cons
 
 PBaseNode WorldManager::GetNodeByIndex(int index) const
 {
+	if (_worldChunkMapping) // Loading chunks?
+		return (index >= 0 && index < _vWorldChunkNodes.size()) ? _vWorldChunkNodes[index] : nullptr;
 	if (index >= 0 && index < _vNodes.size())
 		return _vNodes[index];
 	return nullptr;
@@ -1123,11 +1422,9 @@ void WorldManager::DeleteNode(NodeType type, CSZ name, bool hierarchy)
 		{
 			if (!hierarchy)
 			{
-				for (auto pNode : _vNodes)
-				{
-					if (pNode->GetParent() == &node)
-						pNode->SetParent(node.GetParent());
-				}
+				const Vector<PBaseNode> vChildren = node.GetChildren(); // Copy, SetParent() will change it.
+				for (auto pChildNode : vChildren)
+					pChildNode->SetParent(node.GetParent());
 			}
 
 			BroadcastOnNodeDeleted(&node, false, hierarchy);
@@ -1153,7 +1450,11 @@ void WorldManager::DeleteNode(NodeType type, CSZ name, bool hierarchy)
 			case NodeType::terrain:      TStoreTerrainNodes::Delete(static_cast<PTerrainNode>(&node)); break;
 			}
 			if (deleted)
+			{
 				std::replace(_vNodes.begin(), _vNodes.end(), &node, static_cast<PBaseNode>(nullptr));
+				if (!_vWorldChunkNodes.empty()) // Chunks can still reference this node.
+					std::replace(_vWorldChunkNodes.begin(), _vWorldChunkNodes.end(), &node, static_cast<PBaseNode>(nullptr));
+			}
 			BroadcastOnNodeDeleted(&node, true, hierarchy);
 			return Continue::no;
 		});
@@ -1805,45 +2106,132 @@ PTerrainNode WorldManager::InsertTerrainNode()
 	return p;
 }
 
+void WorldManager::SubscribeToNodeEvent(NodeEvent event, PBaseNode pNode)
+{
+	auto& v = _vEventSubscribers[+event];
+	if (std::find(v.begin(), v.end(), pNode) == v.end())
+		v.push_back(pNode);
+}
+
+void WorldManager::UnsubscribeFromNodeEvent(NodeEvent event, PBaseNode pNode)
+{
+	auto& v = _vEventSubscribers[+event];
+	v.erase(std::remove(v.begin(), v.end(), pNode), v.end());
+}
+
+bool WorldManager::IsSubscribedToNodeEvent(NodeEvent event, PcBaseNode pNode) const
+{
+	const auto& v = _vEventSubscribers[+event];
+	return std::find(v.begin(), v.end(), pNode) != v.end();
+}
+
+void WorldManager::UnsubscribeFromNodeEvents(PBaseNode pNode)
+{
+	VERUS_FOR(i, +NodeEvent::count)
+		UnsubscribeFromNodeEvent(static_cast<NodeEvent>(i), pNode);
+}
+
+PBaseNode WorldManager::InsertNode(NodeType type, CSZ url)
+{
+	switch (type)
+	{
+	case NodeType::base:         return InsertBaseNode();
+	case NodeType::model:        return InsertModelNode(url);
+	case NodeType::particles:    return InsertParticlesNode(url);
+	case NodeType::ambient:      return InsertAmbientNode();
+	case NodeType::block:        return InsertBlockNode();
+	case NodeType::blockChain:   return InsertBlockChainNode();
+	case NodeType::controlPoint: return InsertControlPointNode();
+	case NodeType::emitter:      return InsertEmitterNode();
+	case NodeType::instance:     return InsertInstanceNode();
+	case NodeType::light:        return InsertLightNode();
+	case NodeType::path:         return InsertPathNode();
+	case NodeType::physics:      return InsertPhysicsNode();
+	case NodeType::prefab:       return InsertPrefabNode();
+	case NodeType::project:      return InsertProjectNode();
+	case NodeType::shaker:       return InsertShakerNode();
+	case NodeType::sound:        return InsertSoundNode();
+	case NodeType::terrain:      return InsertTerrainNode();
+	}
+	return nullptr;
+}
+
 void WorldManager::BroadcastOnNodeDeleted(PBaseNode pTargetNode, bool afterEvent, bool hierarchy)
 {
-	for (auto pNode : _vNodes)
+	if (!afterEvent) // After this event the target node can already be destroyed.
 	{
-		if (pNode)
+		pTargetNode->OnNodeDeleted(pTargetNode, afterEvent, hierarchy);
+		const Vector<PBaseNode> vChildren = pTargetNode->GetChildren(); // Copy, children can be deleted.
+		for (auto pChildNode : vChildren)
+			pChildNode->OnNodeDeleted(pTargetNode, afterEvent, hierarchy);
+	}
+	const Vector<PBaseNode> vSubscribers = _vEventSubscribers[+NodeEvent::deleted];
+	for (auto pNode : vSubscribers)
+	{
+		if (pNode == pTargetNode || (!afterEvent && pNode->GetParent() == pTargetNode))
+			continue; // Already notified.
+		if (IsSubscribedToNodeEvent(NodeEvent::deleted, pNode)) // Still alive?
 			pNode->OnNodeDeleted(pTargetNode, afterEvent, hierarchy);
 	}
 }
 
 void WorldManager::BroadcastOnNodeDuplicated(PBaseNode pTargetNode, bool afterEvent, PBaseNode pDuplicatedNode, HierarchyDuplication hierarchyDuplication)
 {
-	const int nodeCount = GetNodeCount();
-	VERUS_FOR(i, nodeCount)
+	pTargetNode->OnNodeDuplicated(pTargetNode, afterEvent, pDuplicatedNode, hierarchyDuplication);
+	const Vector<PBaseNode> vChildren = pTargetNode->GetChildren(); // Copy, duplicates are added to the same parent.
+	for (auto pChildNode : vChildren)
+		pChildNode->OnNodeDuplicated(pTargetNode, afterEvent, pDuplicatedNode, hierarchyDuplication);
+	const Vector<PBaseNode> vSubscribers = _vEventSubscribers[+NodeEvent::duplicated];
+	for (auto pNode : vSubscribers)
 	{
-		PBaseNode pNode = _vNodes[i];
-		pNode->OnNodeDuplicated(pTargetNode, afterEvent, pDuplicatedNode, hierarchyDuplication);
+		if (pNode != pTargetNode && pNode->GetParent() != pTargetNode)
+			pNode->OnNodeDuplicated(pTargetNode, afterEvent, pDuplicatedNode, hierarchyDuplication);
 	}
 }
 
 void WorldManager::BroadcastOnNodeParentChanged(PBaseNode pTargetNode, bool afterEvent)
 {
-	for (auto pNode : _vNodes)
-		pNode->OnNodeParentChanged(pTargetNode, afterEvent);
+	pTargetNode->OnNodeParentChanged(pTargetNode, afterEvent);
+	const auto& vChildren = pTargetNode->GetChildren();
+	VERUS_FOR(i, vChildren.size())
+		vChildren[i]->OnNodeParentChanged(pTargetNode, afterEvent);
+	for (auto pNode : _vEventSubscribers[+NodeEvent::parentChanged])
+	{
+		if (pNode != pTargetNode && pNode->GetParent() != pTargetNode)
+			pNode->OnNodeParentChanged(pTargetNode, afterEvent);
+	}
 }
 
 void WorldManager::BroadcastOnNodeRigidBodyTransformUpdated(PBaseNode pTargetNode, bool afterEvent)
 {
-	for (auto pNode : _vNodes)
-		pNode->OnNodeRigidBodyTransformUpdated(pTargetNode, afterEvent);
+	pTargetNode->OnNodeRigidBodyTransformUpdated(pTargetNode, afterEvent);
+	const auto& vChildren = pTargetNode->GetChildren();
+	VERUS_FOR(i, vChildren.size())
+		vChildren[i]->OnNodeRigidBodyTransformUpdated(pTargetNode, afterEvent);
+	for (auto pNode : _vEventSubscribers[+NodeEvent::rigidBodyTransformUpdated])
+	{
+		if (pNode != pTargetNode && pNode->GetParent() != pTargetNode)
+			pNode->OnNodeRigidBodyTransformUpdated(pTargetNode, afterEvent);
+	}
 }
 
 void WorldManager::BroadcastOnNodeTransformed(PBaseNode pTargetNode, bool afterEvent)
 {
-	for (auto pNode : _vNodes)
-		pNode->OnNodeTransformed(pTargetNode, afterEvent);
+	pTargetNode->OnNodeTransformed(pTargetNode, afterEvent);
+	const auto& vChildren = pTargetNode->GetChildren();
+	VERUS_FOR(i, vChildren.size())
+		vChildren[i]->OnNodeTransformed(pTargetNode, afterEvent);
+	for (auto pNode : _vEventSubscribers[+NodeEvent::transformed])
+	{
+		if (pNode != pTargetNode && pNode->GetParent() != pTargetNode)
+			pNode->OnNodeTransformed(pTargetNode, afterEvent);
+	}
 }
 
 void WorldManager::Serialize(IO::RSeekableStream stream)
 {
+	LoadAllWorldChunks(); // Nodes from pending chunks must not be lost.
+
 	stream.WriteText(VERUS_CRNL VERUS_CRNL "<WM>");
 	stream.BeginBlock();
 
@@ -1851,7 +2239,7 @@ void WorldManager::Serialize(IO::RSeekableStream stream)
 
 	stream.WriteString(_C(std::to_string(GetNodeCount(nullptr, true))));
 
-	for (auto& shakerNode : TStoreShakerNodes::_list)
+	for (auto& shakerNode : TStoreShakerNodes::_slotMap)
 		shakerNode.ApplyInitialValue();
 
 	for (auto pNode : _vNodes)
@@ -1937,7 +2325,7 @@ void WorldManager::Deserialize(IO::RStream stream)
 
 	for (auto pNode : _vNodes)
 		pNode->OnAllNodesDeserialized();
-	for (auto& prefabNode : TStorePrefabNodes::_list)
+	for (auto& prefabNode : TStorePrefabNodes::_slotMap)
 		UpdatePrefabInstances(&prefabNode, false);
 	SortNodes();
 }
@@ -2011,6 +2399,442 @@ void WorldManager::Deserialize_LegacyXXX(IO::RStream stream)
 	SortNodes();
 }
 
+void WorldManager::SerializeChunks(IO::RSeekableStream stream)
+{
+	LoadAllWorldChunks(); // Nodes from pending chunks must not be lost.
+
+	stream.WriteText(VERUS_CRNL VERUS_CRNL "<WC>");
+	stream.BeginBlock();
+
+	for (auto& shakerNode : TStoreShakerNodes::_slotMap)
+		shakerNode.ApplyInitialValue();
+
+	// Nodes are sorted, so each hierarchy is a continuous range, which goes to one chunk:
+	Map<int, Vector<PBaseNode>> mapChunks; // Global chunk has key -1.
+	mapChunks[-1];
+	const float worldHalf = _worldSide * 0.5f;
+	const int cellCount = Math::Max(1, static_cast<int>(ceil(_worldSide / _worldChunkSide)));
+	const int nodeCount = GetNodeCount();
+	int rootIndex = 0;
+	while (rootIndex < nodeCount)
+	{
+		PBaseNode pRootNode = _vNodes[rootIndex];
+		int endIndex = rootIndex + 1;
+		while (endIndex < nodeCount && _vNodes[endIndex]->GetDepth() > pRootNode->GetDepth())
+			endIndex++;
+
+		bool chunkable = true;
+		for (int i = rootIndex; i < endIndex && chunkable; ++i)
+			chunkable = IsChunkableNodeType(_vNodes[i]->GetType());
+
+		int key = -1;
+		if (chunkable)
+		{
+			const Point3 pos = pRootNode->GetPosition();
+			const int x = Math::Clamp(static_cast<int>((pos.getX() + worldHalf) / _worldChunkSide), 0, cellCount - 1);
+			const int z = Math::Clamp(static_cast<int>((pos.getZ() + worldHalf) / _worldChunkSide), 0, cellCount - 1);
+			key = z * cellCount + x;
+		}
+
+		auto& vChunkNodes = mapChunks[key];
+		for (int i = rootIndex; i < endIndex; ++i)
+		{
+			if (!_vNodes[i]->IsGenerated())
+				vChunkNodes.push_back(_vNodes[i]);
+		}
+		rootIndex = endIndex;
+	}
+
+	// File index is used for references between nodes:
+	int fileIndex = 0;
+	for (const auto& [key, vChunkNodes] : mapChunks)
+	{
+		for (auto pNode : vChunkNodes)
+			_mapWorldChunkIndices[pNode] = fileIndex++;
+	}
+
+	Vector<WorldChunk> vChunks;
+	Vector<Vector<BYTE>> vChunkData;
+	vChunks.reserve(mapChunks.size());
+	vChunkData.reserve(mapChunks.size());
+	fileIndex = 0;
+	for (const auto& [key, vChunkNodes] : mapChunks)
+	{
+		if (vChunkNodes.empty() && key >= 0)
+			continue;
+		WorldChunk chunk;
+		chunk._firstNode = fileIndex;
+		chunk._nodeCount = Utils::Cast32(vChunkNodes.size());
+		IO::MemoryStream ms;
+		ms.SetVersion(stream.GetVersion());
+		for (auto pNode : vChunkNodes)
+		{
+			ms << NodeTypeToHash(pNode->GetType());
+			switch (pNode->GetType())
+			{
+			case NodeType::model:     ms.WriteString(_C(static_cast<PModelNode>(pNode)->GetURL())); break;
+			case NodeType::particles: ms.WriteString(_C(static_cast<PParticlesNode>(pNode)->GetURL())); break;
+			}
+			pNode->Serialize(ms);
+			if (key >= 0)
+				chunk._bounds.CombineWith(pNode->GetBounds());
+		}
+		fileIndex += chunk._nodeCount;
+		chunk._uncompressedSize = ms.GetSize();
+		vChunks.push_back(chunk);
+		vChunkData.push_back(std::move(ms.GetData()));
+	}
+	_mapWorldChunkIndices.clear();
+
+	// Chunks are independent, compress them in parallel:
+	const int chunkCount = Utils::Cast32(vChunks.size());
+	Vector<Vector<BYTE>> vZip(chunkCount);
+	Vector<int> vRet(chunkCount);
+	Parallel::For(0, chunkCount, [&vChunkData, &vZip, &vRet](int i)
+		{
+			uLongf destLen = compressBound(static_cast<uLong>(vChunkData[i].size()));
+			vZip[i].resize(destLen);
+			vRet[i] = compress2(vZip[i].data(), &destLen, vChunkData[i].data(), static_cast<uLong>(vChunkData[i].size()), Z_DEFAULT_COMPRESSION);
+			vZip[i].resize(destLen);
+		});
+	for (int ret : vRet)
+	{
+		if (Z_OK != ret)
+			throw VERUS_RUNTIME_ERROR << "compress2(); " << ret;
+	}
+
+	// Header:
+	stream << _worldSide;
+	stream << fileIndex;
+	stream << chunkCount;
+	INT64 offset = 0;
+	VERUS_FOR(i, chunkCount)
+	{
+		RWorldChunk chunk = vChunks[i];
+		chunk._offset = offset;
+		chunk._size = vZip[i].size();
+		offset += chunk._size;
+		stream << chunk._bounds.GetMin().GLM();
+		stream << chunk._bounds.GetMax().GLM();
+		stream << chunk._offset;
+		stream << chunk._size;
+		stream << chunk._uncompressedSize;
+		stream << chunk._firstNode;
+		stream << chunk._nodeCount;
+	}
+
+	// Data:
+	for (const auto& v : vZip)
+		stream.Write(v.data(), v.size());
+
+	stream.EndBlock();
+}
+
+void WorldManager::DeserializeChunks(IO::RStream stream)
+{
+	int worldSide = 0;
+	int nodeCount = 0;
+	int chunkCount = 0;
+	stream >> worldSide;
+	stream >> nodeCount;
+	stream >> chunkCount;
+
+	Desc desc;
+	desc._worldSide = worldSide;
+	PCamera     pPassCamera = _pPassCamera;
+	PMainCamera pHeadCamera = _pHeadCamera;
+	PMainCamera pViewCamera = _pViewCamera;
+	const float worldChunkSide = _worldChunkSide;
+	const float worldChunkLoadDist = _worldChunkLoadDist;
+	const float worldChunkTimeBudget = _worldChunkTimeBudget;
+	const bool lazyWorldChunks = _lazyWorldChunks;
+	Done();
+	Init(desc);
+	_pPassCamera = pPassCamera;
+	_pHeadCamera = pHeadCamera;
+	_pViewCamera = pViewCamera;
+	_worldChunkSide = worldChunkSide;
+	_worldChunkLoadDist = worldChunkLoadDist;
+	_worldChunkTimeBudget = worldChunkTimeBudget;
+	_lazyWorldChunks = lazyWorldChunks;
+
+	_worldChunkVersion = stream.GetVersion();
+	_vWorldChunks.resize(chunkCount);
+	INT64 dataSize = 0;
+	for (auto& chunk : _vWorldChunks)
+	{
+		glm::vec3 mn, mx;
+		stream >> mn;
+		stream >> mx;
+		if (mn.x <= mx.x)
+			chunk._bounds.Set(Point3(mn), Point3(mx));
+		stream >> chunk._offset;
+		stream >> chunk._size;
+		stream >> chunk._uncompressedSize;
+		stream >> chunk._firstNode;
+		stream >> chunk._nodeCount;
+		dataSize = Math::Max(dataSize, chunk._offset + chunk._size);
+	}
+	_vWorldChunkData.resize(dataSize);
+	stream.Read(_vWorldChunkData.data(), dataSize);
+	_vWorldChunkNodes.resize(nodeCount);
+
+	// Global chunk and nearby chunks are loaded now, other chunks will be loaded by UpdateWorldChunks():
+	VERUS_QREF_WU;
+	const bool lazy = _lazyWorldChunks && _pHeadCamera && !wu.IsEditorMode();
+	Vector<int> vIndices;
+	vIndices.reserve(chunkCount);
+	VERUS_FOR(i, chunkCount)
+	{
+		if (!i || !lazy || IsWorldChunkNear(i))
+			vIndices.push_back(i);
+	}
+	LoadWorldChunks(vIndices);
+}
+
+void WorldManager::UpdateWorldChunks()
+{
+	if (_vWorldChunkNodes.empty())
+		return; // Everything is loaded.
+
+	// Nodes are created until the time budget is used, large chunks take several frames:
+	const auto deadline = std::chrono::high_resolution_clock::now() +
+		std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<float, std::milli>(_worldChunkTimeBudget));
+	do
+	{
+		if (_lazyWorldChunk < 0 && !BeginLazyWorldChunk())
+			break; // No near chunks.
+		ContinueLazyWorldChunk(deadline);
+	} while (!_vWorldChunkNodes.empty() && std::chrono::high_resolution_clock::now() < deadline);
+}
+
+void WorldManager::LoadAllWorldChunks()
+{
+	Vector<int> vIndices;
+	VERUS_FOR(i, _vWorldChunks.size())
+		vIndices.push_back(i);
+	LoadWorldChunks(vIndices);
+}
+
+int WorldManager::GetPendingWorldChunkCount() const
+{
+	return Utils::Cast32(std::count_if(_vWorldChunks.begin(), _vWorldChunks.end(), [](RcWorldChunk chunk)
+		{
+			return !chunk._loaded;
+		}));
+}
+
+void WorldManager::LoadWorldChunks(const Vector<int>& vIndices)
+{
+	if (_lazyWorldChunk >= 0) // Finish partially loaded chunk first.
+	{
+		ContinueLazyWorldChunk(std::chrono::high_resolution_clock::time_point::max());
+		if (_vWorldChunks.empty())
+			return; // That was the last one.
+	}
+
+	Vector<int> vLoad;
+	vLoad.reserve(vIndices.size());
+	for (int index : vIndices)
+	{
+		if (!_vWorldChunks[index]._loaded)
+			vLoad.push_back(index);
+	}
+	if (vLoad.empty())
+		return;
+	const int count = Utils::Cast32(vLoad.size());
+
+	// Decompress in parallel, nodes must be created on this thread:
+	Vector<Vector<BYTE>> vData(count);
+	Vector<int> vRet(count);
+	Parallel::For(0, count, [this, &vLoad, &vData, &vRet](int i)
+		{
+			vRet[i] = DecompressWorldChunk(vLoad[i], vData[i]);
+		});
+	for (int ret : vRet)
+	{
+		if (Z_OK != ret)
+			throw VERUS_RUNTIME_ERROR << "uncompress(); " << ret;
+	}
+
+	_recursionDepth++; // Disable sorting.
+	_worldChunkMapping = true;
+
+	bool globalChunk = false;
+	VERUS_FOR(i, count)
+	{
+		RWorldChunk chunk = _vWorldChunks[vLoad[i]];
+		IO::StreamPtr sp(Blob(vData[i].data(), vData[i].size()));
+		sp.SetVersion(_worldChunkVersion);
+		VERUS_FOR(j, chunk._nodeCount)
+			LoadWorldChunkNode(sp, chunk._firstNode + j);
+		chunk._loaded = true;
+		if (!vLoad[i])
+			globalChunk = true;
+	}
+
+	_worldChunkMapping = false;
+	_recursionDepth--; // Enable sorting.
+	SortNodes();
+
+	OnWorldChunksLoaded(vLoad, globalChunk);
+}
+
+int WorldManager::DecompressWorldChunk(int index, Vector<BYTE>& vData) const
+{
+	RcWorldChunk chunk = _vWorldChunks[index];
+	vData.resize(chunk._uncompressedSize);
+	uLongf destLen = static_cast<uLongf>(chunk._uncompressedSize);
+	return uncompress(vData.data(), &destLen, _vWorldChunkData.data() + chunk._offset, static_cast<uLong>(chunk._size));
+}
+
+void WorldManager::LoadWorldChunkNode(IO::RStream stream, int fileIndex)
+{
+	char buffer[IO::Stream::s_bufferSize] = {};
+	UINT32 hash = 0;
+	stream >> hash;
+	const NodeType type = HashToNodeType(hash);
+	if (NodeType::model == type || NodeType::particles == type)
+		stream.ReadString(buffer);
+	PBaseNode pNode = InsertNode(type, buffer);
+	if (!pNode)
+		throw VERUS_RUNTIME_ERROR << "LoadWorldChunkNode(); Invalid node type hash: " << hash;
+	_vWorldChunkNodes[fileIndex] = pNode;
+	pNode->Deserialize(stream);
+}
+
+void WorldManager::OnWorldChunksLoaded(const Vector<int>& vIndices, bool globalChunk)
+{
+	_worldChunkMapping = true;
+	Vector<PPrefabNode> vPrefabNodes;
+	for (int index : vIndices)
+	{
+		RcWorldChunk chunk = _vWorldChunks[index];
+		VERUS_FOR(i, chunk._nodeCount)
+		{
+			PBaseNode pNode = _vWorldChunkNodes[chunk._firstNode + i];
+			if (!pNode)
+				continue;
+			pNode->OnAllNodesDeserialized();
+			if (!globalChunk && NodeType::instance == pNode->GetType())
+			{
+				PPrefabNode pPrefabNode = static_cast<PPrefabNode>(static_cast<PInstanceNode>(pNode)->GetPrefabNode());
+				if (pPrefabNode && std::find(vPrefabNodes.begin(), vPrefabNodes.end(), pPrefabNode) == vPrefabNodes.end())
+					vPrefabNodes.push_back(pPrefabNode);
+			}
+		}
+	}
+	_worldChunkMapping = false;
+
+	if (globalChunk)
+	{
+		for (auto& prefabNode : TStorePrefabNodes::_slotMap)
+			UpdatePrefabInstances(&prefabNode, false);
+	}
+	else
+	{
+		for (auto pPrefabNode : vPrefabNodes)
+			UpdatePrefabInstances(pPrefabNode, false);
+	}
+	SortNodes();
+
+	if (!GetPendingWorldChunkCount()) // Free memory:
+	{
+		_vWorldChunks.clear();
+		_vWorldChunkData.clear();
+		_vWorldChunkData.shrink_to_fit();
+		_vWorldChunkNodes.clear();
+		_vWorldChunkNodes.shrink_to_fit();
+	}
+}
+
+bool WorldManager::BeginLazyWorldChunk()
+{
+	const int chunkCount = Utils::Cast32(_vWorldChunks.size());
+	VERUS_FOR(i, chunkCount)
+	{
+		if (!_vWorldChunks[i]._loaded && IsWorldChunkNear(i))
+		{
+			const int ret = DecompressWorldChunk(i, _vLazyWorldChunkData);
+			if (Z_OK != ret)
+				throw VERUS_RUNTIME_ERROR << "uncompress(); " << ret;
+			_lazyWorldChunk = i;
+			_lazyWorldChunkNode = 0;
+			_lazyWorldChunkOffset = 0;
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorldManager::ContinueLazyWorldChunk(std::chrono::high_resolution_clock::time_point deadline)
+{
+	RWorldChunk chunk = _vWorldChunks[_lazyWorldChunk];
+	IO::StreamPtr sp(Blob(_vLazyWorldChunkData.data(), _vLazyWorldChunkData.size()));
+	sp.SetVersion(_worldChunkVersion);
+	sp.Advance(_lazyWorldChunkOffset);
+
+	_recursionDepth++; // Disable sorting.
+	_worldChunkMapping = true;
+
+	// Parents are stored before their children, so hierarchies are linked even if a chunk is split:
+	while (_lazyWorldChunkNode < chunk._nodeCount)
+	{
+		LoadWorldChunkNode(sp, chunk._firstNode + _lazyWorldChunkNode);
+		_lazyWorldChunkNode++;
+		if (std::chrono::high_resolution_clock::now() >= deadline)
+			break;
+	}
+	_lazyWorldChunkOffset = sp.GetOffset();
+
+	_worldChunkMapping = false;
+	_recursionDepth--; // Enable sorting.
+	SortNodes();
+
+	if (_lazyWorldChunkNode < chunk._nodeCount)
+		return; // Continue in the next frame.
+
+	Vector<int> vIndices;
+	vIndices.push_back(_lazyWorldChunk);
+	chunk._loaded = true;
+	_lazyWorldChunk = -1;
+	_vLazyWorldChunkData.clear();
+	_vLazyWorldChunkData.shrink_to_fit();
+	OnWorldChunksLoaded(vIndices, false);
+}
+
+bool WorldManager::IsWorldChunkNear(int index) const
+{
+	RcWorldChunk chunk = _vWorldChunks[index];
+	if (chunk._bounds.IsNull() || !_pHeadCamera)
+		return true;
+	const RcPoint3 headPos = _pHeadCamera->GetEyePosition();
+	const Point3 closestPos = VMath::minPerElem(VMath::maxPerElem(headPos, chunk._bounds.GetMin()), chunk._bounds.GetMax());
+	return VMath::distSqr(headPos, closestPos) <= _worldChunkLoadDist * _worldChunkLoadDist;
+}
+
+bool WorldManager::IsChunkableNodeType(NodeType type)
+{
+	switch (type)
+	{
+	case NodeType::ambient:
+	case NodeType::base:
+	case NodeType::block:
+	case NodeType::blockChain:
+	case NodeType::controlPoint:
+	case NodeType::emitter:
+	case NodeType::instance:
+	case NodeType::light:
+	case NodeType::path:
+	case NodeType::physics:
+	case NodeType::project:
+	case NodeType::shaker:
+	case NodeType::sound:
+		return true;
+	}
+	return false; // Models, particles, prefabs and terrain can be referenced from any chunk.
+}
+
 UINT32 WorldManager::NodeTypeToHash(NodeType type)
 {
 	switch (type)
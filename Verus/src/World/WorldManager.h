@@ -10,21 +10,21 @@ namespace verus::World
 	// * this is prettier than *this.
 	typedef StoreUnique<String, ModelNode> TStoreModelNodes;
 	typedef StoreUnique<String, ParticlesNode> TStoreParticlesNodes;
-	typedef Store<BaseNode> TStoreBaseNodes;
-	typedef Store<AmbientNode> TStoreAmbientNodes;
-	typedef Store<BlockNode> TStoreBlockNodes;
-	typedef Store<BlockChainNode> TStoreBlockChainNodes;
-	typedef Store<ControlPointNode> TStoreControlPointNodes;
-	typedef Store<EmitterNode> TStoreEmitterNodes;
-	typedef Store<InstanceNode> TStoreInstanceNodes;
-	typedef Store<LightNode> TStoreLightNodes;
-	typedef Store<PathNode> TStorePathNodes;
-	typedef Store<PhysicsNode> TStorePhysicsNodes;
-	typedef Store<PrefabNode> TStorePrefabNodes;
-	typedef Store<ProjectNode> TStoreProjectNodes;
-	typedef Store<ShakerNode> TStoreShakerNodes;
-	typedef Store<SoundNode> TStoreSoundNodes;
-	typedef Store<TerrainNode> TStoreTerrainNodes;
+	typedef StoreSlotMap<BaseNode> TStoreBaseNodes;
+	typedef StoreSlotMap<AmbientNode> TStoreAmbientNodes;
+	typedef StoreSlotMap<BlockNode> TStoreBlockNodes;
+	typedef StoreSlotMap<BlockChainNode> TStoreBlockChainNodes;
+	typedef StoreSlotMap<ControlPointNode> TStoreControlPointNodes;
+	typedef StoreSlotMap<EmitterNode> TStoreEmitterNodes;
+	typedef StoreSlotMap<InstanceNode> TStoreInstanceNodes;
+	typedef StoreSlotMap<LightNode> TStoreLightNodes;
+	typedef StoreSlotMap<PathNode> TStorePathNodes;
+	typedef StoreSlotMap<PhysicsNode> TStorePhysicsNodes;
+	typedef StoreSlotMap<PrefabNode> TStorePrefabNodes;
+	typedef StoreSlotMap<ProjectNode> TStoreProjectNodes;
+	typedef StoreSlotMap<ShakerNode> TStoreShakerNodes;
+	typedef StoreSlotMap<SoundNode> TStoreSoundNodes;
+	typedef StoreSlotMap<TerrainNode> TStoreTerrainNodes;
 	class WorldManager : public Singleton<WorldManager>, public Object, public Math::OctreeDelegate,
 		private TStoreModelNodes, private TStoreParticlesNodes,
 		private TStoreBaseNodes, private TStoreAmbientNodes, private TStoreBlockNodes,
@@ -36,7 +36,69 @@ namespace verus::World
 #include "../Shaders/DS.inc.hlsl"
 #include "../Shaders/DS_AmbientNode.inc.hlsl"
 
+	public:
+		struct LODStats // Accumulated over all passes of the frame.
+		{
+			INT64 _triangleCount = 0; // Drawn triangles of blocks.
+			INT64 _fullTriangleCount = 0; // Same blocks without levels of detail.
+			int   _instanceCount[BaseMesh::s_maxLODCount] = {};
+			float _selectTime = 0; // Milliseconds.
+		};
+		VERUS_TYPEDEFS(LODStats);
+
+		struct ClusterStats // Accumulated over all passes of the frame.
+		{
+			int   _blockCount = 0; // Blocks, which were drawn by clusters.
+			int   _clusterCount = 0;
+			int   _visibleClusterCount = 0;
+			int   _rangeCount = 0; // Draw calls.
+			INT64 _culledTriangleCount = 0;
+			float _cullTime = 0; // Milliseconds.
+		};
+		VERUS_TYPEDEFS(ClusterStats);
+
+		struct LightStats // Accumulated over the frame.
+		{
+			INT64 _visitedLightCount = 0; // By light grid, without it each query would visit all lights.
+			int   _queryCount = 0;
+			int   _lightCount = 0;
+			int   _clusteredLightCount = 0; // Drawn omni and spot lights, other visible ones are outside of clusters.
+			float _queryTime = 0; // Milliseconds.
+		};
+		VERUS_TYPEDEFS(LightStats);
+
+	private:
+		// Part of the world file, which contains whole node hierarchies.
+		// Chunk 0 has global nodes (models, prefabs, etc.), other chunks are spatial and can be loaded later.
+		struct WorldChunk
+		{
+			Math::Bounds _bounds;
+			INT64        _offset = 0;
+			INT64        _size = 0;
+			INT64        _uncompressedSize = 0;
+			int          _firstNode = 0;
+			int          _nodeCount = 0;
+			bool         _loaded = false;
+		};
+		VERUS_TYPEDEFS(WorldChunk);
+
+		// Instances of a block's model, which are drawn with the same material and level of detail.
+		// Blocks drawn by clusters are single instances with their own index ranges.
+		struct BlockBatch
+		{
+			ModelNodePtr _modelNode;
+			MaterialPtr  _material;
+			int          _lod = 0;
+			int          _firstInstance = 0;
+			int          _instanceCount = 0;
+			int          _firstClusterRange = 0;
+			int          _clusterRangeCount = 0;
+		};
+		VERUS_TYPEDEFS(BlockBatch);
+
 		Math::Octree         _octree;
+		LightGrid            _lightGrid;
+		LightClusters        _lightClusters;
 		LocalPtr<btBoxShape> _pPickingShape;
 		PCamera              _pPassCamera = nullptr; // Render pass camera for getting view and projection matrices.
 		PMainCamera          _pHeadCamera = nullptr; // Head camera which is located between the eyes.
@@ -45,17 +107,49 @@ namespace verus::World
 		PLightNode           _pSmbpDynamic[8];
 		Vector<PBaseNode>    _vNodes;
 		Vector<PBaseNode>    _vVisibleNodes;
+		Vector<PBaseNode>    _vSortedNodes;
+		Vector<SortKey>      _vSortKeys;
+		Vector<SortKey>      _vSortKeysTemp;
+		SortIdAllocator      _modelSortIdAllocator;
+		Vector<PLightNode>   _vShadowReservedLightNodes;
+		Vector<PLightNode>   _vVisibleLightNodes;
+		Vector<PBaseNode>    _vEventSubscribers[+NodeEvent::count]; // Nodes, which want to know about events of other nodes.
+		Vector<Vector<PBaseNode>> _vDirtyTransformNodes; // Per depth.
+		Vector<Vector<SlotHandle>> _vForEachHandles; // Free snapshots for ForEachStored, which can be nested.
+		Vector<BaseMesh::IndexRange> _vClusterRanges;
+		Vector<BaseMesh::IndexRange> _vBlockBatchClusterRanges; // All cluster ranges of block batches.
+		Vector<BlockBatch>   _vBlockBatches;
+		Vector<WorldChunk>   _vWorldChunks;
+		Vector<BYTE>         _vWorldChunkData; // Compressed chunks, which are not loaded yet.
+		Vector<PBaseNode>    _vWorldChunkNodes; // File index to node, used when loading chunks.
+		Vector<BYTE>         _vLazyWorldChunkData; // Decompressed chunk, which is loaded in steps.
+		HashMap<PcBaseNode, int> _mapWorldChunkIndices; // Node to file index, used when saving chunks.
 		Random               _random;
 		int                  _visibleCount = 0;
 		int                  _visibleCountPerType[+NodeType::count];
 		int                  _worldSide = 0;
 		int                  _recursionDepth = 0;
+		int                  _lazyWorldChunk = -1; // Partially loaded chunk.
+		int                  _lazyWorldChunkNode = 0;
+		INT64                _lazyWorldChunkOffset = 0;
 		int                  _smbpDynamicCount = 0;
 		int                  _smbpDynamicMax = 0;
 		float                _pickingShapeHalfExtent = 0.05f;
 		float                _lightsReserveShadowDist = 100;
 		float                _lightsFreeShadowDist = 150;
+		float                _worldChunkSide = 128;
+		float                _worldChunkLoadDist = 400;
+		float                _worldChunkTimeBudget = 2; // Milliseconds per frame for lazy loading.
+		float                _lodPixelError = 1;
+		LODStats             _lodStats;
+		ClusterStats         _clusterStats;
+		LightStats           _lightStats;
+		UINT32               _worldChunkVersion = 0;
 		bool                 _async_loaded = false;
+		bool                 _deferredTransformMode = false;
+		bool                 _worldChunkMapping = false;
+		bool                 _lazyWorldChunks = true;
+		bool                 _clusterCulling = true;
 
 	public:
 		struct Desc
@@ -92,8 +186,12 @@ namespace verus::World
 		void UpdateParts();
 		void Layout();
 		void SortVisible();
+		// Sort key is [type:5][group:37][depth:22], group depends on node type:
+		static UINT64 MakeSortKey(NodeType type, UINT64 group, float distToHeadSq);
+		static UINT64 MakeBlockSortGroup(MaterialPtr material, int modelSortID, int lod);
 		void Draw();
 		void DrawSimple(DrawSimpleMode mode);
+		VERUS_P(void CullClusters(PBlockNode pBlockNode));
 		void DrawTerrainNodes(Terrain::RcDrawDesc dd);
 		void DrawTerrainNodesSimple(DrawSimpleMode mode);
 		void DrawLights();
@@ -108,6 +206,32 @@ namespace verus::World
 
 		static int GetEditorOverlaysAlpha(int originalAlpha, float distSq, float fadeDistSq);
 
+		// <DeferredTransform>
+		// In deferred mode (see Settings::_worldDeferredTransforms) transform changes only mark nodes as dirty.
+		// The before event is sent when a node becomes dirty.
+		// Global transforms, bounds and after events are processed once per frame, level by level.
+		bool IsDeferredTransformMode() const { return _deferredTransformMode; }
+		void SetDeferredTransformMode(bool deferred);
+		void AddDirtyTransformNode(PBaseNode pNode);
+		void RemoveDirtyTransformNode(PBaseNode pNode);
+		void UpdateTransforms();
+		// </DeferredTransform>
+
+		// <LevelOfDetail>
+		// Blocks use simplified meshes, when the error projected on screen is small enough.
+		float GetLODPixelError() const { return _lodPixelError; }
+		void SetLODPixelError(float error) { _lodPixelError = error; } // Zero disables levels of detail.
+		void SelectLODs();
+		RcLODStats GetLODStats() const { return _lodStats; }
+		// </LevelOfDetail>
+
+		// <Clusters>
+		// Large blocks at full detail are drawn alone, only their visible clusters are submitted.
+		bool IsClusterCullingEnabled() const { return _clusterCulling; }
+		void EnableClusterCulling(bool b = true) { _clusterCulling = b; }
+		RcClusterStats GetClusterStats() const { return _clusterStats; }
+		// </Clusters>
+
 		// <Lights>
 		PLightNode GetSmbpStatic() const { return _pSmbpStatic; }
 		PLightNode GetSmbpDynamic(int index) const { return _pSmbpDynamic[index]; }
@@ -115,6 +239,13 @@ namespace verus::World
 		bool IsSmbpDynamic(PcLightNode pLightNode) const;
 		int GetInfluentialLightsAt(Math::RcSphere sphere, PLightNode lightNodes[], int maxLights = 4, bool forShadow = true, bool incDir = false);
 		void InfluentialLightsToSmbpDynamic(Math::RcSphere sphere);
+		void BindLightNode(PLightNode pLightNode);
+		void UnbindLightNode(PLightNode pLightNode);
+		RLightGrid GetLightGrid() { return _lightGrid; }
+		// Assigns visible lights to clusters of the pass camera's frustum, called by DrawLights:
+		void BuildLightClusters();
+		RcLightClusters GetLightClusters() const { return _lightClusters; }
+		RcLightStats GetLightStats() const { return _lightStats; }
 		// </Lights>
 
 		// <Cameras>
@@ -171,18 +302,18 @@ namespace verus::World
 
 			if (NodeType::unknown == query._type || NodeType::block == query._type)
 			{
-				VERUS_FOREACH_X(TStoreBlockNodes::TList, TStoreBlockNodes::_list, it)
-				{
-					auto& block = *it++;
-					if (
-						MatchName(block) &&
-						MatchSelected(block) &&
-						MatchParent(block) &&
-						(!query._blockMesh || block.GetURL() == query._blockMesh) &&
-						(!query._blockMaterial || block.GetMaterial()->_name == query._blockMaterial))
-						if (Continue::no == fn(block))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreBlockNodes>([&](auto& block)
+					{
+						if (
+							MatchName(block) &&
+							MatchSelected(block) &&
+							MatchParent(block) &&
+							(!query._blockMesh || block.GetURL() == query._blockMesh) &&
+							(!query._blockMaterial || block.GetMaterial()->_name == query._blockMaterial))
+							return fn(block);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (query._blockMesh || query._blockMaterial)
@@ -190,16 +321,16 @@ namespace verus::World
 
 			if (NodeType::unknown == query._type || NodeType::base == query._type)
 			{
-				VERUS_FOREACH_X(TStoreBaseNodes::TList, TStoreBaseNodes::_list, it)
-				{
-					auto& node = *it++;
-					if (
-						MatchName(node) &&
-						MatchSelected(node) &&
-						MatchParent(node))
-						if (Continue::no == fn(node))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreBaseNodes>([&](auto& node)
+					{
+						if (
+							MatchName(node) &&
+							MatchSelected(node) &&
+							MatchParent(node))
+							return fn(node);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::model == query._type)
@@ -235,185 +366,185 @@ namespace verus::World
 
 			if (NodeType::unknown == query._type || NodeType::ambient == query._type)
 			{
-				VERUS_FOREACH_X(TStoreAmbientNodes::TList, TStoreAmbientNodes::_list, it)
-				{
-					auto& ambient = *it++;
-					if (
-						MatchName(ambient) &&
-						MatchSelected(ambient) &&
-						MatchParent(ambient))
-						if (Continue::no == fn(ambient))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreAmbientNodes>([&](auto& ambient)
+					{
+						if (
+							MatchName(ambient) &&
+							MatchSelected(ambient) &&
+							MatchParent(ambient))
+							return fn(ambient);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::blockChain == query._type)
 			{
-				VERUS_FOREACH_X(TStoreBlockChainNodes::TList, TStoreBlockChainNodes::_list, it)
-				{
-					auto& blockChain = *it++;
-					if (
-						MatchName(blockChain) &&
-						MatchSelected(blockChain) &&
-						MatchParent(blockChain))
-						if (Continue::no == fn(blockChain))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreBlockChainNodes>([&](auto& blockChain)
+					{
+						if (
+							MatchName(blockChain) &&
+							MatchSelected(blockChain) &&
+							MatchParent(blockChain))
+							return fn(blockChain);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::controlPoint == query._type)
 			{
-				VERUS_FOREACH_X(TStoreControlPointNodes::TList, TStoreControlPointNodes::_list, it)
-				{
-					auto& controlPoint = *it++;
-					if (
-						MatchName(controlPoint) &&
-						MatchSelected(controlPoint) &&
-						MatchParent(controlPoint))
-						if (Continue::no == fn(controlPoint))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreControlPointNodes>([&](auto& controlPoint)
+					{
+						if (
+							MatchName(controlPoint) &&
+							MatchSelected(controlPoint) &&
+							MatchParent(controlPoint))
+							return fn(controlPoint);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::emitter == query._type)
 			{
-				VERUS_FOREACH_X(TStoreEmitterNodes::TList, TStoreEmitterNodes::_list, it)
-				{
-					auto& emitter = *it++;
-					if (
-						MatchName(emitter) &&
-						MatchSelected(emitter) &&
-						MatchParent(emitter) &&
-						(!query._particlesURL || emitter.GetURL() == query._particlesURL))
-						if (Continue::no == fn(emitter))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreEmitterNodes>([&](auto& emitter)
+					{
+						if (
+							MatchName(emitter) &&
+							MatchSelected(emitter) &&
+							MatchParent(emitter) &&
+							(!query._particlesURL || emitter.GetURL() == query._particlesURL))
+							return fn(emitter);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::instance == query._type)
 			{
-				VERUS_FOREACH_X(TStoreInstanceNodes::TList, TStoreInstanceNodes::_list, it)
-				{
-					auto& instance = *it++;
-					if (
-						MatchName(instance) &&
-						MatchSelected(instance) &&
-						MatchParent(instance))
-						if (Continue::no == fn(instance))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreInstanceNodes>([&](auto& instance)
+					{
+						if (
+							MatchName(instance) &&
+							MatchSelected(instance) &&
+							MatchParent(instance))
+							return fn(instance);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::light == query._type)
 			{
-				VERUS_FOREACH_X(TStoreLightNodes::TList, TStoreLightNodes::_list, it)
-				{
-					auto& light = *it++;
-					if (
-						MatchName(light) &&
-						MatchSelected(light) &&
-						MatchParent(light))
-						if (Continue::no == fn(light))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreLightNodes>([&](auto& light)
+					{
+						if (
+							MatchName(light) &&
+							MatchSelected(light) &&
+							MatchParent(light))
+							return fn(light);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::path == query._type)
 			{
-				VERUS_FOREACH_X(TStorePathNodes::TList, TStorePathNodes::_list, it)
-				{
-					auto& path = *it++;
-					if (
-						MatchName(path) &&
-						MatchSelected(path) &&
-						MatchParent(path))
-						if (Continue::no == fn(path))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStorePathNodes>([&](auto& path)
+					{
+						if (
+							MatchName(path) &&
+							MatchSelected(path) &&
+							MatchParent(path))
+							return fn(path);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::physics == query._type)
 			{
-				VERUS_FOREACH_X(TStorePhysicsNodes::TList, TStorePhysicsNodes::_list, it)
-				{
-					auto& physics = *it++;
-					if (
-						MatchName(physics) &&
-						MatchSelected(physics) &&
-						MatchParent(physics))
-						if (Continue::no == fn(physics))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStorePhysicsNodes>([&](auto& physics)
+					{
+						if (
+							MatchName(physics) &&
+							MatchSelected(physics) &&
+							MatchParent(physics))
+							return fn(physics);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::prefab == query._type)
 			{
-				VERUS_FOREACH_X(TStorePrefabNodes::TList, TStorePrefabNodes::_list, it)
-				{
-					auto& prefab = *it++;
-					if (
-						MatchName(prefab) &&
-						MatchSelected(prefab) &&
-						MatchParent(prefab))
-						if (Continue::no == fn(prefab))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStorePrefabNodes>([&](auto& prefab)
+					{
+						if (
+							MatchName(prefab) &&
+							MatchSelected(prefab) &&
+							MatchParent(prefab))
+							return fn(prefab);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::project == query._type)
 			{
-				VERUS_FOREACH_X(TStoreProjectNodes::TList, TStoreProjectNodes::_list, it)
-				{
-					auto& project = *it++;
-					if (
-						MatchName(project) &&
-						MatchSelected(project) &&
-						MatchParent(project))
-						if (Continue::no == fn(project))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreProjectNodes>([&](auto& project)
+					{
+						if (
+							MatchName(project) &&
+							MatchSelected(project) &&
+							MatchParent(project))
+							return fn(project);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::shaker == query._type)
 			{
-				VERUS_FOREACH_X(TStoreShakerNodes::TList, TStoreShakerNodes::_list, it)
-				{
-					auto& shaker = *it++;
-					if (
-						MatchName(shaker) &&
-						MatchSelected(shaker) &&
-						MatchParent(shaker))
-						if (Continue::no == fn(shaker))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreShakerNodes>([&](auto& shaker)
+					{
+						if (
+							MatchName(shaker) &&
+							MatchSelected(shaker) &&
+							MatchParent(shaker))
+							return fn(shaker);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::sound == query._type)
 			{
-				VERUS_FOREACH_X(TStoreSoundNodes::TList, TStoreSoundNodes::_list, it)
-				{
-					auto& sound = *it++;
-					if (
-						MatchName(sound) &&
-						MatchSelected(sound) &&
-						MatchParent(sound))
-						if (Continue::no == fn(sound))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreSoundNodes>([&](auto& sound)
+					{
+						if (
+							MatchName(sound) &&
+							MatchSelected(sound) &&
+							MatchParent(sound))
+							return fn(sound);
+						return Continue::yes;
+					}))
+					return;
 			}
 
 			if (NodeType::unknown == query._type || NodeType::terrain == query._type)
 			{
-				VERUS_FOREACH_X(TStoreTerrainNodes::TList, TStoreTerrainNodes::_list, it)
-				{
-					auto& terrain = *it++;
-					if (
-						MatchName(terrain) &&
-						MatchSelected(terrain) &&
-						MatchParent(terrain))
-						if (Continue::no == fn(terrain))
-							return;
-				}
+				if (Continue::no == ForEachStored<TStoreTerrainNodes>([&](auto& terrain)
+					{
+						if (
+							MatchName(terrain) &&
+							MatchSelected(terrain) &&
+							MatchParent(terrain))
+							return fn(terrain);
+						return Continue::yes;
+					}))
+					return;
 			}
 		}
 
@@ -441,6 +572,9 @@ namespace verus::World
 		// <NodeOperations>
 		String EnsureUniqueName(CSZ name, PcBaseNode pSkipNode = nullptr);
 		void SortNodes();
+		// Nodes are sorted after each insertion, disable sorting while inserting many nodes:
+		void DisableNodeSorting() { _recursionDepth++; }
+		void EnableNodeSorting() { _recursionDepth--; SortNodes(); }
 		int FindOffsetFor(NodeType type) const;
 
 		int GetNodeCount(int* pPerType = nullptr, bool excludeGenerated = false) const;
@@ -479,6 +613,8 @@ namespace verus::World
 
 		PModelNode InsertModelNode(CSZ url);
 		PModelNode FindModelNode(CSZ url);
+		UINT16     AllocateModelSortID() { return _modelSortIdAllocator.Allocate(); }
+		void       ReleaseModelSortID(UINT16 id) { _modelSortIdAllocator.Release(id); }
 
 		PParticlesNode InsertParticlesNode(CSZ url);
 		PParticlesNode FindParticlesNode(CSZ url);
@@ -513,7 +649,15 @@ namespace verus::World
 
 		PTerrainNode InsertTerrainNode();
 
+		PBaseNode InsertNode(NodeType type, CSZ url = nullptr);
+
 		// <Events>
+		// Events are delivered to the target node, to its children and to the subscribers.
+		// Subscribe only if the node must react to events of unrelated nodes.
+		void SubscribeToNodeEvent(NodeEvent event, PBaseNode pNode);
+		void UnsubscribeFromNodeEvent(NodeEvent event, PBaseNode pNode);
+		void UnsubscribeFromNodeEvents(PBaseNode pNode);
+		bool IsSubscribedToNodeEvent(NodeEvent event, PcBaseNode pNode) const;
 		void BroadcastOnNodeDeleted(PBaseNode pTargetNode, bool afterEvent, bool hierarchy);
 		void BroadcastOnNodeDuplicated(PBaseNode pTargetNode, bool afterEvent, PBaseNode pDuplicatedNode, HierarchyDuplication hierarchyDuplication);
 		void BroadcastOnNodeParentChanged(PBaseNode pTargetNode, bool afterEvent);
@@ -529,8 +673,62 @@ namespace verus::World
 		static NodeType HashToNodeType(UINT32 hash);
 		// </Serialization>
 
+		// <WorldChunks>
+		// Chunked format: binary header with chunk index, each chunk is compressed separately.
+		// Chunks are decompressed in parallel, far chunks are loaded when the head camera approaches.
+		void SerializeChunks(IO::RSeekableStream stream);
+		void DeserializeChunks(IO::RStream stream);
+		void UpdateWorldChunks();
+		void LoadAllWorldChunks();
+		int GetPendingWorldChunkCount() const;
+		bool IsLazyWorldChunks() const { return _lazyWorldChunks; }
+		void SetLazyWorldChunks(bool lazy) { _lazyWorldChunks = lazy; }
+		float GetWorldChunkSide() const { return _worldChunkSide; }
+		void SetWorldChunkSide(float side) { _worldChunkSide = Math::Max(side, 1.f); }
+		float GetWorldChunkLoadDist() const { return _worldChunkLoadDist; }
+		void SetWorldChunkLoadDist(float dist) { _worldChunkLoadDist = dist; }
+		float GetWorldChunkTimeBudget() const { return _worldChunkTimeBudget; }
+		void SetWorldChunkTimeBudget(float ms) { _worldChunkTimeBudget = ms; }
+		void LoadWorldChunks(const Vector<int>& vIndices);
+		VERUS_P(int DecompressWorldChunk(int index, Vector<BYTE>& vData) const);
+		VERUS_P(void LoadWorldChunkNode(IO::RStream stream, int fileIndex));
+		VERUS_P(void OnWorldChunksLoaded(const Vector<int>& vIndices, bool globalChunk));
+		VERUS_P(bool BeginLazyWorldChunk());
+		VERUS_P(void ContinueLazyWorldChunk(std::chrono::high_resolution_clock::time_point deadline));
+		bool IsWorldChunkNear(int index) const;
+		static bool IsChunkableNodeType(NodeType type);
+		// </WorldChunks>
+
 		static UINT32 NodeTypeToColor(NodeType type, int alpha = 255);
 		static int GetNodeTypePriority(NodeType type);
+
+	private:
+		// Nodes can be deleted by fn, so a snapshot of handles is visited and deleted nodes are skipped.
+		// Snapshot vectors are reused, so that there are no allocations after the first few calls:
+		template<typename TStore, typename TFn>
+		Continue ForEachStored(const TFn& fn)
+		{
+			TStore& store = *this;
+			Vector<SlotHandle> vHandles;
+			if (!_vForEachHandles.empty())
+			{
+				vHandles = std::move(_vForEachHandles.back());
+				_vForEachHandles.pop_back();
+			}
+			store.GetStoredHandles(vHandles);
+			Continue ret = Continue::yes;
+			for (const auto& handle : vHandles)
+			{
+				auto p = store.FindStored(handle);
+				if (p && Continue::no == fn(*p))
+				{
+					ret = Continue::no;
+					break;
+				}
+			}
+			_vForEachHandles.push_back(std::move(vHandles));
+			return ret;
+		}
 	};
 	VERUS_TYPEDEFS(WorldManager);
 }
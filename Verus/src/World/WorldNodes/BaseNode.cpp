@@ -38,7 +38,11 @@ void BaseNode::Init(RcDesc desc)
 void BaseNode::Done()
 {
 	WorldManager::I().GetOctree().UnbindElement(this);
+	WorldManager::I().UnsubscribeFromNodeEvents(this);
+	if (IsTransformDirty())
+		WorldManager::I().RemoveDirtyTransformNode(this);
 	RemoveRigidBody();
+	UnlinkHierarchy();
 
 	VERUS_DONE(BaseNode);
 }
@@ -51,10 +55,10 @@ void BaseNode::Duplicate(RBaseNode node, HierarchyDuplication hierarchyDuplicati
 	_uiScale = node._uiScale;
 	_bounds = node._bounds;
 	_dict = node._dict;
-	_pParent = node._pParent;
+	LinkParent(node._pParent);
 	_name = node._name;
 	_type = node._type;
-	_flags = node._flags | Flags::readOnlyFlags;
+	_flags = (node._flags & ~Flags::transformDirty) | Flags::readOnlyFlags;
 	_groups = node._groups;
 	_depth = node._depth;
 
@@ -185,7 +189,7 @@ bool BaseNode::SetParent(PBaseNode pNode, bool keepLocalTransform)
 	wm.BroadcastOnNodeParentChanged(this, false);
 	wm.BroadcastOnNodeTransformed(this, false);
 
-	_pParent = pNode;
+	LinkParent(pNode);
 	UpdateDepth();
 
 	if (keepLocalTransform)
@@ -201,6 +205,28 @@ bool BaseNode::SetParent(PBaseNode pNode, bool keepLocalTransform)
 	return true;
 }
 
+void BaseNode::LinkParent(PBaseNode pNode)
+{
+	if (_pParent == pNode)
+		return;
+	if (_pParent)
+	{
+		auto& vSiblings = _pParent->_vChildren;
+		vSiblings.erase(std::remove(vSiblings.begin(), vSiblings.end(), this), vSiblings.end());
+	}
+	_pParent = pNode;
+	if (_pParent)
+		_pParent->_vChildren.push_back(this);
+}
+
+void BaseNode::UnlinkHierarchy()
+{
+	LinkParent(nullptr);
+	for (auto pChildNode : _vChildren)
+		pChildNode->_pParent = nullptr;
+	_vChildren.clear();
+}
+
 bool BaseNode::IsOctreeElement(bool strict) const
 {
 	VERUS_QREF_WU;
@@ -332,41 +358,36 @@ Vector3 BaseNode::GetScale() const
 
 void BaseNode::MoveTo(RcPoint3 pos, bool local)
 {
-	VERUS_QREF_WM;
-	wm.BroadcastOnNodeTransformed(this, false);
+	const bool deferred = BeginTransformChange();
 	if (local)
 	{
 		_trLocal.setTranslation(Vector3(pos));
 		OnLocalTransformUpdated();
-		UpdateGlobalTransform();
 	}
 	else
 	{
+		if (deferred)
+			_trGlobal = ResolveGlobalTransform();
 		_trGlobal.setTranslation(Vector3(pos));
 		UpdateLocalTransform(false);
-		UpdateBounds();
 	}
-	wm.BroadcastOnNodeTransformed(this, true);
+	EndTransformChange(deferred, local);
 }
 
 void BaseNode::RotateTo(RcVector3 v)
 {
-	VERUS_QREF_WM;
-	wm.BroadcastOnNodeTransformed(this, false);
+	const bool deferred = BeginTransformChange();
 	_uiRotation = v;
 	UiToLocalTransform();
-	UpdateGlobalTransform();
-	wm.BroadcastOnNodeTransformed(this, true);
+	EndTransformChange(deferred, true);
 }
 
 void BaseNode::ScaleTo(RcVector3 v)
 {
-	VERUS_QREF_WM;
-	wm.BroadcastOnNodeTransformed(this, false);
+	const bool deferred = BeginTransformChange();
 	_uiScale = v;
 	UiToLocalTransform();
-	UpdateGlobalTransform();
-	wm.BroadcastOnNodeTransformed(this, true);
+	EndTransformChange(deferred, true);
 }
 
 void BaseNode::SetDirection(RcVector3 dir)
@@ -383,26 +404,24 @@ RcTransform3 BaseNode::GetTransform(bool local) const
 
 void BaseNode::SetTransform(RcTransform3 tr, bool local)
 {
-	VERUS_QREF_WM;
-	wm.BroadcastOnNodeTransformed(this, false);
+	const bool deferred = BeginTransformChange();
 	if (local)
 	{
 		_trLocal = tr;
 		OnLocalTransformUpdated();
 		UiFromLocalTransform();
-		UpdateGlobalTransform();
 	}
 	else
 	{
 		_trGlobal = tr;
 		UpdateLocalTransform();
-		UpdateBounds();
 	}
-	wm.BroadcastOnNodeTransformed(this, true);
+	EndTransformChange(deferred, local);
 }
 
 void BaseNode::OverrideGlobalTransform(RcTransform3 tr)
 {
+	// Always immediate, because local transform is not changed:
 	VERUS_QREF_WM;
 	wm.BroadcastOnNodeTransformed(this, false);
 	_trGlobal = tr;
@@ -412,13 +431,35 @@ void BaseNode::OverrideGlobalTransform(RcTransform3 tr)
 
 void BaseNode::RestoreTransform(RcTransform3 trLocal, RcVector3 rot, RcVector3 scale)
 {
-	VERUS_QREF_WM;
-	wm.BroadcastOnNodeTransformed(this, false);
+	const bool deferred = BeginTransformChange();
 	_trLocal = trLocal;
 	_uiRotation = rot;
 	_uiScale = scale;
 	OnLocalTransformUpdated();
-	UpdateGlobalTransform();
+	EndTransformChange(deferred, true);
+}
+
+bool BaseNode::BeginTransformChange()
+{
+	VERUS_QREF_WM;
+	const bool deferred = wm.IsDeferredTransformMode();
+	if (!deferred || !IsTransformDirty()) // Before event is sent once per update.
+		wm.BroadcastOnNodeTransformed(this, false);
+	return deferred;
+}
+
+void BaseNode::EndTransformChange(bool deferred, bool localChanged)
+{
+	if (deferred)
+	{
+		MarkTransformDirty();
+		return;
+	}
+	if (localChanged)
+		UpdateGlobalTransform();
+	else
+		UpdateBounds();
+	VERUS_QREF_WM;
 	wm.BroadcastOnNodeTransformed(this, true);
 }
 
@@ -426,7 +467,7 @@ void BaseNode::UpdateLocalTransform(bool updateUiValues)
 {
 	_trLocal = _trGlobal;
 	if (_pParent)
-		_trLocal = VMath::inverse(_pParent->GetTransform()) * _trGlobal;
+		_trLocal = VMath::inverse(_pParent->ResolveGlobalTransform()) * _trGlobal;
 	OnLocalTransformUpdated();
 	if (updateUiValues)
 		UiFromLocalTransform();
@@ -441,6 +482,40 @@ void BaseNode::UpdateGlobalTransform(bool updateBounds)
 		UpdateBounds();
 }
 
+bool BaseNode::IsTransformDirty() const
+{
+	return !!(_flags & Flags::transformDirty);
+}
+
+void BaseNode::MarkTransformDirty()
+{
+	if (IsTransformDirty())
+		return;
+	VERUS_BITMASK_SET(_flags, Flags::transformDirty);
+	VERUS_QREF_WM;
+	wm.AddDirtyTransformNode(this);
+}
+
+Transform3 BaseNode::ResolveGlobalTransform() const
+{
+	bool dirty = false;
+	for (PcBaseNode pNode = this; pNode && !dirty; pNode = pNode->_pParent)
+		dirty = pNode->IsTransformDirty();
+	if (!dirty)
+		return _trGlobal;
+	return _pParent ? _pParent->ResolveGlobalTransform() * _trLocal : _trLocal;
+}
+
+void BaseNode::UpdateDeferredTransform(bool updateGlobalTransform)
+{
+	VERUS_BITMASK_UNSET(_flags, Flags::transformDirty);
+	if (updateGlobalTransform)
+		UpdateGlobalTransform(false);
+	UpdateBounds();
+	VERUS_QREF_WM;
+	wm.BroadcastOnNodeTransformed(this, true); // Only after event, children will be marked as dirty.
+}
+
 void BaseNode::UiToLocalTransform()
 {
 	Quat q;
@@ -528,6 +603,7 @@ void BaseNode::UpdateRigidBodyTransform()
 	{
 		// https://pybullet.org/Bullet/phpBB3/viewtopic.php?t=6729
 		VERUS_QREF_BULLET;
+		bullet.WaitForSimulation(); // Motion states are written by physics thread.
 		_pRigidBody->setWorldTransform(_trGlobal.Bullet());
 		_pRigidBody->getMotionState()->setWorldTransform(_trGlobal.Bullet());
 		bullet.GetWorld()->updateSingleAabb(_pRigidBody);
@@ -550,7 +626,7 @@ void BaseNode::OnNodeDuplicated(PBaseNode pNode, bool afterEvent, PBaseNode pDup
 	{
 		VERUS_QREF_WM;
 		if (PBaseNode pThisDuplicatedNode = wm.DuplicateNode(this, hierarchyDuplication))
-			pThisDuplicatedNode->_pParent = pDuplicatedNode;
+			pThisDuplicatedNode->LinkParent(pDuplicatedNode);
 	}
 }
 
@@ -579,6 +655,13 @@ void BaseNode::OnNodeTransformed(PBaseNode pNode, bool afterEvent)
 	if (afterEvent && pNode == _pParent)
 	{
 		VERUS_QREF_WM;
+		if (wm.IsDeferredTransformMode())
+		{
+			if (!IsTransformDirty())
+				wm.BroadcastOnNodeTransformed(this, false);
+			MarkTransformDirty();
+			return;
+		}
 		wm.BroadcastOnNodeTransformed(this, false);
 		UpdateGlobalTransform();
 		wm.BroadcastOnNodeTransformed(this, true);
@@ -619,7 +702,7 @@ void BaseNode::Deserialize(IO::RStream stream)
 	_trLocal = trLocal;
 	_uiRotation = uiRotation;
 	_uiScale = uiScale;
-	_pParent = wm.GetNodeByIndex(parentIndex);
+	LinkParent(wm.GetNodeByIndex(parentIndex));
 	_name = name;
 	_flags |= Flags::readOnlyFlags;
 
@@ -737,7 +820,7 @@ void BaseNode::DeserializeXML(pugi::xml_node node)
 	_flags = static_cast<Flags>(node.attribute("flags").as_uint());
 	_groups = node.attribute("groups").as_uint();
 
-	_pParent = wm.GetNodeByIndex(parentIndex);
+	LinkParent(wm.GetNodeByIndex(parentIndex));
 
 	if (NodeType::base == _type)
 		Init(_C(_name));
@@ -23,24 +23,32 @@ namespace verus::World
 			selected = (1 << 5),
 			shadow = (1 << 6),
 			reserveShadow = (1 << 7),
+			transformDirty = (1 << 8), // Global transform will be updated by WorldManager (deferred mode).
 
 			readOnlyFlags = (1u << 31),
-			serializedMask = ~(octreeBindOnce | generated | selected | reserveShadow)
+			serializedMask = ~(octreeBindOnce | generated | selected | reserveShadow | transformDirty)
 		};
 
-		Transform3     _trLocal = Transform3::identity();
-		Transform3     _trGlobal = Transform3::identity();
-		Vector3        _uiRotation = Vector3(0); // User-friendly rotation used in editor's UI.
-		Vector3        _uiScale = Vector3(1, 1, 1); // User-friendly scale used in editor's UI.
-		Math::Bounds   _bounds;
-		IO::Dictionary _dict;
-		btRigidBody* _pRigidBody = nullptr;
-		BaseNode* _pParent = nullptr;
-		String         _name;
-		NodeType       _type = NodeType::base;
-		Flags          _flags = Flags::none;
-		UINT32         _groups = 0;
-		int            _depth = 0;
+		Transform3        _trLocal = Transform3::identity();
+		Transform3        _trGlobal = Transform3::identity();
+		Vector3           _uiRotation = Vector3(0); // User-friendly rotation used in editor's UI.
+		Vector3           _uiScale = Vector3(1, 1, 1); // User-friendly scale used in editor's UI.
+		Math::Bounds      _bounds;
+		IO::Dictionary    _dict;
+		btRigidBody*      _pRigidBody = nullptr;
+		BaseNode*         _pParent = nullptr;
+		Vector<BaseNode*> _vChildren; // Kept in sync with _pParent, use LinkParent() to change parent.
+		String            _name;
+		NodeType          _type = NodeType::base;
+		Flags             _flags = Flags::none;
+		UINT32            _groups = 0;
+		int               _depth = 0;
+
+		void LinkParent(BaseNode* pNode); // Changes parent without events.
+		void UnlinkHierarchy();
+
+		bool BeginTransformChange();
+		void EndTransformChange(bool deferred, bool localChanged);
 
 	public:
 		struct Desc
@@ -87,6 +95,7 @@ namespace verus::World
 		BaseNode* GetParent() const;
 		bool SetParent(BaseNode* pNode, bool keepLocalTransform = false);
 		virtual bool CanSetParent(BaseNode* pNode) const { return true; }
+		const Vector<BaseNode*>& GetChildren() const { return _vChildren; }
 		// </Hierarchy>
 
 		// <Flags>
@@ -141,6 +150,11 @@ namespace verus::World
 		void UiToLocalTransform();
 		void UiFromLocalTransform();
 		virtual void OnLocalTransformUpdated() {} // Can be used to adjust local transform.
+		// In deferred mode GetTransform() can return old global transform until WorldManager::UpdateTransforms() is called:
+		bool IsTransformDirty() const;
+		void MarkTransformDirty();
+		Transform3 ResolveGlobalTransform() const;
+		void UpdateDeferredTransform(bool updateGlobalTransform = true);
 		// </Transform>
 
 		Math::RcBounds GetBounds() const { return _bounds; }
@@ -154,6 +168,7 @@ namespace verus::World
 		// </Physics>
 
 		// <Events>
+		// Event is delivered to the target node, to its children and to nodes, which are subscribed to this event (see WorldManager).
 		virtual void OnNodeDeleted(BaseNode* pNode, bool afterEvent, bool hierarchy);
 		virtual void OnNodeDuplicated(BaseNode* pNode, bool afterEvent, BaseNode* pDuplicatedNode, HierarchyDuplication hierarchyDuplication);
 		virtual void OnNodeParentChanged(BaseNode* pNode, bool afterEvent);
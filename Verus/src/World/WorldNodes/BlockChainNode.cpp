@@ -30,7 +30,7 @@ BlockChainNode::~BlockChainNode()
 
 void BlockChainNode::Init(RcDesc desc)
 {
-	_pParent = desc._pPathNode;
+	LinkParent(desc._pPathNode);
 	UpdateDepth();
 	String name;
 	if (!desc._name)
@@ -38,6 +38,9 @@ void BlockChainNode::Init(RcDesc desc)
 	BaseNode::Init(desc._name ? desc._name : _C(name));
 
 	_vSourceModels.reserve(8);
+
+	VERUS_QREF_WM;
+	wm.SubscribeToNodeEvent(NodeEvent::deleted, this); // Source models are not related to this node.
 }
 
 void BlockChainNode::Done()
@@ -51,10 +54,11 @@ void BlockChainNode::Duplicate(RBaseNode node, HierarchyDuplication hierarchyDup
 
 	RBlockChainNode blockChainNode = static_cast<RBlockChainNode>(node);
 
-	if (NodeType::block == _type)
+	if (NodeType::blockChain == _type)
 	{
 		Desc desc;
 		desc._name = _C(_name);
+		desc._pPathNode = GetParent();
 		Init(desc);
 	}
 }
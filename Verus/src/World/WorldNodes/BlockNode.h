@@ -14,6 +14,7 @@ namespace verus::World
 		ModelNodePwn _modelNode;
 		MaterialPwn  _material;
 		int          _materialIndex = 0;
+		int          _lod = 0; // Selected by WorldManager.
 		bool         _async_loadedModel = false;
 
 	public:
@@ -55,6 +56,9 @@ namespace verus::World
 
 		RcVector4 GetColor() { return _userColor; }
 		void SetColor(RcVector4 color) { _userColor = color; }
+
+		int GetLOD() const { return _lod; }
+		void SetLOD(int lod) { _lod = lod; }
 	};
 	VERUS_TYPEDEFS(BlockNode);
 
@@ -18,7 +18,7 @@ ControlPointNode::~ControlPointNode()
 
 void ControlPointNode::Init(RcDesc desc)
 {
-	_pParent = desc._pPathNode;
+	LinkParent(desc._pPathNode);
 	UpdateDepth();
 	String name;
 	if (!desc._name)
@@ -152,17 +152,15 @@ void ControlPointNode::OnNodeDeleted(PBaseNode pNode, bool afterEvent, bool hier
 {
 	BaseNode::OnNodeDeleted(pNode, afterEvent, hierarchy);
 
-	if (!afterEvent)
+	if (!afterEvent && pNode == this) // Neighbors are not notified, so connect them here:
 	{
-		if (pNode == _pPrev)
+		if (_pPrev && _pPrev->_pNext == this)
 		{
-			_pPrev = static_cast<PControlPointNode>(pNode)->GetPreviousControlPoint();
-		}
-		if (pNode == _pNext)
-		{
-			_pNext = static_cast<PControlPointNode>(pNode)->GetNextControlPoint();
-			UpdateSegmentLength();
+			_pPrev->_pNext = _pNext;
+			_pPrev->UpdateSegmentLength();
 		}
+		if (_pNext && _pNext->_pPrev == this)
+			_pNext->_pPrev = _pPrev;
 	}
 }
 
@@ -181,10 +179,11 @@ void ControlPointNode::OnNodeTransformed(PBaseNode pNode, bool afterEvent)
 {
 	BaseNode::OnNodeTransformed(pNode, afterEvent);
 
-	if (afterEvent)
+	if (afterEvent && pNode == this)
 	{
-		if (pNode == this || pNode == _pNext)
-			UpdateSegmentLength();
+		UpdateSegmentLength();
+		if (_pPrev && _pPrev->_pNext == this)
+			_pPrev->UpdateSegmentLength();
 	}
 }
 
@@ -36,6 +36,8 @@ void LightNode::Init(RcDesc desc)
 void LightNode::Done()
 {
 	UpdateShadowMapHandle(true);
+	if (WorldManager::IsValidSingleton())
+		WorldManager::I().UnbindLightNode(this);
 	VERUS_DONE(LightNode);
 }
 
@@ -196,6 +198,8 @@ void LightNode::UpdateBounds()
 	const bool dir = (CGI::LightType::dir == _data._lightType);
 	const bool octreeRoot = (IsDynamic() || dir);
 
+	wm.BindLightNode(this);
+
 	VERUS_QREF_WU;
 	RMesh mesh = wu.GetDeferredShadingMeshes().Get(_data._lightType);
 	if (mesh.IsLoaded())
@@ -354,6 +358,8 @@ RcVector4 LightNode::GetColor() const
 void LightNode::SetColor(RcVector4 color)
 {
 	_data._color = color;
+	if (IsInitialized())
+		WorldManager::I().BindLightNode(this); // Influence depends on intensity.
 	RequestShadowMapUpdate();
 }
 
@@ -365,6 +371,8 @@ float LightNode::GetIntensity() const
 void LightNode::SetIntensity(float i)
 {
 	_data._color.setW(i);
+	if (IsInitialized())
+		WorldManager::I().BindLightNode(this); // Influence depends on intensity.
 	RequestShadowMapUpdate();
 }
 
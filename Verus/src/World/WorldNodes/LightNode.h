@@ -15,17 +15,28 @@ namespace verus::World
 	};
 	VERUS_TYPEDEFS(LightData);
 
+	// Location of a light in LightGrid.
+	struct LightGridBinding
+	{
+		short  _range[4] = { -1, -1, -1, -1 }; // Cells x0, z0, x1, z1.
+		UINT32 _queryID = 0;
+		bool   _bound = false;
+		bool   _unbounded = false; // Stored in the list, which is always checked.
+	};
+	VERUS_TYPEDEFS(LightGridBinding);
+
 	// LightNode defines a light source.
 	// LightNode's scale is tied to the radius.
 	// * has different light parameters, like color, radius, etc.
 	class LightNode : public BaseNode
 	{
-		Matrix4         _matShadow = Matrix4::identity();
-		LightData       _data;
-		ShadowMapHandle _shadowMapHandle;
-		float           _cachedInfluence = 0;
-		bool            _shadowMapUpdateRequired = false;
-		bool            _async_loadedMesh = false;
+		Matrix4          _matShadow = Matrix4::identity();
+		LightData        _data;
+		ShadowMapHandle  _shadowMapHandle;
+		LightGridBinding _lightGridBinding;
+		float            _cachedInfluence = 0;
+		bool             _shadowMapUpdateRequired = false;
+		bool             _async_loadedMesh = false;
 
 	public:
 		struct Desc : BaseNode::Desc
@@ -100,6 +111,7 @@ namespace verus::World
 
 		float GetInfluenceAt(Math::RcSphere sphere);
 		float GetCachedInfluence() const { return _cachedInfluence; }
+		RLightGridBinding GetLightGridBinding() { return _lightGridBinding; }
 	};
 	VERUS_TYPEDEFS(LightNode);
 
@@ -21,8 +21,11 @@ void ModelNode::Init(RcDesc desc)
 	if (_refCount)
 		return;
 
+	VERUS_QREF_WM;
+
 	BaseNode::Init(desc._name ? desc._name : desc._url);
 	_refCount = 1;
+	_sortID = wm.AllocateModelSortID();
 
 	Mesh::Desc meshDesc;
 	meshDesc._url = desc._url;
@@ -40,6 +43,8 @@ bool ModelNode::Done()
 	{
 		_material.Done();
 		_mesh.Done();
+		if (IsInitialized() && WorldManager::IsValidSingleton())
+			WorldManager::I().ReleaseModelSortID(_sortID);
 
 		VERUS_DONE(ModelNode);
 		return true;
@@ -157,12 +162,22 @@ void ModelNode::PushInstance(RcTransform3 matW, RcVector4 instData)
 	_mesh.PushInstance(matW, instData);
 }
 
-void ModelNode::Draw(CGI::CommandBufferPtr cb)
+void ModelNode::Draw(CGI::CommandBufferPtr cb, int lod)
+{
+	if (!_mesh.IsInstanceBufferEmpty(true))
+	{
+		_mesh.UpdateInstanceBuffer();
+		cb->DrawIndexed(_mesh.GetLODIndexCount(lod), _mesh.GetInstanceCount(true), _mesh.GetLODFirstIndex(lod), 0, _mesh.GetMarkedInstance());
+	}
+}
+
+void ModelNode::Draw(CGI::CommandBufferPtr cb, const Vector<BaseMesh::IndexRange>& vRanges)
 {
 	if (!_mesh.IsInstanceBufferEmpty(true))
 	{
 		_mesh.UpdateInstanceBuffer();
-		cb->DrawIndexed(_mesh.GetIndexCount(), _mesh.GetInstanceCount(true), 0, 0, _mesh.GetMarkedInstance());
+		for (const auto& range : vRanges)
+			cb->DrawIndexed(range._indexCount, _mesh.GetInstanceCount(true), range._firstIndex, 0, _mesh.GetMarkedInstance());
 	}
 }
 
@@ -11,6 +11,7 @@ namespace verus::World
 		Mesh        _mesh;
 		MaterialPwn _material;
 		int         _refCount = 0;
+		UINT16      _sortID = 0;
 
 	public:
 		struct Desc : BaseNode::Desc
@@ -28,6 +29,7 @@ namespace verus::World
 
 		void AddRef() { _refCount++; }
 		int GetRefCount() const { return _refCount; }
+		UINT16 GetSortID() const { return _sortID; } // Stable ID for sort keys.
 
 		void Init(RcDesc desc);
 		bool Done();
@@ -56,7 +58,8 @@ namespace verus::World
 		void BindGeo(CGI::CommandBufferPtr cb);
 		void MarkInstance();
 		void PushInstance(RcTransform3 matW, RcVector4 instData);
-		void Draw(CGI::CommandBufferPtr cb);
+		void Draw(CGI::CommandBufferPtr cb, int lod = 0);
+		void Draw(CGI::CommandBufferPtr cb, const Vector<BaseMesh::IndexRange>& vRanges);
 	};
 	VERUS_TYPEDEFS(ModelNode);
 
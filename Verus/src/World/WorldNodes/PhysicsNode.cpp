@@ -61,6 +61,7 @@ void PhysicsNode::Duplicate(RBaseNode node, HierarchyDuplication hierarchyDuplic
 void PhysicsNode::Update()
 {
 	VERUS_QREF_BULLET;
+	bullet.WaitForSimulation(); // Motion states are written by physics thread.
 
 	PBlockNode pBlockNode = nullptr;
 	if (_pParent && NodeType::block == _pParent->GetType())
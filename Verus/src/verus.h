@@ -87,6 +87,9 @@ using namespace Microsoft::WRL;
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <Serialize/BulletWorldImporter/btBulletWorldImporter.h>
 #ifdef _DEBUG
 #	pragma comment(lib, "BulletCollision_vs2010_x64_debug.lib")
@@ -143,6 +146,7 @@ using namespace Microsoft::WRL;
 #include <atomic>
 #include <cassert>
 #include <ctime>
+#include <filesystem>
 #include <future>
 #include <iomanip>
 #include <limits>
@@ -89,6 +89,13 @@ extern "C"
 		}
 	}
 
+	VERUS_DLL_EXPORT CSZ VulkanCompilerVersion()
+	{
+		// Also change this when compiler's options change:
+		static const std::string version = std::string(glslang::GetGlslVersionString()) + "; HLSL; Vulkan 1.1; SPIR-V 1.3";
+		return version.c_str();
+	}
+
 	VERUS_DLL_EXPORT bool VulkanCompile(CSZ source, CSZ sourceName, CSZ* defines, ShaderInclude* pInclude,
 		CSZ entryPoint, CSZ target, UINT32 flags, UINT32** ppCode, UINT32* pSize, CSZ* ppErrorMsgs)
 	{